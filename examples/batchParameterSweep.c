@@ -0,0 +1,137 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file examples/batchParameterSweep.c
+ *	\version 1.0beta
+ *
+ *	Sweep over initial states of an integrator chain MPC problem, solved
+ *	as one batch of QPs with qpDUNES_solveBatch and compared against
+ *	solving every QP on its own.
+ */
+
+
+#include <qpDUNES.h>
+#include <math.h>
+
+#include "integratorChain.h"
+
+#define NBATCH	16
+
+
+/* QP bb of the sweep, with initial state 0.5 * sin( 0.4*bb + i ) */
+static return_t setupSweepQp(	qpData_t* const qpData,
+								int bb )
+{
+	double H[NZ*NZ];
+	double HTerminal[NX*NX];
+	double zLow[NZ], zUpp[NZ], z0Low[NZ], z0Upp[NZ];
+
+	setupChainHessian( H, NZ, 1.0, 0.0, 0.0 );
+	setupChainHessian( HTerminal, NX, 1.0, 0.0, 0.0 );
+	setupChainBounds( zLow, zUpp, 1.0 );
+	setupChainInitialState( z0Low, z0Upp, zLow, zUpp, 0.5, 0.4*bb );
+
+	return setupChainQp( qpData, H, HTerminal, z0Low, z0Upp, zLow, zUpp );
+}
+
+
+int main( )
+{
+	int bb, ii;
+	int nErrors = 0;
+
+	return_t statusFlag;
+	return_t exitFlags[NBATCH];
+	int_t numIter[NBATCH];
+
+	qpData_t qpDataBatch[NBATCH];
+	qpData_t qpDataSingle;
+
+	double zBatch[NI*NZ+NX];
+	double zSingle[NI*NZ+NX];
+	double maxDiff = 0.0;
+
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.maxIter    = 100;
+	qpOptions.printLevel = 0;
+	qpOptions.logLevel   = QPDUNES_LOG_OFF;
+
+
+	/** batch solve */
+	statusFlag = qpDUNES_setupBatch( qpDataBatch, NBATCH, NI, NX, NU, 0, &qpOptions );
+	if (statusFlag != QPDUNES_OK) {
+		printf( "qpDUNES batch setup failed.\n" );
+		return (int)statusFlag;
+	}
+	for ( bb=0; bb<NBATCH; ++bb ) {
+		setupSweepQp( &(qpDataBatch[bb]), bb );
+	}
+
+	statusFlag = qpDUNES_solveBatch( qpDataBatch, NBATCH, exitFlags, numIter );
+	if (statusFlag != QPDUNES_OK) {
+		printf( "qpDUNES batch solve failed (flag %d).\n", (int)statusFlag );
+	}
+
+
+	/** compare against single solves */
+	printf( "   QP | exit flag | iterations | max |z_batch - z_single|\n" );
+	for ( bb=0; bb<NBATCH; ++bb ) {
+		if ( qpDUNES_setup( &qpDataSingle, NI, NX, NU, 0, &qpOptions ) != QPDUNES_OK ) {
+			printf( "qpDUNES setup failed.\n" );
+			return 1;
+		}
+		setupSweepQp( &qpDataSingle, bb );
+		if ( qpDUNES_solve( &qpDataSingle ) != exitFlags[bb] ) {
+			++nErrors;
+		}
+		qpDUNES_getPrimalSol( &(qpDataBatch[bb]), zBatch );
+		qpDUNES_getPrimalSol( &qpDataSingle, zSingle );
+		maxDiff = 0.0;
+		for ( ii=0; ii<NI*NZ+NX; ++ii ) {
+			maxDiff = ( fabs( zBatch[ii] - zSingle[ii] ) > maxDiff ) ? fabs( zBatch[ii] - zSingle[ii] ) : maxDiff;
+		}
+		if ( maxDiff > 1.0e-8 ) {
+			++nErrors;
+		}
+		printf( "  %3d | %9d | %10d | %.2e\n", bb, (int)exitFlags[bb], (int)numIter[bb], maxDiff );
+
+		qpDUNES_cleanup( &qpDataSingle );
+	}
+
+	qpDUNES_cleanupBatch( qpDataBatch, NBATCH );
+
+	if ( ( statusFlag != QPDUNES_OK ) || ( nErrors != 0 ) ) {
+		printf( "Batch and single solutions differ for %d QPs.\n", nErrors );
+		return 1;
+	}
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
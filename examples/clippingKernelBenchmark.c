@@ -0,0 +1,214 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file examples/clippingKernelBenchmark.c
+ *	\version 1.0beta
+ *
+ *	Micro-benchmark of the clipping stage QP kernels (saturation, step size
+ *	to the first active set change, ratio test) for stage dimensions
+ *	nZ = 4...64, scalar versus vectorized versions. Reports ns per stage and
+ *	fails if the results of both versions differ.
+ */
+
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <qpDUNES.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define NSTAGES		20
+#define NRUNS		5000
+#define NSIZES		5
+
+
+static double wallTime( )
+{
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	return t.tv_sec + 1.0e-9*t.tv_nsec;
+}
+
+
+static double randomNumber( double lb, double ub )
+{
+	return lb + (ub - lb) * rand() / (double)RAND_MAX;
+}
+
+
+/* time all three kernels with the kernel table currently set in qpData;
+ * results of the last run are left in z, y, alphaMin and alphaRatio */
+static void runKernels(	qpData_t* const qpData,
+						double* const nsPerStage,
+						real_t* const alphaMin,
+						real_t* const alphaRatio )
+{
+	int kk, run;
+	interval_t* interval;
+	double t0;
+
+	/* saturation of line search trial points */
+	t0 = wallTime();
+	for ( run=0; run<NRUNS; ++run ) {
+		for ( kk=0; kk<NSTAGES; ++kk ) {
+			interval = qpData->intervals[kk];
+			addVectorScaledVector( &(interval->z), &(interval->qpSolverClipping.zUnconstrained), 1.0/(1+run%7), &(interval->qpSolverClipping.dz), interval->nV );
+			directQpSolver_saturateVector( qpData, &(interval->z), &(interval->y), &(interval->zLow), &(interval->zUpp), &(interval->H), interval->nV );
+		}
+	}
+	nsPerStage[0] = 1.0e9 * ( wallTime() - t0 ) / ( NRUNS * NSTAGES );
+
+	/* step size to first active set change */
+	t0 = wallTime();
+	for ( run=0; run<NRUNS; ++run ) {
+		*alphaMin = qpData->options.QPDUNES_INFTY;
+		for ( kk=0; kk<NSTAGES; ++kk ) {
+			clippingQpSolver_getMinStepsize( qpData, qpData->intervals[kk], alphaMin );
+		}
+	}
+	nsPerStage[1] = 1.0e9 * ( wallTime() - t0 ) / ( NRUNS * NSTAGES );
+
+	/* ratio test */
+	t0 = wallTime();
+	for ( run=0; run<NRUNS; ++run ) {
+		for ( kk=0; kk<NSTAGES; ++kk ) {
+			interval = qpData->intervals[kk];
+			clippingQpSolver_ratioTest( qpData, &(alphaRatio[kk]), &(interval->qpSolverClipping.dz), &(interval->y), &(interval->zLow), &(interval->zUpp), interval->nV );
+		}
+	}
+	nsPerStage[2] = 1.0e9 * ( wallTime() - t0 ) / ( NRUNS * NSTAGES );
+}
+
+
+int main( )
+{
+	const int sizes[NSIZES] = { 4, 8, 16, 32, 64 };
+	const char* kernelNames[3] = { "saturate", "minStepsize", "ratioTest" };
+
+	int ss, kk, jj;
+	unsigned int ii;
+	int nErrors = 0;
+
+	return_t statusFlag;
+
+	qpData_t qpData;
+	qpOptions_t qpOptions;
+	interval_t* interval;
+	clippingKernels_t simdKernels;
+
+	double nsScalar[3], nsSimd[3];
+	real_t alphaMinScalar, alphaMinSimd;
+	real_t alphaRatioScalar[NSTAGES], alphaRatioSimd[NSTAGES];
+	real_t* zScalar;
+	real_t* yScalar;
+
+
+	for ( ss=0; ss<NSIZES; ++ss ) {
+		const unsigned int nX = sizes[ss] / 2;
+		const unsigned int nU = sizes[ss] - nX;
+
+		qpOptions = qpDUNES_setupDefaultOptions();
+		qpOptions.printLevel = 0;
+		qpOptions.logLevel   = QPDUNES_LOG_OFF;
+
+		statusFlag = qpDUNES_setup( &qpData, NSTAGES-1, nX, nU, 0, &qpOptions );
+		if (statusFlag != QPDUNES_OK) {
+			printf( "qpDUNES setup failed.\n" );
+			return (int)statusFlag;
+		}
+
+		/* random stage data: box constraints (some infinite), half of the
+		 * diagonal Hessians identity, some zero directions and gaps */
+		srand( 42 );
+		for ( kk=0; kk<NSTAGES; ++kk ) {
+			interval = qpData.intervals[kk];
+			interval->H.sparsityType = ( kk % 2 == 0 ) ? QPDUNES_DIAGONAL : QPDUNES_IDENTITY;
+			for ( ii=0; ii<interval->nV; ++ii ) {
+				interval->H.data[ii] = randomNumber( 0.1, 10.0 );
+				interval->zLow.data[ii] = ( ii % 5 == 3 ) ? -qpOptions.QPDUNES_INFTY : randomNumber( -2.0, -0.5 );
+				interval->zUpp.data[ii] = ( ii % 7 == 5 ) ?  qpOptions.QPDUNES_INFTY : randomNumber(  0.5,  2.0 );
+				interval->qpSolverClipping.zUnconstrained.data[ii] = randomNumber( -2.0, 2.0 );
+				interval->qpSolverClipping.dz.data[ii] = ( ii % 6 == 1 ) ? 0.0 : randomNumber( -3.0, 3.0 );
+			}
+		}
+		zScalar = (real_t*)calloc( NSTAGES*(nX+nU), sizeof(real_t) );
+		yScalar = (real_t*)calloc( 2*NSTAGES*(nX+nU), sizeof(real_t) );
+
+		/* scalar versions */
+		simdKernels = qpData.clippingKernels;
+		qpData.clippingKernels.saturate = 0;
+		qpData.clippingKernels.minStepsize = 0;
+		qpData.clippingKernels.ratioTest = 0;
+		runKernels( &qpData, nsScalar, &alphaMinScalar, alphaRatioScalar );
+		for ( kk=0; kk<NSTAGES; ++kk ) {
+			interval = qpData.intervals[kk];
+			for ( ii=0; ii<interval->nV; ++ii ) {
+				zScalar[kk*(nX+nU)+ii] = interval->z.data[ii];
+				yScalar[2*kk*(nX+nU)+2*ii] = interval->y.data[2*ii];
+				yScalar[2*kk*(nX+nU)+2*ii+1] = interval->y.data[2*ii+1];
+			}
+		}
+
+		/* vectorized versions */
+		qpData.clippingKernels = simdKernels;
+		runKernels( &qpData, nsSimd, &alphaMinSimd, alphaRatioSimd );
+		for ( kk=0; kk<NSTAGES; ++kk ) {
+			interval = qpData.intervals[kk];
+			for ( ii=0; ii<interval->nV; ++ii ) {
+				nErrors += ( zScalar[kk*(nX+nU)+ii] != interval->z.data[ii] );
+				nErrors += ( yScalar[2*kk*(nX+nU)+2*ii] != interval->y.data[2*ii] );
+				nErrors += ( yScalar[2*kk*(nX+nU)+2*ii+1] != interval->y.data[2*ii+1] );
+			}
+			nErrors += ( alphaRatioScalar[kk] != alphaRatioSimd[kk] );
+		}
+		nErrors += ( alphaMinScalar != alphaMinSimd );
+
+		if ( ss == 0 ) {
+			printf( "Vectorized kernels:     %s\n", ( simdKernels.saturate != 0 ) ? "yes" : "no (scalar versions timed twice)" );
+			printf( "   nZ | kernel      | scalar [ns/stage] | vectorized [ns/stage] | speedup\n" );
+		}
+		for ( jj=0; jj<3; ++jj ) {
+			printf( "  %3d | %-11s | %17.1f | %21.1f | %6.2fx\n", sizes[ss], kernelNames[jj], nsScalar[jj], nsSimd[jj], nsScalar[jj] / nsSimd[jj] );
+		}
+
+		free( zScalar );
+		free( yScalar );
+		qpDUNES_cleanup( &qpData );
+	}
+
+	if ( nErrors != 0 ) {
+		printf( "Scalar and vectorized kernels disagree in %d results.\n", nErrors );
+		return 1;
+	}
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
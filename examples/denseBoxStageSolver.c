@@ -0,0 +1,204 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file examples/denseBoxStageSolver.c
+ *	\version 1.0beta
+ *
+ *	Integrator chain MPC problem with dense stage Hessians (coupled state
+ *	weights and state-input cross terms) and simple bounds only. The stage
+ *	QPs are solved by the box QP solver and, for reference, by qpOASES; both
+ *	have to give the same solution in every MPC step. Only the memory of
+ *	the stage QP solver in use is allocated, and the box QP stages share
+ *	one factor of their equal Hessians.
+ */
+
+
+#include <qpDUNES.h>
+#include <math.h>
+
+#include "integratorChain.h"
+
+#define NSTEPS	5
+
+
+static double H[NI+1][NZ*NZ];
+static double g[NI+1][NZ];
+static double C[NI][NX*NZ];
+static double c[NI][NX];
+static double zLow[NI+1][NZ];
+static double zUpp[NI+1][NZ];
+
+
+/* integrator chain data with coupled state weights and state-input cross terms, stored stage by stage */
+static void setupChainData( )
+{
+	int i, k;
+
+	for ( k=0; k<NI+1; ++k ) {
+		setupChainHessian( H[k], ( k < NI ) ? NZ : NX, 1.0, 0.3, 0.05 );
+		for ( i=0; i<NZ; ++i ) {
+			g[k][i] = 0.0;
+		}
+		setupChainBounds( zLow[k], zUpp[k], 0.3 );
+	}
+	for ( k=0; k<NI; ++k ) {
+		setupChainDynamics( C[k], c[k] );
+	}
+}
+
+
+/* initial state and a tracking term on one stage */
+static void changeChainData(	int step )
+{
+	int i;
+
+	for ( i=0; i<NX; ++i ) {
+		zLow[0][i] = 0.5 * sin( 1.0 + i + step );
+		zUpp[0][i] = zLow[0][i];
+		g[step%NI+1][i] = -0.2 * step;
+	}
+}
+
+
+static return_t setupQp(	qpData_t* const qpData,
+							boolean_t useBoxQpSolver )
+{
+	int k;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.maxIter    = 100;
+	qpOptions.printLevel = 0;
+	qpOptions.logLevel   = QPDUNES_LOG_OFF;
+	qpOptions.useBoxQpSolver = useBoxQpSolver;
+	qpOptions.lsType     = QPDUNES_LS_HOMOTOPY_GRID_SEARCH;	/* line search along the logged stage homotopies */
+
+	if ( qpDUNES_setup( qpData, NI, NX, NU, 0, &qpOptions ) != QPDUNES_OK ) {
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+	for ( k=0; k<NI; ++k ) {
+		qpDUNES_setupRegularInterval( qpData, qpData->intervals[k], H[k],0,0,0, g[k], C[k],0,0, c[k], zLow[k],zUpp[k], 0,0,0,0, 0,0,0 );
+	}
+	qpDUNES_setupFinalInterval( qpData, qpData->intervals[NI], H[NI], g[NI], zLow[NI],zUpp[NI], 0,0,0 );
+
+	return qpDUNES_setupAllLocalQPs( qpData, QPDUNES_FALSE );
+}
+
+
+int main( )
+{
+	int ii, step;
+
+	return_t statusFlagBoxQp;
+	return_t statusFlagQpoases;
+
+	qpData_t qpDataBoxQp;
+	qpData_t qpDataQpoases;
+
+	double zBoxQp[NI*NZ+NX];
+	double zQpoases[NI*NZ+NX];
+	stageMemoryReport_t memBoxQp[NI+1];
+	stageMemoryReport_t memQpoases[NI+1];
+
+	double maxDiff = 0.0;
+	double objDiff = 0.0;
+
+
+	/** set up both QPs */
+	setupChainData( );
+	changeChainData( 0 );
+	if ( ( setupQp( &qpDataBoxQp, QPDUNES_TRUE ) != QPDUNES_OK ) ||
+		 ( setupQp( &qpDataQpoases, QPDUNES_FALSE ) != QPDUNES_OK ) )
+	{
+		printf( "Setup failed.\n" );
+		return 1;
+	}
+	if ( qpDataBoxQp.intervals[1]->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_BOXQP ) {
+		printf( "Box QP solver not selected.\n" );
+		return 1;
+	}
+
+	/** stage QP solver memory is only allocated for the solver in use */
+	qpDUNES_getMemoryReport( &qpDataBoxQp, memBoxQp );
+	qpDUNES_getMemoryReport( &qpDataQpoases, memQpoases );
+	for ( ii=0; ii<NI+1; ++ii ) {
+		if ( ( qpDataBoxQp.intervals[ii]->qpSolverQpoases.qpoasesObject != 0 ) ||
+			 ( qpDataQpoases.intervals[ii]->qpSolverBoxQp.cholHFree.data != 0 ) ||
+			 ( memBoxQp[ii].solverBytes == 0 ) || ( memQpoases[ii].solverBytes == 0 ) )
+		{
+			printf( "Stage %d: unexpected stage QP solver memory.\n", ii );
+			return 1;
+		}
+	}
+	qpDUNES_printMemoryReport( &qpDataQpoases );
+
+	/* equal stage Hessians share one factor (all but the terminal stage) */
+	if ( qpDataBoxQp.factorCache.nFactorizations != 2 ) {
+		printf( "%d stage Hessian factorizations, expected 2.\n", (int)qpDataBoxQp.factorCache.nFactorizations );
+		return 1;
+	}
+
+
+	/** MPC loop */
+	for ( step=0; step<NSTEPS; ++step ) {
+		if ( step > 0 ) {
+			changeChainData( step );
+			qpDUNES_updateIntervalData( &qpDataBoxQp, qpDataBoxQp.intervals[0], 0,0,0,0, zLow[0],zUpp[0], 0,0,0, 0 );
+			qpDUNES_updateIntervalData( &qpDataBoxQp, qpDataBoxQp.intervals[step%NI+1], 0,g[step%NI+1],0,0, 0,0, 0,0,0, 0 );
+			qpDUNES_updateIntervalData( &qpDataQpoases, qpDataQpoases.intervals[0], 0,0,0,0, zLow[0],zUpp[0], 0,0,0, 0 );
+			qpDUNES_updateIntervalData( &qpDataQpoases, qpDataQpoases.intervals[step%NI+1], 0,g[step%NI+1],0,0, 0,0, 0,0,0, 0 );
+		}
+
+		statusFlagBoxQp = qpDUNES_solve( &qpDataBoxQp );
+		statusFlagQpoases = qpDUNES_solve( &qpDataQpoases );
+		if ( ( statusFlagBoxQp != QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) ||
+			 ( statusFlagQpoases != QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) )
+		{
+			printf( "Step %d: solve failed (box QP: %d, qpOASES: %d).\n", step, (int)statusFlagBoxQp, (int)statusFlagQpoases );
+			return 1;
+		}
+
+		qpDUNES_getPrimalSol( &qpDataBoxQp, zBoxQp );
+		qpDUNES_getPrimalSol( &qpDataQpoases, zQpoases );
+		for ( ii=0; ii<NI*NZ+NX; ++ii ) {
+			maxDiff = ( fabs( zBoxQp[ii] - zQpoases[ii] ) > maxDiff ) ? fabs( zBoxQp[ii] - zQpoases[ii] ) : maxDiff;
+		}
+		objDiff = fabs( qpDUNES_computeObjectiveValue( &qpDataBoxQp ) - qpDUNES_computeObjectiveValue( &qpDataQpoases ) );
+		printf( "Step %d: box QP %d iterations, qpOASES %d iterations, max |z_boxQp - z_qpOASES|: %.2e, objective difference: %.2e\n",
+				step, (int)qpDataBoxQp.log.numIter, (int)qpDataQpoases.log.numIter, maxDiff, objDiff );
+		if ( ( maxDiff > 1.0e-6 ) || ( objDiff > 1.0e-6 ) ) {
+			return 1;
+		}
+	}
+
+	qpDUNES_cleanup( &qpDataBoxQp );
+	qpDUNES_cleanup( &qpDataQpoases );
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
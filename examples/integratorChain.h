@@ -0,0 +1,159 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file examples/integratorChain.h
+ *	\version 1.0beta
+ *
+ *	LTI integrator chain MPC problem shared by the examples that compare
+ *	two qpDUNES setups on the same data: NX chained integrators, the last
+ *	NU driven by the inputs, with bounded states and inputs and the initial
+ *	state fixed by the bounds of stage 0.
+ */
+
+
+#ifndef QP42_INTEGRATOR_CHAIN_H
+#define QP42_INTEGRATOR_CHAIN_H
+
+
+#include <qpDUNES.h>
+#include <math.h>
+
+#define NI		20
+#define NX		4
+#define NU		2
+#define NZ		(NX+NU)
+
+
+/* stage Hessian of dimension nV (NZ, or NX on the terminal stage); states are weighted by
+ * stateWeight, inputs by 0.1, neighbouring states by stateCoupling, and states and inputs by crossWeight */
+static inline void setupChainHessian(	double* const H,
+										int nV,
+										double stateWeight,
+										double stateCoupling,
+										double crossWeight )
+{
+	int i, j;
+
+	for ( i=0; i<nV; ++i ) {
+		for ( j=0; j<nV; ++j ) {
+			if ( i == j ) {
+				H[i*nV+j] = ( i < NX ) ? stateWeight : 0.1;
+			}
+			else if ( ( i < NX ) && ( j < NX ) ) {
+				H[i*nV+j] = ( abs( i-j ) == 1 ) ? stateCoupling : 0.0;
+			}
+			else if ( ( i < NX ) != ( j < NX ) ) {
+				H[i*nV+j] = crossWeight;
+			}
+			else {
+				H[i*nV+j] = 0.0;
+			}
+		}
+	}
+}
+
+
+/* dynamics x_{k+1} = C z_k + c */
+static inline void setupChainDynamics(	double* const C,
+										double* const c )
+{
+	int i, j;
+	double dt = 0.1;
+
+	for ( i=0; i<NX; ++i ) {
+		for ( j=0; j<NX; ++j ) {
+			C[i*NZ+j] = ( i == j ) ? 1.0 : ( ( j == i+1 ) ? dt : 0.0 );
+		}
+		for ( j=0; j<NU; ++j ) {
+			C[i*NZ+NX+j] = ( i == NX-NU+j ) ? dt : 0.0;
+		}
+		c[i] = 0.0;
+	}
+}
+
+
+/* states bounded by +-2, inputs by +-uMax */
+static inline void setupChainBounds(	double* const zLow,
+										double* const zUpp,
+										double uMax )
+{
+	int i;
+
+	for ( i=0; i<NZ; ++i ) {
+		zLow[i] = ( i < NX ) ? -2.0 : -uMax;
+		zUpp[i] = ( i < NX ) ?  2.0 :  uMax;
+	}
+}
+
+
+/* bounds of stage 0, fixing the initial state to x0Scale * sin( phase + i ) */
+static inline void setupChainInitialState(	double* const z0Low,
+											double* const z0Upp,
+											const double* const zLow,
+											const double* const zUpp,
+											double x0Scale,
+											double phase )
+{
+	int i;
+
+	for ( i=0; i<NZ; ++i ) {
+		z0Low[i] = ( i < NX ) ? x0Scale * sin( phase + i ) : zLow[i];
+		z0Upp[i] = ( i < NX ) ? z0Low[i] : zUpp[i];
+	}
+}
+
+
+/* QP with the same stage data on all stages but the first (initial state) and the last */
+static inline return_t setupChainQp(	qpData_t* const qpData,
+										const double* const H,
+										const double* const HTerminal,
+										const double* const z0Low,
+										const double* const z0Upp,
+										const double* const zLow,
+										const double* const zUpp )
+{
+	int k;
+	double C[NX*NZ];
+	double c[NX];
+
+	setupChainDynamics( C, c );
+
+	qpDUNES_setupRegularInterval( qpData, qpData->intervals[0], H,0,0,0, 0, C,0,0, c, z0Low,z0Upp, 0,0,0,0, 0,0,0 );
+	for ( k=1; k<NI; ++k ) {
+		qpDUNES_setupRegularInterval( qpData, qpData->intervals[k], H,0,0,0, 0, C,0,0, c, zLow,zUpp, 0,0,0,0, 0,0,0 );
+	}
+	qpDUNES_setupFinalInterval( qpData, qpData->intervals[NI], HTerminal, 0, zLow,zUpp, 0,0,0 );
+
+	return qpDUNES_setupAllLocalQPs( qpData, QPDUNES_FALSE );
+}
+
+
+#endif	/* QP42_INTEGRATOR_CHAIN_H */
+
+
+/*
+ *	end of file
+ */
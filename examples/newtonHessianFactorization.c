@@ -0,0 +1,222 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file examples/newtonHessianFactorization.c
+ *	\version 1.0beta
+ *
+ *	Double integrator QP of examples/doubleIntegrator_qp.c, solved with each
+ *	Newton Hessian factorization and compared against the forward band
+ *	factorization, for singular directions and Levenberg-Marquardt
+ *	regularization. Singular directions regularization falls back to the
+ *	reverse band factorization for the cyclic reduction and the twisted
+ *	factorization.
+ */
+
+
+#include <qpDUNES.h>
+#include <math.h>
+
+#define NI		200
+#define NX		2
+#define NU		1
+#define NZ		(NX+NU)
+
+/* the state weights of 1e-8 make the primal solution sensitive to the dual stationarity tolerance */
+#define SOL_TOL	1.0e-4
+
+
+static double H[NI*NZ*NZ+NX*NX];
+static double C[NI*NX*NZ];
+static double c[NI*NX];
+static double zLow[NI*NZ+NX];
+static double zUpp[NI*NZ+NX];
+
+
+/* stacked QP data of the double integrator with arrival constraints */
+static void setupData( )
+{
+	int i, j, k;
+	double dt = 0.01;
+	double x0[NX] = { -1.0, 0.0 };
+	double Hi[NZ*NZ] = { 1.0e-8, 0.0, 0.0,
+						 0.0, 1.0e-8, 0.0,
+						 0.0, 0.0, 1.0e0 };
+	double Ci[NX*NZ] = { 1.0, dt, 0.0,
+						 0.0, 1.0, dt };
+	double ziLow[NZ] = { -1.9, -3.0, -30.0 };
+	double ziUpp[NZ] = {  1.9,  3.0,  30.0 };
+
+	for ( k=0; k<NI; ++k ) {
+		for ( i=0; i<NZ*NZ; ++i ) {
+			H[k*NZ*NZ+i] = Hi[i];
+		}
+		for ( i=0; i<NX*NZ; ++i ) {
+			C[k*NX*NZ+i] = Ci[i];
+		}
+		for ( i=0; i<NX; ++i ) {
+			c[k*NX+i] = 0.0;
+		}
+		for ( i=0; i<NZ; ++i ) {
+			zLow[k*NZ+i] = ziLow[i];
+			zUpp[k*NZ+i] = ziUpp[i];
+		}
+	}
+	for ( i=0; i<NX; ++i ) {
+		for ( j=0; j<NX; ++j ) {
+			H[NI*NZ*NZ+i*NX+j] = Hi[i*NZ+j];
+		}
+		zLow[NI*NZ+i] = ziLow[i];
+		zUpp[NI*NZ+i] = ziUpp[i];
+	}
+
+	/* arrival constraints */
+	for ( k=45; k<47; ++k ) {
+		zLow[k*NZ+0] = 0.0;
+		zUpp[k*NZ+0] = 0.0;
+	}
+
+	/* initial value constraints */
+	for ( i=0; i<NX; ++i ) {
+		zLow[i] = x0[i];
+		zUpp[i] = x0[i];
+	}
+}
+
+
+/* solves the QP with the given factorization; returns the algorithm actually used, or -1 on failure */
+static int solveQp(	double* const z,
+					nwtnHssnFacAlg_t nwtnHssnFacAlg,
+					nwtnHssnRegType_t regType )
+{
+	int nwtnHssnFacAlgUsed;
+	return_t statusFlag;
+
+	qpData_t qpData;
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.maxIter    = 100;
+	qpOptions.printLevel = 0;
+	qpOptions.logLevel   = QPDUNES_LOG_OFF;
+	qpOptions.stationarityTolerance = 1.e-6;
+	qpOptions.equalityTolerance     = 2.221e-16;
+	qpOptions.regParam              = 1.e-8;
+	qpOptions.newtonHessDiagRegTolerance = 1.e-11;
+	qpOptions.lsType                = QPDUNES_LS_ACCELERATED_GRADIENT_BISECTION_LS;
+	qpOptions.lineSearchNbrGridPoints         = 5000;
+	qpOptions.lineSearchStationarityTolerance = 1.e-3;
+	qpOptions.lineSearchReductionFactor       = 0.1;
+	qpOptions.lineSearchMaxStepSize           = 1.;
+	qpOptions.maxNumLineSearchIterations           = 25;
+	qpOptions.maxNumLineSearchRefinementIterations = 60;
+	qpOptions.regType        = regType;
+	qpOptions.nwtnHssnFacAlg = nwtnHssnFacAlg;
+
+	if ( qpDUNES_setup( &qpData, NI, NX, NU, 0, &qpOptions ) != QPDUNES_OK ) {
+		return -1;
+	}
+	nwtnHssnFacAlgUsed = (int)qpData.options.nwtnHssnFacAlg;
+
+	statusFlag = qpDUNES_init( &qpData, H, 0, C, c, zLow,zUpp, 0,0,0 );
+	if ( statusFlag == QPDUNES_OK ) {
+		statusFlag = qpDUNES_solve( &qpData );
+	}
+	qpDUNES_getPrimalSol( &qpData, z );
+	qpDUNES_cleanup( &qpData );
+
+	return ( statusFlag == QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) ? nwtnHssnFacAlgUsed : -1;
+}
+
+
+/* compares all factorizations against the forward band factorization; returns 0 if solutions agree */
+static int compareFactorizations(	nwtnHssnRegType_t regType )
+{
+	int ii, jj;
+	int nwtnHssnFacAlgUsed;
+
+	nwtnHssnFacAlg_t nwtnHssnFacAlgs[] = { QPDUNES_NH_FAC_BAND_REVERSE,
+										   QPDUNES_NH_FAC_CYCLIC_REDUCTION,
+										   QPDUNES_NH_FAC_TWISTED };
+	int nFacAlgs = sizeof( nwtnHssnFacAlgs ) / sizeof( nwtnHssnFacAlg_t );
+
+	double zRef[NI*NZ+NX];
+	double z[NI*NZ+NX];
+	double maxDiff;
+
+	if ( solveQp( zRef, QPDUNES_NH_FAC_BAND_FORWARD, regType ) < 0 ) {
+		printf( "Solve with forward band factorization failed.\n" );
+		return 1;
+	}
+
+	for ( jj=0; jj<nFacAlgs; ++jj ) {
+		nwtnHssnFacAlgUsed = solveQp( z, nwtnHssnFacAlgs[jj], regType );
+		if ( nwtnHssnFacAlgUsed < 0 ) {
+			printf( "Solve with factorization %d failed.\n", (int)nwtnHssnFacAlgs[jj] );
+			return 1;
+		}
+
+		maxDiff = 0.0;
+		for ( ii=0; ii<NI*NZ+NX; ++ii ) {
+			maxDiff = ( fabs( z[ii] - zRef[ii] ) > maxDiff ) ? fabs( z[ii] - zRef[ii] ) : maxDiff;
+		}
+		printf( "Factorization %d (used %d): max |z - z_ref|: %.2e\n", (int)nwtnHssnFacAlgs[jj], nwtnHssnFacAlgUsed, maxDiff );
+		if ( maxDiff > SOL_TOL ) {
+			return 1;
+		}
+
+		/* cyclic reduction and twisted factorization cannot regularize singular directions consistently with the band factorization */
+		if ( ( regType == QPDUNES_REG_SINGULAR_DIRECTIONS ) &&
+			 ( nwtnHssnFacAlgs[jj] != QPDUNES_NH_FAC_BAND_REVERSE ) &&
+			 ( nwtnHssnFacAlgUsed != QPDUNES_NH_FAC_BAND_REVERSE ) )
+		{
+			printf( "Expected fall back to reverse band factorization.\n" );
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+
+int main( )
+{
+	setupData( );
+
+	printf( "Singular directions regularization:\n" );
+	if ( compareFactorizations( QPDUNES_REG_SINGULAR_DIRECTIONS ) != 0 ) {
+		return 1;
+	}
+
+	printf( "Levenberg-Marquardt regularization:\n" );
+	if ( compareFactorizations( QPDUNES_REG_LEVENBERG_MARQUARDT ) != 0 ) {
+		return 1;
+	}
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
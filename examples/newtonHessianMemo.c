@@ -0,0 +1,199 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file examples/newtonHessianMemo.c
+ *	\version 1.0beta
+ *
+ *	LTI integrator chain MPC problem with saturating inputs, solved with and
+ *	without the memo of stage contributions to the Newton Hessian, for a
+ *	diagonal (clipping stages) and a dense stage Hessian (box QP stages).
+ *	The initial state cycles through a few values, such that active sets
+ *	recur. Solutions and iteration counts have to agree exactly, and the
+ *	memo hits and misses logged per iteration have to add up to the totals.
+ */
+
+
+#include <qpDUNES.h>
+#include <math.h>
+
+#include "integratorChain.h"
+
+#define NSTEPS	12
+#define NMEMO	16
+
+
+static double H[NZ*NZ];
+static double HTerminal[NX*NX];
+static double zLow[NZ];
+static double zUpp[NZ];
+static double z0Low[NZ];
+static double z0Upp[NZ];
+
+
+/* stage data of the chain; the initial state cycles through three values */
+static void setupMemoData(	boolean_t isDenseHessian,
+							int step )
+{
+	setupChainHessian( H, NZ, 1.0, ( isDenseHessian == QPDUNES_TRUE ) ? 0.3 : 0.0, 0.0 );
+	setupChainHessian( HTerminal, NX, 10.0, 0.0, 0.0 );
+	setupChainBounds( zLow, zUpp, 0.3 );
+	setupChainInitialState( z0Low, z0Upp, zLow, zUpp, 0.5, 1.0 + step%3 );
+}
+
+
+static return_t setupQp(	qpData_t* const qpData,
+							boolean_t isDenseHessian,
+							int_t nwtnHssnMemoSize )
+{
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.maxIter    = 100;
+	qpOptions.printLevel = 0;
+	qpOptions.logLevel   = QPDUNES_LOG_ITERATIONS;
+	qpOptions.useBoxQpSolver = isDenseHessian;
+	qpOptions.nwtnHssnMaxRankUpdates = 0;		/* rebuild all blocks with changed active sets */
+	qpOptions.nwtnHssnMemoSize = nwtnHssnMemoSize;
+
+	if ( qpDUNES_setup( qpData, NI, NX, NU, 0, &qpOptions ) != QPDUNES_OK ) {
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	return setupChainQp( qpData, H, HTerminal, z0Low, z0Upp, zLow, zUpp );
+}
+
+
+/* MPC loop with and without memo; returns 0 if solutions agree */
+static int runMpc(	boolean_t isDenseHessian )
+{
+	int ii, step;
+	int nLoggedHits, nLoggedMisses;
+	int nHits, nMisses;
+
+	return_t statusFlagMemo;
+	return_t statusFlagRef;
+
+	qpData_t qpDataMemo;
+	qpData_t qpDataRef;
+
+	double zMemo[NI*NZ+NX];
+	double zRef[NI*NZ+NX];
+
+	double maxDiff = 0.0;
+
+
+	/** set up both QPs */
+	setupMemoData( isDenseHessian, 0 );
+	if ( ( setupQp( &qpDataMemo, isDenseHessian, NMEMO ) != QPDUNES_OK ) ||
+		 ( setupQp( &qpDataRef, isDenseHessian, 0 ) != QPDUNES_OK ) )
+	{
+		printf( "Setup failed.\n" );
+		return 1;
+	}
+
+
+	/** MPC loop */
+	for ( step=0; step<NSTEPS; ++step ) {
+		if ( step > 0 ) {
+			setupMemoData( isDenseHessian, step );
+			qpDUNES_updateIntervalData( &qpDataMemo, qpDataMemo.intervals[0], 0,0,0,0, z0Low,z0Upp, 0,0,0, 0 );
+			qpDUNES_updateIntervalData( &qpDataRef, qpDataRef.intervals[0], 0,0,0,0, z0Low,z0Upp, 0,0,0, 0 );
+		}
+
+		nHits = qpDataMemo.newtonMemo.nHits;
+		nMisses = qpDataMemo.newtonMemo.nMisses;
+		statusFlagMemo = qpDUNES_solve( &qpDataMemo );
+		statusFlagRef = qpDUNES_solve( &qpDataRef );
+		if ( ( statusFlagMemo != QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) ||
+			 ( statusFlagRef != QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) )
+		{
+			printf( "Step %d: solve failed (memo: %d, reference: %d).\n", step, (int)statusFlagMemo, (int)statusFlagRef );
+			return 1;
+		}
+
+		/* hits and misses of all iterations add up to the totals */
+		nLoggedHits = 0;
+		nLoggedMisses = 0;
+		for ( ii=1; ii<=qpDataMemo.log.numIter; ++ii ) {
+			nLoggedHits += qpDataMemo.log.itLog[ii].nNewtonMemoHits;
+			nLoggedMisses += qpDataMemo.log.itLog[ii].nNewtonMemoMisses;
+		}
+		if ( ( nLoggedHits != qpDataMemo.newtonMemo.nHits - nHits ) ||
+			 ( nLoggedMisses != qpDataMemo.newtonMemo.nMisses - nMisses ) )
+		{
+			printf( "Step %d: logged memo hits/misses %d/%d, expected %d/%d.\n", step, nLoggedHits, nLoggedMisses,
+					(int)qpDataMemo.newtonMemo.nHits - nHits, (int)qpDataMemo.newtonMemo.nMisses - nMisses );
+			return 1;
+		}
+
+		qpDUNES_getPrimalSol( &qpDataMemo, zMemo );
+		qpDUNES_getPrimalSol( &qpDataRef, zRef );
+		for ( ii=0; ii<NI*NZ+NX; ++ii ) {
+			maxDiff = ( fabs( zMemo[ii] - zRef[ii] ) > maxDiff ) ? fabs( zMemo[ii] - zRef[ii] ) : maxDiff;
+		}
+		printf( "Step %2d: %2d iterations (reference %2d), memo hits %3d, misses %3d, max |z_memo - z_ref|: %.2e\n",
+				step, (int)qpDataMemo.log.numIter, (int)qpDataRef.log.numIter, nLoggedHits, nLoggedMisses, maxDiff );
+		/* the memo must not change the arithmetic */
+		if ( ( maxDiff != 0.0 ) || ( qpDataMemo.log.numIter != qpDataRef.log.numIter ) ) {
+			return 1;
+		}
+	}
+	qpDUNES_printMemoryReport( &qpDataMemo );
+
+	/* active sets recur, most stage contributions are found in the memo */
+	if ( ( qpDataMemo.newtonMemo.nHits <= qpDataMemo.newtonMemo.nMisses ) ||
+		 ( qpDataRef.newtonMemo.nHits != 0 ) || ( qpDataRef.newtonMemo.nMisses != 0 ) )
+	{
+		printf( "Unexpected memo hits/misses: %d/%d (reference: %d/%d).\n",
+				(int)qpDataMemo.newtonMemo.nHits, (int)qpDataMemo.newtonMemo.nMisses,
+				(int)qpDataRef.newtonMemo.nHits, (int)qpDataRef.newtonMemo.nMisses );
+		return 1;
+	}
+
+	qpDUNES_cleanup( &qpDataMemo );
+	qpDUNES_cleanup( &qpDataRef );
+
+	return 0;
+}
+
+
+int main( )
+{
+	printf( "Diagonal stage Hessians (clipping stage QP solver):\n" );
+	if ( runMpc( QPDUNES_FALSE ) != 0 ) {
+		return 1;
+	}
+
+	printf( "Dense stage Hessians (box QP stage QP solver):\n" );
+	if ( runMpc( QPDUNES_TRUE ) != 0 ) {
+		return 1;
+	}
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
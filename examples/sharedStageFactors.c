@@ -0,0 +1,199 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+
+/**
+ *	\file examples/sharedStageFactors.c
+ *	\version 1.0beta
+ *
+ *	Integrator chain MPC problem with equal Hessians on all but the terminal
+ *	stage, solved with and without sharing of the stage Hessian factors.
+ *	Only two factorizations are needed when sharing, the unconstrained Newton
+ *	Hessian has to be the same, and so do the solutions, also after the
+ *	Hessian of the stage holding the shared factor has been changed.
+ */
+
+
+#include <qpDUNES.h>
+#include <math.h>
+
+#include "integratorChain.h"
+
+#define NSTEPS	5
+
+
+static double H[NZ*NZ];
+static double HTerminal[NX*NX];
+
+
+/* chain QP with initial state 0.5 * sin( 1.0 + i ) and a heavier terminal weight */
+static return_t setupSharingQp(	qpData_t* const qpData,
+								boolean_t shareStageFactors )
+{
+	double zLow[NZ], zUpp[NZ], z0Low[NZ], z0Upp[NZ];
+
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.maxIter    = 100;
+	qpOptions.printLevel = 0;
+	qpOptions.logLevel   = QPDUNES_LOG_OFF;
+	qpOptions.nbrInitialGradientSteps = 2;		/* uses the unconstrained Newton Hessian */
+	qpOptions.shareStageFactors = shareStageFactors;
+
+	if ( qpDUNES_setup( qpData, NI, NX, NU, 0, &qpOptions ) != QPDUNES_OK ) {
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	setupChainHessian( H, NZ, 1.0, 0.0, 0.0 );
+	setupChainHessian( HTerminal, NX, 10.0, 0.0, 0.0 );
+	setupChainBounds( zLow, zUpp, 1.0 );
+	setupChainInitialState( z0Low, z0Upp, zLow, zUpp, 0.5, 1.0 );
+
+	if ( setupChainQp( qpData, H, HTerminal, z0Low, z0Upp, zLow, zUpp ) != QPDUNES_OK ) {
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	return qpDUNES_setupUnconstrainedNewtonSystem( qpData );
+}
+
+
+/* unconstrained Newton Hessians of both QPs have to be identical */
+static boolean_t isEqualUnconstrainedHessian(	const qpData_t* const qpData1,
+												const qpData_t* const qpData2 )
+{
+	int ii;
+
+	for ( ii=0; ii<(int)(NI*qpData1->nhLayout.blockRowStride); ++ii ) {
+		if ( qpData1->unconstrainedHessian.data[ii] != qpData2->unconstrainedHessian.data[ii] ) {
+			return QPDUNES_FALSE;
+		}
+	}
+	return QPDUNES_TRUE;
+}
+
+
+int main( )
+{
+	int ii, k, step;
+
+	return_t statusFlagShared;
+	return_t statusFlagOwn;
+
+	qpData_t qpDataShared;
+	qpData_t qpDataOwn;
+
+	double zShared[NI*NZ+NX];
+	double zOwn[NI*NZ+NX];
+	double z0Low[NZ], z0Upp[NZ];
+	double maxDiff = 0.0;
+
+
+	/** set up QP with and without sharing of stage Hessian factors */
+	if ( ( setupSharingQp( &qpDataShared, QPDUNES_TRUE ) != QPDUNES_OK ) ||
+		 ( setupSharingQp( &qpDataOwn, QPDUNES_FALSE ) != QPDUNES_OK ) )
+	{
+		printf( "Setup failed.\n" );
+		return 1;
+	}
+
+	/* one factor for stages 0 to NI-1 and one for the terminal stage */
+	printf( "Stage Hessian factorizations: %d shared, %d not shared; %d of %d unconstrained Newton blocks copied\n",
+			(int)qpDataShared.factorCache.nFactorizations, (int)qpDataOwn.factorCache.nFactorizations,
+			(int)qpDataShared.factorCache.nSharedNewtonBlocks, 2*NI-1 );
+	if ( ( qpDataShared.factorCache.nFactorizations != 2 ) || ( qpDataOwn.factorCache.nFactorizations != NI+1 ) ||
+		 ( qpDataShared.factorCache.nSharedNewtonBlocks != 2*NI-4 ) )
+	{
+		return 1;
+	}
+	for ( k=1; k<NI; ++k ) {
+		if ( qpDataShared.intervals[k]->cholH.data != qpDataShared.intervals[0]->cholH.data ) {
+			printf( "Stage %d does not share the Hessian factor of stage 0.\n", k );
+			return 1;
+		}
+	}
+	if ( isEqualUnconstrainedHessian( &qpDataShared, &qpDataOwn ) != QPDUNES_TRUE ) {
+		printf( "Unconstrained Newton Hessians differ.\n" );
+		return 1;
+	}
+
+
+	/** MPC loop */
+	for ( step=0; step<NSTEPS; ++step ) {
+		for ( ii=0; ii<NZ; ++ii ) {
+			z0Low[ii] = ( ii < NX ) ? ( 0.5 - 0.05*step ) * sin( 1.0 + ii ) : -1.0;
+			z0Upp[ii] = ( ii < NX ) ? z0Low[ii] : 1.0;
+		}
+		qpDUNES_updateIntervalData( &qpDataShared, qpDataShared.intervals[0], 0,0,0,0, z0Low,z0Upp, 0,0,0, 0 );
+		qpDUNES_updateIntervalData( &qpDataOwn, qpDataOwn.intervals[0], 0,0,0,0, z0Low,z0Upp, 0,0,0, 0 );
+
+		/* stage 0 holds the shared factor; another stage takes it over */
+		if ( step == 2 ) {
+			H[0] = 2.0;
+			qpDUNES_updateIntervalData( &qpDataShared, qpDataShared.intervals[0], H,0,0,0, 0,0, 0,0,0, 0 );
+			qpDUNES_updateIntervalData( &qpDataOwn, qpDataOwn.intervals[0], H,0,0,0, 0,0, 0,0,0, 0 );
+			if ( ( qpDataShared.intervals[0]->cholH.data == qpDataShared.intervals[1]->cholH.data ) ||
+				 ( qpDataShared.intervals[NI-1]->cholH.data != qpDataShared.intervals[1]->cholH.data ) )
+			{
+				printf( "Step %d: unexpected sharing of stage Hessian factors.\n", step );
+				return 1;
+			}
+			qpDUNES_setupUnconstrainedNewtonSystem( &qpDataShared );
+			qpDUNES_setupUnconstrainedNewtonSystem( &qpDataOwn );
+			if ( isEqualUnconstrainedHessian( &qpDataShared, &qpDataOwn ) != QPDUNES_TRUE ) {
+				printf( "Step %d: unconstrained Newton Hessians differ.\n", step );
+				return 1;
+			}
+		}
+
+		statusFlagShared = qpDUNES_solve( &qpDataShared );
+		statusFlagOwn = qpDUNES_solve( &qpDataOwn );
+		if ( statusFlagShared != statusFlagOwn ) {
+			printf( "Exit flags differ in step %d.\n", step );
+			return 1;
+		}
+
+		qpDUNES_getPrimalSol( &qpDataShared, zShared );
+		qpDUNES_getPrimalSol( &qpDataOwn, zOwn );
+		for ( ii=0; ii<NI*NZ+NX; ++ii ) {
+			maxDiff = ( fabs( zShared[ii] - zOwn[ii] ) > maxDiff ) ? fabs( zShared[ii] - zOwn[ii] ) : maxDiff;
+		}
+		printf( "Step %d: exit flag %d, %d iterations, max |z_shared - z_own|: %.2e\n", step, (int)statusFlagShared, (int)qpDataShared.log.numIter, maxDiff );
+	}
+
+	qpDUNES_printMemoryReport( &qpDataShared );
+
+	qpDUNES_cleanup( &qpDataShared );
+	qpDUNES_cleanup( &qpDataOwn );
+
+	if ( maxDiff > 1.0e-12 ) {
+		return 1;
+	}
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
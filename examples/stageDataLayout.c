@@ -0,0 +1,159 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file examples/stageDataLayout.c
+ *	\version 1.0beta
+ *
+ *	Integrator chain MPC problem solved over a few shifted horizons with
+ *	interval data stored stage by stage and field by field; both layouts
+ *	need to give the same solutions.
+ */
+
+
+#include <qpDUNES.h>
+#include <math.h>
+
+#include "integratorChain.h"
+
+#define NSTEPS	5
+
+
+/* chain QP with initial state x0Scale * sin( 1.0 + i ) */
+static return_t setupLayoutQp(	qpData_t* const qpData,
+								double x0Scale )
+{
+	double H[NZ*NZ];
+	double HTerminal[NX*NX];
+	double zLow[NZ], zUpp[NZ], z0Low[NZ], z0Upp[NZ];
+
+	setupChainHessian( H, NZ, 1.0, 0.0, 0.0 );
+	setupChainHessian( HTerminal, NX, 1.0, 0.0, 0.0 );
+	setupChainBounds( zLow, zUpp, 1.0 );
+	setupChainInitialState( z0Low, z0Upp, zLow, zUpp, x0Scale, 1.0 );
+
+	return setupChainQp( qpData, H, HTerminal, z0Low, z0Upp, zLow, zUpp );
+}
+
+
+/* fix the initial state on stage 0 and release the stage shifted to the end of the horizon */
+static return_t embedInitialValue(	qpData_t* const qpData,
+									double x0Scale )
+{
+	return_t statusFlag;
+
+	double z0Low[NZ], z0Upp[NZ];
+	double zLow[NZ], zUpp[NZ];
+
+	setupChainBounds( zLow, zUpp, 1.0 );
+	setupChainInitialState( z0Low, z0Upp, zLow, zUpp, x0Scale, 1.0 );
+
+	statusFlag = qpDUNES_updateIntervalData( qpData, qpData->intervals[0], 0,0,0,0, z0Low,z0Upp, 0,0,0, 0 );
+	if ( statusFlag != QPDUNES_OK ) {
+		return statusFlag;
+	}
+	return qpDUNES_updateIntervalData( qpData, qpData->intervals[NI-1], 0,0,0,0, zLow,zUpp, 0,0,0, 0 );
+}
+
+
+int main( )
+{
+	int ii, step;
+
+	return_t statusFlagByStage;
+	return_t statusFlagByField;
+
+	qpData_t qpDataByStage;
+	qpData_t qpDataByField;
+
+	double zByStage[NI*NZ+NX];
+	double zByField[NI*NZ+NX];
+	double maxDiff = 0.0;
+
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.maxIter    = 100;
+	qpOptions.printLevel = 0;
+	qpOptions.logLevel   = QPDUNES_LOG_OFF;
+
+
+	/** set up QP in both layouts */
+	qpOptions.stageDataLayout = QPDUNES_STAGE_LAYOUT_BY_STAGE;
+	if ( qpDUNES_setup( &qpDataByStage, NI, NX, NU, 0, &qpOptions ) != QPDUNES_OK ) {
+		printf( "qpDUNES setup failed.\n" );
+		return 1;
+	}
+	qpOptions.stageDataLayout = QPDUNES_STAGE_LAYOUT_BY_FIELD;
+	if ( qpDUNES_setup( &qpDataByField, NI, NX, NU, 0, &qpOptions ) != QPDUNES_OK ) {
+		printf( "qpDUNES setup failed.\n" );
+		return 1;
+	}
+
+
+	setupLayoutQp( &qpDataByStage, 0.5 );
+	setupLayoutQp( &qpDataByField, 0.5 );
+
+
+	/** MPC loop */
+	for ( step=0; step<NSTEPS; ++step ) {
+		if ( step > 0 ) {
+			embedInitialValue( &qpDataByStage, 0.5 - 0.05*step );
+			embedInitialValue( &qpDataByField, 0.5 - 0.05*step );
+		}
+
+		statusFlagByStage = qpDUNES_solve( &qpDataByStage );
+		statusFlagByField = qpDUNES_solve( &qpDataByField );
+		if ( statusFlagByStage != statusFlagByField ) {
+			printf( "Exit flags differ in step %d.\n", step );
+			return 1;
+		}
+
+		qpDUNES_getPrimalSol( &qpDataByStage, zByStage );
+		qpDUNES_getPrimalSol( &qpDataByField, zByField );
+		for ( ii=0; ii<NI*NZ+NX; ++ii ) {
+			maxDiff = ( fabs( zByStage[ii] - zByField[ii] ) > maxDiff ) ? fabs( zByStage[ii] - zByField[ii] ) : maxDiff;
+		}
+		printf( "Step %d: exit flag %d, max |z_byStage - z_byField|: %.2e\n", step, (int)statusFlagByStage, maxDiff );
+
+		/* shift for the next horizon; field-wise, the interval slots are reused as a ring buffer */
+		qpDUNES_shiftLambda( &qpDataByStage );
+		qpDUNES_shiftIntervals( &qpDataByStage );
+		qpDUNES_shiftLambda( &qpDataByField );
+		qpDUNES_shiftIntervals( &qpDataByField );
+	}
+
+	qpDUNES_cleanup( &qpDataByStage );
+	qpDUNES_cleanup( &qpDataByField );
+
+	if ( maxDiff > 1.0e-12 ) {
+		return 1;
+	}
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
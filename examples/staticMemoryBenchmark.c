@@ -0,0 +1,184 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file examples/staticMemoryBenchmark.c
+ *	\version 1.0beta
+ *
+ *	Solve time benchmark of dynamic vs. static memory version on an
+ *	integrator chain MPC problem. Build once against qpdunes and once
+ *	against qpdunes_static (with matching dimensions) to compare.
+ */
+
+
+
+#include <mpc/setup_mpc.h>
+#include <math.h>
+
+#if defined(__STATIC_MEMORY__)
+	#define BENCHMARK_NX _NX_
+	#define BENCHMARK_NU _NU_
+	#define BENCHMARK_NI _NI_
+#else
+	#ifndef BENCHMARK_NX
+		#define BENCHMARK_NX 3
+	#endif
+	#ifndef BENCHMARK_NU
+		#define BENCHMARK_NU 1
+	#endif
+	#ifndef BENCHMARK_NI
+		#define BENCHMARK_NI 10
+	#endif
+#endif
+
+#define NRUNS 1000
+
+
+int main( )
+{
+	unsigned int i, j, k;
+	int run;
+
+	return_t statusFlag;
+
+	const unsigned int nI = BENCHMARK_NI;	/* number of control intervals */
+	const unsigned int nX = BENCHMARK_NX;	/* number of states */
+	const unsigned int nU = BENCHMARK_NU;	/* number of controls */
+	unsigned int* nD = 0;	  				/* number of constraints */
+
+	double dt = 0.1;	/* discretization sampling time */
+
+	double Q[BENCHMARK_NX*BENCHMARK_NX];
+	double R[BENCHMARK_NU*BENCHMARK_NU];
+	double* P = Q;
+	double A[BENCHMARK_NX*BENCHMARK_NX];
+	double B[BENCHMARK_NX*BENCHMARK_NU];
+	double c[BENCHMARK_NX];
+
+	double xLow[BENCHMARK_NX*(BENCHMARK_NI+1)];
+	double xUpp[BENCHMARK_NX*(BENCHMARK_NI+1)];
+	double uLow[BENCHMARK_NU*BENCHMARK_NI];
+	double uUpp[BENCHMARK_NU*BENCHMARK_NI];
+
+	double x0[BENCHMARK_NX];
+
+	double t0, t1;
+	double tMean = 0.0;
+	double tMin = 1.0e12;
+
+
+	/** integrator chain, controls act on the last states */
+	for ( i=0; i<nX; ++i ) {
+		for ( j=0; j<nX; ++j ) {
+			Q[i*nX+j] = ( i == j ) ? 1.0 : 0.0;
+			A[i*nX+j] = ( i == j ) ? 1.0 : ( ( j == i+1 ) ? dt : 0.0 );
+		}
+		for ( j=0; j<nU; ++j ) {
+			B[i*nU+j] = ( i == nX-nU+j ) ? dt : 0.0;
+		}
+		c[i] = 0.0;
+	}
+	for ( i=0; i<nU; ++i ) {
+		for ( j=0; j<nU; ++j ) {
+			R[i*nU+j] = ( i == j ) ? 0.1 : 0.0;
+		}
+	}
+
+	/** build up bounds */
+	for ( k=0; k<nI+1; ++k ) {
+		for ( i=0; i<nX; ++i ) {
+			xLow[k*nX+i] = -2.0;
+			xUpp[k*nX+i] =  2.0;
+		}
+	}
+	for ( k=0; k<nI; ++k ) {
+		for ( i=0; i<nU; ++i ) {
+			uLow[k*nU+i] = -1.0;
+			uUpp[k*nU+i] =  1.0;
+		}
+	}
+
+
+	mpcProblem_t mpcProblem;
+
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.maxIter    = 100;
+	qpOptions.printLevel = 0;
+	qpOptions.logLevel   = QPDUNES_LOG_OFF;
+
+	statusFlag = mpcDUNES_setup( &mpcProblem, nI, nX, nU, nD, &(qpOptions) );
+	if (statusFlag != QPDUNES_OK) {
+		printf( "mpcDUNES setup failed.\n" );
+		return (int)statusFlag;
+	}
+
+	statusFlag = mpcDUNES_initLtiSb_xu( &mpcProblem, Q, R, 0, P, A, B, c, xLow, xUpp, uLow, uUpp, 0, 0 );
+	if (statusFlag != QPDUNES_OK) {
+		printf( "mpcDUNES initialization failed.\n" );
+		return (int)statusFlag;
+	}
+
+
+	/** closed-loop-like sequence of initial values */
+	for ( run=0; run<NRUNS; ++run ) {
+		for ( i=0; i<nX; ++i ) {
+			x0[i] = 0.5 * sin( 0.01*run + i );
+		}
+
+		t0 = getTime();
+		statusFlag = mpcDUNES_solve( &mpcProblem, x0 );
+		t1 = getTime();
+
+		if (statusFlag != QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND) {
+			printf( "mpcDUNES solve failed in run %d (flag %d).\n", run, (int)statusFlag );
+			mpcDUNES_cleanup( &mpcProblem );
+			return (int)statusFlag;
+		}
+
+		tMean += ( t1 - t0 ) / NRUNS;
+		tMin = ( t1 - t0 < tMin ) ? t1 - t0 : tMin;
+	}
+
+
+	#if defined(__STATIC_MEMORY__)
+	printf( "Memory version:         static\n" );
+	#else
+	printf( "Memory version:         dynamic\n" );
+	#endif
+	printf( "Dimensions:             nX = %u, nU = %u, nI = %u\n", nX, nU, nI );
+	printf( "Mean solution time:     %.4lf ms (%d runs)\n", 1e3*tMean, NRUNS );
+	printf( "Min solution time:      %.4lf ms\n", 1e3*tMin );
+	#if defined(__STATIC_MEMORY__)
+	printf( "Static memory used:     %u of %u bytes\n", (unsigned int)qpDUNES_getStaticMemoryUsage(), (unsigned int)QPDUNES_STATIC_MEMORY_SIZE );
+	#endif
+
+	mpcDUNES_cleanup( &mpcProblem );
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,164 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file examples/userMemorySetup.c
+ *	\version 1.0beta
+ *
+ *	Integrator chain MPC problem set up in a memory block supplied by the
+ *	user, sized with qpDUNES_memoryRequirement, and compared against the
+ *	default setup, for a diagonal (clipping stages) and a dense stage Hessian
+ *	(box QP or qpOASES stages, whose solver memory is taken from the block as
+ *	well).
+ */
+
+
+#include <qpDUNES.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "integratorChain.h"
+
+
+/* chain QP with initial state x0Scale * sin( 1.0 + i ) */
+static return_t setupUserMemoryQp(	qpData_t* const qpData,
+									double x0Scale,
+									boolean_t isDenseHessian )
+{
+	double H[NZ*NZ];
+	double HTerminal[NX*NX];
+	double zLow[NZ], zUpp[NZ], z0Low[NZ], z0Upp[NZ];
+
+	setupChainHessian( H, NZ, 1.0, ( isDenseHessian == QPDUNES_TRUE ) ? 0.3 : 0.0, 0.0 );
+	setupChainHessian( HTerminal, NX, 1.0, ( isDenseHessian == QPDUNES_TRUE ) ? 0.3 : 0.0, 0.0 );
+	setupChainBounds( zLow, zUpp, 1.0 );
+	setupChainInitialState( z0Low, z0Upp, zLow, zUpp, x0Scale, 1.0 );
+
+	return setupChainQp( qpData, H, HTerminal, z0Low, z0Upp, zLow, zUpp );
+}
+
+
+/* solve in user memory and in memory allocated by qpDUNES; returns 0 if solutions agree */
+static int runComparison(	boolean_t isDenseHessian,
+							boolean_t useBoxQpSolver )
+{
+	int ii;
+
+	return_t statusFlag;
+
+	qpData_t qpDataUser;
+	qpData_t qpDataDefault;
+
+	uint_t memorySize;
+	boolean_t isMemoryUsed;
+	char* memory;
+	char* alignedMemory;
+
+	double zUser[NI*NZ+NX];
+	double zDefault[NI*NZ+NX];
+	double maxDiff = 0.0;
+
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.maxIter    = 100;
+	qpOptions.printLevel = 0;
+	qpOptions.logLevel   = QPDUNES_LOG_OFF;
+	qpOptions.useBoxQpSolver = useBoxQpSolver;
+
+
+	/** set up QP in user memory, aligned to a cache line */
+	memorySize = qpDUNES_memoryRequirement( NI, NX, NU, 0, &qpOptions );
+	memory = (char*)malloc( memorySize + QPDUNES_MEMORY_ALIGNMENT );
+	alignedMemory = memory + ( QPDUNES_MEMORY_ALIGNMENT - (uintptr_t)memory % QPDUNES_MEMORY_ALIGNMENT ) % QPDUNES_MEMORY_ALIGNMENT;
+
+	statusFlag = qpDUNES_setupInMemory( &qpDataUser, NI, NX, NU, 0, &qpOptions, alignedMemory, memorySize );
+	if (statusFlag != QPDUNES_OK) {
+		printf( "qpDUNES setup in user memory failed.\n" );
+		return (int)statusFlag;
+	}
+	printf( "Memory requirement: %d bytes, used: %d bytes.\n", (int)memorySize, (int)qpDataUser.arena.used );
+	if ( setupUserMemoryQp( &qpDataUser, 0.5, isDenseHessian ) != QPDUNES_OK ) {
+		printf( "Setup of stage QPs in user memory failed.\n" );
+		return 1;
+	}
+	printf( "Memory used after setup of stage QPs: %d bytes.\n", (int)qpDataUser.arena.used );
+	statusFlag = qpDUNES_solve( &qpDataUser );
+
+
+	/** compare against default setup */
+	if ( qpDUNES_setup( &qpDataDefault, NI, NX, NU, 0, &qpOptions ) != QPDUNES_OK ) {
+		printf( "qpDUNES setup failed.\n" );
+		return 1;
+	}
+	setupUserMemoryQp( &qpDataDefault, 0.5, isDenseHessian );
+	if ( qpDUNES_solve( &qpDataDefault ) != statusFlag ) {
+		printf( "Exit flags differ.\n" );
+		return 1;
+	}
+	qpDUNES_getPrimalSol( &qpDataUser, zUser );
+	qpDUNES_getPrimalSol( &qpDataDefault, zDefault );
+	for ( ii=0; ii<NI*NZ+NX; ++ii ) {
+		maxDiff = ( fabs( zUser[ii] - zDefault[ii] ) > maxDiff ) ? fabs( zUser[ii] - zDefault[ii] ) : maxDiff;
+	}
+	printf( "Exit flag: %d, max |z_user - z_default|: %.2e\n", (int)statusFlag, maxDiff );
+
+	/* the stage QP solver memory is sized for the worst case */
+	isMemoryUsed = ( qpDataUser.arena.used <= memorySize ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+
+	qpDUNES_cleanup( &qpDataDefault );
+	qpDUNES_cleanup( &qpDataUser );
+	free( memory );		/* not before qpDUNES_cleanup */
+
+	if ( ( isMemoryUsed != QPDUNES_TRUE ) || ( maxDiff > 1.0e-12 ) ) {
+		return 1;
+	}
+
+	return 0;
+}
+
+
+int main( )
+{
+	printf( "Diagonal stage Hessians (clipping stage QP solver):\n" );
+	if ( runComparison( QPDUNES_FALSE, QPDUNES_TRUE ) != 0 ) {
+		return 1;
+	}
+
+	printf( "Dense stage Hessians (box QP stage QP solver):\n" );
+	if ( runComparison( QPDUNES_TRUE, QPDUNES_TRUE ) != 0 ) {
+		return 1;
+	}
+
+	printf( "Dense stage Hessians (qpOASES stage QP solver):\n" );
+	if ( runComparison( QPDUNES_TRUE, QPDUNES_FALSE ) != 0 ) {
+		return 1;
+	}
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,213 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file examples/zeroCopyUpdate.c
+ *	\version 1.0beta
+ *
+ *	Integrator chain MPC problem whose stage data lives in user arrays that
+ *	are registered with qpDUNES once; in the MPC loop the arrays are changed
+ *	in place and only the changed stages and fields are indicated. The
+ *	solutions are compared against the copying data update.
+ */
+
+
+#include <qpDUNES.h>
+#include <math.h>
+
+#include "integratorChain.h"
+
+#define NSTEPS	5
+
+
+/* user-owned stage data; Hessians are diagonal and stored as diagonals */
+static double Hdiag[NI+1][NZ];
+static double g[NI+1][NZ];
+static double C[NI][NX*NZ];
+static double c[NI][NX];
+static double zLow[NI+1][NZ];
+static double zUpp[NI+1][NZ];
+
+
+/* integrator chain data, stored stage by stage */
+static void setupChainData( )
+{
+	int i, k;
+
+	for ( k=0; k<NI+1; ++k ) {
+		for ( i=0; i<NZ; ++i ) {
+			Hdiag[k][i] = ( i < NX ) ? 1.0 : 0.1;
+			g[k][i] = 0.0;
+		}
+		setupChainBounds( zLow[k], zUpp[k], 1.0 );
+	}
+	for ( k=0; k<NI; ++k ) {
+		setupChainDynamics( C[k], c[k] );
+	}
+}
+
+
+/* initial state and a tracking term on a few stages, changed in place */
+static void changeChainData(	int step )
+{
+	int i;
+
+	for ( i=0; i<NX; ++i ) {
+		zLow[0][i] = 0.5 * sin( 1.0 + i + step );
+		zUpp[0][i] = zLow[0][i];
+		g[step%NI+1][i] = -0.2 * step;
+	}
+}
+
+
+/* copying data setup of the reference QP */
+static return_t setupCopiedQp(	qpData_t* const qpData )
+{
+	int i, k;
+	double H[NZ*NZ];
+
+	for ( k=0; k<NI+1; ++k ) {
+		for ( i=0; i<NZ*NZ; ++i ) {
+			H[i] = 0.0;
+		}
+		if ( k < NI ) {
+			for ( i=0; i<NZ; ++i ) {
+				H[i*NZ+i] = Hdiag[k][i];
+			}
+			qpDUNES_setupRegularInterval( qpData, qpData->intervals[k], H,0,0,0, g[k], C[k],0,0, c[k], zLow[k],zUpp[k], 0,0,0,0, 0,0,0 );
+		}
+		else {
+			for ( i=0; i<NX; ++i ) {
+				H[i*NX+i] = Hdiag[k][i];
+			}
+			qpDUNES_setupFinalInterval( qpData, qpData->intervals[k], H, g[k], zLow[k],zUpp[k], 0,0,0 );
+		}
+	}
+
+	return qpDUNES_setupAllLocalQPs( qpData, QPDUNES_FALSE );
+}
+
+
+/* zero-copy data setup */
+static return_t setupRegisteredQp(	qpData_t* const qpData )
+{
+	int k;
+	return_t statusFlag;
+
+	for ( k=0; k<NI; ++k ) {
+		statusFlag = qpDUNES_registerIntervalData( qpData, qpData->intervals[k], Hdiag[k], QPDUNES_DIAGONAL, g[k], C[k], c[k], zLow[k], zUpp[k], 0,0,0 );
+		if ( statusFlag != QPDUNES_OK ) {
+			return statusFlag;
+		}
+	}
+	statusFlag = qpDUNES_registerIntervalData( qpData, qpData->intervals[NI], Hdiag[NI], QPDUNES_DIAGONAL, g[NI], 0,0, zLow[NI], zUpp[NI], 0,0,0 );
+	if ( statusFlag != QPDUNES_OK ) {
+		return statusFlag;
+	}
+
+	return qpDUNES_setupAllLocalQPs( qpData, QPDUNES_FALSE );
+}
+
+
+int main( )
+{
+	int ii, step;
+
+	return_t statusFlagCopied;
+	return_t statusFlagRegistered;
+
+	qpData_t qpDataCopied;
+	qpData_t qpDataRegistered;
+
+	double zCopied[NI*NZ+NX];
+	double zRegistered[NI*NZ+NX];
+	double maxDiff = 0.0;
+
+	qpOptions_t qpOptions = qpDUNES_setupDefaultOptions();
+	qpOptions.maxIter    = 100;
+	qpOptions.printLevel = 0;
+	qpOptions.logLevel   = QPDUNES_LOG_OFF;
+
+
+	/** set up both QPs */
+	setupChainData( );
+	changeChainData( 0 );
+	if ( ( qpDUNES_setup( &qpDataCopied, NI, NX, NU, 0, &qpOptions ) != QPDUNES_OK ) ||
+		 ( qpDUNES_setup( &qpDataRegistered, NI, NX, NU, 0, &qpOptions ) != QPDUNES_OK ) )
+	{
+		printf( "qpDUNES setup failed.\n" );
+		return 1;
+	}
+	if ( ( setupCopiedQp( &qpDataCopied ) != QPDUNES_OK ) ||
+		 ( setupRegisteredQp( &qpDataRegistered ) != QPDUNES_OK ) )
+	{
+		printf( "Data setup failed.\n" );
+		return 1;
+	}
+
+
+	/** MPC loop */
+	for ( step=0; step<NSTEPS; ++step ) {
+		if ( step > 0 ) {
+			changeChainData( step );
+
+			/* copying update */
+			qpDUNES_updateIntervalData( &qpDataCopied, qpDataCopied.intervals[0], 0,0,0,0, zLow[0],zUpp[0], 0,0,0, 0 );
+			qpDUNES_updateIntervalData( &qpDataCopied, qpDataCopied.intervals[step%NI+1], 0,g[step%NI+1],0,0, 0,0, 0,0,0, 0 );
+
+			/* zero-copy update */
+			qpDUNES_indicateDataChange( &qpDataRegistered, qpDataRegistered.intervals[0], QPDUNES_DATA_ZLOW | QPDUNES_DATA_ZUPP );
+			qpDUNES_indicateDataChange( &qpDataRegistered, qpDataRegistered.intervals[step%NI+1], QPDUNES_DATA_G );
+		}
+
+		statusFlagCopied = qpDUNES_solve( &qpDataCopied );
+		statusFlagRegistered = qpDUNES_solve( &qpDataRegistered );
+		if ( statusFlagCopied != statusFlagRegistered ) {
+			printf( "Exit flags differ in step %d.\n", step );
+			return 1;
+		}
+
+		qpDUNES_getPrimalSol( &qpDataCopied, zCopied );
+		qpDUNES_getPrimalSol( &qpDataRegistered, zRegistered );
+		for ( ii=0; ii<NI*NZ+NX; ++ii ) {
+			maxDiff = ( fabs( zCopied[ii] - zRegistered[ii] ) > maxDiff ) ? fabs( zCopied[ii] - zRegistered[ii] ) : maxDiff;
+		}
+		printf( "Step %d: exit flag %d, max |z_copied - z_registered|: %.2e\n", step, (int)statusFlagCopied, maxDiff );
+	}
+
+	qpDUNES_cleanup( &qpDataCopied );
+	qpDUNES_cleanup( &qpDataRegistered );	/* user arrays are not freed */
+
+	if ( maxDiff > 1.0e-12 ) {
+		return 1;
+	}
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
@@ -35,6 +35,7 @@
 #include <qpOASES/QProblem.hpp>
 #include <qpOASES/SQProblem.hpp>
 #include <qpOASES/LoggedSQProblem.hpp>
+#include <qpOASES/LoggedQProblemB.hpp>
 #include <qpOASES/extras/OQPinterface.hpp>
 #include <qpOASES/extras/SolutionAnalysis.hpp>
 
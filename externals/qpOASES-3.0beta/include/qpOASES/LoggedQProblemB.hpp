@@ -0,0 +1,208 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2012 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qpOASES/LoggedQProblemB.hpp
+ *	\version 3.0
+ *
+ *	Wrapper of QProblemB for additional qpDUNES functionality.
+ */
+
+
+
+#ifndef QPOASES_LOGGEDQPROBLEMB_HPP
+#define QPOASES_LOGGEDQPROBLEMB_HPP
+
+
+#include <qpOASES/QProblemB.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/**
+ *	\brief Wrapper of QProblemB for additional qpDUNES functionality.
+ *
+ *	Counterpart of LoggedSQProblem for stage QPs with simple bounds only.
+ *	The null space of the active bounds is spanned by unit vectors, so the
+ *	transposed null space basis is assembled on request from the index list
+ *	of free variables instead of being maintained by a QR factorization.
+ *
+ *	\version 3.0
+ */
+class LoggedQProblemB : public QProblemB
+{
+
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Constructor which takes the QP dimension and Hessian type
+		 *  information. If the Hessian is the zero (i.e. HST_ZERO) or the
+		 *  identity matrix (i.e. HST_IDENTITY), respectively, no memory
+		 *  is allocated for it and a NULL pointer can be passed for it
+		 *  to the init() functions. */
+		LoggedQProblemB(	int _nV,	  							/**< Number of variables. */
+							HessianType _hessianType = HST_UNKNOWN	/**< Type of Hessian matrix. */
+							);
+
+		/** Destructor. */
+		virtual ~LoggedQProblemB( );
+
+
+		using QProblemB::hotstart;
+
+		/** Solves QProblemB for a new Hessian matrix, starting from the
+		 *  current working set (QProblemB does not support matrix updates
+		 *  within the homotopy, so the QP is reinitialised).
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_MAX_NWSR_REACHED \n
+					RET_INIT_FAILED \n
+					RET_INIT_FAILED_CHOLESKY \n
+					RET_INIT_FAILED_HOTSTART \n
+					RET_INIT_FAILED_INFEASIBILITY \n
+					RET_INIT_FAILED_UNBOUNDEDNESS */
+		returnValue hotstart(	const real_t* const H_new,		/**< Hessian matrix of neighbouring QP to be solved (a shallow copy is made). */
+								const real_t* const g_new,		/**< Gradient of neighbouring QP to be solved. */
+								const real_t* const lb_new,		/**< Lower bounds of neighbouring QP to be solved. \n
+													 			 	 If no lower bounds exist, a NULL pointer can be passed. */
+								const real_t* const ub_new,		/**< Upper bounds of neighbouring QP to be solved. \n
+													 			 	 If no upper bounds exist, a NULL pointer can be passed. */
+								int& nWSR,						/**< Input: Maximum number of working set recalculations; \n
+															 		 Output: Number of performed working set recalculations. */
+								real_t* const cputime = 0		/**< Input: Maximum CPU time allowed for QP solution. \n
+																 	 Output: CPU time spend for QP solution (or to perform nWSR iterations). */
+								);
+
+		/** Solves QProblemB using online active set strategy and logs the
+		 *  piecewise quadratic objective along the homotopy.
+		 *	\return SUCCESSFUL_RETURN \n
+	 				RET_MAX_NWSR_REACHED \n
+	 				RET_HOTSTART_FAILED_AS_QP_NOT_INITIALISED \n
+					RET_HOTSTART_FAILED \n
+					RET_SHIFT_DETERMINATION_FAILED \n
+					RET_STEPDIRECTION_DETERMINATION_FAILED \n
+					RET_STEPLENGTH_DETERMINATION_FAILED \n
+					RET_HOMOTOPY_STEP_FAILED \n
+					RET_HOTSTART_STOPPED_INFEASIBILITY \n
+					RET_HOTSTART_STOPPED_UNBOUNDEDNESS */
+		returnValue hotstart_withHomotopyLogging(	const real_t* const g_new,		/**< Gradient of neighbouring QP to be solved. */
+								const real_t* const lb_new,		/**< Lower bounds of neighbouring QP to be solved. \n
+													 			 	 If no lower bounds exist, a NULL pointer can be passed. */
+								const real_t* const ub_new,		/**< Upper bounds of neighbouring QP to be solved. \n
+													 			 	 If no upper bounds exist, a NULL pointer can be passed. */
+								real_t* const parametricObjFctn_alpha,			/**< log for homotopy kinks (active set changes) */
+								real_t* const parametricObjFctn_f,				/**< log for objective value */
+								real_t* const parametricObjFctn_fPrime,			/**< log for objective derivative in homotopy direction */
+								real_t* const parametricObjFctn_fPrimePrime,	/**< log for objective second derivative in homotopy direction */
+								int& nWSR,						/**< Input: Maximum number of working set recalculations; \n
+															 		 Output: Number of performed working set recalculations. */
+								real_t* const cputime = 0		/**< Input: Maximum CPU time allowed for QP solution. \n
+																 	 Output: CPU time spend for QP solution (or to perform nWSR iterations). */
+								);
+
+
+		/** Returns the Cholesky factor R of the Hessian block of the free
+		 *  variables (i.e. R^T*R = Z^T*H*Z). */
+		void getR(	real_t** const ROut	/**< Output: Pointer to upper triangular Cholesky factor of projected Hessian (after QP has been solved). */
+					) const;
+
+		/** Returns the transposed projection matrix Z of the projected
+		 *  Hessian Z^T*H*Z, i.e. one unit row per free variable, in the
+		 *  order of the free variables in R. */
+		void getQT(	real_t** const QTOut,	/**< Output: pointer to transposed optimal Hessian projection matrix  (after QP has been solved). */
+					int* nZ					/**< Output: dimension of the null space. */
+					);
+
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+
+		/** Determines type of bounds (i.e. implicitly fixed, unbounded etc.)
+		 *  of the current QP data; called when the QP is (re-)initialised.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_SETUPSUBJECTTOTYPE_FAILED */
+		virtual returnValue setupSubjectToType( );
+
+		/** Keeps the type of bounds on a hotstart: tight bounds that are
+		 *  inactive would otherwise become inactive equalities and never get
+		 *  active again (same as in QProblem::solveQP).
+		 *	\return SUCCESSFUL_RETURN */
+		virtual returnValue setupSubjectToType(	const real_t* const lb_new,	/**< New lower bounds. */
+												const real_t* const ub_new	/**< New upper bounds. */
+												);
+
+
+		/** Solves QProblemB using online active set strategy.
+		 *  Note: This function is internally called by all hotstart functions!
+		 *	\return SUCCESSFUL_RETURN \n
+	 				RET_MAX_NWSR_REACHED \n
+	 				RET_HOTSTART_FAILED_AS_QP_NOT_INITIALISED \n
+					RET_HOTSTART_FAILED \n
+					RET_SHIFT_DETERMINATION_FAILED \n
+					RET_STEPDIRECTION_DETERMINATION_FAILED \n
+					RET_STEPLENGTH_DETERMINATION_FAILED \n
+					RET_HOMOTOPY_STEP_FAILED \n
+					RET_HOTSTART_STOPPED_INFEASIBILITY \n
+					RET_HOTSTART_STOPPED_UNBOUNDEDNESS */
+		returnValue solveQP_withHomotopyLogging(	const real_t* const g_new,		/**< Gradient of neighbouring QP to be solved. */
+								const real_t* const lb_new,		/**< Lower bounds of neighbouring QP to be solved. \n
+													 			 	 If no lower bounds exist, a NULL pointer can be passed. */
+								const real_t* const ub_new,		/**< Upper bounds of neighbouring QP to be solved. \n
+													 			 	 If no upper bounds exist, a NULL pointer can be passed. */
+								real_t* const parametricObjFctn_alpha,			/**< log for homotopy kinks (active set changes) */
+								real_t* const parametricObjFctn_f,				/**< log for objective value */
+								real_t* const parametricObjFctn_fPrime,			/**< log for objective derivative in homotopy direction */
+								real_t* const parametricObjFctn_fPrimePrime,	/**< log for objective second derivative in homotopy direction */
+								int& nWSR,						/**< Input: Maximum number of working set recalculations; \n
+															 		 Output: Number of performed working set recalculations. */
+								real_t* const cputime			/**< Input: Maximum CPU time allowed for QP solution. \n
+																 	 Output: CPU time spend for QP solution (or to perform nWSR iterations). */
+								);
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		real_t* QT;		/**< Transposed null space basis (nV x nV, row-major), filled by getQT(). */
+
+	private:
+		LoggedQProblemB( const LoggedQProblemB& rhs );				/**< Not copyable (owns QT). */
+		LoggedQProblemB& operator=( const LoggedQProblemB& rhs );	/**< Not assignable (owns QT). */
+};
+
+
+END_NAMESPACE_QPOASES
+
+
+#endif	/* QPOASES_LOGGEDQPROBLEMB_HPP */
+
+
+/*
+ *	end of file
+ */
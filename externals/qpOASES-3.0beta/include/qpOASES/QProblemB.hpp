@@ -48,6 +48,7 @@ BEGIN_NAMESPACE_QPOASES
 
 
 class SolutionAnalysis;
+class LoggedQProblemB;
 
 /** 
  *	\brief Implements the online active set strategy for box-constrained QPs.
@@ -64,6 +65,8 @@ class QProblemB
 {
 	/* allow SolutionAnalysis class to access private members */
 	friend class SolutionAnalysis;
+	/* allow LoggedQProblemB (qpDUNES homotopy logging) to run its own homotopy loop */
+	friend class LoggedQProblemB;
 
 	/*
 	 *	PUBLIC MEMBER FUNCTIONS
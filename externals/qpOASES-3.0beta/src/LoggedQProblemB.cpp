@@ -0,0 +1,479 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2012 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file src/LoggedQProblemB.cpp
+ *	\version 3.0
+ *
+ *	Implementation of the LoggedQProblemB class, which adds homotopy
+ *	logging and access to the factorization of the free Hessian block to
+ *	QProblemB for use as a qpDUNES stage QP solver.
+ */
+
+
+#include <qpOASES/LoggedQProblemB.hpp>
+#include <stdio.h>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	L o g g e d Q P r o b l e m B
+ */
+LoggedQProblemB::LoggedQProblemB( int _nV, HessianType _hessianType ) : QProblemB( _nV,_hessianType )
+{
+	int nV = getNV( );
+
+	QT = new real_t[nV*nV];
+	for( int i=0; i<nV*nV; ++i )
+		QT[i] = 0.0;
+}
+
+
+/*
+ *	~ L o g g e d Q P r o b l e m B
+ */
+LoggedQProblemB::~LoggedQProblemB( )
+{
+	delete[] QT;
+}
+
+
+/*
+ *	h o t s t a r t
+ *	(for a new Hessian matrix)
+ */
+returnValue LoggedQProblemB::hotstart(	const real_t* const H_new, const real_t* const g_new,
+										const real_t* const lb_new, const real_t* const ub_new,
+										int& nWSR, real_t* const cputime
+										)
+{
+	if ( getNV( ) == 0 )
+		return THROWERROR( RET_QPOBJECT_NOT_SETUP );
+
+	if ( isInitialised( ) == BT_FALSE )
+		return init( H_new,g_new,lb_new,ub_new, nWSR,cputime );
+
+	/* keep the current working set as initial guess for the new Hessian */
+	Bounds guessedBounds( bounds );
+
+	reset( );
+
+	return init( H_new,g_new,lb_new,ub_new, nWSR,cputime, 0,0,&guessedBounds );
+}
+
+
+/*
+ *	h o t s t a r t    w i t h    h o m o t o p y    l o g g i n g
+ *	(for line search in qpDUNES)
+ */
+returnValue LoggedQProblemB::hotstart_withHomotopyLogging(	const real_t* const g_new,
+															const real_t* const lb_new, const real_t* const ub_new,
+															real_t* const parametricObjFctn_alpha,			/* log for homotopy kinks (active set changes) */
+															real_t* const parametricObjFctn_f,				/* log for objective value */
+															real_t* const parametricObjFctn_fPrime,			/* log for objective derivative in homotopy direction */
+															real_t* const parametricObjFctn_fPrimePrime,	/* log for objective second derivative in homotopy direction */
+															int& nWSR, real_t* const cputime
+															)
+{
+	if ( getNV( ) == 0 )
+		return THROWERROR( RET_QPOBJECT_NOT_SETUP );
+
+	returnValue returnvalue = SUCCESSFUL_RETURN;
+
+	/* Simple check for consistency of bounds */
+	if ( areBoundsConsistent(lb_new, ub_new) != SUCCESSFUL_RETURN )
+		return setInfeasibilityFlag(returnvalue,BT_TRUE);
+
+	++count;
+
+	if ( haveCholesky == BT_FALSE )
+	{
+		returnvalue = setupInitialCholesky( );
+		if (returnvalue != SUCCESSFUL_RETURN)
+			return THROWERROR(returnvalue);
+	}
+
+	/** far bounds and regularisation are disabled by qpDUNES, so the regular solveQP can be called directly */
+	returnvalue = solveQP_withHomotopyLogging(	g_new,lb_new,ub_new,
+												parametricObjFctn_alpha,
+												parametricObjFctn_f,
+												parametricObjFctn_fPrime,
+												parametricObjFctn_fPrimePrime,
+												nWSR,cputime
+												);
+
+	return ( returnvalue != SUCCESSFUL_RETURN ) ? THROWERROR( returnvalue ) : returnvalue;
+}
+
+
+/*
+ *	g e t R
+ */
+void LoggedQProblemB::getR( real_t** const ROut ) const
+{
+	*ROut = R;
+}
+
+
+/*
+ *	g e t Q T
+ */
+void LoggedQProblemB::getQT( real_t** const QTOut, int* nZ )
+{
+	int i, j;
+	int nV  = getNV( );
+	int nFR = getNFR( );
+
+	int* FR_idx;
+	bounds.getFree( )->getNumberArray( &FR_idx );
+
+	/* Z = I(:,FR_idx), in the order in which the free variables enter R */
+	for( i=0; i<nFR; ++i )
+	{
+		for( j=0; j<nV; ++j )
+			QT[i*nV+j] = 0.0;
+		QT[i*nV+FR_idx[i]] = 1.0;
+	}
+
+	*nZ = nFR;
+	*QTOut = QT;
+}
+
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+/*
+ *	s e t u p S u b j e c t T o T y p e
+ */
+returnValue LoggedQProblemB::setupSubjectToType( )
+{
+	return QProblemB::setupSubjectToType( lb,ub );
+}
+
+
+/*
+ *	s e t u p S u b j e c t T o T y p e
+ *	(on hotstart, called by QProblemB::solveQP)
+ */
+returnValue LoggedQProblemB::setupSubjectToType( const real_t* const lb_new, const real_t* const ub_new )
+{
+	/* bound types are kept; unused arguments */
+	(void)lb_new;
+	(void)ub_new;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s o l v e Q P
+ */
+returnValue LoggedQProblemB::solveQP_withHomotopyLogging(	const real_t* const g_new,
+															const real_t* const lb_new, const real_t* const ub_new,
+															real_t* const parametricObjFctn_alpha,			/* log for homotopy kinks (active set changes) */
+															real_t* const parametricObjFctn_f,				/* log for objective value */
+															real_t* const parametricObjFctn_fPrime,			/* log for objective derivative in homotopy direction */
+															real_t* const parametricObjFctn_fPrimePrime,	/* log for objective second derivative in homotopy direction */
+															int& nWSR, real_t* const cputime
+															)
+{
+	int iter;
+	int nV  = getNV( );
+
+	/* consistency check */
+	if ( ( getStatus( ) == QPS_NOTINITIALISED )       ||
+		 ( getStatus( ) == QPS_PREPARINGAUXILIARYQP ) ||
+		 ( getStatus( ) == QPS_PERFORMINGHOMOTOPY )   )
+	{
+		return THROWERROR( RET_HOTSTART_FAILED_AS_QP_NOT_INITIALISED );
+	}
+
+	/* start runtime measurement */
+	real_t starttime = 0.0;
+	if ( cputime != 0 )
+		starttime = getCPUtime( );
+
+
+	/* I) PREPARATIONS */
+	/* 1) Allocate delta vectors of gradient and bounds,
+	 *    index arrays and step direction arrays. */
+	real_t* delta_xFR = new real_t[nV];
+	real_t* delta_xFX = new real_t[nV];
+	real_t* delta_yFX = new real_t[nV];
+
+	real_t* delta_g  = new real_t[nV];
+	real_t* delta_lb = new real_t[nV];
+	real_t* delta_ub = new real_t[nV];
+
+	returnValue returnvalue;
+	BooleanType Delta_bB_isZero;
+
+	int BC_idx;
+	SubjectToStatus BC_status;
+
+	real_t homotopyLength;
+
+	#ifndef __XPCTARGET__
+	char messageString[80];
+	#endif
+
+	/* 2) Bound types are not updated (see setupSubjectToType): tight bounds that
+	 *    are inactive would become inactive equalities and never get active again. */
+
+	/* 3) Reset status flags. */
+	infeasible = BT_FALSE;
+	unbounded  = BT_FALSE;
+
+
+	/* II) MAIN HOMOTOPY LOOP */
+	for( iter=0; iter<nWSR; ++iter )
+	{
+		tabularOutput.idxAddB = tabularOutput.idxRemB = tabularOutput.idxAddC = tabularOutput.idxRemC = -1;
+		tabularOutput.excAddB = tabularOutput.excRemB = tabularOutput.excAddC = tabularOutput.excRemC = 0;
+
+		if ( isCPUtimeLimitExceeded( cputime,starttime,iter ) == BT_TRUE )
+		{
+			/* Assign number of working set recalculations and stop runtime measurement. */
+			nWSR = iter;
+			if ( cputime != 0 )
+				*cputime = getCPUtime( ) - starttime;
+
+			break;
+		}
+
+		status = QPS_PERFORMINGHOMOTOPY;
+
+		#ifndef __XPCTARGET__
+		snprintf( messageString,80,"%d ...",iter );
+		getGlobalMessageHandler( )->throwInfo( RET_ITERATION_STARTED,messageString,__FUNCTION__,__FILE__,__LINE__,VS_VISIBLE );
+		#endif
+
+		/* 2) Initialise shift direction of the gradient and the bounds. */
+		returnvalue = determineDataShift(	g_new,lb_new,ub_new,
+											delta_g,delta_lb,delta_ub,
+											Delta_bB_isZero
+											);
+		if ( returnvalue != SUCCESSFUL_RETURN )
+		{
+			delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
+			delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
+
+			/* Assign number of working set recalculations and stop runtime measurement. */
+			nWSR = iter;
+			if ( cputime != 0 )
+				*cputime = getCPUtime( ) - starttime;
+
+			THROWERROR( RET_SHIFT_DETERMINATION_FAILED );
+			return returnvalue;
+		}
+
+		/* log homotopy origin */
+		if (iter == 0) {
+			parametricObjFctn_alpha[0] = 0.0;
+			parametricObjFctn_f[0] = getObjVal( x );
+			real_t fPrime0 = 0.0;
+			for ( int ii=0; ii < nV; ++ii ) {
+				fPrime0 += x[ii] * delta_g[ii];
+			}
+			parametricObjFctn_fPrime[0] = fPrime0;
+		}
+
+		/* 3) Determination of step direction of X and Y. */
+		returnvalue = determineStepDirection(	delta_g,delta_lb,delta_ub,
+												Delta_bB_isZero,
+												delta_xFX,delta_xFR,delta_yFX
+												);
+		if ( returnvalue != SUCCESSFUL_RETURN )
+		{
+			delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
+			delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
+
+			/* Assign number of working set recalculations and stop runtime measurement. */
+			nWSR = iter;
+			if ( cputime != 0 )
+				*cputime = getCPUtime( ) - starttime;
+
+			THROWERROR( RET_STEPDIRECTION_DETERMINATION_FAILED );
+			return returnvalue;
+		}
+
+
+		/* 4) Determination of step length TAU.
+		 *    This step along the homotopy path is also taken (without changing working set). */
+		returnvalue = performStep(	delta_g,delta_lb,delta_ub,
+									delta_xFX,delta_xFR,delta_yFX,
+									BC_idx,BC_status
+									);
+		if ( returnvalue != SUCCESSFUL_RETURN )
+		{
+			delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
+			delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
+
+			/* Assign number of working set recalculations and stop runtime measurement. */
+			nWSR = iter;
+			if ( cputime != 0 )
+				*cputime = getCPUtime( ) - starttime;
+
+			THROWERROR( RET_STEPLENGTH_DETERMINATION_FAILED );
+			return returnvalue;
+		}
+
+		/* log tau and objective value, same as in LoggedSQProblem;
+		 * note: c * deltaLambda needs to be added afterwards (constant QP objective term) */
+		real_t fPrime0 = parametricObjFctn_fPrime[iter];
+		real_t fPrime1 = 0.0;
+		for ( int ii=0; ii < nV; ++ii ) {
+			fPrime1 += x[ii] * delta_g[ii] / ( 1 - parametricObjFctn_alpha[iter] );
+		}
+		/* second derivative is constant between active set changes */
+		real_t deltaAlpha = ( 1 - parametricObjFctn_alpha[iter] ) * tau;		/* tau is only relative on each homotopy section */
+		real_t fPrimePrime01 = 0.0;
+		if ( deltaAlpha > EPS )	{
+			fPrimePrime01 = (fPrime1 - fPrime0)/deltaAlpha;
+		}
+		real_t f1Pred = parametricObjFctn_f[iter] + fPrime0 * deltaAlpha + .5 * fPrimePrime01 * deltaAlpha * deltaAlpha;
+
+		parametricObjFctn_alpha[iter+1] = parametricObjFctn_alpha[iter] + deltaAlpha;
+		parametricObjFctn_f[iter+1] = f1Pred;
+		parametricObjFctn_fPrime[iter+1] = fPrime1;
+		parametricObjFctn_fPrimePrime[iter] = fPrimePrime01;
+
+		/* 5) Termination criterion. */
+		homotopyLength = getRelativeHomotopyLength(g_new, lb_new, ub_new);
+		if ( homotopyLength <= options.terminationTolerance )
+		{
+			status = QPS_SOLVED;
+
+			THROWINFO( RET_OPTIMAL_SOLUTION_FOUND );
+
+			if ( printIteration( iter,BC_idx,BC_status,homotopyLength ) != SUCCESSFUL_RETURN )
+				THROWERROR( RET_PRINT_ITERATION_FAILED ); /* do not pass this as return value! */
+
+			nWSR = iter;
+			if ( cputime != 0 )
+				*cputime = getCPUtime( ) - starttime;
+
+			delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
+			delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
+
+			return SUCCESSFUL_RETURN;
+		}
+
+
+		/* 6) Change active set. */
+		returnvalue = changeActiveSet( BC_idx,BC_status );
+		if ( returnvalue != SUCCESSFUL_RETURN )
+		{
+			delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
+			delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
+
+			/* Assign number of working set recalculations and stop runtime measurement. */
+			nWSR = iter;
+			if ( cputime != 0 )
+				*cputime = getCPUtime( ) - starttime;
+
+			/* checks for infeasibility... */
+			if ( infeasible == BT_TRUE )
+			{
+				status = QPS_HOMOTOPYQPSOLVED;
+				return setInfeasibilityFlag( RET_HOTSTART_STOPPED_INFEASIBILITY );
+			}
+
+			/* ...unboundedness... */
+			if ( unbounded == BT_TRUE ) /* not necessary since objective function convex! */
+				return THROWERROR( RET_HOTSTART_STOPPED_UNBOUNDEDNESS );
+
+			/* ... and throw unspecific error otherwise */
+			THROWERROR( RET_HOMOTOPY_STEP_FAILED );
+			return returnvalue;
+		}
+
+		/* 6a) Possibly refactorise projected Hessian from scratch. */
+		if ( ( options.enableCholeskyRefactorisation > 0 ) && ( (iter % options.enableCholeskyRefactorisation) == 0 ) )
+		{
+			returnvalue = computeCholesky( );
+			if (returnvalue != SUCCESSFUL_RETURN)
+			{
+				delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
+				delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
+				return returnvalue;
+			}
+		}
+
+
+		/* 7) Perform Ramping Strategy on zero homotopy step or drift correction (if desired). */
+		 if ( ( tau <= EPS ) && ( options.enableRamping == BT_TRUE ) )
+			performRamping( );
+		else
+		if ( (options.enableDriftCorrection > 0) && ((iter+1) % options.enableDriftCorrection == 0) )
+			performDriftCorrection( );  /* always returns SUCCESSFUL_RETURN */
+
+		/* 8) Output information of successful QP iteration. */
+		status = QPS_HOMOTOPYQPSOLVED;
+
+		if ( printIteration( iter,BC_idx,BC_status,homotopyLength ) != SUCCESSFUL_RETURN )
+			THROWERROR( RET_PRINT_ITERATION_FAILED ); /* do not pass this as return value! */
+	}
+
+	delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
+	delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
+
+	/* stop runtime measurement */
+	if ( cputime != 0 )
+		*cputime = getCPUtime( ) - starttime;
+
+
+	/* if program gets to here, output information that QP could not be solved
+	 * within the given maximum numbers of working set changes */
+	if ( options.printLevel == PL_HIGH )
+	{
+		#ifndef __XPCTARGET__
+		snprintf( messageString,80,"(nWSR = %d)",iter );
+		return getGlobalMessageHandler( )->throwWarning( RET_MAX_NWSR_REACHED,messageString,__FUNCTION__,__FILE__,__LINE__,VS_VISIBLE );
+		#else
+		return RET_MAX_NWSR_REACHED;
+		#endif
+	}
+	else
+	{
+		return RET_MAX_NWSR_REACHED;
+	}
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
@@ -45,6 +45,9 @@
 	#include <qp/qpDataStatic.h>
 #endif
 #include <qp/stage_qp_solver_clipping.h>
+#include <qp/stage_qp_solver_boxqp.h>
+#include <qp/factor_cache.h>
+#include <qp/newton_memo.h>
 #include <qp/stage_qp_solver_qpoases.hpp>
 #include <qp/matrix_vector.h>
 #include <qp/setup_qp.h>
@@ -55,6 +58,15 @@ return_t qpDUNES_solve(	qpData_t* const qpData
 						);
 
 
+/** solve nBatch QPs of equal dimensions; exit flag (and iteration count,
+ *  if numIter is not null) of every QP are returned in exitFlags and numIter */
+return_t qpDUNES_solveBatch(	qpData_t* const qpDataBatch,
+								int_t nBatch,
+								return_t* const exitFlags,
+								int_t* const numIter
+								);
+
+
 void qpDUNES_logIteration( qpData_t* qpData,
 						itLog_t* itLogPtr,
 						real_t objValIncumbent,
@@ -93,16 +105,31 @@ return_t qpDUNES_solveLocalQP(	qpData_t* const qpData,
 
 
 return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData,
+									int_t* const firstHessianDataChangeIdx,
 									int_t* const lastHessianDataChangeIdx
 									);
 
+boolean_t qpDUNES_updateNewtonSystem(	qpData_t* const qpData,
+										int_t* const firstHessianDataChangeIdx,
+										int_t* const lastHessianDataChangeIdx
+										);
+
+boolean_t qpDUNES_isBoundActiveInNewtonHessian(	const qpData_t* const qpData,
+												const interval_t* const interval,
+												int_t varIdx
+												);
+
 return_t qpDUNES_setupCholDefaultHessian(	qpData_t* const qpData	);
 
 return_t qpDUNES_factorNewtonSystem(	qpData_t* const qpData,
 										xn2x_matrix_t* const cholHessian,
 										xn2x_matrix_t* const hessian,
 										boolean_t* const isHessianRegularized,
-										int_t lastHessianDataChangeIdx
+										int_t firstHessianDataChangeIdx,
+										int_t lastHessianDataChangeIdx,
+										int_t* const twistIdx,
+										sparsityType_t* const blockSparsity,
+										int_t* const nRefactoredBlocks
 										);
 
 
@@ -110,13 +137,23 @@ return_t qpDUNES_setupUnconstrainedNewtonSystem(	qpData_t* const qpData	);
 
 
 return_t qpDUNES_computeNewtonGradient(	qpData_t* const qpData,
-										xn_vector_t* gradient,
-										x_vector_t* gradPiece
+										xn_vector_t* gradient
+										);
+
+
+return_t qpDUNES_updateNewtonGradient(	qpData_t* const qpData
 										);
 
 
+return_t qpDUNES_computeParametricNewtonGradient(	qpData_t* const qpData,
+													xn_vector_t* gradient,
+													real_t alpha
+													);
+
+
 return_t qpDUNES_factorizeNewtonHessian(	qpData_t* const qpData,
 											xn2x_matrix_t* const cholHessian,
+											sparsityType_t* const cholBlockSparsity,
 											xn2x_matrix_t* const hessian,
 											boolean_t* isHessianRegularized
 											);
@@ -124,24 +161,105 @@ return_t qpDUNES_factorizeNewtonHessian(	qpData_t* const qpData,
 
 return_t qpDUNES_factorizeNewtonHessianBottomUp(	qpData_t* const qpData,
 													xn2x_matrix_t* const cholHessian,
+													sparsityType_t* const cholBlockSparsity,
 													xn2x_matrix_t* const hessian,
 													int_t lastActSetChangeIdx,
 													boolean_t* isHessianRegularized
 													);
 
+return_t qpDUNES_updateNewtonHessianFactor(	qpData_t* const qpData,
+											xn2x_matrix_t* const cholHessian,
+											sparsityType_t* const cholBlockSparsity,
+											xn_vector_t* const updateVec,
+											real_t sigma,
+											int_t blockIdxStart
+											);
+
+return_t qpDUNES_updateNewtonHessianFactorBottomUp(	qpData_t* const qpData,
+													xn2x_matrix_t* const cholHessian,
+													sparsityType_t* const cholBlockSparsity,
+													xn_vector_t* const updateVec,
+													real_t sigma,
+													int_t blockIdxStart
+													);
+
+boolean_t qpDUNES_isNewtonHessianBlockDiagonal(	qpData_t* const qpData,
+												const real_t* const hessBlock,
+												const real_t* const cholBlock,
+												boolean_t isCholBlockTransposed
+												);
+
+
+return_t qpDUNES_factorizeNewtonHessianCyclicReduction(	qpData_t* const qpData,
+														xn2x_matrix_t* const cholHessian,
+														xn2x_matrix_t* const hessian,
+														boolean_t* isHessianRegularized
+														);
+
+
+return_t qpDUNES_factorizeNewtonHessianTwisted(	qpData_t* const qpData,
+												xn2x_matrix_t* const cholHessian,
+												xn2x_matrix_t* const hessian,
+												int_t firstActSetChangeIdx,
+												int_t lastActSetChangeIdx,
+												int_t* const twistIdx,
+												int_t* const nRefactoredBlocks,
+												boolean_t* isHessianRegularized
+												);
+
+
+return_t qpDUNES_factorizeNewtonHessianBlock(	qpData_t* const qpData,
+												real_t* const block,
+												boolean_t* isHessianRegularized
+												);
+
+
+void qpDUNES_solveNewtonHessianBlock(	qpData_t* const qpData,
+										real_t* const res,
+										const real_t* const cholBlock,
+										int_t incr
+										);
+
+void qpDUNES_solveNewtonHessianBlockL(	qpData_t* const qpData,
+										real_t* const res,
+										const real_t* const cholBlock,
+										int_t incr
+										);
+
+void qpDUNES_solveNewtonHessianBlockLT(	qpData_t* const qpData,
+										real_t* const res,
+										const real_t* const cholBlock,
+										int_t incr
+										);
+
 
 return_t qpDUNES_solveNewtonEquation(	qpData_t* const qpData,
 										xn_vector_t* const res,
 										const xn2x_matrix_t* const cholHessian,	/**< lower triangular Newton Hessian factor */
+										const sparsityType_t* const cholBlockSparsity,	/**< block sparsity tags of cholHessian */
 										const xn_vector_t* const gradient
 										);
 
 return_t qpDUNES_solveNewtonEquationBottomUp(	qpData_t* const qpData,
 												xn_vector_t* const res,
 												const xn2x_matrix_t* const cholHessian,	/**< lower triangular Newton Hessian factor */
+												const sparsityType_t* const cholBlockSparsity,	/**< block sparsity tags of cholHessian */
 												const xn_vector_t* const gradient
 												);
 
+return_t qpDUNES_solveNewtonEquationCyclicReduction(	qpData_t* const qpData,
+														xn_vector_t* const res,
+														const xn2x_matrix_t* const cholHessian,	/**< cyclic reduction Newton Hessian factor */
+														const xn_vector_t* const gradient
+														);
+
+return_t qpDUNES_solveNewtonEquationTwisted(	qpData_t* const qpData,
+												xn_vector_t* const res,
+												const xn2x_matrix_t* const cholHessian,	/**< twisted Newton Hessian factor */
+												const xn_vector_t* const gradient,
+												int_t twistIdx
+												);
+
 return_t qpDUNES_multiplyNewtonHessianVector(	qpData_t* const qpData,
 												xn_vector_t* const res,
 												const xn2x_matrix_t* const hessian, /**< Newton Hessian */
@@ -162,6 +280,16 @@ return_t qpDUNES_determineStepLength(	qpData_t* const qpData,
 										boolean_t newtonHessianRegularized
 										);
 
+
+return_t qpDUNES_doStepAllLocalQPs(	qpData_t* const qpData,
+									real_t alpha
+									);
+
+
+return_t qpDUNES_doTrialStepAllLocalQPs(	qpData_t* const qpData,
+											real_t alpha
+											);
+
 return_t qpDUNES_backTrackingLineSearch(	qpData_t* const qpData,
 											real_t* const alpha,
 											uint_t* const itCntr,
@@ -226,12 +354,46 @@ return_t qpDUNES_gridSearch(	qpData_t* const qpData,
 								real_t alphaMax
 								);
 
+return_t qpDUNES_mergeHomotopyBreakpoints(	qpData_t* const qpData,
+											real_t** const alphaSorted,
+											int_t** const idxSorted,
+											int_t* const nBreakpoints
+											);
+
 return_t qpDUNES_homotopyGridSearch(	qpData_t* const qpData,
 										real_t* const alpha,
 										uint_t* const itCntr
 										);
 
 
+return_t qpDUNES_piecewiseQuadraticLineSearch(	qpData_t* const qpData,
+												real_t* const alpha,
+												uint_t* const itCntr,
+												real_t alphaMax
+												);
+
+int qpDUNES_compareBreakpoints(	const void* a,
+								const void* b
+								);
+
+
+return_t qpDUNES_newtonLineSearch(	qpData_t* const qpData,
+									real_t* const alpha,
+									uint_t* const itCntr,
+									const xn_vector_t* const deltaLambdaFS,
+									int_t nV,
+									real_t alphaMin,
+									real_t alphaMax
+									);
+
+
+return_t qpDUNES_computeParametricObjectiveDerivatives(	qpData_t* const qpData,
+														real_t alpha,
+														real_t* const slope,
+														real_t* const curvature
+														);
+
+
 return_t qpDUNES_infeasibilityCheck(	qpData_t* qpData
 										);
 
@@ -254,6 +416,12 @@ real_t qpDUNES_computeParametricObjectiveValue(	qpData_t* const qpData,
 												const real_t alpha
 												);
 
+return_t qpDUNES_computeParametricObjectiveValues(	qpData_t* const qpData,
+													const real_t* const alphas,
+													real_t* const objVals,
+													int_t nAlphas
+													);
+
 /* ----------------------------------------------
  * Get number of active local constraints
  *
@@ -0,0 +1,106 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file include/qp/factor_cache.h
+ *	\version 1.0beta
+ *
+ *	Cache of stage Hessian factors. Stages with equal Hessian (typically all
+ *	stages of an LTI problem) point their cholH at one factor instead of each
+ *	holding a copy, and equal unconstrained Newton Hessian blocks of such
+ *	stages are computed only once.
+ */
+
+
+#ifndef QP42_FACTOR_CACHE_H
+#define QP42_FACTOR_CACHE_H
+
+
+#include <qp/types.h>
+#if !defined(__STATIC_MEMORY__)
+	#include <qp/qpData.h>
+#else
+	#include <qp/qpDataStatic.h>
+#endif
+#include <qp/matrix_vector.h>
+#include <qp/qpdunes_utils.h>
+
+
+/* ----------------------------------------------
+ * factorize the stage Hessian into cholH, or
+ * use the factor of a stage with equal Hessian
+ *
+ *		                                           */
+return_t qpDUNES_factorizeStageHessian(	qpData_t* const qpData,
+										interval_t* const interval
+										);
+
+
+/* ----------------------------------------------
+ * use the Hessian factor of stage source
+ * (LTI case: Hessians are equal by assumption)
+ *
+ *		                                           */
+return_t qpDUNES_shareStageFactor(	qpData_t* const qpData,
+									interval_t* const interval,
+									const interval_t* const source
+									);
+
+
+/* ----------------------------------------------
+ * stop using a shared Hessian factor; cholH
+ * points to the stage-owned storage again
+ *
+ *		                                           */
+void qpDUNES_releaseStageFactor(	qpData_t* const qpData,
+									interval_t* const interval
+									);
+
+
+/* ----------------------------------------------
+ * release the shared factors of all stages
+ *
+ *		                                           */
+void qpDUNES_resetFactorCache(	qpData_t* const qpData
+								);
+
+
+/* ----------------------------------------------
+ * find unconstrained Newton Hessian blocks that
+ * equal a block further up (stages with shared
+ * Hessian factors and equal dynamics); returns
+ * the number of blocks that can be copied
+ *
+ *		                                           */
+int_t qpDUNES_findSharedNewtonBlocks(	qpData_t* const qpData
+										);
+
+
+#endif	/* QP42_FACTOR_CACHE_H */
+
+
+/*
+ *	end of file
+ */
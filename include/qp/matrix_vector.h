@@ -462,6 +462,20 @@ void multiplyMatrixMatrixTDenseDense( real_t* const res,
 							int_t dim2					/**< leading dimension of untransposed M2 */
 							);
 
+/* ----------------------------------------------
+ * Transposed matrix-matrix product res = M1.T*M2
+ * for M1, M2 of size nRows x nX; uses the
+ * specialized kernel for nX if available
+ *
+ >>>>>                                            */
+void multiplyZxTZx(	qpData_t* const qpData,
+					xx_matrix_t* const res,
+					const zx_matrix_t* const M1,
+					const zx_matrix_t* const M2,
+					int_t nRows,
+					boolean_t addToRes			/**< flag to specify whether to overwrite res, or simply add to it */
+					);
+
 
 /** Low-level scalar product */
 real_t scalarProd(	const vector_t* const x,
@@ -582,10 +596,32 @@ return_t addCInvHCT(	qpData_t* const qpData,
 //						xz_matrix_t* const C,			/**< temporary matrix to build up C as once */
 						xx_matrix_t* const xxMatTmp,
 						ux_matrix_t* const uxMatTmp,
-						zx_matrix_t* const zxMatTmp
+						zx_matrix_t* const zxMatTmp,
+						x_vector_t* const xVecTmp
 						);
 
 
+return_t getMatrixInvMatrixMatrixTFactor(	qpData_t* const qpData,
+											matrix_t* const Z,				/**< factor of shape dim1 x dim0 */
+											const matrix_t* const cholM1,
+											const matrix_t* const M2,
+											vector_t* const vecTmp,
+											int_t dim0,						/**< dimensions of M2 */
+											int_t dim1
+											);
+
+
+return_t addMultiplyMatrixInvMatrixMatrixTFromFactor(	qpData_t* const qpData,
+														matrix_t* const res,
+														const matrix_t* const cholM1,
+														const matrix_t* const M2,
+														const real_t* const y,			/**< vector containing non-zeros for columns of M2 to be eliminated */
+														const matrix_t* const Z,		/**< factor from getMatrixInvMatrixMatrixTFactor */
+														int_t dim0,						/**< dimensions of M2 */
+														int_t dim1
+														);
+
+
 return_t addMultiplyMatrixInvMatrixMatrixT(	qpData_t* const qpData,
 											matrix_t* const res,
 											const matrix_t* const cholM1,
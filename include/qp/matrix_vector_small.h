@@ -0,0 +1,61 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qp42; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qp/matrix_vector_small.h
+ *	\version 1.0beta
+ *
+ *	Dense stage kernels specialized for small problem dimensions.
+ */
+
+
+#ifndef QP42_MATRIX_VECTOR_SMALL_H
+#define QP42_MATRIX_VECTOR_SMALL_H
+
+
+#include <qp/types.h>
+#if !defined(__STATIC_MEMORY__)
+	#include <qp/qpData.h>
+#else
+	#include <qp/qpDataStatic.h>
+#endif
+
+
+/** largest dimensions for which specialized kernels are instantiated */
+#define QPDUNES_SMALL_KERNELS_NX_MAX	12
+#define QPDUNES_SMALL_KERNELS_NU_MAX	4
+
+
+/** select kernels for qpData->nX, qpData->nU; returns QPDUNES_FALSE and
+ *  clears the kernel table if no specialization is available */
+boolean_t qpDUNES_setupSmallKernels(	qpData_t* const qpData
+										);
+
+
+#endif	/* QP42_MATRIX_VECTOR_SMALL_H */
+
+
+/*
+ *	end of file
+ */
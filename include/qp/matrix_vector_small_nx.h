@@ -0,0 +1,76 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qp42; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qp/matrix_vector_small_nx.h
+ *	\version 1.0beta
+ *
+ *	Instantiates matrix_vector_small_template.h for nX = 1..12 and the
+ *	SMALL_NU defined by the including file.
+ *
+ *	NOTE: no include guard on purpose.
+ */
+
+
+#define SMALL_NX 1
+#include <qp/matrix_vector_small_template.h>
+#undef SMALL_NX
+#define SMALL_NX 2
+#include <qp/matrix_vector_small_template.h>
+#undef SMALL_NX
+#define SMALL_NX 3
+#include <qp/matrix_vector_small_template.h>
+#undef SMALL_NX
+#define SMALL_NX 4
+#include <qp/matrix_vector_small_template.h>
+#undef SMALL_NX
+#define SMALL_NX 5
+#include <qp/matrix_vector_small_template.h>
+#undef SMALL_NX
+#define SMALL_NX 6
+#include <qp/matrix_vector_small_template.h>
+#undef SMALL_NX
+#define SMALL_NX 7
+#include <qp/matrix_vector_small_template.h>
+#undef SMALL_NX
+#define SMALL_NX 8
+#include <qp/matrix_vector_small_template.h>
+#undef SMALL_NX
+#define SMALL_NX 9
+#include <qp/matrix_vector_small_template.h>
+#undef SMALL_NX
+#define SMALL_NX 10
+#include <qp/matrix_vector_small_template.h>
+#undef SMALL_NX
+#define SMALL_NX 11
+#include <qp/matrix_vector_small_template.h>
+#undef SMALL_NX
+#define SMALL_NX 12
+#include <qp/matrix_vector_small_template.h>
+#undef SMALL_NX
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,270 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qp42; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qp/matrix_vector_small_template.h
+ *	\version 1.0beta
+ *
+ *	Dense stage kernels for one fixed pair of dimensions SMALL_NX, SMALL_NU.
+ *	Included once per instantiated pair by src/matrix_vector_small.c; since
+ *	all loop bounds are compile-time constants, the compiler can fully
+ *	unroll the loops and keep the small blocks in registers.
+ *
+ *	NOTE: no include guard on purpose.
+ */
+
+
+#if !defined(SMALL_NX) || !defined(SMALL_NU)
+	#error "SMALL_NX and SMALL_NU need to be defined before including matrix_vector_small_template.h"
+#endif
+
+#define SMALL_NZ	(SMALL_NX+SMALL_NU)
+
+
+/* ----------------------------------------------
+ * Matrix-vector product res = C*z
+ *
+ >>>>>                                            */
+static void SMALL_KERNEL(multiplyCz)(	real_t* const res,
+										const real_t* const C,
+										const real_t* const z )
+{
+	int_t ii, jj;
+	real_t sum;
+
+	for( ii = 0; ii < SMALL_NX; ++ii ) {
+		sum = 0.;
+		for( jj = 0; jj < SMALL_NZ; ++jj ) {
+			sum += C[ii*SMALL_NZ+jj] * z[jj];
+		}
+		res[ii] = sum;
+	}
+}
+/*<<< END OF multiplyCz */
+
+
+/* ----------------------------------------------
+ * Matrix-vector product res = C.T*y
+ *
+ >>>>>                                            */
+static void SMALL_KERNEL(multiplyCTy)(	real_t* const res,
+										const real_t* const C,
+										const real_t* const y )
+{
+	int_t ii, jj;
+	real_t acc[SMALL_NZ];
+
+	for( jj = 0; jj < SMALL_NZ; ++jj ) {
+		acc[jj] = C[jj] * y[0];
+	}
+	for( ii = 1; ii < SMALL_NX; ++ii ) {
+		for( jj = 0; jj < SMALL_NZ; ++jj ) {
+			acc[jj] += C[ii*SMALL_NZ+jj] * y[ii];
+		}
+	}
+	for( jj = 0; jj < SMALL_NZ; ++jj ) {
+		res[jj] = acc[jj];
+	}
+}
+/*<<< END OF multiplyCTy */
+
+
+/* ----------------------------------------------
+ * Matrix backsolve L*res = C.T for dense lower
+ * triangular L; res is of size nZ x nX
+ *
+ >>>>>                                            */
+static boolean_t SMALL_KERNEL(backsolveCT)(	real_t* const res,
+											const real_t* const L,
+											const real_t* const C,
+											real_t zeroTol )
+{
+	int_t ii, jj, kk;
+	real_t sums[SMALL_NX];
+
+	for( ii = 0; ii < SMALL_NZ; ++ii ) {	/* go by rows */
+		for( kk = 0; kk < SMALL_NX; ++kk ) {
+			sums[kk] = C[kk*SMALL_NZ+ii];
+		}
+		for( jj = 0; jj < ii; ++jj ) {
+			for( kk = 0; kk < SMALL_NX; ++kk ) {
+				sums[kk] -= L[ii*SMALL_NZ+jj] * res[jj*SMALL_NX+kk];
+			}
+		}
+		for( kk = 0; kk < SMALL_NX; ++kk ) {
+			if ( fabs( L[ii*SMALL_NZ+ii] ) < zeroTol * fabs( sums[kk] ) ) {
+				return QPDUNES_FALSE;
+			}
+			res[ii*SMALL_NX+kk] = sums[kk] / L[ii*SMALL_NZ+ii];
+		}
+	}
+
+	return QPDUNES_TRUE;
+}
+/*<<< END OF backsolveCT */
+
+
+/* ----------------------------------------------
+ * res += Z.T*Z, restricted to rows of Z whose
+ * bounds are inactive in y (all rows if y == 0)
+ *
+ >>>>>                                            */
+static void SMALL_KERNEL(addMaskedZTZ)(	real_t* const res,
+										const real_t* const Z,
+										const real_t* const y,
+										real_t activeTol )
+{
+	int_t ii, jj, ll;
+
+	for( ll = 0; ll < SMALL_NZ; ++ll ) {
+		if ( ( y != 0 ) && ( ( y[2*ll] > activeTol ) || ( y[2*ll+1] > activeTol ) ) ) {
+			continue;
+		}
+		for( ii = 0; ii < SMALL_NX; ++ii ) {
+			for( jj = 0; jj < SMALL_NX; ++jj ) {
+				res[ii*SMALL_NX+jj] += Z[ll*SMALL_NX+ii] * Z[ll*SMALL_NX+jj];
+			}
+		}
+	}
+}
+/*<<< END OF addMaskedZTZ */
+
+
+/* ----------------------------------------------
+ * res += C*Z, restricted to columns of C (rows
+ * of Z) whose bounds are inactive in y (all if
+ * y == 0)
+ *
+ >>>>>                                            */
+static void SMALL_KERNEL(addMaskedCZ)(	real_t* const res,
+										const real_t* const C,
+										const real_t* const Z,
+										const real_t* const y,
+										real_t activeTol )
+{
+	int_t ii, jj, ll;
+
+	for( ll = 0; ll < SMALL_NZ; ++ll ) {
+		if ( ( y != 0 ) && ( ( y[2*ll] > activeTol ) || ( y[2*ll+1] > activeTol ) ) ) {
+			continue;
+		}
+		for( ii = 0; ii < SMALL_NX; ++ii ) {
+			for( jj = 0; jj < SMALL_NX; ++jj ) {
+				res[ii*SMALL_NX+jj] += C[ii*SMALL_NZ+ll] * Z[ll*SMALL_NX+jj];
+			}
+		}
+	}
+}
+/*<<< END OF addMaskedCZ */
+
+
+/* ----------------------------------------------
+ * res = M1.T*M2 (or res += M1.T*M2) for M1, M2
+ * of size nRows x nX
+ *
+ >>>>>                                            */
+static void SMALL_KERNEL(multiplyZxTZx)(	real_t* const res,
+											const real_t* const M1,
+											const real_t* const M2,
+											int_t nRows,
+											boolean_t addToRes )
+{
+	int_t ii, jj, kk;
+	real_t acc[SMALL_NX*SMALL_NX];
+
+	for( jj = 0; jj < SMALL_NX*SMALL_NX; ++jj ) {
+		acc[jj] = ( addToRes == QPDUNES_TRUE ) ? res[jj] : 0.;
+	}
+	for( ii = 0; ii < nRows; ++ii ) {
+		for( jj = 0; jj < SMALL_NX; ++jj ) {
+			for( kk = 0; kk < SMALL_NX; ++kk ) {
+				acc[jj*SMALL_NX+kk] += M1[ii*SMALL_NX+jj] * M2[ii*SMALL_NX+kk];
+			}
+		}
+	}
+	for( jj = 0; jj < SMALL_NX*SMALL_NX; ++jj ) {
+		res[jj] = acc[jj];
+	}
+}
+/*<<< END OF multiplyZxTZx */
+
+
+/* ----------------------------------------------
+ * Dense Cholesky factorization of nZ x nZ M
+ *
+ >>>>>                                            */
+static boolean_t SMALL_KERNEL(choleskyZZ)(	real_t* const cholM,
+											const real_t* const M,
+											real_t zeroTol )
+{
+	int_t ii, jj, kk;
+	real_t sum;
+
+	for( ii = 0; ii < SMALL_NZ; ++ii ) {	/* go by columns */
+		sum = M[ii*SMALL_NZ+ii];
+		for( kk = 0; kk < ii; ++kk ) {
+			sum -= cholM[ii*SMALL_NZ+kk] * cholM[ii*SMALL_NZ+kk];
+		}
+		if ( sum <= zeroTol ) {
+			return QPDUNES_FALSE;
+		}
+		cholM[ii*SMALL_NZ+ii] = sqrt( sum );
+
+		for( jj = ii+1; jj < SMALL_NZ; ++jj ) {
+			sum = M[jj*SMALL_NZ+ii];
+			for( kk = 0; kk < ii; ++kk ) {
+				sum -= cholM[ii*SMALL_NZ+kk] * cholM[jj*SMALL_NZ+kk];
+			}
+			cholM[jj*SMALL_NZ+ii] = sum / cholM[ii*SMALL_NZ+ii];
+		}
+	}
+
+	return QPDUNES_TRUE;
+}
+/*<<< END OF choleskyZZ */
+
+
+/* ----------------------------------------------
+ * Fill kernel table with this instantiation
+ *
+ >>>>>                                            */
+static void SMALL_KERNEL(setupSmallKernels)(	smallKernels_t* const kernels )
+{
+	kernels->multiplyCz = &SMALL_KERNEL(multiplyCz);
+	kernels->multiplyCTy = &SMALL_KERNEL(multiplyCTy);
+	kernels->backsolveCT = &SMALL_KERNEL(backsolveCT);
+	kernels->addMaskedZTZ = &SMALL_KERNEL(addMaskedZTZ);
+	kernels->addMaskedCZ = &SMALL_KERNEL(addMaskedCZ);
+	kernels->multiplyZxTZx = &SMALL_KERNEL(multiplyZxTZx);
+	kernels->choleskyZZ = &SMALL_KERNEL(choleskyZZ);
+}
+/*<<< END OF setupSmallKernels */
+
+
+#undef SMALL_NZ
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,80 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file include/qp/newton_memo.h
+ *	\version 1.0beta
+ *
+ *	Memo of stage contributions to the Newton Hessian. The contribution of
+ *	a clipping or box QP stage only depends on its Hessian, its dynamics and
+ *	its active bounds; in steady-state MPC few active sets recur on stages
+ *	sharing one Hessian factor, and their contributions are kept in a small
+ *	least recently used table instead of being recomputed.
+ */
+
+
+#ifndef QP42_NEWTON_MEMO_H
+#define QP42_NEWTON_MEMO_H
+
+
+#include <qp/types.h>
+#if !defined(__STATIC_MEMORY__)
+	#include <qp/qpData.h>
+#else
+	#include <qp/qpDataStatic.h>
+#endif
+#include <qp/stage_qp_solver_boxqp.h>
+#include <qp/matrix_vector.h>
+#include <qp/qpdunes_utils.h>
+
+
+/* ----------------------------------------------
+ * find the memoized contributions of all stages
+ * needed for the Newton Hessian blocks to be
+ * rebuilt; assigns slots to the contributions
+ * that have to be computed
+ *
+ *		                                           */
+void qpDUNES_lookupNewtonMemo(	qpData_t* const qpData
+								);
+
+
+/* ----------------------------------------------
+ * compute the contribution of a stage into the
+ * slot assigned by qpDUNES_lookupNewtonMemo
+ *
+ *		                                           */
+return_t qpDUNES_fillNewtonMemo(	qpData_t* const qpData,
+									interval_t* const interval,
+									newtonMemoSlot_t* const slot
+									);
+
+
+#endif	/* QP42_NEWTON_MEMO_H */
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,62 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qp42; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qp/newton_system_simd.h
+ *	\version 1.0beta
+ *
+ *	Vectorized (AVX2/AVX-512) band Cholesky factorization and solves of
+ *	the block tridiagonal Newton system.
+ */
+
+
+#ifndef QP42_NEWTON_SYSTEM_SIMD_H
+#define QP42_NEWTON_SYSTEM_SIMD_H
+
+
+#include <qp/types.h>
+#if !defined(__STATIC_MEMORY__)
+	#include <qp/qpData.h>
+#else
+	#include <qp/qpDataStatic.h>
+#endif
+
+
+/** smallest state dimension for which the vectorized kernels are used;
+ *  below, the scalar loops in dual_qp.c are faster */
+#define QPDUNES_NEWTON_SIMD_NX_MIN	10
+
+
+/** select the vectorized Newton system kernels supported by the CPU;
+ *  returns QPDUNES_FALSE and clears the kernel table if none is available */
+boolean_t qpDUNES_setupNewtonKernels(	qpData_t* const qpData
+										);
+
+
+#endif	/* QP42_NEWTON_SYSTEM_SIMD_H */
+
+
+/*
+ *	end of file
+ */
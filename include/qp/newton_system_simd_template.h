@@ -0,0 +1,478 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qp42; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qp/newton_system_simd_template.h
+ *	\version 1.0beta
+ *
+ *	Vectorized band Cholesky factorizations and solves of the block
+ *	tridiagonal Newton system for one instruction set. Included once per
+ *	instruction set by src/newton_system_simd.c, which defines
+ *
+ *	  SIMD_NAME(fn)      name of the instantiated function
+ *	  SIMD_FUNCTION      storage class and target attribute of all functions
+ *	  SIMD_WIDTH         number of doubles per vector register
+ *	  SIMD_VEC           vector type
+ *	  SIMD_LOAD, SIMD_STORE, SIMD_SET1, SIMD_ZERO, SIMD_FMADD, SIMD_FNMADD,
+ *	  SIMD_REDUCE        vector operations
+ *
+ *	In contrast to the scalar versions in dual_qp.c, which compute every
+ *	factor element as a dot product along (partly transposed) rows, the
+ *	blocks are factorized right-looking, so that all inner loops are axpy
+ *	operations on contiguous rows of the factor (any layout of nhLayout_t).
+ *
+ *	NOTE: no include guard on purpose.
+ */
+
+
+/** pointer to row I of block (K,L) in the Newton Hessian storage format */
+#define SIMD_ROW( M, K, L, I )	( &( (M)[ (K)*layout->blockRowStride + (1+(L))*layout->blockStride + (I)*layout->rowStride ] ) )
+
+
+/* ----------------------------------------------
+ * y -= a*x
+ *
+ >>>>>                                            */
+SIMD_FUNCTION void SIMD_NAME(axpy)(	int_t n,
+									real_t a,
+									const real_t* const x,
+									real_t* const y )
+{
+	int_t ii = 0;
+	SIMD_VEC va = SIMD_SET1( a );
+
+	for( ; ii+SIMD_WIDTH <= n; ii += SIMD_WIDTH ) {
+		SIMD_STORE( &(y[ii]), SIMD_FNMADD( va, SIMD_LOAD( &(x[ii]) ), SIMD_LOAD( &(y[ii]) ) ) );
+	}
+	for( ; ii < n; ++ii ) {
+		y[ii] -= a * x[ii];
+	}
+}
+/*<<< END OF axpy */
+
+
+/* ----------------------------------------------
+ * x'*y
+ *
+ >>>>>                                            */
+SIMD_FUNCTION real_t SIMD_NAME(dot)(	int_t n,
+										const real_t* const x,
+										const real_t* const y )
+{
+	int_t ii = 0;
+	real_t sum;
+	SIMD_VEC acc0 = SIMD_ZERO();
+	SIMD_VEC acc1 = SIMD_ZERO();
+
+	for( ; ii+2*SIMD_WIDTH <= n; ii += 2*SIMD_WIDTH ) {
+		acc0 = SIMD_FMADD( SIMD_LOAD( &(x[ii]) ), SIMD_LOAD( &(y[ii]) ), acc0 );
+		acc1 = SIMD_FMADD( SIMD_LOAD( &(x[ii+SIMD_WIDTH]) ), SIMD_LOAD( &(y[ii+SIMD_WIDTH]) ), acc1 );
+	}
+	for( ; ii+SIMD_WIDTH <= n; ii += SIMD_WIDTH ) {
+		acc0 = SIMD_FMADD( SIMD_LOAD( &(x[ii]) ), SIMD_LOAD( &(y[ii]) ), acc0 );
+	}
+	sum = SIMD_REDUCE( acc0 ) + SIMD_REDUCE( acc1 );
+	for( ; ii < n; ++ii ) {
+		sum += x[ii] * y[ii];
+	}
+
+	return sum;
+}
+/*<<< END OF dot */
+
+
+/* ----------------------------------------------
+ * Check whether the lower triangle of a diagonal
+ * block is diagonal
+ *
+ >>>>>                                            */
+SIMD_FUNCTION boolean_t SIMD_NAME(isDiagonalBlock)(	const real_t* const chol,
+													int_t kk,
+													int_t nX,
+													const nhLayout_t* const layout )
+{
+	int_t ii, jj;
+	const real_t* rowI;
+
+	for( ii = 1; ii < nX; ++ii ) {
+		rowI = SIMD_ROW( chol, kk, 0, ii );
+		for( jj = 0; jj < ii; ++jj ) {
+			if ( rowI[jj] != 0. ) {
+				return QPDUNES_FALSE;
+			}
+		}
+	}
+
+	return QPDUNES_TRUE;
+}
+/*<<< END OF isDiagonalBlock */
+
+
+/* ----------------------------------------------
+ * Block tridiagonal Cholesky H = L*L' (same
+ * result as qpDUNES_factorizeNewtonHessian)
+ *
+ >>>>>                                            */
+SIMD_FUNCTION return_t SIMD_NAME(factorizeForward)(	real_t* const chol,
+													sparsityType_t* const blockSparsity,	/**< per block row: diagonal block of factor diagonal or dense */
+													const real_t* const hess,
+													real_t* const tmp,		/**< workspace of size 2*nX*nX+nX */
+													int_t nI,
+													int_t nX,
+													const nhLayout_t* const layout,
+													const qpOptions_t* const options,
+													boolean_t* const isHessianRegularized )
+{
+	int_t ii, jj, kk, ll;
+	real_t diag;
+	real_t* rowI;
+	real_t* rowJ;
+	boolean_t isDiagBlock;
+	real_t* ST = tmp;					/* transposed sub-diagonal block of factor in this block row */
+	real_t* XT = tmp + nX*nX;			/* transposed sub-diagonal block of factor in next block row */
+	real_t* col = tmp + 2*nX*nX;		/* current column of diagonal block */
+	real_t* swap;
+
+	/* go by block columns */
+	for( kk = 0; kk < nI; ++kk ) {
+		/* 1) diagonal block minus contribution of sub-diagonal block: H_kk - S*S' (lower triangle) */
+		for( ii = 0; ii < nX; ++ii ) {
+			rowI = SIMD_ROW( chol, kk, 0, ii );
+			for( jj = 0; jj <= ii; ++jj ) {
+				rowI[jj] = SIMD_ROW( hess, kk, 0, ii )[jj];
+			}
+			if ( kk > 0 ) {
+				for( ll = 0; ll < nX; ++ll ) {
+					SIMD_NAME(axpy)( ii+1, SIMD_ROW( chol, kk, -1, ii )[ll], &(ST[ll*nX]), rowI );
+				}
+			}
+		}
+
+		/* diagonal blocks only need the square root of the diagonal */
+		isDiagBlock = SIMD_NAME(isDiagonalBlock)( chol, kk, nX, layout );
+		blockSparsity[kk] = ( isDiagBlock == QPDUNES_TRUE ) ? QPDUNES_DIAGONAL : QPDUNES_DENSE;
+
+		/* 2) right-looking Cholesky of diagonal block */
+		for( jj = 0; jj < nX; ++jj ) {
+			rowJ = SIMD_ROW( chol, kk, 0, jj );
+			diag = rowJ[jj];
+
+			if ( ( options->regType == QPDUNES_REG_SINGULAR_DIRECTIONS ) &&
+				 ( diag < options->newtonHessDiagRegTolerance ) )
+			{
+				diag += options->QPDUNES_INFTY * options->QPDUNES_INFTY + 1.;
+				*isHessianRegularized = QPDUNES_TRUE;
+			}
+			else {
+				if ( diag < options->newtonHessDiagRegTolerance ) {	/* matrix not positive definite */
+					return QPDUNES_ERR_DIVISION_BY_ZERO;
+				}
+			}
+			diag = sqrt( diag );
+			rowJ[jj] = diag;
+
+			if ( isDiagBlock == QPDUNES_TRUE )	continue;
+
+			/* remainder of jj-th column, kept contiguous for the trailing update */
+			for( ii = jj+1; ii < nX; ++ii ) {
+				col[ii] = SIMD_ROW( chol, kk, 0, ii )[jj] / diag;
+				SIMD_ROW( chol, kk, 0, ii )[jj] = col[ii];
+			}
+			/* trailing update of lower triangle */
+			for( ii = jj+1; ii < nX; ++ii ) {
+				SIMD_NAME(axpy)( ii-jj, col[ii], &(col[jj+1]), &(SIMD_ROW( chol, kk, 0, ii )[jj+1]) );
+			}
+		}
+
+		/* 3) sub-diagonal block of next block row X = H_{k+1,k} * L_kk^-T, computed transposed: L_kk * X' = H_{k+1,k}' */
+		if ( kk < nI-1 ) {
+			for( jj = 0; jj < nX; ++jj ) {
+				for( ii = 0; ii < nX; ++ii ) {
+					XT[jj*nX+ii] = SIMD_ROW( hess, kk+1, -1, ii )[jj];
+				}
+			}
+			for( jj = 0; jj < nX; ++jj ) {
+				rowJ = SIMD_ROW( chol, kk, 0, jj );
+				if ( isDiagBlock == QPDUNES_FALSE ) {
+					for( ll = 0; ll < jj; ++ll ) {
+						SIMD_NAME(axpy)( nX, rowJ[ll], &(XT[ll*nX]), &(XT[jj*nX]) );
+					}
+				}
+				for( ii = 0; ii < nX; ++ii ) {
+					XT[jj*nX+ii] /= rowJ[jj];
+				}
+			}
+			for( ii = 0; ii < nX; ++ii ) {
+				rowI = SIMD_ROW( chol, kk+1, -1, ii );
+				for( jj = 0; jj < nX; ++jj ) {
+					rowI[jj] = XT[jj*nX+ii];
+				}
+			}
+
+			/* X' is needed for the diagonal block of the next block row */
+			swap = ST;
+			ST = XT;
+			XT = swap;
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF factorizeForward */
+
+
+/* ----------------------------------------------
+ * Bottom-up block tridiagonal Cholesky H = L'*L
+ * (same result as
+ * qpDUNES_factorizeNewtonHessianBottomUp)
+ *
+ >>>>>                                            */
+SIMD_FUNCTION return_t SIMD_NAME(factorizeReverse)(	real_t* const chol,
+													sparsityType_t* const blockSparsity,	/**< per block row: diagonal block of factor diagonal or dense */
+													const real_t* const hess,
+													int_t nI,
+													int_t nX,
+													const nhLayout_t* const layout,
+													int_t blockIdxStart,	/**< block row from where the factorization is restarted */
+													const qpOptions_t* const options,
+													boolean_t* const isHessianRegularized )
+{
+	int_t ii, jj, kk, ll;
+	real_t diag;
+	real_t* rowI;
+	real_t* rowJ;
+	boolean_t isDiagBlock;
+
+	/* go by block columns bottom up */
+	for( kk = blockIdxStart; kk >= 0; --kk ) {
+		/* 1) diagonal block minus contribution of following sub-diagonal block: H_kk - X'*X (lower triangle) */
+		for( ii = 0; ii < nX; ++ii ) {
+			rowI = SIMD_ROW( chol, kk, 0, ii );
+			for( jj = 0; jj <= ii; ++jj ) {
+				rowI[jj] = SIMD_ROW( hess, kk, 0, ii )[jj];
+			}
+		}
+		if ( kk < nI-1 ) {
+			for( ll = 0; ll < nX; ++ll ) {
+				rowJ = SIMD_ROW( chol, kk+1, -1, ll );
+				for( ii = 0; ii < nX; ++ii ) {
+					SIMD_NAME(axpy)( ii+1, rowJ[ii], rowJ, SIMD_ROW( chol, kk, 0, ii ) );
+				}
+			}
+		}
+
+		/* diagonal blocks only need the square root of the diagonal */
+		isDiagBlock = SIMD_NAME(isDiagonalBlock)( chol, kk, nX, layout );
+		blockSparsity[kk] = ( isDiagBlock == QPDUNES_TRUE ) ? QPDUNES_DIAGONAL : QPDUNES_DENSE;
+
+		/* 2) reverse Cholesky of diagonal block, starting from the bottom right */
+		for( jj = nX-1; jj >= 0; --jj ) {
+			rowJ = SIMD_ROW( chol, kk, 0, jj );
+			diag = rowJ[jj];
+
+			if ( ( options->regType == QPDUNES_REG_SINGULAR_DIRECTIONS ) &&
+				 ( diag < options->newtonHessDiagRegTolerance ) )
+			{
+				diag += options->regParam;
+				*isHessianRegularized = QPDUNES_TRUE;
+				#ifdef __DEBUG__
+				if ( diag < options->newtonHessDiagRegTolerance ) {
+					return QPDUNES_ERR_DIVISION_BY_ZERO;
+				}
+				#endif
+			}
+			else {
+				if ( diag < 1.e2*options->equalityTolerance ) {	/* matrix not positive definite */
+					return QPDUNES_ERR_DIVISION_BY_ZERO;
+				}
+			}
+			diag = sqrt( diag );
+			rowJ[jj] = diag;
+
+			if ( isDiagBlock == QPDUNES_TRUE )	continue;
+
+			/* remainder of jj-th row (leftwards) */
+			for( ii = 0; ii < jj; ++ii ) {
+				rowJ[ii] /= diag;
+			}
+			/* update of upper left part of lower triangle */
+			for( ii = 0; ii < jj; ++ii ) {
+				SIMD_NAME(axpy)( ii+1, rowJ[ii], rowJ, SIMD_ROW( chol, kk, 0, ii ) );
+			}
+		}
+
+		/* 3) sub-diagonal block of this block row X = L_kk^-T * H_{k,k-1} */
+		if ( kk > 0 ) {
+			for( ii = 0; ii < nX; ++ii ) {
+				rowI = SIMD_ROW( chol, kk, -1, ii );
+				for( jj = 0; jj < nX; ++jj ) {
+					rowI[jj] = SIMD_ROW( hess, kk, -1, ii )[jj];
+				}
+			}
+			for( jj = nX-1; jj >= 0; --jj ) {
+				rowJ = SIMD_ROW( chol, kk, -1, jj );
+				diag = SIMD_ROW( chol, kk, 0, jj )[jj];
+				for( ii = 0; ii < nX; ++ii ) {
+					rowJ[ii] /= diag;
+				}
+				if ( isDiagBlock == QPDUNES_FALSE ) {
+					for( ii = 0; ii < jj; ++ii ) {
+						SIMD_NAME(axpy)( nX, SIMD_ROW( chol, kk, 0, jj )[ii], rowJ, SIMD_ROW( chol, kk, -1, ii ) );
+					}
+				}
+			}
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF factorizeReverse */
+
+
+/* ----------------------------------------------
+ * Solve L*x = g block row by block row top down,
+ * in place on res (x may be g)
+ *
+ >>>>>                                            */
+SIMD_FUNCTION void SIMD_NAME(solveL)(	real_t* const res,
+										const real_t* const chol,
+										const sparsityType_t* const blockSparsity,
+										const real_t* const rhs,
+										int_t nI,
+										int_t nX,
+										const nhLayout_t* const layout,
+										const real_t* const maxDiag )	/**< if given, unknowns with larger diagonal element are set to zero */
+{
+	int_t ii, kk;
+	real_t sum;
+	const real_t* rowI;
+
+	for( kk = 0; kk < nI; ++kk ) {
+		for( ii = 0; ii < nX; ++ii ) {
+			sum = rhs[kk*nX+ii];
+			if ( kk > 0 ) {
+				sum -= SIMD_NAME(dot)( nX, SIMD_ROW( chol, kk, -1, ii ), &(res[(kk-1)*nX]) );
+			}
+			rowI = SIMD_ROW( chol, kk, 0, ii );
+			if ( blockSparsity[kk] != QPDUNES_DIAGONAL ) {
+				sum -= SIMD_NAME(dot)( ii, rowI, &(res[kk*nX]) );
+			}
+
+			if ( ( maxDiag != 0 ) && ( rowI[ii] > *maxDiag ) ) {	/* dual direction regularized away */
+				res[kk*nX+ii] = 0.;
+			}
+			else {
+				res[kk*nX+ii] = sum / rowI[ii];
+			}
+		}
+	}
+}
+/*<<< END OF solveL */
+
+
+/* ----------------------------------------------
+ * Solve L'*x = g block row by block row bottom
+ * up, in place on res (x may be g)
+ *
+ >>>>>                                            */
+SIMD_FUNCTION void SIMD_NAME(solveLT)(	real_t* const res,
+										const real_t* const chol,
+										const sparsityType_t* const blockSparsity,
+										const real_t* const rhs,
+										int_t nI,
+										int_t nX,
+										const nhLayout_t* const layout )
+{
+	int_t ii, kk, ll;
+	const real_t* rowI;
+
+	if ( res != rhs ) {
+		for( ii = 0; ii < nI*nX; ++ii ) {
+			res[ii] = rhs[ii];
+		}
+	}
+
+	for( kk = nI-1; kk >= 0; --kk ) {
+		/* subtract contribution of already resolved block */
+		if ( kk < nI-1 ) {
+			for( ll = 0; ll < nX; ++ll ) {
+				SIMD_NAME(axpy)( nX, res[(kk+1)*nX+ll], SIMD_ROW( chol, kk+1, -1, ll ), &(res[kk*nX]) );
+			}
+		}
+		/* backsolve with transposed diagonal block, column oriented */
+		for( ii = nX-1; ii >= 0; --ii ) {
+			rowI = SIMD_ROW( chol, kk, 0, ii );
+			res[kk*nX+ii] /= rowI[ii];
+			if ( blockSparsity[kk] != QPDUNES_DIAGONAL ) {
+				SIMD_NAME(axpy)( ii, res[kk*nX+ii], rowI, &(res[kk*nX]) );
+			}
+		}
+	}
+}
+/*<<< END OF solveLT */
+
+
+/* ----------------------------------------------
+ * Newton step for forward factor H = L*L'
+ *
+ >>>>>                                            */
+SIMD_FUNCTION void SIMD_NAME(solveForward)(	real_t* const res,
+											const real_t* const chol,
+											const sparsityType_t* const blockSparsity,
+											const real_t* const gradient,
+											int_t nI,
+											int_t nX,
+											const nhLayout_t* const layout,
+											const qpOptions_t* const options )
+{
+	SIMD_NAME(solveL)( res, chol, blockSparsity, gradient, nI, nX, layout, &(options->QPDUNES_INFTY) );
+	SIMD_NAME(solveLT)( res, chol, blockSparsity, res, nI, nX, layout );
+}
+/*<<< END OF solveForward */
+
+
+/* ----------------------------------------------
+ * Newton step for bottom-up factor H = L'*L
+ *
+ >>>>>                                            */
+SIMD_FUNCTION void SIMD_NAME(solveReverse)(	real_t* const res,
+											const real_t* const chol,
+											const sparsityType_t* const blockSparsity,
+											const real_t* const gradient,
+											int_t nI,
+											int_t nX,
+											const nhLayout_t* const layout )
+{
+	SIMD_NAME(solveLT)( res, chol, blockSparsity, gradient, nI, nX, layout );
+	SIMD_NAME(solveL)( res, chol, blockSparsity, res, nI, nX, layout, 0 );
+}
+/*<<< END OF solveReverse */
+
+
+#undef SIMD_ROW
+
+
+/*
+ *	end of file
+ */
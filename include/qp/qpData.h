@@ -200,6 +200,7 @@ typedef struct
 {
 	qpoases_t* qpoases;
 	qpoasesOptions_t* options;
+	boolean_t isBoundsOnly;		/**< qpoases is a LoggedQProblemB (stage without affine constraints), else a LoggedSQProblem */
 } qpoasesObject_t;
 
 
@@ -243,6 +244,89 @@ typedef struct
 } qpSolverClipping_t;
 
 
+/**
+ *	\brief struct with auxiliary data for dense box QP solver
+ *
+ *	Parametric active-set solver for stage QPs with a dense Hessian and
+ *	simple bounds only. The Cholesky factor of the Hessian block of the free
+ *	variables is kept up to date by row appends and rank-one updates along
+ *	the homotopy, and serves for the projected Hessian Z (Z'HZ)^-1 Z' in the
+ *	Newton system.
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	vv_matrix_t cholHFree;		/**< Cholesky factor of Z'HZ (lower triangular, row stride nV) */
+	vv_matrix_t ZT;				/**< null space basis of the active bounds (transposed): unit vectors of the free variables */
+	intVector_t freeIdx;		/**< indices of the free variables, in order of cholHFree */
+	intVector_t actSet;			/**< bound status: -1 lower bound active, +1 upper bound active, 0 free */
+	int_t nFree;				/**< number of free variables */
+
+	z_vector_t zCur;			/**< primal solution for qCur */
+	z_vector_t qCur;			/**< linear term the active set and factorization are valid for */
+
+	z_vector_t qFullStep;		/**< linear term corresponding to full-step in lambda */
+	real_t pFullStep;			/**< constant term corresponding to full-step in lambda */
+
+	/* workspace */
+	z_vector_t qTarget;			/**< end point of homotopy */
+	z_vector_t dq;				/**< homotopy direction in linear term */
+	z_vector_t dz;				/**< homotopy direction in primal variables */
+	z_vector_t wFree;			/**< free variable workspace for backsolves */
+} qpSolverBoxQp_t;
+
+
+/**
+ *	\brief interval data registered in user memory
+ *
+ *	Data fields of an interval can point to memory owned by the user
+ *	(see qpDUNES_registerIntervalData); the solver-owned storage of these
+ *	fields is kept here and restored on unregistration.
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	int_t fields;		/**< bit mask of registered fields (dataField_t) */
+
+	real_t* H;			/**< solver-owned Hessian storage */
+	real_t* g;			/**< solver-owned gradient storage */
+	real_t* C;			/**< solver-owned dynamics matrix storage */
+	real_t* c;			/**< solver-owned dynamics constant storage */
+	real_t* zLow;		/**< solver-owned lower variable bound storage */
+	real_t* zUpp;		/**< solver-owned upper variable bound storage */
+	real_t* D;			/**< solver-owned constraint matrix storage */
+	real_t* dLow;		/**< solver-owned constraint lower bound storage */
+	real_t* dUpp;		/**< solver-owned constraint upper bound storage */
+} registeredData_t;
+
+
+/**
+ *	\brief stage Hessian factor shared by stages with equal Hessian
+ *
+ *	Entries are found by a hash of dimension, sparsity type and data of the
+ *	stage Hessian and checked against a copy of that Hessian. The factor is
+ *	kept in the cholH storage of one of the stages using it, see
+ *	qpDUNES_factorizeStageHessian.
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	uint_t hash;					/**< hash of dimension, sparsity type and data of the stage Hessian */
+	int_t nV;						/**< dimension of the stage Hessian */
+	vv_matrix_t key;				/**< copy of the stage Hessian the factor was computed from */
+	sparsityType_t sparsityType;	/**< sparsity type of the factor */
+	real_t* data;					/**< factor, held in the cholH storage of one of the stages using it (0 = entry unused) */
+	int_t nRefs;					/**< number of stages using the factor */
+	uint_t generation;				/**< incremented whenever the entry is filled with a new factor */
+
+	int_t newtonDiagStage;			/**< first stage using the factor in the current unconstrained Newton Hessian setup */
+	int_t newtonSubDiagStage;		/**< same, among stages with a sub-diagonal block */
+} factorCacheEntry_t;
+
+
 /**
  *	\brief Hessian interval data type and dynamic constraint interval data type
  *
@@ -310,9 +394,12 @@ typedef struct
 
 	qpSolverClipping_t qpSolverClipping;	/**< workspace for clipping QP solver */
 	qpSolverQpoases_t qpSolverQpoases;		/**< pointer to qpOASES object */
+	qpSolverBoxQp_t qpSolverBoxQp;			/**< workspace for dense box QP solver */
 
 	boolean_t rebuildHessianBlock;				/**< indicator flag whether an active set change occurred on this
 										     	 interval during the current iteration */
+	intVector_t hessianActSet;					/**< bound activity (1 = active) the Newton Hessian blocks of this
+												 interval are currently built for (clipping and box QP solver only) */
 
 
 	/* memory for objective function parameterization (used optionally in line search) */
@@ -322,8 +409,6 @@ typedef struct
 	large_vector_t parametricObjFctn_fPrimePrime;
 	int_t parametricObjFctn_nBasePoints;
 
-	large_vector_t parametricObjFctn_fSum;			/**< full dual objective value at alpha values of this stage */
-
 
 	/* workspace */
 	x_vector_t lambdaK;		/**<  */
@@ -333,6 +418,14 @@ typedef struct
 	u_vector_t uVecTmp;			/**<  */
 	z_vector_t zVecTmp;			/**<  */
 
+
+	/* data registered in user memory */
+	registeredData_t registeredData;	/**< solver-owned storage of fields that currently point to user memory */
+
+	/* shared Hessian factor */
+	factorCacheEntry_t* factorCacheEntry;	/**< factor cache entry holding cholH (0 = cholH in own storage) */
+	real_t* cholHStorage;					/**< stage-owned cholH storage */
+
 } interval_t;
 
 
@@ -391,6 +484,13 @@ typedef struct
 	real_t regParam;					/**< Levenberg-Marquardt relaxation parameter */
 
 	nwtnHssnFacAlg_t nwtnHssnFacAlg;
+	nwtnHssnLayout_t nwtnHssnLayout;	/**< storage layout of the Newton Hessian and its factors */
+	int_t nwtnHssnMaxRankUpdates;		/**< maximum number of bound changes per iteration that are applied as rank-one
+											 modifications of Newton Hessian and factor instead of block rebuild and
+											 refactorization (clipping stages with diagonal Hessian only; 0 = off);
+											 downdates of an ill-conditioned factor lose accuracy against refactorization */
+	int_t nwtnHssnMemoSize;				/**< number of stage contributions to the Newton Hessian kept for recurring active
+											 sets (clipping and box QP stages with shared factors only; 0 = off) */
 
 	/* line search options */
 	lineSearchType_t lsType;
@@ -402,6 +502,21 @@ typedef struct
 	real_t lineSearchMaxStepSize;
 	int_t lineSearchNbrGridPoints;		/**< number of grid points for grid line search */
 
+	/* memory options */
+	stageDataLayout_t stageDataLayout;	/**< storage layout of the interval data (dynamic memory version: needs the memory arena) */
+
+	/* parallelization options */
+	int_t nThreads;						/**< size of the OpenMP thread team (0 = OpenMP default); ignored in serial builds */
+
+	/* kernel options */
+	boolean_t useSmallKernels;			/**< use dense stage kernels specialized for the problem dimensions, if available */
+	boolean_t useSimdNewtonKernels;		/**< use vectorized Newton system factorization and solves, if supported by the CPU */
+	boolean_t useSimdClippingKernels;	/**< use vectorized saturation and ratio tests in clipping stage QPs, if supported by the CPU */
+
+	/* stage QP solver options */
+	boolean_t useBoxQpSolver;			/**< solve stage QPs with dense Hessian and simple bounds only by the box QP solver instead of qpOASES */
+	boolean_t shareStageFactors;		/**< stages with equal Hessian share one Hessian factor (clipping and box QP solver only) */
+
 	/* qpOASES options */
 	real_t qpOASES_terminationTolerance;
 
@@ -443,6 +558,7 @@ typedef struct
 	/* timings */
 	real_t tIt;
 	real_t tNwtnSetup;
+	real_t tNwtnFactor;
 	real_t tNwtnSolve;
 	real_t tQP;
 	real_t tLineSearch;
@@ -457,6 +573,9 @@ typedef struct
 	uint_t nActConstr;
 	uint_t nChgdConstr;
 	int_t hessRefactorIdx;
+	int_t nRefactoredBlocks;		/**< number of Newton Hessian factor blocks recomputed in this iteration */
+	int_t nNewtonMemoHits;			/**< stage contributions to the Newton Hessian found in the memo in this iteration */
+	int_t nNewtonMemoMisses;		/**< stage contributions to the Newton Hessian computed in this iteration */
 
 
 	/* flags, etc. */
@@ -501,6 +620,259 @@ typedef struct
 
 
 
+/**
+ *	\brief per-thread workspace
+ *
+ *	Scratch memory for stage loops that run in parallel; each thread of
+ *	the team works on its own instance, indexed by qpDUNES_getThreadNum().
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	x_vector_t xVecTmp;			/**<  */
+	u_vector_t uVecTmp;			/**<  */
+	z_vector_t zVecTmp;			/**<  */
+
+	xx_matrix_t xxMatTmp;		/**<  */
+	xx_matrix_t xxMatTmp2;		/**<  */
+	ux_matrix_t uxMatTmp;		/**<  */
+	xz_matrix_t xzMatTmp;		/**<  */
+	zx_matrix_t zxMatTmp;		/**<  */
+
+} threadWorkspace_t;
+
+
+
+/**
+ *	\brief storage layout of the Newton Hessian and its factors
+ *
+ *	Element (I,J) of block L (0 = diagonal, -1 = sub-diagonal) of block row K
+ *	is stored at K*blockRowStride + (1+L)*blockStride + I*rowStride + J (see
+ *	accHessian). The strides follow from options.nwtnHssnLayout and are set
+ *	in qpDUNES_setup.
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	int_t rowStride;		/**< distance of consecutive rows of a block */
+	int_t blockStride;		/**< distance of sub-diagonal and diagonal block of a block row */
+	int_t blockRowStride;	/**< distance of consecutive block rows */
+} nhLayout_t;
+
+
+
+/**
+ *	\brief dense kernels specialized for small stage dimensions
+ *
+ *	Function pointers to versions of the hot dense stage kernels with
+ *	problem dimensions nX and nU fixed at compile time (see
+ *	matrix_vector_small.h). They are chosen once in qpDUNES_setup; null
+ *	pointers select the generic kernels in matrix_vector.c.
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	/** res = C*z */
+	void (*multiplyCz)( real_t* const res, const real_t* const C, const real_t* const z );
+
+	/** res = C.T*y */
+	void (*multiplyCTy)( real_t* const res, const real_t* const C, const real_t* const y );
+
+	/** solve L*res = C.T for dense lower triangular nZ x nZ L; FALSE on zero pivot */
+	boolean_t (*backsolveCT)( real_t* const res, const real_t* const L, const real_t* const C, real_t zeroTol );
+
+	/** res += sum of dyadic products of rows of Z (nZ x nX) whose bounds in y are inactive */
+	void (*addMaskedZTZ)( real_t* const res, const real_t* const Z, const real_t* const y, real_t activeTol );
+
+	/** res += sum of dyadic products of columns of C and rows of Z whose bounds in y are inactive */
+	void (*addMaskedCZ)( real_t* const res, const real_t* const C, const real_t* const Z, const real_t* const y, real_t activeTol );
+
+	/** res (+)= M1.T*M2 for M1, M2 of size nRows x nX */
+	void (*multiplyZxTZx)( real_t* const res, const real_t* const M1, const real_t* const M2, int_t nRows, boolean_t addToRes );
+
+	/** dense Cholesky factorization of nZ x nZ matrix M; FALSE if M is not positive definite */
+	boolean_t (*choleskyZZ)( real_t* const cholM, const real_t* const M, real_t zeroTol );
+
+} smallKernels_t;
+
+
+
+/**
+ *	\brief vectorized Newton system kernels
+ *
+ *	Function pointers to AVX2/AVX-512 versions of the forward and bottom-up
+ *	band Cholesky factorization of the Newton Hessian and the corresponding
+ *	solves (see newton_system_simd.h). They are chosen once in qpDUNES_setup
+ *	by CPU feature detection; null pointers select the scalar versions in
+ *	dual_qp.c.
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	/** H = L*L'; tmp is workspace of size 2*nX*nX+nX */
+	return_t (*factorizeForward)( real_t* const chol, sparsityType_t* const blockSparsity, const real_t* const hess, real_t* const tmp, int_t nI, int_t nX, const nhLayout_t* const layout, const qpOptions_t* const options, boolean_t* const isHessianRegularized );
+
+	/** H = L'*L, restarted at block row blockIdxStart */
+	return_t (*factorizeReverse)( real_t* const chol, sparsityType_t* const blockSparsity, const real_t* const hess, int_t nI, int_t nX, const nhLayout_t* const layout, int_t blockIdxStart, const qpOptions_t* const options, boolean_t* const isHessianRegularized );
+
+	/** solve L*L'*res = gradient */
+	void (*solveForward)( real_t* const res, const real_t* const chol, const sparsityType_t* const blockSparsity, const real_t* const gradient, int_t nI, int_t nX, const nhLayout_t* const layout, const qpOptions_t* const options );
+
+	/** solve L'*L*res = gradient */
+	void (*solveReverse)( real_t* const res, const real_t* const chol, const sparsityType_t* const blockSparsity, const real_t* const gradient, int_t nI, int_t nX, const nhLayout_t* const layout );
+
+} newtonKernels_t;
+
+
+/**
+ *	\brief vectorized clipping stage QP kernels
+ *
+ *	Function pointers to AVX2/AVX-512 versions of the saturation, step size
+ *	and ratio test loops of the clipping stage QP solver (see
+ *	stage_qp_solver_clipping_simd.h), chosen in qpDUNES_setup like the
+ *	Newton system kernels. Multipliers mu are (lower, upper) gap pairs as in
+ *	interval_t::y.
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	/** saturate vec to [lb,ub]; gaps scaled by hDiag (null pointer: identity Hessian) */
+	void (*saturate)( real_t* const vec, real_t* const mu, const real_t* const lb, const real_t* const ub, const real_t* const hDiag, int_t nV, real_t activenessTolerance );
+
+	/** shorten alphaMin to the first active set change along dz */
+	void (*minStepsize)( const real_t* const mu, const real_t* const dz, int_t nV, real_t infty, real_t* const alphaMin );
+
+	/** minimum step size along zStepDir that activates a finite bound */
+	void (*ratioTest)( real_t* const minStepSizeASChange, const real_t* const zStepDir, const real_t* const mu, const real_t* const lb, const real_t* const ub, int_t nV, real_t equalityTolerance, real_t infty );
+
+} clippingKernels_t;
+
+
+
+/**
+ *	\brief memory block holding all solver data of one QP
+ *
+ *	Solver data is placed one block after the other in the order of
+ *	allocation in qpDUNES_setup, i.e., stage by stage. The block is either
+ *	supplied by the user or allocated in qpDUNES_setup with the size from
+ *	qpDUNES_memoryRequirement. Memory of the qpOASES and box QP stage
+ *	solvers is only allocated for the stages that select them, in
+ *	qpDUNES_setupAllLocalQPs, from the end of the block, which is sized for
+ *	the worst case. Only the qpOASES objects themselves live on the heap.
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	char* buffer;			/**< start of memory block, aligned to QPDUNES_MEMORY_ALIGNMENT */
+	uint_t size;			/**< size of memory block in bytes */
+	uint_t used;			/**< bytes handed out so far */
+	boolean_t isOwned;		/**< memory block was allocated by qpDUNES_setup and is released in qpDUNES_cleanup */
+	boolean_t isExhausted;	/**< a request did not fit into the memory block */
+} memoryArena_t;
+
+
+
+/**
+ *	\brief cache of stage Hessian factors
+ *
+ *	Holds at most one entry per stage. Stages sharing a factor and having
+ *	equal dynamics also have equal unconstrained Newton Hessian blocks, which
+ *	are then computed only once.
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	factorCacheEntry_t* entries;	/**< nI+1 entries (0 = stage factors are not shared) */
+	real_t* keys;					/**< storage of the Hessian copies of all entries */
+	intVector_t newtonBlockSource;	/**< stage each diagonal (first nI) and sub-diagonal (last nI) unconstrained Newton block is copied from */
+
+	int_t nFactorizations;			/**< stage Hessian factorizations */
+	int_t nSharedFactors;			/**< stage Hessians whose factor was found in the cache */
+	int_t nSharedNewtonBlocks;		/**< unconstrained Newton blocks copied in the last setup instead of computed */
+} factorCache_t;
+
+
+
+/**
+ *	\brief stage contribution to the Newton Hessian for one active set
+ *
+ *	For a stage with projected inverse Hessian P (depending on the stage
+ *	Hessian and the active bounds only) the blocks E P E', C P C' and C P E'
+ *	(the latter two are not used for the final stage). C P C' is kept as a
+ *	factor, such that it is added onto E P E' of the next stage in the same
+ *	order as without the memo.
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	const factorCacheEntry_t* factor;	/**< shared Hessian factor of the stage (0 = slot unused) */
+	uint_t factorGeneration;			/**< generation of the factor when the slot was filled */
+	uint_t hash;						/**< hash of factor and active set */
+	boolean_t hasC;						/**< contribution of a stage with dynamics (not the final stage) */
+	xz_matrix_t C;						/**< copy of the dynamics of the stage */
+	uint_t* actSet;						/**< active set bitmask */
+
+	xx_matrix_t EPE;
+	zx_matrix_t CPCFactor;				/**< factor Z of C P C' (Z'Z, or C Z for diagonal clipping stage Hessians), see getMatrixInvMatrixMatrixTFactor */
+	int_t nFree;						/**< number of rows of CPCFactor on box QP stages */
+	xx_matrix_t CPE;
+
+	uint_t lastUse;						/**< setup counter value of the last use, for least recently used replacement */
+	int_t fillStage;					/**< stage that computes the blocks in the current setup (-1 = blocks valid) */
+} newtonMemoSlot_t;
+
+
+/**
+ *	\brief memo of stage contributions to the Newton Hessian
+ *
+ *	Stage contributions of clipping and box QP stages with shared Hessian
+ *	factor are kept for the last few active sets, such that recurring active
+ *	sets (typical for steady-state MPC) do not require the matrix products
+ *	in qpDUNES_setupNewtonSystem. See qpDUNES_lookupNewtonMemo.
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	newtonMemoSlot_t* slots;		/**< options.nwtnHssnMemoSize slots (0 = memo off) */
+	int_t nSlots;
+	int_t nActSetWords;				/**< length of the active set bitmasks */
+	real_t* blocks;					/**< storage of the blocks and dynamics of all slots */
+	uint_t* actSets;				/**< storage of the active set bitmasks of all slots and of one lookup key */
+	intVector_t stageSlot;			/**< slot of the contribution of each stage in the current setup (-1 = not memoized) */
+	uint_t clock;					/**< number of setups using the memo */
+
+	int_t nHits;					/**< stage contributions found in the memo since setup */
+	int_t nMisses;					/**< stage contributions computed since setup */
+} newtonMemo_t;
+
+
+
+/**
+ *	\brief memory of one stage, see qpDUNES_getMemoryReport
+ *
+ *	Bytes are the sizes of the arrays and structs of a stage, without
+ *	alignment padding.
+ *
+ *	\version 1.0beta
+ */
+typedef struct
+{
+	qp_solver_t qpSolverSpecification;	/**< stage QP solver selected for the stage */
+	uint_t dataBytes;					/**< interval data every stage holds, incl. the clipping solver workspace */
+	uint_t solverBytes;					/**< memory of the selected qpOASES or box QP solver, incl. the homotopy log */
+} stageMemoryReport_t;
+
+
+
 /**
  *	\brief ...
  *
@@ -524,13 +896,37 @@ typedef struct
 	xn_vector_t lambda;
 	xn_vector_t deltaLambda;
 
+	nhLayout_t nhLayout;			/**< storage layout of all Newton Hessian type matrices below */
 	xn2x_matrix_t hessian;
 	xn2x_matrix_t cholHessian;
 	xn_vector_t gradient;
+	xn_vector_t gradientCache;			/**< dual gradient at step size gradientCacheAlpha, left by the line search */
 
 	xn2x_matrix_t unconstrainedHessian;
 	xn2x_matrix_t cholUnconstrainedHessian;
 
+	xn2x_matrix_t cyclicReductionTmp;	/**< eliminated blocks' coupling terms D^-1*L and L*D^-1 of one cyclic reduction level */
+	large_vector_t cyclicReductionRhs;	/**< right hand sides of all cyclic reduction levels */
+	large_vector_t newtonKernelTmp;		/**< workspace of vectorized forward factorization */
+	large_vector_t lineSearchBreakpoints;	/**< (alpha, curvature change) pairs of the piecewise quadratic line search */
+	large_vector_t lineSearchGrid;			/**< step sizes and objective values of the grid line search */
+	large_vector_t lineSearchStageObjVals;	/**< stage objective values at all grid points, one row per stage */
+	large_vector_t homotopyBreakpoints;		/**< homotopy breakpoints of all stages, merge source and target buffer */
+	intVector_t homotopyBreakpointIdx;		/**< stage and section of each homotopy breakpoint, same layout */
+	intVector_t homotopyRunStart;			/**< offset of each stage's breakpoints in the merge buffers */
+
+	int_t cholHessianTwistIdx;					/**< block row in which the two halves of a twisted cholHessian meet (-1 = not factorized yet) */
+	int_t cholUnconstrainedHessianTwistIdx;		/**< same for cholUnconstrainedHessian */
+
+	sparsityType_t* cholHessianBlockSparsity;					/**< per block row: QPDUNES_DIAGONAL if the diagonal block of the (band) factor is diagonal, QPDUNES_DENSE otherwise */
+	sparsityType_t* cholUnconstrainedHessianBlockSparsity;		/**< same for cholUnconstrainedHessian */
+
+	boolean_t isCholHessianUpdatable;	/**< cholHessian is an unregularized factor of hessian, low-rank modifications can be applied */
+	boolean_t isCholHessianUpToDate;	/**< cholHessian was modified along with hessian, no refactorization needed */
+
+	real_t gradientCacheAlpha;			/**< step size of gradientCache and of the trial primal variables in interval->zVecTmp (-1 = none) */
+	boolean_t isGradientCacheValid;		/**< gradientCache is the dual gradient at the current lambda */
+
 //	int_t* ieqStatus;
 //	int_t* prevIeqStatus;
 
@@ -563,6 +959,22 @@ typedef struct
 	zz_matrix_t zzMatTmp;		/**<  */
 	zz_matrix_t zzMatTmp2;		/**<  */
 
+	/* thread team */
+	int_t nThreads;							/**< number of threads used in parallel stage loops */
+	threadWorkspace_t* threadWorkspace;		/**< one workspace per thread */
+
+	/* dense stage kernels */
+	smallKernels_t smallKernels;			/**< kernels specialized for nX, nU (null pointers: generic kernels) */
+	newtonKernels_t newtonKernels;			/**< vectorized Newton system kernels (null pointers: scalar versions) */
+	clippingKernels_t clippingKernels;		/**< vectorized clipping stage QP kernels (null pointers: scalar versions) */
+
+	/* shared stage Hessian factors */
+	factorCache_t factorCache;				/**< factors of equal stage Hessians, see qpDUNES_factorizeStageHessian */
+	newtonMemo_t newtonMemo;				/**< stage contributions to the Newton Hessian for recurring active sets */
+
+	/* memory */
+	memoryArena_t arena;					/**< memory block holding the solver data of this QP (dynamic memory version) */
+
 	/* log */
 	log_t log;
 
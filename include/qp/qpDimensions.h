@@ -38,16 +38,40 @@
 #ifndef QPDIMENSIONS_H_
 #define QPDIMENSIONS_H_
 
-#assert defined(__STATIC_MEMORY__)
+#if !defined(__STATIC_MEMORY__)
+	#error "qpDimensions.h is only used in the static memory version of qpDUNES"
+#endif
 
 
-/* Define the QP problem's dimensions below */
-#define _NX_ 3				/* the number of states */
-#define _NU_ 1				/* the number of controls */
-#define _NZ_ (_NX_+_NU_)	/* the number of stage variables */
-#define _NI_ 10				/* the number of control intervals */
-#define _NDMAX_ 10			/* the maximum number of affine stage constraints over all stages */
-#define _NDTTL_ 100			/* the total number of affine stage constraints summed over all stages */
+/* Define the QP problem's dimensions below; all of them can be overridden by compiler definitions */
+#ifndef _NX_
+	#define _NX_ 3				/* the number of states */
+#endif
+#ifndef _NU_
+	#define _NU_ 1				/* the number of controls */
+#endif
+#define _NZ_ (_NX_+_NU_)		/* the number of stage variables */
+#ifndef _NI_
+	#define _NI_ 10				/* the number of control intervals */
+#endif
+#ifndef _NDMAX_
+	#define _NDMAX_ 10			/* the maximum number of affine stage constraints over all stages */
+#endif
+
+
+/* Upper limits on solver options that determine the memory size */
+#ifndef _NTHREADSMAX_
+	#define _NTHREADSMAX_ 1				/* the maximum number of threads in parallel stage loops */
+#endif
+#ifndef _NQPOASESITERMAX_
+	#define _NQPOASESITERMAX_ 100		/* the maximum number of qpOASES working set recalculations */
+#endif
+#ifndef _NGRIDPOINTSMAX_
+	#define _NGRIDPOINTSMAX_ 10			/* the maximum number of grid line search points */
+#endif
+#ifndef _NNEWTONMEMOMAX_
+	#define _NNEWTONMEMOMAX_ 0			/* the maximum number of memoized stage contributions to the Newton Hessian */
+#endif
 
 
 #endif /* QPDIMENSIONS_H_ */
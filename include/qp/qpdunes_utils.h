@@ -63,7 +63,8 @@
  *	\version 1.0beta
  *	\date 2012
  */
-void qpDUNES_free(	real_t** data
+void qpDUNES_free(	memoryArena_t* const arena,
+					real_t** data
 				);
 
 
@@ -76,10 +77,152 @@ void qpDUNES_free(	real_t** data
  *	\version 1.0beta
  *	\date 2012
  */
-void qpDUNES_intFree(	int_t** data
+void qpDUNES_intFree(	memoryArena_t* const arena,
+						int_t** data
 					);
 
 
+/**
+ *	\brief zero-initialized memory allocation for solver data
+ *
+ *	Takes the memory from the given arena in the dynamic memory version and
+ *	from the static memory pool otherwise. Passing 0 as arena, or an arena
+ *	without memory block, allocates on the heap. If a memory block that
+ *	qpDUNES allocated itself is full, the heap is used as well; a full
+ *	user-supplied memory block is an error. Returns 0 if no memory is left.
+ */
+void* qpDUNES_calloc(	memoryArena_t* const arena,
+						uint_t num,
+						uint_t size
+						);
+
+
+/**
+ *	\brief free memory obtained from qpDUNES_calloc
+ *
+ *	Memory within the arena is released with the arena as a whole. Does
+ *	nothing in the static memory version.
+ */
+void qpDUNES_freeMemory(	memoryArena_t* const arena,
+							void* data
+							);
+
+
+/**
+ *	\brief zero-initialized memory allocation aligned to QPDUNES_MEMORY_ALIGNMENT
+ *
+ *	Like qpDUNES_calloc, but the returned block starts on a full cache line.
+ *	Has to be released with qpDUNES_freeAligned.
+ */
+void* qpDUNES_callocAligned(	memoryArena_t* const arena,
+								uint_t num,
+								uint_t size
+								);
+
+
+/**
+ *	\brief free memory obtained from qpDUNES_callocAligned
+ */
+void qpDUNES_freeAligned(	memoryArena_t* const arena,
+							real_t** data
+							);
+
+
+/**
+ *	\brief free memory obtained from qpDUNES_callocAligned
+ *
+ *	Version of qpDUNES_freeAligned for data of any type.
+ */
+void qpDUNES_freeAlignedMemory(	memoryArena_t* const arena,
+								void* data
+								);
+
+
+/**
+ *	\brief add a memory block of num*size bytes to memorySize
+ *
+ *	Accounts for the padding qpDUNES_calloc inserts in a memory arena, such
+ *	that a sequence of calls mirroring a sequence of qpDUNES_calloc calls
+ *	yields the arena size needed.
+ */
+void qpDUNES_reserveMemory(	uint_t* const memorySize,
+							uint_t num,
+							uint_t size
+							);
+
+
+/**
+ *	\brief add a memory block of num*size bytes to memorySize
+ *
+ *	Same as qpDUNES_reserveMemory for qpDUNES_callocAligned.
+ */
+void qpDUNES_reserveMemoryAligned(	uint_t* const memorySize,
+									uint_t num,
+									uint_t size
+									);
+
+
+#if !defined(__STATIC_MEMORY__)
+/**
+ *	\brief zero-initialized memory block from a memory arena
+ *
+ *	Returns 0 if the arena has no memory block or the block is full; the
+ *	latter is recorded in arena->isExhausted.
+ */
+void* qpDUNES_arenaCalloc(	memoryArena_t* const arena,
+							uint_t nBytes,
+							uint_t alignment
+							);
+
+
+/**
+ *	\brief check whether data lies within the memory block of an arena
+ */
+boolean_t qpDUNES_isArenaMemory(	const memoryArena_t* const arena,
+									const void* const data
+									);
+#endif
+
+
+#if defined(__STATIC_MEMORY__)
+/**
+ *	\brief release the whole static memory pool for a new setup
+ *
+ *	\version 1.0beta
+ */
+void qpDUNES_resetStaticMemory( void );
+
+
+/**
+ *	\brief number of bytes currently taken from the static memory pool
+ *
+ *	\version 1.0beta
+ */
+uint_t qpDUNES_getStaticMemoryUsage( void );
+#endif
+
+
+
+/**
+ *	\brief index of the calling thread within the current thread team
+ *
+ *	Returns 0 outside of parallel regions and in serial builds.
+ *
+ *	\version 1.0beta
+ */
+int_t qpDUNES_getThreadNum( void );
+
+
+/**
+ *	\brief maximum number of threads a parallel region may use
+ *
+ *	Returns 1 in serial builds.
+ *
+ *	\version 1.0beta
+ */
+int_t qpDUNES_getMaxThreads( void );
+
+
 
 /**
  *	\brief ...
@@ -173,7 +316,8 @@ return_t qpDUNES_setupZeroMatrix(	int_t nRows,
  *	\version 1.0beta
  *	\date 2012
  */
-return_t qpDUNES_setMatrixNull(	matrix_t* matrix
+return_t qpDUNES_setMatrixNull(	memoryArena_t* const arena,
+								matrix_t* matrix
 								);
 
 
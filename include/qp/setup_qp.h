@@ -36,6 +36,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <assert.h>
 #include <qp/types.h>
 #if !defined(__STATIC_MEMORY__)
@@ -44,6 +45,11 @@
 	#include <qp/qpDataStatic.h>
 #endif
 #include <qp/matrix_vector.h>
+#include <qp/matrix_vector_small.h>
+#include <qp/newton_system_simd.h>
+#include <qp/stage_qp_solver_clipping_simd.h>
+#include <qp/stage_qp_solver_boxqp.h>
+#include <qp/factor_cache.h>
 #include <qp/qpdunes_utils.h>
 
 #include <qp/stage_qp_solver_qpoases.hpp>
@@ -58,6 +64,54 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 						);
 
 
+/** set up QP with all solver data in the given memory block of memorySize bytes, aligned to
+ *  QPDUNES_MEMORY_ALIGNMENT (memory = 0: allocate a block of qpDUNES_memoryRequirement bytes) */
+return_t qpDUNES_setupInMemory(	qpData_t* const qpData,
+								uint_t nI,
+								uint_t nX,
+								uint_t nU,
+								uint_t* nD,
+								qpOptions_t* options,
+								void* const memory,
+								uint_t memorySize
+								);
+
+
+/** set up nBatch QPs of equal dimensions in qpDataBatch[0..nBatch-1], see qpDUNES_solveBatch */
+return_t qpDUNES_setupBatch(	qpData_t* const qpDataBatch,
+								int_t nBatch,
+								uint_t nI,
+								uint_t nX,
+								uint_t nU,
+								uint_t* nD,
+								qpOptions_t* options
+								);
+
+
+void qpDUNES_setupDimensions(	qpData_t* const qpData,
+								uint_t nI,
+								uint_t nX,
+								uint_t nU,
+								const uint_t* const nD
+								);
+
+
+#if !defined(__STATIC_MEMORY__)
+/** size in bytes of the memory block for qpDUNES_setupInMemory */
+uint_t qpDUNES_memoryRequirement(	uint_t nI,
+									uint_t nX,
+									uint_t nU,
+									const uint_t* const nD,
+									const qpOptions_t* const options
+									);
+
+
+uint_t qpDUNES_getMemorySize(	const qpData_t* const qpData,
+								const uint_t* const nD
+								);
+#endif
+
+
 interval_t* qpDUNES_allocInterval(	qpData_t* const qpData,
 								uint_t nX,		/* FIXME: just use these temporary, work with nZ later on */
 								uint_t nU,		/* FIXME: just use these temporary, work with nZ later on */
@@ -66,19 +120,80 @@ interval_t* qpDUNES_allocInterval(	qpData_t* const qpData,
 								);
 
 
+void qpDUNES_getIntervalMemorySize(	uint_t* const memorySize,
+									uint_t nX,
+									uint_t nV,
+									uint_t nD
+									);
+
+
+void qpDUNES_allocIntervalsByField(	qpData_t* const qpData,
+									const uint_t* const nD
+									);
+
+
+void qpDUNES_getIntervalsByFieldMemorySize(	const qpData_t* const qpData,
+											uint_t* const memorySize
+											);
+
+
+/** allocate the qpOASES or box QP solver memory of an interval once its stage QP solver is selected */
+return_t qpDUNES_allocStageQpSolver(	qpData_t* const qpData,
+										interval_t* const interval
+										);
+
+
+void qpDUNES_getStageQpSolverMaxMemorySize(	const qpData_t* const qpData,
+											uint_t* const memorySize,
+											uint_t nV,
+											uint_t nD
+											);
+
+
+uint_t qpDUNES_getStageDataMemorySize(	const qpData_t* const qpData,
+										const interval_t* const interval
+										);
+
+
+uint_t qpDUNES_getStageQpSolverMemorySize(	const qpData_t* const qpData,
+											const interval_t* const interval
+											);
+
+
+/** memory per stage and stage QP solver (stageReports: nI+1 entries), after qpDUNES_setupAllLocalQPs */
+return_t qpDUNES_getMemoryReport(	const qpData_t* const qpData,
+									stageMemoryReport_t* const stageReports
+									);
+
+
+/** print memory per stage and totals per stage QP solver */
+void qpDUNES_printMemoryReport(	const qpData_t* const qpData
+								);
+
+
+uint_t qpDUNES_getCyclicReductionNumBlocks(	uint_t nI
+											);
+
+
+void qpDUNES_setupNewtonHessianLayout(	nhLayout_t* const layout,
+										uint_t nX,
+										nwtnHssnLayout_t layoutType
+										);
+
+
 return_t qpDUNES_cleanup(	qpData_t* const qpData
 							);
 
 
+return_t qpDUNES_cleanupBatch(	qpData_t* const qpDataBatch,
+								int_t nBatch
+								);
+
+
 void qpDUNES_freeInterval(	qpData_t* const qpData,
 						interval_t* const interval
 						);
 
-//void qpDUNES_indicateDataChange(	qpData_t* const qpData,
-//									interval_t* const interval
-//									);
-
-
 return_t qpDUNES_init(	qpData_t* const qpData,
 						const real_t* const H_,
 						const real_t* const g_,
@@ -199,6 +314,51 @@ return_t qpDUNES_updateIntervalData(	qpData_t* const qpData,
 										);
 
 
+return_t qpDUNES_updateIntervalQp(	qpData_t* const qpData,
+									interval_t* interval,
+									int_t changedData,
+									vv_matrix_t* const cholH
+									);
+
+
+/* ----------------------------------------------
+ * zero-copy data interface: data fields of an
+ * interval point to user memory, changes are
+ * indicated per interval and field
+ *
+ >>>>>>                                           */
+return_t qpDUNES_registerIntervalData(	qpData_t* const qpData,
+										interval_t* interval,
+										real_t* const H_,
+										sparsityType_t sparsityH,
+										real_t* const g_,
+										real_t* const C_,
+										real_t* const c_,
+										real_t* const zLow_,
+										real_t* const zUpp_,
+										real_t* const D_,
+										real_t* const dLow_,
+										real_t* const dUpp_
+										);
+
+
+return_t qpDUNES_unregisterIntervalData(	qpData_t* const qpData,
+											interval_t* interval
+											);
+
+
+void qpDUNES_releaseIntervalData(	qpData_t* const qpData,
+									interval_t* interval,
+									boolean_t keepData
+									);
+
+
+return_t qpDUNES_indicateDataChange(	qpData_t* const qpData,
+										interval_t* const interval,
+										int_t changedData
+										);
+
+
 /* ----------------------------------------------
  * first set up of local QP
  * 
@@ -229,6 +389,19 @@ return_t qpDUNES_setupQpoases(	qpData_t* const qpData,
 								);
 
 
+/* ----------------------------------------------
+ * initial setup and update of box QP stage
+ * solver; warm start keeps the active set and
+ * is only valid for unchanged H and bounds
+ *
+ >>>>>>                                           */
+return_t qpDUNES_setupBoxQpSolver(	qpData_t* const qpData,
+									interval_t* const interval,
+									boolean_t refactorHessian,
+									boolean_t warmStart
+									);
+
+
 /* ----------------------------------------------
  * (external) data update of qpOASES stage QP
  * solver
@@ -0,0 +1,157 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qp/stage_qp_solver_boxqp.h
+ *	\version 1.0beta
+ *
+ *	Parametric active-set solver for stage QPs with dense Hessian and simple
+ *	bounds. Along the homotopy in the linear term, bounds are added to and
+ *	removed from the active set by rank-one updates of the Cholesky factor of
+ *	the free Hessian block. The homotopy is logged in the same piecewise
+ *	quadratic format as the qpOASES homotopy, so the line search treats both
+ *	stage solvers alike.
+ */
+
+
+#ifndef QP42_STAGE_QP_SOLVER_BOXQP_H
+#define QP42_STAGE_QP_SOLVER_BOXQP_H
+
+
+#include <qp/types.h>
+#if !defined(__STATIC_MEMORY__)
+	#include <qp/qpData.h>
+#else
+	#include <qp/qpDataStatic.h>
+#endif
+#include <qp/matrix_vector.h>
+#include <qp/qpdunes_utils.h>
+
+
+/* ----------------------------------------------
+ * update linear and constant term for a full
+ * step in lambda
+ *
+ * qFullStep = q + C.T*lambdaK1 - [lambdaK.T 0]
+ * pFullStep = c*lambdaK1
+ *
+ *		                                           */
+return_t boxQpSolver_updateDualGuess(	qpData_t* const qpData,
+										interval_t* const interval,
+										const z_vector_t* const lambdaK,
+										const z_vector_t* const lambdaK1
+										);
+
+
+/* ----------------------------------------------
+ * solve stage QP for qFullStep; cold start from
+ * cholH with all non-fixed variables free, or
+ * warm start from the current active set (only
+ * valid if H and bounds did not change)
+ *
+ *		                                           */
+return_t boxQpSolver_setup(	qpData_t* const qpData,
+							interval_t* const interval,
+							boolean_t warmStart
+							);
+
+
+/* ----------------------------------------------
+ * follow the homotopy from the current linear
+ * term to qTarget; optionally log the piecewise
+ * quadratic stage objective along the way
+ * (from q to qFullStep)
+ *
+ *		                                           */
+return_t boxQpSolver_hotstart(	qpData_t* const qpData,
+								interval_t* const interval,
+								const z_vector_t* const qTarget,
+								int_t* const nActSetChanges,
+								boolean_t logHomotopy
+								);
+
+
+/* ----------------------------------------------
+ * do a step of length alpha from q towards
+ * qFullStep
+ *
+ *		                                           */
+return_t boxQpSolver_doStep(	qpData_t* const qpData,
+								interval_t* const interval,
+								real_t alpha,
+								z_vector_t* const z,
+								d2_vector_t* const mu,
+								z_vector_t* const qCandidate,
+								real_t* const p
+								);
+
+
+/** multipliers of the bounds in qpDUNES style for linear term q */
+return_t boxQpSolver_getDualSol(	qpData_t* const qpData,
+									interval_t* const interval,
+									const z_vector_t* const q,
+									d2_vector_t* const mu
+									);
+
+
+/** Cholesky factor of the projected Hessian Z'HZ (backsolveRT_ZTET format) */
+return_t boxQpSolver_getCholZTHZ(	qpData_t* const qpData,
+									interval_t* const interval,
+									zz_matrix_t* const cholZTHZ
+									);
+
+
+/** null space basis of the active bounds (transposed) */
+return_t boxQpSolver_getZT(	qpData_t* const qpData,
+							interval_t* const interval,
+							int_t* const nFree,
+							zz_matrix_t* const ZT
+							);
+
+
+/** add variable idx to the free variables; appends a row to cholHFree */
+return_t boxQpSolver_addFreeVariable(	qpData_t* const qpData,
+										interval_t* const interval,
+										int_t idx
+										);
+
+
+/** remove the free variable at position pos; rank-one update of cholHFree */
+return_t boxQpSolver_removeFreeVariable(	interval_t* const interval,
+											int_t pos
+											);
+
+
+/** solve (Z'HZ) x = b in place for b given in order of the free variables */
+void boxQpSolver_backsolveFree(	interval_t* const interval,
+								real_t* const b
+								);
+
+
+#endif	/* QP42_STAGE_QP_SOLVER_BOXQP_H */
+
+
+/*
+ *	end of file
+ */
@@ -73,6 +73,43 @@ return_t clippingQpSolver_getMinStepsize( 	const qpData_t* const qpData,
 											real_t* alphaMin );
 
 
+/* ----------------------------------------------
+ * collects the breakpoints of the piecewise
+ * quadratic stage dual function along dz in
+ * (0, alphaMax); adds slope and curvature at 0+
+ *
+ *		                                           */
+return_t clippingQpSolver_getBreakpoints(	const interval_t* const interval,
+											real_t alphaMax,
+											real_t* const breakpoints,
+											int_t* const nBreakpoints,
+											real_t* const slope,
+											real_t* const curvature
+											);
+
+
+/* ----------------------------------------------
+ * return stage dual function derivative at given
+ * alpha value along dz
+ *
+ *		                                           */
+real_t clippingQpSolver_getParametricObjFctnGrad(	const interval_t* const interval,
+													real_t alpha
+													);
+
+
+/* ----------------------------------------------
+ * return stage dual function second derivative at
+ * given alpha value along dz; at breakpoints, the
+ * one in given direction (+1: increasing alpha)
+ *
+ *		                                           */
+real_t clippingQpSolver_getParametricObjFctnHess(	const interval_t* const interval,
+													real_t alpha,
+													int_t direction
+													);
+
+
 /** ... */
 return_t directQpSolver_doStep( qpData_t* const qpData,
 								interval_t* const interval,
@@ -85,6 +122,13 @@ return_t directQpSolver_doStep( qpData_t* const qpData,
 								real_t* const p				);
 
 
+/** ... */
+return_t directQpSolver_doTrialStep( interval_t* const interval,
+									 const z_vector_t* const stepDir,
+									 real_t alpha,
+									 const z_vector_t* const zTry	);
+
+
 ///** ... */
 //return_t directQpSolver_tryStep( qpData_t* const qpData,
 //								 interval_t* const interval,
@@ -116,6 +160,15 @@ return_t clippingQpSolver_ratioTest(	qpData_t* const qpData,
 									);
 
 
+/** stage objective values for several step sizes, without modifying the interval */
+return_t directQpSolver_getParametricObjectiveValues(	qpData_t* const qpData,
+														const interval_t* const interval,
+														const real_t* const alphas,
+														real_t* const objVals,
+														int_t nAlphas
+														);
+
+
 /** ... */
 real_t directQpSolver_getObjectiveValue(	qpData_t* const qpData,
 												interval_t* const interval
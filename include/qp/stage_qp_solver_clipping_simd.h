@@ -0,0 +1,62 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qp42; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file include/qp/stage_qp_solver_clipping_simd.h
+ *	\version 1.0beta
+ *
+ *	Vectorized (AVX2/AVX-512) saturation, step size and ratio test kernels
+ *	of the clipping stage QP solver.
+ */
+
+
+#ifndef QP42_STAGE_QP_SOLVER_CLIPPING_SIMD_H
+#define QP42_STAGE_QP_SOLVER_CLIPPING_SIMD_H
+
+
+#include <qp/types.h>
+#if !defined(__STATIC_MEMORY__)
+	#include <qp/qpData.h>
+#else
+	#include <qp/qpDataStatic.h>
+#endif
+
+
+/** smallest stage dimension for which the vectorized kernels are used */
+#define QPDUNES_CLIPPING_SIMD_NZ_MIN	4
+
+
+/** select the vectorized clipping kernels supported by the CPU;
+ *  returns QPDUNES_FALSE and clears the kernel table if none is available */
+boolean_t qpDUNES_setupClippingKernels(	qpData_t* const qpData
+										);
+
+
+#endif	/* QP42_STAGE_QP_SOLVER_CLIPPING_SIMD_H */
+
+
+/*
+ *	end of file
+ */
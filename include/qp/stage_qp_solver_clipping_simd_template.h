@@ -0,0 +1,205 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qp42; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file include/qp/stage_qp_solver_clipping_simd_template.h
+ *	\version 1.0beta
+ *
+ *	Branchless saturation, step size and ratio test kernels of the clipping
+ *	stage QP solver for one instruction set. Included once per instruction
+ *	set by src/stage_qp_solver_clipping_simd.c, which defines
+ *
+ *	  SIMD_NAME(fn)      name of the instantiated function
+ *	  SIMD_FUNCTION      storage class and target attribute of all functions
+ *	  SIMD_WIDTH         number of doubles per vector register
+ *	  SIMD_VEC, SIMD_MASK  vector and comparison mask types
+ *	  SIMD_LOAD, SIMD_STORE, SIMD_SET1, SIMD_ZERO, SIMD_SUB, SIMD_MUL,
+ *	  SIMD_DIV, SIMD_MIN, SIMD_CMP_GE, SIMD_CMP_LT, SIMD_MASK_AND,
+ *	  SIMD_BLEND         vector operations; SIMD_BLEND( m, a, b ) takes b
+ *	                     where m is set
+ *	  SIMD_REDUCE_MIN    horizontal minimum
+ *	  SIMD_LOAD_PAIRS, SIMD_STORE_PAIRS
+ *	                     split interleaved (lower, upper) gap pairs of a
+ *	                     d2_vector_t into one register per bound and back
+ *
+ *	All branches of the scalar loops in stage_qp_solver_clipping.c become
+ *	comparison masks and blends, with lower and upper bound gaps held in
+ *	separate registers. Results are identical to the scalar versions.
+ *
+ *	NOTE: no include guard on purpose.
+ */
+
+
+/* ----------------------------------------------
+ * saturate vec to [lb,ub] and store the gaps to
+ * the bounds, scaled by the diagonal Hessian hDiag
+ * (null pointer: identity), in mu
+ *
+ >>>>>                                            */
+SIMD_FUNCTION void SIMD_NAME(saturate)(	real_t* const vec,
+										real_t* const mu,
+										const real_t* const lb,
+										const real_t* const ub,
+										const real_t* const hDiag,
+										int_t nV,
+										real_t activenessTolerance )
+{
+	int_t ii = 0;
+	SIMD_VEC v, l, u, h, gapLow, gapUpp;
+	const SIMD_VEC negTol = SIMD_SET1( -activenessTolerance );
+
+	for( ; ii+SIMD_WIDTH <= nV; ii += SIMD_WIDTH ) {
+		v = SIMD_LOAD( &(vec[ii]) );
+		l = SIMD_LOAD( &(lb[ii]) );
+		u = SIMD_LOAD( &(ub[ii]) );
+		gapLow = SIMD_SUB( l, v );
+		gapUpp = SIMD_SUB( v, u );
+		if ( hDiag != 0 ) {
+			h = SIMD_LOAD( &(hDiag[ii]) );
+			gapLow = SIMD_MUL( gapLow, h );
+			gapUpp = SIMD_MUL( gapUpp, h );
+		}
+		/* lower bound takes precedence over upper bound */
+		v = SIMD_BLEND( SIMD_CMP_GE( gapUpp, negTol ), v, u );
+		v = SIMD_BLEND( SIMD_CMP_GE( gapLow, negTol ), v, l );
+		SIMD_STORE( &(vec[ii]), v );
+		SIMD_STORE_PAIRS( &(mu[2*ii]), gapLow, gapUpp );
+	}
+	for( ; ii < nV; ++ii ) {
+		mu[2*ii] = ( hDiag != 0 ) ? (lb[ii] - vec[ii])*hDiag[ii] : lb[ii] - vec[ii];
+		mu[2*ii+1] = ( hDiag != 0 ) ? (vec[ii] - ub[ii])*hDiag[ii] : vec[ii] - ub[ii];
+		vec[ii] = ( mu[2*ii] >= -activenessTolerance ) ? lb[ii] : ( ( mu[2*ii+1] >= -activenessTolerance ) ? ub[ii] : vec[ii] );
+	}
+}
+/*<<< END OF saturate */
+
+
+/* ----------------------------------------------
+ * shorten alphaMin to the smallest nonnegative
+ * step size at which a gap in mu closes along dz
+ *
+ >>>>>                                            */
+SIMD_FUNCTION void SIMD_NAME(minStepsize)(	const real_t* const mu,
+											const real_t* const dz,
+											int_t nV,
+											real_t infty,
+											real_t* const alphaMin )
+{
+	int_t ii = 0;
+	real_t lbRatio, ubRatio, alpha;
+	SIMD_VEC gapLow, gapUpp, d, ratioLow, ratioUpp;
+	SIMD_VEC acc = SIMD_SET1( *alphaMin );
+	const SIMD_VEC vInfty = SIMD_SET1( infty );
+	const SIMD_VEC zero = SIMD_ZERO();
+	const SIMD_VEC minusOne = SIMD_SET1( -1. );
+
+	for( ; ii+SIMD_WIDTH <= nV; ii += SIMD_WIDTH ) {
+		SIMD_LOAD_PAIRS( &(mu[2*ii]), &gapLow, &gapUpp );
+		d = SIMD_LOAD( &(dz[ii]) );
+		ratioLow = SIMD_DIV( gapLow, d );
+		ratioUpp = SIMD_MUL( SIMD_DIV( gapUpp, d ), minusOne );
+		/* negative ratios and NaN (0/0) do not restrict the step */
+		ratioLow = SIMD_BLEND( SIMD_CMP_GE( ratioLow, zero ), vInfty, ratioLow );
+		ratioUpp = SIMD_BLEND( SIMD_CMP_GE( ratioUpp, zero ), vInfty, ratioUpp );
+		acc = SIMD_MIN( acc, SIMD_MIN( ratioLow, ratioUpp ) );
+	}
+	alpha = SIMD_REDUCE_MIN( acc );
+	for( ; ii < nV; ++ii ) {
+		lbRatio = mu[2*ii] / dz[ii];
+		ubRatio = - mu[2*ii+1] / dz[ii];
+		lbRatio = ( lbRatio >= 0. ) ? lbRatio : infty;
+		ubRatio = ( ubRatio >= 0. ) ? ubRatio : infty;
+		alpha = ( lbRatio < alpha ) ? lbRatio : alpha;
+		alpha = ( ubRatio < alpha ) ? ubRatio : alpha;
+	}
+	if ( alpha < *alphaMin ) {
+		*alphaMin = alpha;
+	}
+}
+/*<<< END OF minStepsize */
+
+
+/* ----------------------------------------------
+ * smallest step size along zStepDir at which an
+ * inactive finite bound becomes active
+ *
+ >>>>>                                            */
+SIMD_FUNCTION void SIMD_NAME(ratioTest)(	real_t* const minStepSizeASChange,
+											const real_t* const zStepDir,
+											const real_t* const mu,
+											const real_t* const lb,
+											const real_t* const ub,
+											int_t nV,
+											real_t equalityTolerance,
+											real_t infty )
+{
+	int_t ii = 0;
+	real_t stepRatio, minStepSize;
+	const real_t lbFinite = infty * (-1 + equalityTolerance);		/* treat infinite bounds separately */
+	const real_t ubFinite = infty * (1 - equalityTolerance);
+	SIMD_VEC gapLow, gapUpp, d, ratio;
+	SIMD_MASK isCandidate;
+	SIMD_VEC acc = SIMD_SET1( infty );
+	const SIMD_VEC zero = SIMD_ZERO();
+	const SIMD_VEC minusOne = SIMD_SET1( -1. );
+	const SIMD_VEC eqTol = SIMD_SET1( equalityTolerance );
+	const SIMD_VEC vLbFinite = SIMD_SET1( lbFinite );
+	const SIMD_VEC vUbFinite = SIMD_SET1( ubFinite );
+
+	for( ; ii+SIMD_WIDTH <= nV; ii += SIMD_WIDTH ) {
+		SIMD_LOAD_PAIRS( &(mu[2*ii]), &gapLow, &gapUpp );
+		d = SIMD_LOAD( &(zStepDir[ii]) );
+
+		/* distance to lower bound */
+		ratio = SIMD_DIV( gapLow, d );
+		isCandidate = SIMD_MASK_AND( SIMD_MASK_AND( SIMD_CMP_GE( ratio, zero ), SIMD_CMP_LT( gapLow, eqTol ) ),
+									 SIMD_CMP_LT( SIMD_LOAD( &(lb[ii]) ), vLbFinite ) );
+		acc = SIMD_MIN( acc, SIMD_BLEND( isCandidate, acc, ratio ) );
+
+		/* distance to upper bound */
+		ratio = SIMD_MUL( SIMD_DIV( gapUpp, d ), minusOne );
+		isCandidate = SIMD_MASK_AND( SIMD_MASK_AND( SIMD_CMP_GE( ratio, zero ), SIMD_CMP_LT( gapUpp, eqTol ) ),
+									 SIMD_CMP_LT( SIMD_LOAD( &(ub[ii]) ), vUbFinite ) );
+		acc = SIMD_MIN( acc, SIMD_BLEND( isCandidate, acc, ratio ) );
+	}
+	minStepSize = SIMD_REDUCE_MIN( acc );
+	for( ; ii < nV; ++ii ) {
+		stepRatio = mu[2*ii] / zStepDir[ii];
+		if ( ( stepRatio >= 0. ) && ( stepRatio < minStepSize ) && ( mu[2*ii] < equalityTolerance ) && ( lb[ii] < lbFinite ) ) {
+			minStepSize = stepRatio;
+		}
+		stepRatio = - mu[2*ii+1] / zStepDir[ii];
+		if ( ( stepRatio >= 0. ) && ( stepRatio < minStepSize ) && ( mu[2*ii+1] < equalityTolerance ) && ( ub[ii] < ubFinite ) ) {
+			minStepSize = stepRatio;
+		}
+	}
+	*minStepSizeASChange = minStepSize;
+}
+/*<<< END OF ratioTest */
+
+
+/*
+ *	end of file
+ */
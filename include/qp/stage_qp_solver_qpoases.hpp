@@ -63,6 +63,12 @@ qpoasesObject_t* qpOASES_constructor(	qpData_t* qpData,
 void qpOASES_destructor( qpoasesObject_t** qpoasesObject );
 
 
+/** memory in bytes of a qpOASES object for nV variables and nC constraints */
+uint_t qpOASES_getMemorySize(	int_t nV,
+								int_t nC
+								);
+
+
 /** ... */
 return_t qpOASES_setup( qpData_t* qpData,
 						qpoasesObject_t* qpoasesObject,
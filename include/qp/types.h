@@ -56,14 +56,18 @@
 #define __ANALYZE_FACTORIZATION__			/* log inverse Newton Hessian for analysis */
 #undef __ANALYZE_FACTORIZATION__
 
-#define __QPDUNES_PARALLEL__				/* use openMP parallelization */
-#undef __QPDUNES_PARALLEL__
+//#define __QPDUNES_PARALLEL__			/* use openMP parallelization; set by the build system (QPDUNES_PARALLEL) */
+//#undef __QPDUNES_PARALLEL__
 
 #define __DO_UNIT_TESTS__					/* include some unit tests */
 #undef __DO_UNIT_TESTS__
 
 #define PRINTING_PRECISION 14
 
+#define QPDUNES_MEMORY_ALIGNMENT 64		/* alignment in bytes of Newton Hessian storage (one cache line, one AVX-512 register) */
+#define QPDUNES_MEMORY_BLOCK_ALIGNMENT 16	/* alignment in bytes of all other solver data in a memory arena */
+#define QPDUNES_ALIGN_UP( N, A )	( ( ( (N) + (A) - 1 ) / (A) ) * (A) )	/* N rounded up to a multiple of A */
+
 #ifdef __MATLAB__
 	#define MAX_STR_LEN 2560
 #endif
@@ -110,8 +114,10 @@
 	#define _NU_ (qpData->nU)
 	#define _NZ_ (qpData->nZ)
 	#define _NI_ (qpData->nI)
-	#define _NDTTL_ (qpData->nDttl)
+#else
+	#include <qpDimensions.h>
 #endif
+#define _NDTTL_ (qpData->nDttl)
 #define _NV( I ) (qpData->intervals[ I ]->nV)
 #define _ND( I ) (qpData->intervals[ I ]->nD)
 #define _NV_ (interval->nV)
@@ -120,14 +126,20 @@
 
 
 /** MATRIX ACCESS */
-/*                                                block offset   row offset   column offset (0=diag,-1=supDiag)   column */
-#define accHessian( K, L, I, J )	hessian->data[ (K)*2*_NX_*_NX_  + (I)*2*_NX_   + (1+L)*_NX_                         + (J) ]
-/*                                                        block offset   row offset   column offset (0=diag,-1=supDiag)   column */
-#define accCholHessian( K, L, I, J )	cholHessian->data[ (K)*2*_NX_*_NX_  + (I)*2*_NX_   + (1+L)*_NX_                         + (J) ]
+/** Newton Hessian storage, see nhLayout_t:  block row offset   column offset (0=diag,-1=subDiag)   row offset   column */
+#define nhOffset( K, L, I, J )	( (K)*qpData->nhLayout.blockRowStride + (1+(L))*qpData->nhLayout.blockStride + (I)*qpData->nhLayout.rowStride + (J) )
+#define _NH_LD_ (qpData->nhLayout.rowStride)	/**< row stride within Newton Hessian blocks */
+#define QPDUNES_NH_PAD( N )	( ( ( (N) + QPDUNES_MEMORY_ALIGNMENT/sizeof(real_t) - 1 ) / ( QPDUNES_MEMORY_ALIGNMENT/sizeof(real_t) ) ) * ( QPDUNES_MEMORY_ALIGNMENT/sizeof(real_t) ) )	/**< padded row length of blocked layout */
+
+#define accHessian( K, L, I, J )	hessian->data[ nhOffset( K, L, I, J ) ]
+
+#define accCholHessian( K, L, I, J )	cholHessian->data[ nhOffset( K, L, I, J ) ]
+
+#define accUnconstrainedHessian( K, L, I, J )	qpData->unconstrainedHessian.data[ nhOffset( K, L, I, J ) ]
 
-#define accUnconstrainedHessian( K, L, I, J )	qpData->unconstrainedHessian.data[ (K)*2*_NX_*_NX_ + (I)*2*_NX_ + (1+L)*_NX_ + (J) ]
+#define accCholUnconstrainedHessian( K, L, I, J )	qpData->cholUnconstrainedHessian.data[ nhOffset( K, L, I, J ) ]
 
-#define accCholUnconstrainedHessian( K, L, I, J )	qpData->cholUnconstrainedHessian.data[ (K)*2*_NX_*_NX_ + (I)*2*_NX_ + (1+L)*_NX_ + (J) ]
+#define accCyclicReductionTmp( K, L, I, J )	qpData->cyclicReductionTmp.data[ nhOffset( K, L, I, J ) ]
 
 
 #define accH( I, J )	H->data[ (I)*nV + (J) ]
@@ -186,7 +198,8 @@ typedef enum
 {
 	QPDUNES_STAGE_QP_SOLVER_UNDEFINED,		/**< ... */
 	QPDUNES_STAGE_QP_SOLVER_CLIPPING,		/**< ... */
-	QPDUNES_STAGE_QP_SOLVER_QPOASES			/**< ... */
+	QPDUNES_STAGE_QP_SOLVER_QPOASES,		/**< ... */
+	QPDUNES_STAGE_QP_SOLVER_BOXQP			/**< parametric active-set solver for dense Hessians and simple bounds */
 } qp_solver_t;
 
 
@@ -207,10 +220,45 @@ typedef enum
 typedef enum
 {
 	QPDUNES_NH_FAC_BAND_FORWARD,		/**< 0 = ... */
-	QPDUNES_NH_FAC_BAND_REVERSE			/**< 1 = ... */
+	QPDUNES_NH_FAC_BAND_REVERSE,		/**< 1 = ... */
+	QPDUNES_NH_FAC_CYCLIC_REDUCTION,	/**< 2 = block cyclic reduction; levels are factorized in parallel (not with singular directions regularization) */
+	QPDUNES_NH_FAC_TWISTED				/**< 3 = twisted (forward from the top, reverse from the bottom); only blocks between first and last change are refactorized (not with singular directions regularization) */
 } nwtnHssnFacAlg_t;
 
 
+/** Newton Hessian storage layouts */
+typedef enum
+{
+	QPDUNES_NH_LAYOUT_INTERLEAVED,		/**< 0 = one (nI*nX) x (2*nX) row major array; sub-diagonal and diagonal block of a block row side by side */
+	QPDUNES_NH_LAYOUT_BLOCKED			/**< 1 = sub-diagonal and diagonal block of a block row stored one after the other; rows padded to full cache lines */
+} nwtnHssnLayout_t;
+
+
+/** Interval data storage layouts */
+typedef enum
+{
+	QPDUNES_STAGE_LAYOUT_BY_STAGE,		/**< 0 = all arrays of an interval stored together, one interval after the other */
+	QPDUNES_STAGE_LAYOUT_BY_FIELD		/**< 1 = structure of arrays; each array (z, C, ...) of all intervals stored together, one interval after the other */
+} stageDataLayout_t;
+
+
+/** Interval data fields, combined to a bit mask in data change indications */
+typedef enum
+{
+	QPDUNES_DATA_NONE		= 0,	/**< no data */
+	QPDUNES_DATA_H			= 1,	/**< Hessian */
+	QPDUNES_DATA_G			= 2,	/**< gradient */
+	QPDUNES_DATA_C			= 4,	/**< dynamics matrix */
+	QPDUNES_DATA_C_CONST	= 8,	/**< dynamics constant part */
+	QPDUNES_DATA_ZLOW		= 16,	/**< lower variable bounds */
+	QPDUNES_DATA_ZUPP		= 32,	/**< upper variable bounds */
+	QPDUNES_DATA_D			= 64,	/**< constraint matrix */
+	QPDUNES_DATA_DLOW		= 128,	/**< constraint lower bounds */
+	QPDUNES_DATA_DUPP		= 256,	/**< constraint upper bounds */
+	QPDUNES_DATA_ALL		= 511	/**< all of the above */
+} dataField_t;
+
+
 /** Line search types */
 typedef enum
 {
@@ -221,7 +269,9 @@ typedef enum
 	QPDUNES_LS_ACCELERATED_GRADIENT_BISECTION_LS,	/**< 4 = fast backtracking first, then gradient based bisection for refinement */
 	QPDUNES_LS_GRID_LS,								/**< 5 = evaluate objective function on a grid and take minimum */
 	QPDUNES_LS_ACCELERATED_GRID_LS,					/**< 6 = fast backtracking first, then grid search for refinement */
-	QPDUNES_LS_HOMOTOPY_GRID_SEARCH					/**< 7 = Grid search utilizing precomputed homotoppy parameterization */
+	QPDUNES_LS_HOMOTOPY_GRID_SEARCH,				/**< 7 = Grid search utilizing precomputed homotoppy parameterization */
+	QPDUNES_LS_PIECEWISE_QUADRATIC_LS,				/**< 8 = exact maximization of the piecewise quadratic dual function over all stage breakpoints (clipping stage QPs only, backtracking otherwise) */
+	QPDUNES_LS_NEWTON_LS							/**< 9 = safeguarded Newton iterations on the slope of the dual function, using analytic stage curvatures */
 } lineSearchType_t;
 
 
@@ -32,7 +32,10 @@
 
 #include <qp/types.h>
 #include <qp/matrix_vector.h>
+#include <qp/matrix_vector_small.h>
+#include <qp/newton_system_simd.h>
 #include <qp/stage_qp_solver_clipping.h>
+#include <qp/stage_qp_solver_clipping_simd.h>
 #include <qp/stage_qp_solver_qpoases.hpp>
 #include <qp/dual_qp.h>
 #include <qp/qpdunes_utils.h>
@@ -49,7 +52,10 @@ extern "C"
 	#include <qp/qpDataStatic.h>
 #endif
 #include <qp/matrix_vector.h>
+#include <qp/matrix_vector_small.h>
+#include <qp/newton_system_simd.h>
 #include <qp/stage_qp_solver_clipping.h>
+#include <qp/stage_qp_solver_clipping_simd.h>
 
 #include <qp/dual_qp.h>
 #include <qp/qpdunes_utils.h>
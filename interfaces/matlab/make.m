@@ -69,6 +69,7 @@ QPDUNES_OBJECTS = [	QPDUNESPATH, 'src/stage_qp_solver_clipping.c ',...
 QPOASES_OBJECTS = [	QPOASESPATH, 'src/BLASReplacement.cpp ',...
 					QPOASESPATH, 'src/LAPACKReplacement.cpp ',...
                     QPOASESPATH, 'src/LoggedSQProblem.cpp ',...
+                    QPOASESPATH, 'src/LoggedQProblemB.cpp ',...
 					QPOASESPATH, 'src/SQProblem.cpp ',...
 					QPOASESPATH, 'src/QProblem.cpp ',...
 					QPOASESPATH, 'src/QProblemB.cpp ',...
@@ -51,30 +51,34 @@ return_t mpcDUNES_setup(	mpcProblem_t* const mpcProblem,
 {
 	int_t ii;
 	int_t nZ = nX+nU;
+	return_t statusFlag;
 
 	/* allocate qpData struct */
-	qpDUNES_setup( &(mpcProblem->qpData), nI, nX, nU, nD, qpOptions );
+	statusFlag = qpDUNES_setup( &(mpcProblem->qpData), nI, nX, nU, nD, qpOptions );
+	if ( statusFlag != QPDUNES_OK ) {
+		return statusFlag;
+	}
 	
 	/* allocate xRef, uRef, xOpt, uOpt, lambdaOpt */
-	mpcProblem->zRef  = (real_t*)calloc( nI*nZ+nX,sizeof(real_t) );
-//	mpcProblem->xRef  = (real_t*)calloc( (nI+1)*nX,sizeof(real_t) );
-//	mpcProblem->uRef  = (real_t*)calloc( nI*nU,sizeof(real_t) );
-	mpcProblem->xOpt  = (real_t*)calloc( (nI+1)*nX,sizeof(real_t) );
-	mpcProblem->uOpt  = (real_t*)calloc( nI*nU,sizeof(real_t) );
-	mpcProblem->lambdaOpt  = (real_t*)calloc( nI*nX,sizeof(real_t) );
+	mpcProblem->zRef  = (real_t*)qpDUNES_calloc( 0, nI*nZ+nX,sizeof(real_t) );
+//	mpcProblem->xRef  = (real_t*)qpDUNES_calloc( 0, (nI+1)*nX,sizeof(real_t) );
+//	mpcProblem->uRef  = (real_t*)qpDUNES_calloc( 0, nI*nU,sizeof(real_t) );
+	mpcProblem->xOpt  = (real_t*)qpDUNES_calloc( 0, (nI+1)*nX,sizeof(real_t) );
+	mpcProblem->uOpt  = (real_t*)qpDUNES_calloc( 0, nI*nU,sizeof(real_t) );
+	mpcProblem->lambdaOpt  = (real_t*)qpDUNES_calloc( 0, nI*nX,sizeof(real_t) );
 	
 	/* allocate workspace */
-	mpcProblem->xnTmp   = (real_t*)calloc( nI*nX,sizeof(real_t) );
-	mpcProblem->zn1Tmp   = (real_t*)calloc( nI*nZ+nX,sizeof(real_t) );
-	mpcProblem->zn1Tmp2   = (real_t*)calloc( nI*nZ+nX,sizeof(real_t) );
-	mpcProblem->xn1Tmp   = (real_t*)calloc( (nI+1)*nX,sizeof(real_t) );
-	mpcProblem->xn1Tmp2  = (real_t*)calloc( (nI+1)*nX,sizeof(real_t) );
-	mpcProblem->xn1Tmp3  = (real_t*)calloc( (nI+1)*nX,sizeof(real_t) );
-	mpcProblem->unTmp   = (real_t*)calloc( nI*nU,sizeof(real_t) );
-	mpcProblem->unTmp2  = (real_t*)calloc( nI*nU,sizeof(real_t) );
+	mpcProblem->xnTmp   = (real_t*)qpDUNES_calloc( 0, nI*nX,sizeof(real_t) );
+	mpcProblem->zn1Tmp   = (real_t*)qpDUNES_calloc( 0, nI*nZ+nX,sizeof(real_t) );
+	mpcProblem->zn1Tmp2   = (real_t*)qpDUNES_calloc( 0, nI*nZ+nX,sizeof(real_t) );
+	mpcProblem->xn1Tmp   = (real_t*)qpDUNES_calloc( 0, (nI+1)*nX,sizeof(real_t) );
+	mpcProblem->xn1Tmp2  = (real_t*)qpDUNES_calloc( 0, (nI+1)*nX,sizeof(real_t) );
+	mpcProblem->xn1Tmp3  = (real_t*)qpDUNES_calloc( 0, (nI+1)*nX,sizeof(real_t) );
+	mpcProblem->unTmp   = (real_t*)qpDUNES_calloc( 0, nI*nU,sizeof(real_t) );
+	mpcProblem->unTmp2  = (real_t*)qpDUNES_calloc( 0, nI*nU,sizeof(real_t) );
 	
-	mpcProblem->z0LowOrig = (real_t*)calloc( nZ,sizeof(real_t) );	/* workspace to save bounds before initial value embedding */
-	mpcProblem->z0UppOrig = (real_t*)calloc( nZ,sizeof(real_t) );
+	mpcProblem->z0LowOrig = (real_t*)qpDUNES_calloc( 0, nZ,sizeof(real_t) );	/* workspace to save bounds before initial value embedding */
+	mpcProblem->z0UppOrig = (real_t*)qpDUNES_calloc( 0, nZ,sizeof(real_t) );
 
 	/* initalize solution variables */
 	for ( ii=0; ii<(nI+1)*nX; ++ii ) {
@@ -103,22 +107,22 @@ return_t mpcDUNES_cleanup(	mpcProblem_t* const mpcProblem
 {
 	qpDUNES_cleanup( &(mpcProblem->qpData) );
 	
-	qpDUNES_free( &(mpcProblem->zRef) );
-	qpDUNES_free( &(mpcProblem->xOpt) );
-	qpDUNES_free( &(mpcProblem->uOpt) );
-	qpDUNES_free( &(mpcProblem->lambdaOpt) );
+	qpDUNES_free( 0, &(mpcProblem->zRef) );
+	qpDUNES_free( 0, &(mpcProblem->xOpt) );
+	qpDUNES_free( 0, &(mpcProblem->uOpt) );
+	qpDUNES_free( 0, &(mpcProblem->lambdaOpt) );
 	
-	qpDUNES_free( &(mpcProblem->xnTmp) );
-	qpDUNES_free( &(mpcProblem->zn1Tmp) );
-	qpDUNES_free( &(mpcProblem->zn1Tmp2) );
-	qpDUNES_free( &(mpcProblem->xn1Tmp) );
-	qpDUNES_free( &(mpcProblem->xn1Tmp2) );
-	qpDUNES_free( &(mpcProblem->xn1Tmp3) );
-	qpDUNES_free( &(mpcProblem->unTmp) );
-	qpDUNES_free( &(mpcProblem->unTmp2) );
-
-	qpDUNES_free( &(mpcProblem->z0LowOrig) );
-	qpDUNES_free( &(mpcProblem->z0UppOrig) );
+	qpDUNES_free( 0, &(mpcProblem->xnTmp) );
+	qpDUNES_free( 0, &(mpcProblem->zn1Tmp) );
+	qpDUNES_free( 0, &(mpcProblem->zn1Tmp2) );
+	qpDUNES_free( 0, &(mpcProblem->xn1Tmp) );
+	qpDUNES_free( 0, &(mpcProblem->xn1Tmp2) );
+	qpDUNES_free( 0, &(mpcProblem->xn1Tmp3) );
+	qpDUNES_free( 0, &(mpcProblem->unTmp) );
+	qpDUNES_free( 0, &(mpcProblem->unTmp2) );
+
+	qpDUNES_free( 0, &(mpcProblem->z0LowOrig) );
+	qpDUNES_free( 0, &(mpcProblem->z0UppOrig) );
 	
 	return QPDUNES_OK;
 }
@@ -820,6 +824,10 @@ return_t mpcDUNES_solve(	mpcProblem_t* const mpcProblem,
 			qpDUNES_updateQpoases( qpData, qpData->intervals[0], QPDUNES_FALSE, QPDUNES_FALSE, QPDUNES_TRUE, QPDUNES_TRUE, QPDUNES_FALSE, QPDUNES_FALSE, QPDUNES_FALSE, &nQpoasesIter );
 			break;
 
+		case QPDUNES_STAGE_QP_SOLVER_BOXQP:
+			qpDUNES_setupBoxQpSolver( qpData, qpData->intervals[0], QPDUNES_FALSE, QPDUNES_FALSE );
+			break;
+
 		default:
 			qpDUNES_printError( qpData, __FILE__, __LINE__, "Unknown stage QP solver selected." );
 			return QPDUNES_ERR_INVALID_ARGUMENT;
@@ -895,6 +903,10 @@ return_t mpcDUNES_solve(	mpcProblem_t* const mpcProblem,
 										&nQpoasesIter );
 				break;
 
+			case QPDUNES_STAGE_QP_SOLVER_BOXQP:
+				qpDUNES_setupBoxQpSolver( qpData, interval, QPDUNES_FALSE, QPDUNES_TRUE );
+				break;
+
 			default:
 				qpDUNES_printError( qpData, __FILE__, __LINE__, "MPC shift failed. Unknown stage QP solver selected." );
 				return QPDUNES_ERR_INVALID_ARGUMENT;
@@ -43,6 +43,8 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 	*itCntr = 0;
 	return_t statusFlag; /* generic status flag */
 	int_t hessRefactorIdx;
+	int_t hessFirstChangeIdx;
+	int_t nMemoHits, nMemoMisses;	/* Newton Hessian memo counters before the Newton system setup */
 
 	real_t objValIncumbent = qpDUNES_computeObjectiveValue(qpData);
 
@@ -55,6 +57,10 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 
 	real_t* y_swap = 0;
 
+	/* problem data might have changed since the last call, the Newton Hessian factor needs to be rebuilt */
+	qpData->isCholHessianUpdatable = QPDUNES_FALSE;
+	qpData->isGradientCacheValid = QPDUNES_FALSE;
+
 
 	/** (3a) log and display */
 	if (qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS)
@@ -90,22 +96,33 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 		/** (1) get a step direction:
 		 *      switch between preconditioned gradient and Newton steps */
 		itLogPtr->isHessianRegularized = QPDUNES_FALSE;
+		itLogPtr->nRefactoredBlocks = 0;
+		itLogPtr->nNewtonMemoHits = 0;
+		itLogPtr->nNewtonMemoMisses = 0;
 		if ((*itCntr > 1) && (*itCntr - 1 <= qpData->options.nbrInitialGradientSteps)) { /* always do one Newton step first */
 
 			/** preconditioned gradient step with unconstrained hessian */
 
 			tNwtnSetupStart = getTime();
-			qpDUNES_computeNewtonGradient(qpData, &(qpData->gradient), &(qpData->xVecTmp));
+			qpDUNES_updateNewtonGradient(qpData);
 			tNwtnSetupEnd = getTime();
 
 			tNwtnSolveStart = getTime();
 			switch (qpData->options.nwtnHssnFacAlg) {
 			case QPDUNES_NH_FAC_BAND_FORWARD:
-				statusFlag = qpDUNES_solveNewtonEquation(qpData, &(qpData->deltaLambda), &(qpData->cholUnconstrainedHessian), &(qpData->gradient));
+				statusFlag = qpDUNES_solveNewtonEquation(qpData, &(qpData->deltaLambda), &(qpData->cholUnconstrainedHessian), qpData->cholUnconstrainedHessianBlockSparsity, &(qpData->gradient));
 				break;
 
 			case QPDUNES_NH_FAC_BAND_REVERSE:
-				statusFlag = qpDUNES_solveNewtonEquationBottomUp(qpData, &(qpData->deltaLambda), &(qpData->cholUnconstrainedHessian), &(qpData->gradient));
+				statusFlag = qpDUNES_solveNewtonEquationBottomUp(qpData, &(qpData->deltaLambda), &(qpData->cholUnconstrainedHessian), qpData->cholUnconstrainedHessianBlockSparsity, &(qpData->gradient));
+				break;
+
+			case QPDUNES_NH_FAC_CYCLIC_REDUCTION:
+				statusFlag = qpDUNES_solveNewtonEquationCyclicReduction(qpData, &(qpData->deltaLambda), &(qpData->cholUnconstrainedHessian), &(qpData->gradient));
+				break;
+
+			case QPDUNES_NH_FAC_TWISTED:
+				statusFlag = qpDUNES_solveNewtonEquationTwisted(qpData, &(qpData->deltaLambda), &(qpData->cholUnconstrainedHessian), &(qpData->gradient), qpData->cholUnconstrainedHessianTwistIdx);
 				break;
 
 			default:
@@ -129,7 +146,9 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 
 			/** (1Ba) set up Newton system */
 			tNwtnSetupStart = getTime();
-			statusFlag = qpDUNES_setupNewtonSystem( qpData, &hessRefactorIdx );
+			nMemoHits = qpData->newtonMemo.nHits;
+			nMemoMisses = qpData->newtonMemo.nMisses;
+			statusFlag = qpDUNES_setupNewtonSystem( qpData, &hessFirstChangeIdx, &hessRefactorIdx );
 			switch (statusFlag) {
 				case QPDUNES_OK:
 					break;
@@ -165,17 +184,26 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 					return statusFlag;
 			}
 			tNwtnSetupEnd = getTime();
+			itLogPtr->nNewtonMemoHits = qpData->newtonMemo.nHits - nMemoHits;
+			itLogPtr->nNewtonMemoMisses = qpData->newtonMemo.nMisses - nMemoMisses;
 
-			/** (1Bb) factorize Newton system */
+			/** (1Bb) factorize Newton system (unless factor was already modified along with the Newton Hessian) */
 			tNwtnFactorStart = getTime();
-			statusFlag = qpDUNES_factorNewtonSystem(qpData, &(qpData->cholHessian), &(qpData->hessian), &(itLogPtr->isHessianRegularized), hessRefactorIdx);		// TODO! can we get a problem with on-the-fly regularization in partial refactorization? might only be partially reg.
-			switch (statusFlag) {
-				case QPDUNES_OK:
-					break;
-				default:
-					qpDUNES_printError(qpData, __FILE__, __LINE__,	"Factorization of Newton Equation failed.");
-					if (qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS)	 qpDUNES_logIteration(qpData, itLogPtr, objValIncumbent, hessRefactorIdx);
-					return statusFlag;
+			if (qpData->isCholHessianUpToDate == QPDUNES_FALSE) {
+				qpData->isCholHessianUpdatable = QPDUNES_FALSE;
+				statusFlag = qpDUNES_factorNewtonSystem(qpData, &(qpData->cholHessian), &(qpData->hessian), &(itLogPtr->isHessianRegularized), hessFirstChangeIdx, hessRefactorIdx, &(qpData->cholHessianTwistIdx), qpData->cholHessianBlockSparsity, &(itLogPtr->nRefactoredBlocks));		// TODO! can we get a problem with on-the-fly regularization in partial refactorization? might only be partially reg.
+				switch (statusFlag) {
+					case QPDUNES_OK:
+						break;
+					default:
+						qpDUNES_printError(qpData, __FILE__, __LINE__,	"Factorization of Newton Equation failed.");
+						if (qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS)	 qpDUNES_logIteration(qpData, itLogPtr, objValIncumbent, hessRefactorIdx);
+						return statusFlag;
+				}
+				/* only band factors of the unregularized Newton Hessian can be modified later on */
+				qpData->isCholHessianUpdatable = ( ( itLogPtr->isHessianRegularized == QPDUNES_FALSE ) &&
+												   ( ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_BAND_FORWARD ) ||
+													 ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_BAND_REVERSE ) ) ) ? QPDUNES_TRUE : QPDUNES_FALSE;
 			}
 			tNwtnFactorEnd = getTime();
 
@@ -183,11 +211,19 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 			tNwtnSolveStart = getTime();
 			switch (qpData->options.nwtnHssnFacAlg) {
 			case QPDUNES_NH_FAC_BAND_FORWARD:
-				statusFlag = qpDUNES_solveNewtonEquation(qpData, &(qpData->deltaLambda), &(qpData->cholHessian), &(qpData->gradient));
+				statusFlag = qpDUNES_solveNewtonEquation(qpData, &(qpData->deltaLambda), &(qpData->cholHessian), qpData->cholHessianBlockSparsity, &(qpData->gradient));
 				break;
 
 			case QPDUNES_NH_FAC_BAND_REVERSE:
-				statusFlag = qpDUNES_solveNewtonEquationBottomUp(qpData, &(qpData->deltaLambda), &(qpData->cholHessian), &(qpData->gradient));
+				statusFlag = qpDUNES_solveNewtonEquationBottomUp(qpData, &(qpData->deltaLambda), &(qpData->cholHessian), qpData->cholHessianBlockSparsity, &(qpData->gradient));
+				break;
+
+			case QPDUNES_NH_FAC_CYCLIC_REDUCTION:
+				statusFlag = qpDUNES_solveNewtonEquationCyclicReduction(qpData, &(qpData->deltaLambda), &(qpData->cholHessian), &(qpData->gradient));
+				break;
+
+			case QPDUNES_NH_FAC_TWISTED:
+				statusFlag = qpDUNES_solveNewtonEquationTwisted(qpData, &(qpData->deltaLambda), &(qpData->cholHessian), &(qpData->gradient), qpData->cholHessianTwistIdx);
 				break;
 
 			default:
@@ -200,6 +236,10 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 				if (qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS)	 qpDUNES_logIteration(qpData, itLogPtr, objValIncumbent, hessRefactorIdx);
 				return statusFlag;
 			}
+			/* regularized blocks of a twisted factor are not tracked, refactor it entirely next time */
+			if ( itLogPtr->isHessianRegularized == QPDUNES_TRUE ) {
+				qpData->cholHessianTwistIdx = -1;
+			}
 		}
 
 
@@ -316,6 +356,8 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 			qpData->log.itLog[(*itCntr)].tIt = tItEnd - tItStart;
 			qpData->log.itLog[(*itCntr)].tNwtnSetup = tNwtnSetupEnd
 					- tNwtnSetupStart;
+			qpData->log.itLog[(*itCntr)].tNwtnFactor = tNwtnFactorEnd
+					- tNwtnFactorStart;
 			qpData->log.itLog[(*itCntr)].tNwtnSolve = tNwtnSolveEnd
 					- tNwtnSolveStart;
 			qpData->log.itLog[(*itCntr)].tQP = tQpEnd - tQpStart;
@@ -359,7 +401,7 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 	qpData->log.numIter = qpData->options.maxIter;
 
 	if ( qpData->options.allowSuboptimalTermination == QPDUNES_TRUE )	{
-		qpDUNES_computeNewtonGradient(qpData, &(qpData->gradient), &(qpData->xVecTmp) );
+		qpDUNES_updateNewtonGradient(qpData);
 		qpDUNES_printSuccess(qpData, "Early termination due to iteration limit.\n          Dual suboptimal with remaining ascent slope %.1e",	vectorNorm(&(qpData->gradient), _NI_ * _NX_));
 		/* save the final active set (the one where the solution lies).
 		 *   Even if the hessian is not yet updated according to the last
@@ -393,6 +435,64 @@ return_t qpDUNES_solve(qpData_t* const qpData) {
 /*<<< END OF qpDUNES_solve */
 
 
+/* ----------------------------------------------
+ * solve a batch of QPs of equal dimensions
+ *
+ *   With at least as many QPs as threads, whole QPs are distributed over
+ *   the thread team and each one is solved single-threaded; otherwise the
+ *   QPs are solved one after another, with their stage loops spread over
+ *   the team. Returns QPDUNES_OK if all QPs were solved (optimal or
+ *   suboptimal termination), else the exit flag of the first failed QP.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_solveBatch(	qpData_t* const qpDataBatch,
+								int_t nBatch,
+								return_t* const exitFlags,
+								int_t* const numIter
+								)
+{
+	int_t bb;
+	int_t nThreadsQp;
+	int_t firstFailedIdx = nBatch;
+
+	const int_t nThreads = ( nBatch > 0 ) ? qpDataBatch[0].nThreads : 1;
+	const boolean_t isBatchParallel = ( ( nThreads > 1 ) && ( nBatch >= nThreads ) ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+
+	/* all QPs need to share dimensions */
+	for( bb=1; bb<nBatch; ++bb ) {
+		if ( ( qpDataBatch[bb].nI != qpDataBatch[0].nI ) || ( qpDataBatch[bb].nX != qpDataBatch[0].nX ) ||
+			 ( qpDataBatch[bb].nU != qpDataBatch[0].nU ) || ( qpDataBatch[bb].nDttl != qpDataBatch[0].nDttl ) )
+		{
+			qpDUNES_printError( &(qpDataBatch[0]), __FILE__, __LINE__, "Dimensions of QP %d in batch differ from QP 0.", bb );
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+		}
+	}
+
+	#pragma omp parallel for private(bb,nThreadsQp) reduction(min:firstFailedIdx) schedule(dynamic) num_threads(nThreads) if(isBatchParallel)
+	for( bb=0; bb<nBatch; ++bb ) {
+		nThreadsQp = qpDataBatch[bb].nThreads;
+		if ( isBatchParallel == QPDUNES_TRUE ) {
+			qpDataBatch[bb].nThreads = 1;
+		}
+		exitFlags[bb] = qpDUNES_solve( &(qpDataBatch[bb]) );
+		qpDataBatch[bb].nThreads = nThreadsQp;
+
+		if ( numIter != 0 ) {
+			numIter[bb] = qpDataBatch[bb].log.numIter;
+		}
+		if ( ( exitFlags[bb] != QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND ) &&
+			 ( exitFlags[bb] != QPDUNES_SUCC_SUBOPTIMAL_TERMINATION ) &&
+			 ( bb < firstFailedIdx ) )
+		{
+			firstFailedIdx = bb;
+		}
+	}
+
+	return ( firstFailedIdx < nBatch ) ? exitFlags[firstFailedIdx] : QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_solveBatch */
+
+
 /* ----------------------------------------------
  * log all data of this iteration
  *
@@ -419,7 +519,7 @@ void qpDUNES_logIteration(	qpData_t* qpData,
 		qpDUNES_copyVector(&(itLogPtr->deltaLambda), &(qpData->deltaLambda),
 				_NI_ * _NX_);
 		/* - Newton system */
-		for (ii = 0; ii < _NI_ * _NX_ * 2 * _NX_; ++ii) {
+		for (ii = 0; ii < _NI_ * qpData->nhLayout.blockRowStride; ++ii) {
 			itLogPtr->hessian.data[ii] = qpData->hessian.data[ii];
 			itLogPtr->cholHessian.data[ii] = qpData->cholHessian.data[ii];
 		}
@@ -461,7 +561,7 @@ void qpDUNES_logIteration(	qpData_t* qpData,
 			}
 			for( ii=0; ii<_NI_*_NX_; ++ii ) {
 				unitVec->data[ii] = 1.;
-				qpDUNES_solveNewtonEquation( qpData, resVec, &(qpData->cholHessian), unitVec );
+				qpDUNES_solveNewtonEquation( qpData, resVec, &(qpData->cholHessian), qpData->cholHessianBlockSparsity, unitVec );
 				for ( kk=0; kk<_NI_*_NX_; ++kk) {
 					itLogPtr->invHessian.data[kk*_NI_*_NX_+ii] = resVec->data[kk];
 				}
@@ -485,6 +585,7 @@ return_t qpDUNES_updateAllLocalQPs(	qpData_t* const qpData,
 									)
 {
 	int_t kk;
+	int_t errCntr = 0;
 	interval_t* interval;
 
 	/* first interval: */
@@ -500,6 +601,7 @@ return_t qpDUNES_updateAllLocalQPs(	qpData_t* const qpData,
 	interval = qpData->intervals[_NI_];
 	qpDUNES_updateVector( &(interval->lambdaK), &(lambda->data[(_NI_ - 1) * _NX_]), _NX_ );
 
+	#pragma omp parallel for private(kk,interval) reduction(+:errCntr) schedule(static) num_threads(qpData->nThreads)
 	for (kk = 0; kk < _NI_ + 1; ++kk) {
 		interval = qpData->intervals[kk];
 		switch (interval->qpSolverSpecification) {
@@ -509,11 +611,17 @@ return_t qpDUNES_updateAllLocalQPs(	qpData_t* const qpData,
 			case QPDUNES_STAGE_QP_SOLVER_QPOASES:
 				qpOASES_updateDualGuess( qpData, interval, &(interval->lambdaK), &(interval->lambdaK1) );
 				break;
+			case QPDUNES_STAGE_QP_SOLVER_BOXQP:
+				boxQpSolver_updateDualGuess( qpData, interval, &(interval->lambdaK), &(interval->lambdaK1) );
+				break;
 			default:
 				qpDUNES_printError( qpData, __FILE__, __LINE__, "Stage QP solver undefined! Bailing out..." );
-				return QPDUNES_ERR_INVALID_ARGUMENT;
+				errCntr++;
 		}
 	}
+	if (errCntr > 0) {
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
 
 	return QPDUNES_OK;
 }
@@ -534,11 +642,14 @@ return_t qpDUNES_solveAllLocalQPs(	qpData_t* const qpData,
 	return_t statusFlag;
 
 	/* 1) update local QP data */
-	qpDUNES_updateAllLocalQPs(qpData, lambda);
+	statusFlag = qpDUNES_updateAllLocalQPs(qpData, lambda);
+	if (statusFlag != QPDUNES_OK) {
+		return statusFlag;
+	}
 
 	/* 2) solve local QPs */
 	// Note: const variables are predetermined shared (at least on apple)
-	#pragma omp parallel for private(kk) shared(statusFlag) schedule(static) //shared(qpData)    // todo: manage threads outside!
+	#pragma omp parallel for private(kk,statusFlag) reduction(+:errCntr) schedule(static) num_threads(qpData->nThreads)
 		for (kk = 0; kk < _NI_ + 1; ++kk) {
 			statusFlag = qpDUNES_solveLocalQP( qpData, qpData->intervals[kk], (int_t*)offsetIntArray( numQpoasesIter, kk) );
 			if (statusFlag != QPDUNES_OK) { /* note that QPDUNES_OK == 0 */
@@ -549,7 +660,6 @@ return_t qpDUNES_solveAllLocalQPs(	qpData_t* const qpData,
 			//			qpDUNES_printf("Computed QP %d by thread %d/%d.", kk, omp_get_thread_num(), omp_get_num_threads() );
 			#endif
 		}
-//	} /* END of omp parallel */
 	if (errCntr > 0) {
 		return QPDUNES_ERR_STAGE_QP_INFEASIBLE;
 	}
@@ -592,6 +702,19 @@ return_t qpDUNES_solveLocalQP(	qpData_t* const qpData,
 			}
 			break;
 
+		case QPDUNES_STAGE_QP_SOLVER_BOXQP:
+			*numQpoasesIter = 0;
+			/* the line search may have left the homotopy at a trial step; return to q first */
+			statusFlag = boxQpSolver_hotstart( qpData, interval, &(interval->q), 0, QPDUNES_FALSE );
+			if (statusFlag == QPDUNES_OK) {
+				statusFlag = boxQpSolver_hotstart( qpData, interval, &(interval->qpSolverBoxQp.qFullStep), numQpoasesIter, QPDUNES_TRUE );
+			}
+			if (statusFlag != QPDUNES_OK) {
+				qpDUNES_printError(qpData, __FILE__, __LINE__, "Box QP solver failed.");
+				return statusFlag;
+			}
+			break;
+
 		default:
 			qpDUNES_printError(qpData, __FILE__, __LINE__, "Stage QP solver undefined! Bailing out...");
 			return QPDUNES_ERR_INVALID_ARGUMENT;
@@ -607,17 +730,23 @@ return_t qpDUNES_solveLocalQP(	qpData_t* const qpData,
  * 
  >>>>>>                                           */
 return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData,
+									int_t* const firstHessianDataChangeIdx,
 									int_t* const lastHessianDataChangeIdx
 									)
 {
 	int_t ii, jj, kk;
-
-	x_vector_t* xVecTmp = &(qpData->xVecTmp);
-	xx_matrix_t* xxMatTmp = &(qpData->xxMatTmp);
-	xx_matrix_t* xxMatTmp2 = &(qpData->xxMatTmp2);
-	ux_matrix_t* uxMatTmp = &(qpData->uxMatTmp);
-	zx_matrix_t* zxMatTmp = &(qpData->zxMatTmp);
-	zx_matrix_t* zxMatTmp2 = &(qpData->xzMatTmp);
+	int_t firstChangeIdx = _NI_;
+	int_t lastChangeIdx = -1;
+	boolean_t rebuildDiag, rebuildSubDiag;
+
+	/* workspace of the executing thread */
+	threadWorkspace_t* workspace;
+	x_vector_t* xVecTmp;
+	xx_matrix_t* xxMatTmp;
+	xx_matrix_t* xxMatTmp2;
+	ux_matrix_t* uxMatTmp;
+	zx_matrix_t* zxMatTmp;
+	zx_matrix_t* zxMatTmp2;
 
 	// get Matrices for reduced Hessian and for projection matrix
 	zz_matrix_t ZT;
@@ -632,8 +761,13 @@ return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData,
 
 	xn2x_matrix_t* hessian = &(qpData->hessian);
 
+	/* memoized stage contributions (stage kk in slot memoSlot[kk] >= 0) */
+	newtonMemoSlot_t* memoSlots = qpData->newtonMemo.slots;
+	int_t* memoSlot = 0;
+	newtonMemoSlot_t* slot;
+
 	/** calculate gradient and check gradient norm for convergence */
-	qpDUNES_computeNewtonGradient(qpData, &(qpData->gradient), xVecTmp);
+	qpDUNES_updateNewtonGradient(qpData);
 	if ( (vectorNorm(&(qpData->gradient), _NX_ * _NI_) < qpData->options.stationarityTolerance) ) {
 		return QPDUNES_SUCC_OPTIMAL_SOLUTION_FOUND;
 	}
@@ -641,135 +775,176 @@ return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData,
 //	qpDUNES_printMatrixData( qpData->gradient.data, _NI_*_NX_, 1, "grad" );
 
 
-	/** calculate hessian */
-	*lastHessianDataChangeIdx = -1;
+	/** try to apply few bound changes as low-rank modifications instead of rebuilding blocks */
+	qpData->isCholHessianUpToDate = QPDUNES_FALSE;
+	if ( qpDUNES_updateNewtonSystem( qpData, firstHessianDataChangeIdx, lastHessianDataChangeIdx ) == QPDUNES_TRUE ) {
+		return QPDUNES_OK;
+	}
 
-	/* 1) diagonal blocks */
-	/*    E_{k+1} P_{k+1}^-1 E_{k+1}' + C_{k} P_{k} C_{k}'  for projected Hessian  P = Z (Z'HZ)^-1 Z'  */
+
+	/** look up stage contributions of recurring active sets, compute the missing ones */
+	if ( qpData->newtonMemo.nSlots > 0 ) {
+		qpDUNES_lookupNewtonMemo( qpData );
+		memoSlot = qpData->newtonMemo.stageSlot.data;
+		#pragma omp parallel for private(kk,slot) schedule(static) num_threads(qpData->nThreads)
+		for (kk = 0; kk < _NI_ + 1; ++kk) {
+			if ( memoSlot[kk] >= 0 ) {
+				slot = &(memoSlots[memoSlot[kk]]);
+				if ( slot->fillStage == kk ) {
+					qpDUNES_fillNewtonMemo( qpData, intervals[kk], slot );
+				}
+			}
+		}
+	}
+
+
+	/** calculate hessian */
+	/* one sweep over the stages: iteration kk builds the diagonal block
+	 *    E_{k+1} P_{k+1}^-1 E_{k+1}' + C_{k} P_{k} C_{k}'  for projected Hessian  P = Z (Z'HZ)^-1 Z'
+	 * and the sub-diagonal block
+	 *    - C_{k} P_{k} E_{k}'
+	 * so that the projection data of stage kk is fetched and factorized once */
+	#pragma omp parallel for private(kk,ii,jj,nFree,rebuildDiag,rebuildSubDiag,workspace,xVecTmp,xxMatTmp,xxMatTmp2,uxMatTmp,zxMatTmp,zxMatTmp2,slot) firstprivate(ZT,cholProjHess) reduction(min:firstChangeIdx) reduction(max:lastChangeIdx) schedule(static) num_threads(qpData->nThreads)
 	for (kk = 0; kk < _NI_; ++kk) {
-		/* check whether block needs to be recomputed */
-		if ( (intervals[kk]->rebuildHessianBlock == QPDUNES_TRUE) || (intervals[kk+1]->rebuildHessianBlock == QPDUNES_TRUE)
-//		if ( 1
-			 ) {
-			if ( kk > *lastHessianDataChangeIdx )	*lastHessianDataChangeIdx = kk;
-			#ifdef __DEBUG__
-			if (qpData->options.printLevel >= 4) {
-				qpDUNES_printf("rebuilt diagonal block %d of %d", kk, _NI_-1);
+		/* check whether blocks need to be recomputed */
+		rebuildDiag = ( (intervals[kk]->rebuildHessianBlock == QPDUNES_TRUE) || (intervals[kk+1]->rebuildHessianBlock == QPDUNES_TRUE) ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+		rebuildSubDiag = ( (kk > 0) && (intervals[kk]->rebuildHessianBlock == QPDUNES_TRUE) ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+		if ( rebuildDiag == QPDUNES_FALSE ) {
+			continue;	/* sub-diagonal block can only change together with diagonal block */
+		}
+
+		if ( kk < firstChangeIdx )	firstChangeIdx = kk;
+		if ( kk > lastChangeIdx )	lastChangeIdx = kk;
+		workspace = &(qpData->threadWorkspace[qpDUNES_getThreadNum()]);
+		xVecTmp = &(workspace->xVecTmp);
+		xxMatTmp = &(workspace->xxMatTmp);
+		xxMatTmp2 = &(workspace->xxMatTmp2);
+		uxMatTmp = &(workspace->uxMatTmp);
+		zxMatTmp = &(workspace->zxMatTmp);
+		zxMatTmp2 = &(workspace->xzMatTmp);
+		#ifdef __DEBUG__
+		if (qpData->options.printLevel >= 4) {
+			qpDUNES_printf("rebuilt diagonal block %d of %d", kk, _NI_-1);
+			if (rebuildSubDiag == QPDUNES_TRUE) {
+				qpDUNES_printf("rebuilt off-diag block %d of %d", kk, _NI_-1);
 			}
-			#endif
-			/* get EPE part */
-			if (intervals[kk + 1]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_QPOASES)
-			{
-				for (ii=0; ii<_NX_*_NZ_; ++ii)	{
-					zxMatTmp2->data[ii] = 0;	/* wipe out matrices for safety */
-				}
-				for (ii=0; ii<_NX_*_NX_; ++ii)	{
-					xxMatTmp->data[ii] = 0;	/* wipe out matrices for safety */
-				}
+		}
+		#endif
+
+		/* 1) get EPE part of diagonal block from stage kk+1 */
+		if ( ( memoSlot != 0 ) && ( memoSlot[kk + 1] >= 0 ) )
+		{
+			slot = &(memoSlots[memoSlot[kk + 1]]);
+			xxMatTmp->sparsityType = QPDUNES_DENSE;
+			for (ii=0; ii<_NX_*_NX_; ++ii)	{
+				xxMatTmp->data[ii] = slot->EPE.data[ii];
+			}
+		}
+		else if (intervals[kk + 1]->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_CLIPPING)
+		{
+			for (ii=0; ii<_NX_*_NZ_; ++ii)	{
+				zxMatTmp2->data[ii] = 0;	/* wipe out matrices for safety */
+			}
+			for (ii=0; ii<_NX_*_NX_; ++ii)	{
+				xxMatTmp->data[ii] = 0;	/* wipe out matrices for safety */
+			}
+			if (intervals[kk + 1]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_BOXQP) {
+				boxQpSolver_getZT(qpData, intervals[kk + 1], &nFree, &ZT);
+				boxQpSolver_getCholZTHZ(qpData, intervals[kk + 1], &cholProjHess);
+			}
+			else {
 				qpOASES_getZT(qpData, intervals[kk + 1]->qpSolverQpoases.qpoasesObject, &nFree,	&ZT);
 				qpOASES_getCholZTHZ(qpData, intervals[kk + 1]->qpSolverQpoases.qpoasesObject, &cholProjHess);
-				backsolveRT_ZTET(qpData, zxMatTmp2, &cholProjHess, &ZT, xVecTmp, intervals[kk + 1]->nV, nFree);
-				boolean_t addToRes = QPDUNES_FALSE;
-				multiplyMatrixTMatrixDenseDense(xxMatTmp->data, zxMatTmp2->data, zxMatTmp2->data, nFree, _NX_, _NX_, addToRes);
-//				if (kk == 1) qpDUNES_printMatrixData( ZT.data, _NZ_, _NZ_, "EE: Z' [%d] (nfree = %d)", kk, nFree );
-//				if (kk == 1) qpDUNES_printMatrixData( cholProjHess.data, _NZ_, _NZ_, "EE: cholProjHess [%d] (nfree = %d)", kk, nFree );
-//				if (kk == 1) qpDUNES_printMatrixData( zxMatTmp2->data, _NZ_, _NX_, "EE: EPE sqrt[%d]", kk );
-//				if (kk == 1) qpDUNES_printMatrixData( xxMatTmp->data, _NX_, _NX_, "EE: EPE[%d] (with nFree = %d)", kk, nFree );
 			}
-			else { /* clipping QP solver */
+			backsolveRT_ZTET(qpData, zxMatTmp2, &cholProjHess, &ZT, xVecTmp, intervals[kk + 1]->nV, nFree);
+			boolean_t addToRes = QPDUNES_FALSE;
+			multiplyZxTZx(qpData, xxMatTmp, zxMatTmp2, zxMatTmp2, nFree, addToRes);
+//			if (kk == 1) qpDUNES_printMatrixData( xxMatTmp->data, _NX_, _NX_, "EE: EPE[%d] (with nFree = %d)", kk, nFree );
+		}
+		else { /* clipping QP solver */
 
-				getInvQ(qpData, xxMatTmp, &(intervals[kk + 1]->cholH), intervals[kk + 1]->nV); /* getInvQ not supported with matrices other than diagonal... is this even possible? */
+			getInvQ(qpData, xxMatTmp, &(intervals[kk + 1]->cholH), intervals[kk + 1]->nV); /* getInvQ not supported with matrices other than diagonal... is this even possible? */
 
-				/* Annihilate columns in invQ; note: this can only be applied for diagonal matrices */
-				qpDUNES_makeMatrixDense(xxMatTmp, _NX_, _NX_);
-				for (ii = 0; ii < _NX_; ++ii) {
-					if ((intervals[kk + 1]->y.data[2 * ii] >= qpData->options.equalityTolerance) ||		// check if local constraint lb_x is active
-						(intervals[kk + 1]->y.data[2 * ii + 1] >= qpData->options.equalityTolerance))	// check if local constraint ub_x is active		// WARNING: weakly active constraints are excluded here!
-					/* check if a bound is active. WARNING: WEAKLY ACTIVE CONSTRAINTS ARE EXCLUDED HERE! */
-//					if ( intervals[kk + 1]->y.data[2 * ii] * intervals[kk + 1]->y.data[2 * ii + 1] <= -qpData->options.activenessTolerance )
-					{
-						xxMatTmp->data[ii * _NX_ + ii] = 0.;
-					}
+			/* Annihilate columns in invQ; note: this can only be applied for diagonal matrices */
+			qpDUNES_makeMatrixDense(xxMatTmp, _NX_, _NX_);
+			for (ii = 0; ii < _NX_; ++ii) {
+				if ((intervals[kk + 1]->y.data[2 * ii] >= qpData->options.equalityTolerance) ||		// check if local constraint lb_x is active
+					(intervals[kk + 1]->y.data[2 * ii + 1] >= qpData->options.equalityTolerance))	// check if local constraint ub_x is active		// WARNING: weakly active constraints are excluded here!
+				/* check if a bound is active. WARNING: WEAKLY ACTIVE CONSTRAINTS ARE EXCLUDED HERE! */
+//				if ( intervals[kk + 1]->y.data[2 * ii] * intervals[kk + 1]->y.data[2 * ii + 1] <= -qpData->options.activenessTolerance )
+				{
+					xxMatTmp->data[ii * _NX_ + ii] = 0.;
 				}
-//				if (kk == 1) qpDUNES_printMatrixData( xxMatTmp->data, _NX_, _NX_, "clipping: EPE part[%d]", kk );
 			}
+//			if (kk == 1) qpDUNES_printMatrixData( xxMatTmp->data, _NX_, _NX_, "clipping: EPE part[%d]", kk );
+		}
 
-			/* add CPC part */
-			if (intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_QPOASES)
-			{
-				for (ii=0; ii<_NX_*_NZ_; ++ii)	{
-					zxMatTmp2->data[ii] = 0;	/* wipe out matrices for safety */
-					zxMatTmp->data[ii] = 0;	/* wipe out matrices for safety */
-				}
-				/* get data from qpOASES */
-				qpOASES_getZT(qpData, intervals[kk]->qpSolverQpoases.qpoasesObject,	&nFree, &ZT);
-				qpOASES_getCholZTHZ(qpData,	intervals[kk]->qpSolverQpoases.qpoasesObject, &cholProjHess);
-				/* computer Z.T * C.T */
-				zx_matrix_t* ZTCT = zxMatTmp;
-				multiplyMatrixMatrixTDenseDense(ZTCT->data, ZT.data, intervals[kk]->C.data, nFree, _NZ_, _NX_);
-				/* compute "squareroot" of C_{k} P_{k} C_{k}' */
-				backsolveRT_ZTCT(qpData, zxMatTmp2, &cholProjHess, ZTCT, xVecTmp, intervals[kk]->nV, nFree);
-				/* compute C_{k} P_{k} C_{k}' contribution */
-				boolean_t addToRes = QPDUNES_TRUE;
-				multiplyMatrixTMatrixDenseDense(xxMatTmp->data, zxMatTmp2->data, zxMatTmp2->data, nFree, _NX_, _NX_, addToRes);
-//				if (kk == 1) qpDUNES_printMatrixData( ZT.data, _NZ_, _NZ_, "Z' [%d] (nfree = %d)", kk, nFree );
-//				if (kk == 1) qpDUNES_printMatrixData( ZTCT->data, _NZ_, _NX_, "ZTCT [%d] (nfree = %d)", kk, nFree );
-//				if (kk == 1) qpDUNES_printMatrixData( zxMatTmp2->data, _NZ_, _NX_, "CPC sqrt[%d]", kk );
-//				if (kk == 1) qpDUNES_printMatrixData( xxMatTmp->data, _NX_, _NX_, "EPE+CPC[%d]", kk );
-			}
-			else { /* clipping QP solver */
-				addCInvHCT(qpData, xxMatTmp, &(intervals[kk]->cholH), &(intervals[kk]->C), &(intervals[kk]->y), xxMatTmp2, uxMatTmp, zxMatTmp);
-//				if (kk == 1) qpDUNES_printMatrixData( xxMatTmp->data, _NX_, _NX_, "clipping: CPC+ EPE part[%d]", kk );
-			}
-
-			/* write Hessian part */
-			for (ii = 0; ii < _NX_; ++ii) {
-				for (jj = 0; jj < _NX_; ++jj) {
-					accHessian( kk, 0, ii, jj ) = xxMatTmp->data[ii * _NX_ + jj];
-					/* clean xxMatTmp */
-					xxMatTmp->data[ii * _NX_ + jj] = 0.; /* TODO: this cleaning part is probably not needed, but we need to be very careful if we decide to leave it out! */
+		/* 2) add CPC part of diagonal block and build sub-diagonal block from stage kk */
+		if ( ( memoSlot != 0 ) && ( memoSlot[kk] >= 0 ) )
+		{
+			slot = &(memoSlots[memoSlot[kk]]);
+			/* same products as below, from the memoized factor */
+			if (intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_BOXQP) {
+				multiplyZxTZx(qpData, xxMatTmp, &(slot->CPCFactor), &(slot->CPCFactor), slot->nFree, QPDUNES_TRUE);
+			}
+			else {
+				addMultiplyMatrixInvMatrixMatrixTFromFactor(qpData, xxMatTmp, &(intervals[kk]->cholH), &(intervals[kk]->C), intervals[kk]->y.data, &(slot->CPCFactor), _NX_, _NZ_);
+			}
+			if (rebuildSubDiag == QPDUNES_TRUE) {
+				for (ii = 0; ii < _NX_; ++ii) {
+					for (jj = 0; jj < _NX_; ++jj) {
+						accHessian( kk, -1, ii, jj ) = - slot->CPE.data[ii * _NX_ + jj];
+					}
 				}
 			}
 		}
-	}	/* END OF diagonal block for loop */
-
-	/* 2) sub-diagonal blocks */
-	for (kk = 1; kk < _NI_; ++kk) {
-		if ( (intervals[kk]->rebuildHessianBlock == QPDUNES_TRUE) )
-//		if ( 1 )
+		else if (intervals[kk]->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_CLIPPING)
 		{
-			if ( kk > *lastHessianDataChangeIdx )	*lastHessianDataChangeIdx = kk;
-			#ifdef __DEBUG__
-			if (qpData->options.printLevel >= 4) {
-				qpDUNES_printf("rebuilt off-diag block %d of %d", kk, _NI_-1);
+			for (ii=0; ii<_NX_*_NZ_; ++ii)	{
+				zxMatTmp2->data[ii] = 0;	/* wipe out matrices for safety */
+				zxMatTmp->data[ii] = 0;	/* wipe out matrices for safety */
 			}
-			#endif
-			if (intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_QPOASES) {
-				/* get data from qpOASES */
+			/* get data from stage QP solver */
+			if (intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_BOXQP) {
+				boxQpSolver_getZT(qpData, intervals[kk], &nFree, &ZT);
+				boxQpSolver_getCholZTHZ(qpData, intervals[kk], &cholProjHess);
+			}
+			else {
 				qpOASES_getZT(qpData, intervals[kk]->qpSolverQpoases.qpoasesObject,	&nFree, &ZT);
 				qpOASES_getCholZTHZ(qpData,	intervals[kk]->qpSolverQpoases.qpoasesObject, &cholProjHess);
-
-				/* compute "squareroot" of C_{k} P_{k} C_{k}' */
-				/* computer Z.T * C.T */
-				multiplyMatrixMatrixTDenseDense(zxMatTmp->data, ZT.data, intervals[kk]->C.data, nFree, _NZ_, _NX_);
-				backsolveRT_ZTCT(qpData, zxMatTmp2, &cholProjHess, zxMatTmp, xVecTmp, intervals[kk]->nV, nFree);
-
+			}
+			/* computer Z.T * C.T */
+			zx_matrix_t* ZTCT = zxMatTmp;
+			multiplyMatrixMatrixTDenseDense(ZTCT->data, ZT.data, intervals[kk]->C.data, nFree, _NZ_, _NX_);
+			/* compute "squareroot" of C_{k} P_{k} C_{k}'; shared by both blocks */
+			backsolveRT_ZTCT(qpData, zxMatTmp2, &cholProjHess, ZTCT, xVecTmp, intervals[kk]->nV, nFree);
+			/* compute C_{k} P_{k} C_{k}' contribution */
+			boolean_t addToRes = QPDUNES_TRUE;
+			multiplyZxTZx(qpData, xxMatTmp, zxMatTmp2, zxMatTmp2, nFree, addToRes);
+//			if (kk == 1) qpDUNES_printMatrixData( xxMatTmp->data, _NX_, _NX_, "EPE+CPC[%d]", kk );
+
+			if (rebuildSubDiag == QPDUNES_TRUE) {
 				/* compute "squareroot" of E_{k} P_{k} E_{k}' */
 				backsolveRT_ZTET(qpData, zxMatTmp, &cholProjHess, &ZT, xVecTmp, intervals[kk]->nV, nFree);
 
 				/* compute C_{k} P_{k} E_{k}' contribution */
-				boolean_t addToRes = QPDUNES_FALSE;
-				multiplyMatrixTMatrixDenseDense(xxMatTmp->data, zxMatTmp2->data, zxMatTmp->data, nFree, _NX_, _NX_, addToRes);
+				addToRes = QPDUNES_FALSE;
+				multiplyZxTZx(qpData, xxMatTmp2, zxMatTmp2, zxMatTmp, nFree, addToRes);
 
 				/* write Hessian part */
 				for (ii = 0; ii < _NX_; ++ii) {
 					for (jj = 0; jj < _NX_; ++jj) {
-						accHessian( kk, -1, ii, jj ) = - xxMatTmp->data[ii * _NX_ + jj];
+						accHessian( kk, -1, ii, jj ) = - xxMatTmp2->data[ii * _NX_ + jj];
 					}
 				}
 			}
-			else { /* clipping QP solver */
-				multiplyAInvQ( qpData, &(qpData->xxMatTmp), &(intervals[kk]->C), &(intervals[kk]->cholH) );
+		}
+		else { /* clipping QP solver */
+			addCInvHCT(qpData, xxMatTmp, &(intervals[kk]->cholH), &(intervals[kk]->C), &(intervals[kk]->y), xxMatTmp2, uxMatTmp, zxMatTmp, xVecTmp);
+//			if (kk == 1) qpDUNES_printMatrixData( xxMatTmp->data, _NX_, _NX_, "clipping: CPC+ EPE part[%d]", kk );
+
+			if (rebuildSubDiag == QPDUNES_TRUE) {
+				multiplyAInvQ( qpData, xxMatTmp2, &(intervals[kk]->C), &(intervals[kk]->cholH) );
 
 				/* write Hessian part */
 				for (ii=0; ii<_NX_; ++ii) {
@@ -780,7 +955,7 @@ return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData,
 						/* check if a bound is active. WARNING: WEAKLY ACTIVE CONSTRAINTS ARE EXCLUDED HERE! */
 //						if ( intervals[kk]->y.data[2 * jj] * intervals[kk]->y.data[2 * jj + 1] > -qpData->options.activenessTolerance )
 						{
-							accHessian( kk, -1, ii, jj ) = - xxMatTmp->data[ii * _NX_ + jj];
+							accHessian( kk, -1, ii, jj ) = - xxMatTmp2->data[ii * _NX_ + jj];
 						}
 						else {
 							/* eliminate column if variable bound is active */
@@ -790,7 +965,37 @@ return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData,
 				}
 			}
 		}
-	}	/* END OF sub-diagonal block for loop */
+
+		/* write diagonal Hessian part */
+		for (ii = 0; ii < _NX_; ++ii) {
+			for (jj = 0; jj < _NX_; ++jj) {
+				accHessian( kk, 0, ii, jj ) = xxMatTmp->data[ii * _NX_ + jj];
+				/* clean xxMatTmp */
+				xxMatTmp->data[ii * _NX_ + jj] = 0.; /* TODO: this cleaning part is probably not needed, but we need to be very careful if we decide to leave it out! */
+			}
+		}
+	}	/* END OF Newton Hessian block for loop */
+
+	/* remember active sets the rebuilt blocks are based on */
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		if ( ( intervals[kk]->rebuildHessianBlock == QPDUNES_TRUE ) &&
+			 ( intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_CLIPPING ) )
+		{
+			for (ii = 0; ii < intervals[kk]->nV; ++ii) {
+				intervals[kk]->hessianActSet.data[ii] = qpDUNES_isBoundActiveInNewtonHessian( qpData, intervals[kk], ii );
+			}
+		}
+		if ( ( intervals[kk]->rebuildHessianBlock == QPDUNES_TRUE ) &&
+			 ( intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_BOXQP ) )
+		{
+			for (ii = 0; ii < intervals[kk]->nV; ++ii) {
+				intervals[kk]->hessianActSet.data[ii] = ( intervals[kk]->qpSolverBoxQp.actSet.data[ii] != 0 ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+			}
+		}
+	}
+
+	*firstHessianDataChangeIdx = ( lastChangeIdx >= 0 ) ? firstChangeIdx : -1;
+	*lastHessianDataChangeIdx = lastChangeIdx;
 
 //	qpDUNES_printMatrixData( qpData->hessian.data, _NI_*_NX_, 2*_NX_, "H = ");
 
@@ -798,6 +1003,186 @@ return_t qpDUNES_setupNewtonSystem(	qpData_t* const qpData,
 }
 /*<<< END OF qpDUNES_setupNewtonSystem */
 
+
+/* ----------------------------------------------
+ * Apply bound changes of clipping stages as rank-one modifications
+ *
+ *   Stage k contributes [E_k; -C_k] P_k [E_k; -C_k]' to block rows k-1 and k
+ *   of the Newton Hessian. For a diagonal stage Hessian, (de)activating bound i
+ *   removes (adds) H_ii^-1 e_i e_i' from (to) P_k, i.e., a rank-one term
+ *   sigma * v v' with v = H_ii^-1/2 [E_k e_i; -C_k e_i], sigma = -1 (+1).
+ *   The Newton Hessian blocks are modified in place, the band factor by a
+ *   Cholesky up- or downdate. Updates are applied before downdates.
+ *
+ *   Returns QPDUNES_FALSE if the bound changes need to be handled by block
+ *   rebuild and refactorization instead.
+ *
+ >>>>>>                                           */
+boolean_t qpDUNES_updateNewtonSystem(	qpData_t* const qpData,
+										int_t* const firstHessianDataChangeIdx,
+										int_t* const lastHessianDataChangeIdx
+										)
+{
+	int_t ii, jj, kk, ll;
+	int_t nChgdBounds = 0;
+	int_t firstChangeIdx = _NI_;
+	int_t lastChangeIdx = -1;
+	int_t blockIdxStart;
+	boolean_t isBoundActive;
+	boolean_t isFactorUpdated = QPDUNES_TRUE;
+	real_t sigma;
+	real_t invHii;
+
+	interval_t* interval;
+	xz_matrix_t* C;
+	xn2x_matrix_t* hessian = &(qpData->hessian);
+	xn_vector_t* updateVec = &(qpData->xnVecTmp);
+
+	if ( ( qpData->options.nwtnHssnMaxRankUpdates <= 0 ) ||
+		 ( qpData->isCholHessianUpdatable == QPDUNES_FALSE ) )
+	{
+		return QPDUNES_FALSE;
+	}
+
+	/* check that all flagged blocks only see a few bound changes of the clipping solver */
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
+		if ( interval->rebuildHessianBlock == QPDUNES_FALSE )	continue;
+
+		if ( ( interval->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_CLIPPING ) ||
+			 ( ( interval->cholH.sparsityType != QPDUNES_DIAGONAL ) && ( interval->cholH.sparsityType != QPDUNES_IDENTITY ) ) )
+		{
+			return QPDUNES_FALSE;
+		}
+
+		jj = 0;
+		for (ii = 0; ii < interval->nV; ++ii) {
+			if ( qpDUNES_isBoundActiveInNewtonHessian( qpData, interval, ii ) != (boolean_t)interval->hessianActSet.data[ii] )	++jj;
+		}
+		if ( jj == 0 ) {	/* block flagged for some other reason, e.g., data change */
+			return QPDUNES_FALSE;
+		}
+		nChgdBounds += jj;
+		if ( nChgdBounds > qpData->options.nwtnHssnMaxRankUpdates ) {
+			return QPDUNES_FALSE;
+		}
+		if ( firstChangeIdx == _NI_ )	firstChangeIdx = qpDUNES_max( kk-1, 0 );
+		lastChangeIdx = qpDUNES_min( kk, _NI_-1 );
+	}
+	if ( nChgdBounds == 0 ) {	/* nothing to do, keep factor as it is */
+		return QPDUNES_FALSE;
+	}
+
+	/* apply updates (sigma = 1, bound released) first, then downdates (sigma = -1, bound activated) */
+	for (sigma = 1.; sigma > -2.; sigma -= 2.) {
+		for (kk = 0; kk < _NI_ + 1; ++kk) {
+			interval = qpData->intervals[kk];
+			if ( interval->rebuildHessianBlock == QPDUNES_FALSE )	continue;
+			C = &(interval->C);
+
+			for (ii = 0; ii < interval->nV; ++ii) {
+				isBoundActive = qpDUNES_isBoundActiveInNewtonHessian( qpData, interval, ii );
+				if ( ( isBoundActive == (boolean_t)interval->hessianActSet.data[ii] ) ||
+					 ( ( isBoundActive == QPDUNES_TRUE ) != ( sigma < 0. ) ) )
+				{
+					continue;
+				}
+				#ifdef __DEBUG__
+				if (qpData->options.printLevel >= 4) {
+					qpDUNES_printf("rank-one %s of Newton Hessian for bound [%d,%d]", (sigma > 0.) ? "update" : "downdate", kk, ii);
+				}
+				#endif
+
+				/* cholH holds the actual matrix in the diagonal case */
+				invHii = ( interval->cholH.sparsityType == QPDUNES_DIAGONAL ) ? 1./interval->cholH.data[ii] : 1.;
+
+				/* modify Newton Hessian blocks */
+				if ( ( kk > 0 ) && ( ii < _NX_ ) ) {	/* E P E' part */
+					accHessian( kk-1, 0, ii, ii ) += sigma * invHii;
+				}
+				if ( kk < _NI_ ) {
+					for (jj = 0; jj < _NX_; ++jj) {		/* C P C' part */
+						for (ll = 0; ll < _NX_; ++ll) {
+							accHessian( kk, 0, jj, ll ) += sigma * invHii * accC( jj, ii ) * accC( ll, ii );
+						}
+					}
+					if ( ( kk > 0 ) && ( ii < _NX_ ) ) {	/* - C P E' part */
+						for (jj = 0; jj < _NX_; ++jj) {
+							accHessian( kk, -1, jj, ii ) -= sigma * invHii * accC( jj, ii );
+						}
+					}
+				}
+
+				/* modify factor; once a modification failed it is refactored anyways */
+				if ( isFactorUpdated == QPDUNES_TRUE ) {
+					for (jj = 0; jj < _NX_ * _NI_; ++jj) {
+						updateVec->data[jj] = 0.;
+					}
+					if ( ( kk > 0 ) && ( ii < _NX_ ) ) {
+						updateVec->data[(kk-1)*_NX_ + ii] = sqrt( invHii );
+					}
+					if ( kk < _NI_ ) {
+						for (jj = 0; jj < _NX_; ++jj) {
+							updateVec->data[kk*_NX_ + jj] = - sqrt( invHii ) * accC( jj, ii );
+						}
+					}
+
+					switch (qpData->options.nwtnHssnFacAlg) {
+						case QPDUNES_NH_FAC_BAND_FORWARD:
+							blockIdxStart = ( ( kk > 0 ) && ( ii < _NX_ ) ) ? kk-1 : kk;
+							isFactorUpdated = ( qpDUNES_updateNewtonHessianFactor( qpData, &(qpData->cholHessian), qpData->cholHessianBlockSparsity, updateVec, sigma, blockIdxStart ) == QPDUNES_OK ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+							break;
+
+						case QPDUNES_NH_FAC_BAND_REVERSE:
+							blockIdxStart = qpDUNES_min( kk, _NI_-1 );
+							isFactorUpdated = ( qpDUNES_updateNewtonHessianFactorBottomUp( qpData, &(qpData->cholHessian), qpData->cholHessianBlockSparsity, updateVec, sigma, blockIdxStart ) == QPDUNES_OK ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+							break;
+
+						default:
+							isFactorUpdated = QPDUNES_FALSE;
+							break;
+					}
+					#ifdef __DEBUG__
+					if ( ( isFactorUpdated == QPDUNES_FALSE ) && ( qpData->options.printLevel >= 3 ) ) {
+						qpDUNES_printf("[qpDUNES] Newton Hessian factor modification failed, refactorizing");
+					}
+					#endif
+				}
+
+				interval->hessianActSet.data[ii] = isBoundActive;
+			}
+		}
+	}
+
+	/* a failed factor modification is repaired by partial refactorization from the last changed block */
+	qpData->isCholHessianUpToDate = isFactorUpdated;
+	*firstHessianDataChangeIdx = firstChangeIdx;
+	*lastHessianDataChangeIdx = lastChangeIdx;
+
+	return QPDUNES_TRUE;
+}
+/*<<< END OF qpDUNES_updateNewtonSystem */
+
+
+/* ----------------------------------------------
+ * Activity of a stage variable bound as seen by the Newton Hessian setup
+ *
+ >>>>>>                                           */
+boolean_t qpDUNES_isBoundActiveInNewtonHessian(	const qpData_t* const qpData,
+												const interval_t* const interval,
+												int_t varIdx
+												)
+{
+	/* WARNING: weakly active constraints are considered inactive, see qpDUNES_setupNewtonSystem */
+	if ( ( interval->y.data[2 * varIdx] <= qpData->options.equalityTolerance ) &&		/* lower bound inactive */
+		 ( interval->y.data[2 * varIdx + 1] <= qpData->options.equalityTolerance ) )	/* upper bound inactive */
+	{
+		return QPDUNES_FALSE;
+	}
+	return QPDUNES_TRUE;
+}
+/*<<< END OF qpDUNES_isBoundActiveInNewtonHessian */
+
 /* ----------------------------------------------
  * ...
  *
@@ -806,19 +1191,41 @@ return_t qpDUNES_setupUnconstrainedNewtonSystem(	qpData_t* const qpData	)
 {
 	int_t ii, jj, kk;
 	boolean_t isHessianRegularized;
+	int_t nRefactoredBlocks;
 
-	xx_matrix_t* xxMatTmp = &(qpData->xxMatTmp);
-	xx_matrix_t* xxMatTmp2 = &(qpData->xxMatTmp2);
-	ux_matrix_t* uxMatTmp = &(qpData->uxMatTmp);
-	zx_matrix_t* zxMatTmp = &(qpData->zxMatTmp);
+	/* workspace of the executing thread */
+	threadWorkspace_t* workspace;
+	x_vector_t* xVecTmp;
+	xx_matrix_t* xxMatTmp;
+	xx_matrix_t* xxMatTmp2;
+	ux_matrix_t* uxMatTmp;
+	zx_matrix_t* zxMatTmp;
 
 	interval_t** intervals = qpData->intervals;
 
 	xn2x_matrix_t* hessian = &(qpData->unconstrainedHessian);
 
+	/* stages sharing a Hessian factor and dynamics have equal blocks, which are copied in 3) */
+	int_t* diagSource = 0;
+	int_t* subDiagSource = 0;
+	if ( qpData->factorCache.entries != 0 ) {
+		qpDUNES_findSharedNewtonBlocks( qpData );
+		diagSource = qpData->factorCache.newtonBlockSource.data;
+		subDiagSource = &(qpData->factorCache.newtonBlockSource.data[_NI_]);
+	}
+
 	/* 1) diagonal blocks */
 	/*    E_{k+1} H_{k+1}^-1 E_{k+1}' + C_{k} P_{k} C_{k}'  for projected Hessian  P = Z (Z'HZ)^-1 Z'  */
+	#pragma omp parallel for private(kk,ii,jj,workspace,xVecTmp,xxMatTmp,xxMatTmp2,uxMatTmp,zxMatTmp) schedule(static) num_threads(qpData->nThreads)
 	for (kk = 0; kk < _NI_; ++kk) {
+		if ( ( diagSource != 0 ) && ( diagSource[kk] != kk ) )	continue;
+
+		workspace = &(qpData->threadWorkspace[qpDUNES_getThreadNum()]);
+		xVecTmp = &(workspace->xVecTmp);
+		xxMatTmp = &(workspace->xxMatTmp);
+		xxMatTmp2 = &(workspace->xxMatTmp2);
+		uxMatTmp = &(workspace->uxMatTmp);
+		zxMatTmp = &(workspace->zxMatTmp);
 
 		getInvQ(qpData, xxMatTmp, &(intervals[kk + 1]->cholH), intervals[kk + 1]->nV); /* getInvQ not supported with matrices other than diagonal... is this even possible? */
 
@@ -829,7 +1236,7 @@ return_t qpDUNES_setupUnconstrainedNewtonSystem(	qpData_t* const qpData	)
 
 
 		addCInvHCT(qpData, xxMatTmp, &(intervals[kk]->cholH), &(intervals[kk]->C),
-				0, xxMatTmp2, uxMatTmp, zxMatTmp);
+				0, xxMatTmp2, uxMatTmp, zxMatTmp, xVecTmp);
 //		if (kk == 1) qpDUNES_printMatrixData( xxMatTmp->data, _NX_, _NX_, "clipping: CPC+ EPE part[%d]", kk );
 
 
@@ -846,8 +1253,12 @@ return_t qpDUNES_setupUnconstrainedNewtonSystem(	qpData_t* const qpData	)
 
 
 	/* 2) sub-diagonal blocks */
+	#pragma omp parallel for private(kk,ii,jj,xxMatTmp) schedule(static) num_threads(qpData->nThreads)
 	for (kk = 1; kk < _NI_; ++kk) {
-		multiplyAInvQ( qpData, &(qpData->xxMatTmp), &(intervals[kk]->C), &(intervals[kk]->cholH) );
+		if ( ( subDiagSource != 0 ) && ( subDiagSource[kk] != kk ) )	continue;
+
+		xxMatTmp = &(qpData->threadWorkspace[qpDUNES_getThreadNum()].xxMatTmp);
+		multiplyAInvQ( qpData, xxMatTmp, &(intervals[kk]->C), &(intervals[kk]->cholH) );
 
 		/* write Hessian part */
 		for (ii=0; ii<_NX_; ++ii) {
@@ -857,10 +1268,25 @@ return_t qpDUNES_setupUnconstrainedNewtonSystem(	qpData_t* const qpData	)
 		}
 	}	/* END OF sub-diagonal block for loop */
 
+
+	/* 3) copy blocks of stages with shared Hessian factor */
+	if ( diagSource != 0 ) {
+		#pragma omp parallel for private(kk,ii,jj) schedule(static) num_threads(qpData->nThreads)
+		for (kk = 0; kk < _NI_; ++kk) {
+			for (ii=0; ii<_NX_; ++ii) {
+				for (jj=0; jj<_NX_; ++jj) {
+					if ( diagSource[kk] != kk )		accHessian( kk, 0, ii, jj ) = accHessian( diagSource[kk], 0, ii, jj );
+					if ( subDiagSource[kk] != kk )	accHessian( kk, -1, ii, jj ) = accHessian( subDiagSource[kk], -1, ii, jj );
+				}
+			}
+		}
+	}
+
 //	qpDUNES_printMatrixData( qpData->cholDefaultHessian.data, _NI_*_NX_, 2*_NX_, "H = ");
 
 
-	return qpDUNES_factorNewtonSystem(qpData, &(qpData->cholUnconstrainedHessian), &(qpData->unconstrainedHessian), &isHessianRegularized, -1);
+	qpData->cholUnconstrainedHessianTwistIdx = -1;	/* twisted factorization: refactor entirely */
+	return qpDUNES_factorNewtonSystem(qpData, &(qpData->cholUnconstrainedHessian), &(qpData->unconstrainedHessian), &isHessianRegularized, -1, -1, &(qpData->cholUnconstrainedHessianTwistIdx), qpData->cholUnconstrainedHessianBlockSparsity, &nRefactoredBlocks);
 }
 /*<<< END OF qpDUNES_setupNewtonSystem */
 
@@ -871,16 +1297,20 @@ return_t qpDUNES_setupUnconstrainedNewtonSystem(	qpData_t* const qpData	)
  *
  * >>>>>>                                           */
 return_t qpDUNES_computeNewtonGradient(	qpData_t* const qpData,
-										xn_vector_t* gradient,
-										x_vector_t* gradPiece
+										xn_vector_t* gradient
 										)
 {
 	int_t kk, ii;
 
 	interval_t** intervals = qpData->intervals;
 
+	x_vector_t* gradPiece;
+
 	/* d/(d lambda_ii) for kk=0.._NI_-1 */
+	#pragma omp parallel for private(kk,ii,gradPiece) schedule(static) num_threads(qpData->nThreads)
 	for (kk = 0; kk < _NI_; ++kk) {
+		gradPiece = &(qpData->threadWorkspace[qpDUNES_getThreadNum()].xVecTmp);
+
 //		if ( (kk >= _NI_-4) || (kk == 0) )	qpDUNES_printMatrixData( intervals[kk+1]->z.data, 1, intervals[kk+1]->nV, "z[%3d]:", kk+1);
 		/* ( C_kk*z_kk^opt + c_kk ) - x_(kk+1)^opt */
 		multiplyCz(qpData, gradPiece, &(intervals[kk]->C), &(intervals[kk]->z));
@@ -901,40 +1331,156 @@ return_t qpDUNES_computeNewtonGradient(	qpData_t* const qpData,
 /*<<< END OF computeNewtonGradient */
 
 
-return_t qpDUNES_factorNewtonSystem( qpData_t* const qpData,
-									 xn2x_matrix_t* cholHessian,
-									 xn2x_matrix_t* hessian,
-								  	 boolean_t* const isHessianRegularized,
-								  	 int_t lastActSetChangeIdx
-								  	 )
+/* ----------------------------------------------
+ * dual gradient at the current multipliers:
+ * taken over from the line search if it was
+ * evaluated there at the accepted step size
+ *
+ >>>>>>                                           */
+return_t qpDUNES_updateNewtonGradient(	qpData_t* const qpData
+										)
 {
-	int_t ii, jj, kk;
+	real_t* gradSwap;
 
-	return_t statusFlag;
+	if ( qpData->isGradientCacheValid == QPDUNES_TRUE ) {
+		gradSwap = qpData->gradient.data;
+		qpData->gradient.data = qpData->gradientCache.data;
+		qpData->gradientCache.data = gradSwap;
+		qpData->isGradientCacheValid = QPDUNES_FALSE;
+		return QPDUNES_OK;
+	}
 
-	real_t minDiagElem = qpData->options.QPDUNES_INFTY;
+	return qpDUNES_computeNewtonGradient( qpData, &(qpData->gradient) );
+}
+/*<<< END OF qpDUNES_updateNewtonGradient */
 
-	/* Try to factorize Newton Hessian, to check if positive definite */
-	switch (qpData->options.nwtnHssnFacAlg) {
-		case QPDUNES_NH_FAC_BAND_FORWARD:
-			statusFlag = qpDUNES_factorizeNewtonHessian( qpData, cholHessian, hessian, isHessianRegularized );
-			break;
 
-		case QPDUNES_NH_FAC_BAND_REVERSE:
-			statusFlag = qpDUNES_factorizeNewtonHessianBottomUp( qpData, cholHessian, hessian, lastActSetChangeIdx, isHessianRegularized );
-			break;
+/* ----------------------------------------------
+ * dual gradient for trial step size alpha along the
+ * Newton direction (clipping stage QPs only);
+ * trial primal variables are left in interval->zVecTmp
+ *
+ >>>>>>                                           */
+return_t qpDUNES_computeParametricNewtonGradient(	qpData_t* const qpData,
+													xn_vector_t* gradient,
+													real_t alpha
+													)
+{
+	int_t kk, ii;
+	int_t errCntr = 0;
 
-		default:
+	interval_t* interval;
+	z_vector_t* zTry;
+	x_vector_t* gradPiece;
+
+	#pragma omp parallel private(kk,ii,interval,zTry,gradPiece) num_threads(qpData->nThreads)
+	{
+		/* get primal variables for trial step length */
+		#pragma omp for schedule(static) reduction(+:errCntr)
+		for (kk = 0; kk < _NI_ + 1; ++kk) {
+			interval = qpData->intervals[kk];
+			if ( interval->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_CLIPPING ) {
+				errCntr++;		/* no closed form trial solution, gradient is only an approximation */
+			}
+			zTry = &(interval->zVecTmp);
+			addVectorScaledVector( zTry, &(interval->qpSolverClipping.zUnconstrained), alpha, &(interval->qpSolverClipping.dz), interval->nV );
+			directQpSolver_saturateVector( qpData, zTry, &(interval->y), &(interval->zLow), &(interval->zUpp), &(interval->H), interval->nV );
+		}
+
+		/* ( C_kk*zTry_kk + c_kk ) - xTry_(kk+1) */
+		gradPiece = &(qpData->threadWorkspace[qpDUNES_getThreadNum()].xVecTmp);
+		#pragma omp for schedule(static)
+		for (kk = 0; kk < _NI_; ++kk) {
+			multiplyCz( qpData, gradPiece, &(qpData->intervals[kk]->C), &(qpData->intervals[kk]->zVecTmp) );
+			addToVector( gradPiece, &(qpData->intervals[kk]->c), _NX_ );
+
+			for (ii = 0; ii < _NX_; ++ii) {
+				gradient->data[kk * _NX_ + ii] = gradPiece->data[ii] - qpData->intervals[kk + 1]->zVecTmp.data[ii];
+			}
+		}
+	}
+	if (errCntr > 0) {
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_computeParametricNewtonGradient */
+
+
+return_t qpDUNES_factorNewtonSystem( qpData_t* const qpData,
+									 xn2x_matrix_t* cholHessian,
+									 xn2x_matrix_t* hessian,
+								  	 boolean_t* const isHessianRegularized,
+								  	 int_t firstActSetChangeIdx,
+								  	 int_t lastActSetChangeIdx,
+								  	 int_t* const twistIdx,
+								  	 sparsityType_t* const blockSparsity,
+								  	 int_t* const nRefactoredBlocks
+								  	 )
+{
+	int_t ii, jj, kk;
+	int_t nBlocks, offset;
+
+	return_t statusFlag;
+
+	real_t minDiagElem = qpData->options.QPDUNES_INFTY;
+
+	/* Try to factorize Newton Hessian, to check if positive definite */
+	switch (qpData->options.nwtnHssnFacAlg) {
+		case QPDUNES_NH_FAC_BAND_FORWARD:
+			statusFlag = qpDUNES_factorizeNewtonHessian( qpData, cholHessian, blockSparsity, hessian, isHessianRegularized );
+			*nRefactoredBlocks = _NI_;
+			break;
+
+		case QPDUNES_NH_FAC_BAND_REVERSE:
+			statusFlag = qpDUNES_factorizeNewtonHessianBottomUp( qpData, cholHessian, blockSparsity, hessian, lastActSetChangeIdx, isHessianRegularized );
+			*nRefactoredBlocks = ( lastActSetChangeIdx >= 0 ) ? qpDUNES_min( lastActSetChangeIdx, _NI_-1 ) + 1 : 0;
+			break;
+
+		case QPDUNES_NH_FAC_CYCLIC_REDUCTION:
+			statusFlag = qpDUNES_factorizeNewtonHessianCyclicReduction( qpData, cholHessian, hessian, isHessianRegularized );
+			*nRefactoredBlocks = _NI_;
+			break;
+
+		case QPDUNES_NH_FAC_TWISTED:
+			statusFlag = qpDUNES_factorizeNewtonHessianTwisted( qpData, cholHessian, hessian, firstActSetChangeIdx, lastActSetChangeIdx, twistIdx, nRefactoredBlocks, isHessianRegularized );
+			break;
+
+		default:
 			qpDUNES_printError(qpData, __FILE__, __LINE__, "Unknown Newton Hessian factorization algorithm.");
 			return QPDUNES_ERR_INVALID_ARGUMENT;
 	}
 
 	/* check maximum diagonal element */
 	if (statusFlag == QPDUNES_OK) {
-		for (kk = 0; kk < _NI_; ++kk) {
+		if (qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_CYCLIC_REDUCTION) {
+			/* only eliminated blocks of each level and the last block are factorized */
+			nBlocks = _NI_;
+			offset = 0;
+			while (nBlocks > 1) {
+				for (kk = 1; kk < nBlocks; kk += 2) {
+					for (ii = 0; ii < _NX_; ++ii) {
+						if (minDiagElem > accCholHessian(offset + kk, 0, ii, ii) ) {
+							minDiagElem = accCholHessian(offset + kk, 0, ii, ii);
+						}
+					}
+				}
+				offset += nBlocks;
+				nBlocks = (nBlocks + 1) / 2;
+			}
 			for (ii = 0; ii < _NX_; ++ii) {
-				if (minDiagElem > accCholHessian(kk, 0, ii, ii) ) {
-					minDiagElem = accCholHessian(kk, 0, ii, ii);
+				if (minDiagElem > accCholHessian(offset, 0, ii, ii) ) {
+					minDiagElem = accCholHessian(offset, 0, ii, ii);
+				}
+			}
+		}
+		else {
+			for (kk = 0; kk < _NI_; ++kk) {
+				for (ii = 0; ii < _NX_; ++ii) {
+					if (minDiagElem > accCholHessian(kk, 0, ii, ii) ) {
+						minDiagElem = accCholHessian(kk, 0, ii, ii);
+					}
 				}
 			}
 		}
@@ -1027,15 +1573,25 @@ return_t qpDUNES_factorNewtonSystem( qpData_t* const qpData,
 			break;
 		}
 		*isHessianRegularized = QPDUNES_TRUE;
+		*nRefactoredBlocks += _NI_;
 
 		/* refactor Newton Hessian */
 		switch (qpData->options.nwtnHssnFacAlg) {
 			case QPDUNES_NH_FAC_BAND_FORWARD:
-			statusFlag = qpDUNES_factorizeNewtonHessian( qpData, cholHessian, hessian, isHessianRegularized );
+			statusFlag = qpDUNES_factorizeNewtonHessian( qpData, cholHessian, blockSparsity, hessian, isHessianRegularized );
 			break;
 
 			case QPDUNES_NH_FAC_BAND_REVERSE:
-			statusFlag = qpDUNES_factorizeNewtonHessianBottomUp( qpData, cholHessian, hessian, _NI_+1, isHessianRegularized );	/* refactor full hessian */
+			statusFlag = qpDUNES_factorizeNewtonHessianBottomUp( qpData, cholHessian, blockSparsity, hessian, _NI_+1, isHessianRegularized );	/* refactor full hessian */
+			break;
+
+			case QPDUNES_NH_FAC_CYCLIC_REDUCTION:
+			statusFlag = qpDUNES_factorizeNewtonHessianCyclicReduction( qpData, cholHessian, hessian, isHessianRegularized );
+			break;
+
+			case QPDUNES_NH_FAC_TWISTED:
+			*twistIdx = -1;		/* refactor full hessian */
+			statusFlag = qpDUNES_factorizeNewtonHessianTwisted( qpData, cholHessian, hessian, 0, _NI_+1, twistIdx, &nBlocks, isHessianRegularized );
 			break;
 
 			default:
@@ -1061,20 +1617,36 @@ return_t qpDUNES_factorNewtonSystem( qpData_t* const qpData,
 
 /* ----------------------------------------------
  * Special block tridiagonal Cholesky for special storage format of Newton matrix
- * 
+ *
+ *   Diagonal blocks of the factor that are known to be diagonal (e.g., for
+ *   clipping stages with diagonal H and no active state bounds) are tagged
+ *   QPDUNES_DIAGONAL in cholBlockSparsity and factorized without the
+ *   in-block recursion; the solves skip them as well.
+ *
  >>>>>>                                           */
 return_t qpDUNES_factorizeNewtonHessian( qpData_t* const qpData,
 									  xn2x_matrix_t* const cholHessian,
+									  sparsityType_t* const cholBlockSparsity,
 									  xn2x_matrix_t* const hessian,
 									  boolean_t* isHessianRegularized
 									  )
 {
 	int_t jj, ii, kk, ll;
 	real_t sum;
+	boolean_t isDiagBlock;
 
+	/* vectorized version, if supported by the CPU */
+	if ( qpData->newtonKernels.factorizeForward != 0 ) {
+		return qpData->newtonKernels.factorizeForward( cholHessian->data, cholBlockSparsity, hessian->data, qpData->newtonKernelTmp.data,
+													   (int_t)_NI_, (int_t)_NX_, &(qpData->nhLayout), &(qpData->options), isHessianRegularized );
+	}
 
 	/* go by block columns */
 	for (kk = 0; kk < _NI_; ++kk) {
+		/* tag diagonal blocks; their factor is just the square root of the diagonal */
+		isDiagBlock = qpDUNES_isNewtonHessianBlockDiagonal( qpData, &accHessian(kk,0,0,0), ( kk > 0 ) ? &accCholHessian(kk,-1,0,0) : 0, QPDUNES_FALSE );
+		cholBlockSparsity[kk] = ( isDiagBlock == QPDUNES_TRUE ) ? QPDUNES_DIAGONAL : QPDUNES_DENSE;
+
 		/* go by in-block columns */
 		for (jj = 0; jj < _NX_; ++jj) {
 			/* 1) compute diagonal element: ii == jj */
@@ -1082,9 +1654,11 @@ return_t qpDUNES_factorizeNewtonHessian( qpData_t* const qpData,
 			sum = accHessian(kk,0,jj,jj);
 
 			/* subtract squared forepart of corresponding row: */
-			/*  - this diagonal block */
-			for( ll = 0; ll < jj; ++ll ) {
-				sum -= accCholHessian(kk,0,jj,ll) * accCholHessian(kk,0,jj,ll);
+			/*  - this diagonal block (zero for diagonal blocks) */
+			if ( isDiagBlock == QPDUNES_FALSE ) {
+				for( ll = 0; ll < jj; ++ll ) {
+					sum -= accCholHessian(kk,0,jj,ll) * accCholHessian(kk,0,jj,ll);
+				}
 			}
 			/*  - this row's subdiagonal block */
 			if( kk > 0 ) { /* for all block columns but the first one */
@@ -1092,7 +1666,7 @@ return_t qpDUNES_factorizeNewtonHessian( qpData_t* const qpData,
 					sum -= accCholHessian(kk,-1,jj,ll) * accCholHessian(kk,-1,jj,ll);
 				}
 			}
-			
+
 
 			/* 2) check for too small diagonal elements */
 			if((qpData->options.regType == QPDUNES_REG_SINGULAR_DIRECTIONS) &&	/* Add regularization on too small values already in factorization */
@@ -1104,21 +1678,8 @@ return_t qpDUNES_factorizeNewtonHessian( qpData_t* const qpData,
 					qpDUNES_printf( "Regularized NH[k=%d,j=%d] = %.2e + %.2e", kk, jj, sum, qpData->options.regParam );
 				}
 				#endif
-//				sum += qpData->options.regParam;
 				sum += qpData->options.QPDUNES_INFTY * qpData->options.QPDUNES_INFTY + 1.;
 				*isHessianRegularized = QPDUNES_TRUE;
-				/** -- EXPERIMENTAL -- regularize all diagonal elements after the first one where singularity is detected... */
-//				for( kk=0; kk<_NI_; ++kk ) {
-//					for( jj=0; jj<_NX_; ++jj ) {
-//						accHessian( kk, 0, jj, jj ) += qpData->options.regParam;
-//					}
-//				}
-				/** -- END OF EXPERIMENTAL -- */
-				/* TODO: only log if logging flag switched on */
-//				qpData->log.itLog[0].regDirections.data[kk*_NX_+jj] = -1; //qpData->options.regParam;	/* todo: really log, not only in first iteration... */
-				// TRY
-//				qpData->log.itLog[0].regDirections.data[kk*_NX_+jj] = -qpData->gradient.data[kk*_NX_+jj];
-//				if (kk==51) qpData->log.itLog[0].regDirections.data[kk*_NX_+jj] *= 1./100;
 			}
 			else {
 				if ( sum < qpData->options.newtonHessDiagRegTolerance ) {	/* matrix not positive definite */
@@ -1126,46 +1687,53 @@ return_t qpDUNES_factorizeNewtonHessian( qpData_t* const qpData,
 				}
 			}
 			accCholHessian(kk,0,jj,jj) = sqrt( sum );
-			
+
 
 			/* 3) write remainder of jj-th column: */		// TODO: think about how we can avoid this column-wise access and postpone until the respective element is needed */
 			/*  - this diagonal block */
-			for( ii=(jj+1); ii<_NX_; ++ii )
-			{
-				sum = accHessian(kk,0,ii,jj);
-				
-				/* subtract forepart of this row times forepart of jj-th row */
-				/*  - diagonal block */
-				for( ll = 0; ll < jj; ++ll ) {	
-					sum -= accCholHessian(kk,0,ii,ll) * accCholHessian(kk,0,jj,ll);
-				}
-				/*  - subdiagonal block */
-				if( kk > 0 ) {	/* for all block columns but the first one */
-					for( ll = 0; ll < _NX_; ++ll ) {
-						sum -= accCholHessian(kk,-1,ii,ll) * accCholHessian(kk,-1,jj,ll);
+			if ( isDiagBlock == QPDUNES_FALSE ) {
+				for( ii=(jj+1); ii<_NX_; ++ii )
+				{
+					sum = accHessian(kk,0,ii,jj);
+
+					/* subtract forepart of this row times forepart of jj-th row */
+					/*  - diagonal block */
+					for( ll = 0; ll < jj; ++ll ) {
+						sum -= accCholHessian(kk,0,ii,ll) * accCholHessian(kk,0,jj,ll);
+					}
+					/*  - subdiagonal block */
+					if( kk > 0 ) {	/* for all block columns but the first one */
+						for( ll = 0; ll < _NX_; ++ll ) {
+							sum -= accCholHessian(kk,-1,ii,ll) * accCholHessian(kk,-1,jj,ll);
+						}
 					}
-				}
 
-				accCholHessian(kk,0,ii,jj) = sum / accCholHessian(kk,0,jj,jj);
+					accCholHessian(kk,0,ii,jj) = sum / accCholHessian(kk,0,jj,jj);
+				}
+			}
+			else {
+				for( ii=(jj+1); ii<_NX_; ++ii ) {
+					accCholHessian(kk,0,ii,jj) = 0.;
+				}
 			}
 			/*  - following row's subdiagonal block */
 			if( kk < _NI_-1 ) {	/* for all block columns but the last one */
 				for( ii=0; ii<_NX_; ++ii )
 				{
 					sum = accHessian(kk+1,-1,ii,jj);
-					
+
 					/* subtract forepart of this row times forepart of jj-th row (only this block is non-zero) */
-					for( ll = 0; ll < jj; ++ll ) {	
-						sum -= accCholHessian(kk+1,-1,ii,ll) * accCholHessian(kk,0,jj,ll);
+					if ( isDiagBlock == QPDUNES_FALSE ) {
+						for( ll = 0; ll < jj; ++ll ) {
+							sum -= accCholHessian(kk+1,-1,ii,ll) * accCholHessian(kk,0,jj,ll);
+						}
 					}
-					
+
 					accCholHessian(kk+1,-1,ii,jj) = sum / accCholHessian(kk,0,jj,jj);
 				}
 			}
 		} /* next column */
-		} /* next block column */
-
-//	qpDUNES_factorizeNewtonHessianBottomUp( qpData, cholHessian, hessian, isHessianRegularized );
+	} /* next block column */
 
 	return QPDUNES_OK;
 }
@@ -1174,9 +1742,12 @@ return_t qpDUNES_factorizeNewtonHessian( qpData_t* const qpData,
 /* ----------------------------------------------
  * Bottom-up block-tridiagonal Cholesky for special storage format of Newton matrix
  *
+ *   Tags diagonal blocks of the factor like qpDUNES_factorizeNewtonHessian.
+ *
  >>>>>>                                           */
 return_t qpDUNES_factorizeNewtonHessianBottomUp(	qpData_t* const qpData,
 													xn2x_matrix_t* const cholHessian,
+													sparsityType_t* const cholBlockSparsity,
 													xn2x_matrix_t* const hessian,
 													int_t lastActSetChangeIdx, 			/**< index from where the reverse factorization is restarted */
 													boolean_t* isHessianRegularized
@@ -1184,24 +1755,30 @@ return_t qpDUNES_factorizeNewtonHessianBottomUp(	qpData_t* const qpData,
 {
 	int_t jj, ii, kk, ll;
 	real_t sum;
-
-//	qpDUNES_printMatrixData( cholHessian->data, _NI_*_NX_,2*_NX_, "before" );
-//	qpDUNES_printMatrixData( hessian->data, _NI_*_NX_,2*_NX_, "before" );
+	boolean_t isDiagBlock;
 
 // TODO: switch to upper triangular matrix for higher cache efficiency!!
 
 	int_t blockIdxStart = (lastActSetChangeIdx>=0)  ?  qpDUNES_min(lastActSetChangeIdx, _NI_-1)  :  -1;
-//	int_t blockIdxStart = _NI_-1;
 
 	#ifdef __DEBUG__
 	if (qpData->options.printLevel >= 3) {
 		qpDUNES_printf( "[qpDUNES] Restarting reverse Cholesky factorization at block %d of %d", blockIdxStart, _NI_-1 );
 	}
 	#endif
-//	qpDUNES_printf( "Restarting reverse Cholesky factorization at block %d of %d", blockIdxStart, _NI_-1 );
+
+	/* vectorized version, if supported by the CPU */
+	if ( qpData->newtonKernels.factorizeReverse != 0 ) {
+		return qpData->newtonKernels.factorizeReverse( cholHessian->data, cholBlockSparsity, hessian->data, (int_t)_NI_, (int_t)_NX_, &(qpData->nhLayout),
+													   blockIdxStart, &(qpData->options), isHessianRegularized );
+	}
 
 	/* go by block columns */
 	for (kk = blockIdxStart; kk >= 0; --kk) {
+		/* tag diagonal blocks; their factor is just the square root of the diagonal */
+		isDiagBlock = qpDUNES_isNewtonHessianBlockDiagonal( qpData, &accHessian(kk,0,0,0), ( kk < _NI_-1 ) ? &accCholHessian(kk+1,-1,0,0) : 0, QPDUNES_TRUE );
+		cholBlockSparsity[kk] = ( isDiagBlock == QPDUNES_TRUE ) ? QPDUNES_DIAGONAL : QPDUNES_DENSE;
+
 		/* go by in-block columns */
 		for (jj = _NX_ - 1; jj >= 0; --jj) {
 			/* 1) compute diagonal element: ii == jj */
@@ -1209,10 +1786,12 @@ return_t qpDUNES_factorizeNewtonHessianBottomUp(	qpData_t* const qpData,
 			sum = accHessian(kk,0,jj,jj);
 
 			/* subtract squared rearpart of corresponding row (transposed access, therefore rest of column): */
-			/*  - this diagonal block */
-			for( ll = jj+1; ll < _NX_; ++ll ) {
-				/* TODO: get rid of transposed access...maybe start to save Hessian also in upper triangular format */
-				sum -= accCholHessian(kk,0,ll,jj) * accCholHessian(kk,0,ll,jj); /* transposed access */
+			/*  - this diagonal block (zero for diagonal blocks) */
+			if ( isDiagBlock == QPDUNES_FALSE ) {
+				for( ll = jj+1; ll < _NX_; ++ll ) {
+					/* TODO: get rid of transposed access...maybe start to save Hessian also in upper triangular format */
+					sum -= accCholHessian(kk,0,ll,jj) * accCholHessian(kk,0,ll,jj); /* transposed access */
+				}
 			}
 			/*  - this row's subdiagonal block */
 			if( kk < _NI_-1 ) { /* for all block columns but the last one */
@@ -1246,25 +1825,31 @@ return_t qpDUNES_factorizeNewtonHessianBottomUp(	qpData_t* const qpData,
 
 			/* 3) write remainder of jj-th column (upwards! via transposed access: jj-th row, leftwards): */
 			/*  - this diagonal block */
-			for( ii=jj-1; ii>=0; --ii )
-			{
-				sum = accHessian(kk,0,jj,ii);	/* transposed access */
+			if ( isDiagBlock == QPDUNES_FALSE ) {
+				for( ii=jj-1; ii>=0; --ii )
+				{
+					sum = accHessian(kk,0,jj,ii);	/* transposed access */
 
-				/* subtract rear part of this row times rear part of jj-th row */
-				/*  - diagonal block */
-				for( ll = jj+1; ll < _NX_; ++ll ) {
-					sum -= accCholHessian(kk,0,ll,ii) * accCholHessian(kk,0,ll,jj);		/* transposed access */
-				}
-				/*  - subdiagonal block */
-				if( kk < _NI_-1 ) {	/* for all block rows but the last one */
-					for( ll = 0; ll < _NX_; ++ll ) {
-						sum -= accCholHessian(kk+1,-1,ll,ii) * accCholHessian(kk+1,-1,ll,jj);	/* transposed access */
+					/* subtract rear part of this row times rear part of jj-th row */
+					/*  - diagonal block */
+					for( ll = jj+1; ll < _NX_; ++ll ) {
+						sum -= accCholHessian(kk,0,ll,ii) * accCholHessian(kk,0,ll,jj);		/* transposed access */
+					}
+					/*  - subdiagonal block */
+					if( kk < _NI_-1 ) {	/* for all block rows but the last one */
+						for( ll = 0; ll < _NX_; ++ll ) {
+							sum -= accCholHessian(kk+1,-1,ll,ii) * accCholHessian(kk+1,-1,ll,jj);	/* transposed access */
+						}
 					}
-				}
 
-				/* write transposed! (otherwise it's upper triangular matrix) */
-//				accCholHessian(kk,0,ii,jj) = sum / accCholHessian(kk,0,jj,jj);
-				accCholHessian(kk,0,jj,ii) = sum / accCholHessian(kk,0,jj,jj);
+					/* write transposed! (otherwise it's upper triangular matrix) */
+					accCholHessian(kk,0,jj,ii) = sum / accCholHessian(kk,0,jj,jj);
+				}
+			}
+			else {
+				for( ii=jj-1; ii>=0; --ii ) {
+					accCholHessian(kk,0,jj,ii) = 0.;
+				}
 			}
 			/*  - following row's subdiagonal block */
 			if( kk > 0 ) {	/* for all block rows but the first one */
@@ -1273,25 +1858,195 @@ return_t qpDUNES_factorizeNewtonHessianBottomUp(	qpData_t* const qpData,
 					sum = accHessian(kk,-1,jj,ii);	/* transposed access */
 
 					/* subtract rear part of this row times rear part of jj-th row (only this block is non-zero) */
-					for( ll = jj+1; ll < _NX_; ++ll ) {
-						sum -= accCholHessian(kk,-1,ll,ii) * accCholHessian(kk,0,ll,jj);	/* transposed access */
+					if ( isDiagBlock == QPDUNES_FALSE ) {
+						for( ll = jj+1; ll < _NX_; ++ll ) {
+							sum -= accCholHessian(kk,-1,ll,ii) * accCholHessian(kk,0,ll,jj);	/* transposed access */
+						}
 					}
 
 					/* write transposed! (otherwise it's upper triangular matrix) */
-//					accCholHessian(kk-1,+1,ii,jj) = sum / accCholHessian(kk,0,jj,jj);
 					accCholHessian(kk,-1,jj,ii) = sum / accCholHessian(kk,0,jj,jj);
 				}
 			}
 		} /* next column */
 	} /* next block column */
 
-//	qpDUNES_printMatrixData( cholHessian->data, _NI_*_NX_,2*_NX_, "after" );
-
 	return QPDUNES_OK;
 }
 /*<<< END OF qpDUNES_factorizeNewtonHessianBottomUp */
 
 
+/* ----------------------------------------------
+ * check whether a diagonal block of the Newton
+ * Hessian stays diagonal after subtracting the
+ * contribution S*S' of the coupling factor block
+ * S (S'*S if transposed)
+ *
+ *   The check is structural: the off-diagonals of
+ *   the Hessian block are zero and every column of
+ *   S (row if transposed) has at most one nonzero,
+ *   such that all cross products vanish exactly.
+ *   Only the lower triangle of the Hessian block
+ *   is read.
+ *
+ >>>>>>                                           */
+boolean_t qpDUNES_isNewtonHessianBlockDiagonal(	qpData_t* const qpData,
+												const real_t* const hessBlock,		/**< pointer to first element of diagonal block; row stride _NH_LD_ */
+												const real_t* const cholBlock,		/**< pointer to first element of coupling factor block, or 0; row stride _NH_LD_ */
+												boolean_t isCholBlockTransposed
+												)
+{
+	int_t ii, jj;
+	int_t nNonzeros;
+
+	for (ii = 1; ii < _NX_; ++ii) {
+		for (jj = 0; jj < ii; ++jj) {
+			if ( hessBlock[ii*_NH_LD_+jj] != 0. ) {
+				return QPDUNES_FALSE;
+			}
+		}
+	}
+
+	if ( cholBlock != 0 ) {
+		for (jj = 0; jj < _NX_; ++jj) {
+			nNonzeros = 0;
+			for (ii = 0; ii < _NX_; ++ii) {
+				if ( ( ( isCholBlockTransposed == QPDUNES_FALSE ) ? cholBlock[ii*_NH_LD_+jj] : cholBlock[jj*_NH_LD_+ii] ) != 0. ) {
+					++nNonzeros;
+				}
+			}
+			if ( nNonzeros > 1 ) {
+				return QPDUNES_FALSE;
+			}
+		}
+	}
+
+	return QPDUNES_TRUE;
+}
+/*<<< END OF qpDUNES_isNewtonHessianBlockDiagonal */
+
+
+
+/* ----------------------------------------------
+ * Rank-one modification L L' + sigma * v v' of a forward band factor
+ *
+ *   v (destroyed) must be zero in all blocks before blockIdxStart.
+ *   Rotated diagonal blocks are tagged dense in cholBlockSparsity.
+ *   Returns QPDUNES_ERR_DIVISION_BY_ZERO if a downdate yields a too small
+ *   diagonal element; the factor is inconsistent then and has to be rebuilt.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_updateNewtonHessianFactor(	qpData_t* const qpData,
+											xn2x_matrix_t* const cholHessian,
+											sparsityType_t* const cholBlockSparsity,
+											xn_vector_t* const updateVec,
+											real_t sigma,
+											int_t blockIdxStart
+											)
+{
+	int_t ii, jj, kk;
+	real_t r, c, s;
+
+	real_t* v = updateVec->data;
+
+	/* go by block columns */
+	for (kk = qpDUNES_max(blockIdxStart, 0); kk < _NI_; ++kk) {
+		/* go by in-block columns */
+		for (jj = 0; jj < _NX_; ++jj) {
+			if ( v[kk*_NX_+jj] == 0. )	continue;	/* nothing to rotate */
+
+			/* new diagonal element */
+			r = accCholHessian(kk,0,jj,jj) * accCholHessian(kk,0,jj,jj) + sigma * v[kk*_NX_+jj] * v[kk*_NX_+jj];
+			if ( r < qpData->options.newtonHessDiagRegTolerance ) {
+				return QPDUNES_ERR_DIVISION_BY_ZERO;
+			}
+			r = sqrt( r );
+			c = r / accCholHessian(kk,0,jj,jj);
+			s = v[kk*_NX_+jj] / accCholHessian(kk,0,jj,jj);
+			accCholHessian(kk,0,jj,jj) = r;
+			cholBlockSparsity[kk] = QPDUNES_DENSE;		/* rotation fills in the diagonal block */
+
+			/* remainder of jj-th column: */
+			/*  - this diagonal block */
+			for (ii = jj+1; ii < _NX_; ++ii) {
+				accCholHessian(kk,0,ii,jj) = ( accCholHessian(kk,0,ii,jj) + sigma * s * v[kk*_NX_+ii] ) / c;
+				v[kk*_NX_+ii] = c * v[kk*_NX_+ii] - s * accCholHessian(kk,0,ii,jj);
+			}
+			/*  - following row's subdiagonal block */
+			if ( kk < _NI_-1 ) {
+				for (ii = 0; ii < _NX_; ++ii) {
+					accCholHessian(kk+1,-1,ii,jj) = ( accCholHessian(kk+1,-1,ii,jj) + sigma * s * v[(kk+1)*_NX_+ii] ) / c;
+					v[(kk+1)*_NX_+ii] = c * v[(kk+1)*_NX_+ii] - s * accCholHessian(kk+1,-1,ii,jj);
+				}
+			}
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_updateNewtonHessianFactor */
+
+
+/* ----------------------------------------------
+ * Rank-one modification L' L + sigma * v v' of a bottom-up band factor
+ *
+ *   v (destroyed) must be zero in all blocks after blockIdxStart.
+ *   Rotated diagonal blocks are tagged dense in cholBlockSparsity.
+ *   Returns QPDUNES_ERR_DIVISION_BY_ZERO if a downdate yields a too small
+ *   diagonal element; the factor is inconsistent then and has to be rebuilt.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_updateNewtonHessianFactorBottomUp(	qpData_t* const qpData,
+													xn2x_matrix_t* const cholHessian,
+													sparsityType_t* const cholBlockSparsity,
+													xn_vector_t* const updateVec,
+													real_t sigma,
+													int_t blockIdxStart
+													)
+{
+	int_t jj, kk, ll;
+	real_t r, c, s;
+
+	real_t* v = updateVec->data;
+
+	/* go by block columns of L' (block rows of L) bottom up */
+	for (kk = qpDUNES_min(blockIdxStart, _NI_-1); kk >= 0; --kk) {
+		/* go by in-block columns */
+		for (jj = _NX_ - 1; jj >= 0; --jj) {
+			if ( v[kk*_NX_+jj] == 0. )	continue;	/* nothing to rotate */
+
+			/* new diagonal element */
+			r = accCholHessian(kk,0,jj,jj) * accCholHessian(kk,0,jj,jj) + sigma * v[kk*_NX_+jj] * v[kk*_NX_+jj];
+			if ( r < qpData->options.newtonHessDiagRegTolerance ) {
+				return QPDUNES_ERR_DIVISION_BY_ZERO;
+			}
+			r = sqrt( r );
+			c = r / accCholHessian(kk,0,jj,jj);
+			s = v[kk*_NX_+jj] / accCholHessian(kk,0,jj,jj);
+			accCholHessian(kk,0,jj,jj) = r;
+			cholBlockSparsity[kk] = QPDUNES_DENSE;		/* rotation fills in the diagonal block */
+
+			/* remainder of jj-th row of L (leftwards): */
+			/*  - this diagonal block */
+			for (ll = 0; ll < jj; ++ll) {
+				accCholHessian(kk,0,jj,ll) = ( accCholHessian(kk,0,jj,ll) + sigma * s * v[kk*_NX_+ll] ) / c;
+				v[kk*_NX_+ll] = c * v[kk*_NX_+ll] - s * accCholHessian(kk,0,jj,ll);
+			}
+			/*  - this row's subdiagonal block */
+			if ( kk > 0 ) {
+				for (ll = 0; ll < _NX_; ++ll) {
+					accCholHessian(kk,-1,jj,ll) = ( accCholHessian(kk,-1,jj,ll) + sigma * s * v[(kk-1)*_NX_+ll] ) / c;
+					v[(kk-1)*_NX_+ll] = c * v[(kk-1)*_NX_+ll] - s * accCholHessian(kk,-1,jj,ll);
+				}
+			}
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_updateNewtonHessianFactorBottomUp */
+
+
 
 /* ----------------------------------------------
  * special backsolve for block tridiagonal Newton matrix
@@ -1300,12 +2055,19 @@ return_t qpDUNES_factorizeNewtonHessianBottomUp(	qpData_t* const qpData,
 return_t qpDUNES_solveNewtonEquation(	qpData_t* const qpData,
 									xn_vector_t* const res,
 									const xn2x_matrix_t* const cholHessian, /**< lower triangular Newton Hessian factor */
+									const sparsityType_t* const cholBlockSparsity, /**< block sparsity tags of cholHessian */
 									const xn_vector_t* const gradient	)
 {
 	int_t ii, jj, kk;
 
 	real_t sum;
 
+	/* vectorized version, if supported by the CPU */
+	if ( qpData->newtonKernels.solveForward != 0 ) {
+		qpData->newtonKernels.solveForward( res->data, cholHessian->data, cholBlockSparsity, gradient->data, (int_t)_NI_, (int_t)_NX_, &(qpData->nhLayout), &(qpData->options) );
+		return QPDUNES_OK;
+	}
+
 	/* solve L*x = g */
 	for (kk = 0; kk < _NI_; ++kk) /* go by block rows top down */
 	{
@@ -1318,8 +2080,10 @@ return_t qpDUNES_solveNewtonEquation(	qpData_t* const qpData,
 					sum -= accCholHessian(kk,-1,ii,jj)* res->data[(kk-1)*_NX_+jj];
 				}
 			}
-			for (jj = 0; jj < ii; ++jj) { /* ... of corresponding diagonal block */
-				sum -= accCholHessian(kk,0,ii,jj)* res->data[kk*_NX_+jj];
+			if (cholBlockSparsity[kk] != QPDUNES_DIAGONAL) { /* ... of corresponding diagonal block (if not diagonal) */
+				for (jj = 0; jj < ii; ++jj) {
+					sum -= accCholHessian(kk,0,ii,jj)* res->data[kk*_NX_+jj];
+				}
 			}
 
 			/* divide by diagonal element */
@@ -1346,8 +2110,10 @@ return_t qpDUNES_solveNewtonEquation(	qpData_t* const qpData,
 		{
 			sum = res->data[kk * _NX_ + ii]; /* intermediate result of first backsolve is stored in res */
 			/* subtract all previously resolved unknowns ... */
-			for (jj = ii + 1; jj < _NX_; ++jj) { /* ... of corresponding diagonal block */
-				sum -= accCholHessian(kk,0,jj,ii)* res->data[kk*_NX_+jj];
+			if (cholBlockSparsity[kk] != QPDUNES_DIAGONAL) { /* ... of corresponding diagonal block (if not diagonal) */
+				for (jj = ii + 1; jj < _NX_; ++jj) {
+					sum -= accCholHessian(kk,0,jj,ii)* res->data[kk*_NX_+jj];
+				}
 			}
 			if (kk < _NI_ - 1) { /* ... of corresponding superdiagonal block, access via following row's subdiagonal block (if not first block row from bottom) */
 				for (jj = 0; jj < _NX_; ++jj) {
@@ -1378,6 +2144,7 @@ return_t qpDUNES_solveNewtonEquation(	qpData_t* const qpData,
 return_t qpDUNES_solveNewtonEquationBottomUp(	qpData_t* const qpData,
 											xn_vector_t* const res,
 											const xn2x_matrix_t* const cholHessian, /**< lower triangular Newton Hessian factor */
+											const sparsityType_t* const cholBlockSparsity, /**< block sparsity tags of cholHessian */
 											const xn_vector_t* const gradient	)
 {
 	// TODO: switch to upper triangular matrix for higher cache efficiency!!
@@ -1385,6 +2152,12 @@ return_t qpDUNES_solveNewtonEquationBottomUp(	qpData_t* const qpData,
 
 	real_t sum;
 
+	/* vectorized version, if supported by the CPU */
+	if ( qpData->newtonKernels.solveReverse != 0 ) {
+		qpData->newtonKernels.solveReverse( res->data, cholHessian->data, cholBlockSparsity, gradient->data, (int_t)_NI_, (int_t)_NX_, &(qpData->nhLayout) );
+		return QPDUNES_OK;
+	}
+
 //	qpDUNES_printMatrixDataToFile( res->data, _NI_*_NX_, 1, "dLambda_normal", "" );
 
 	/* solve L^T*x = g */
@@ -1394,8 +2167,10 @@ return_t qpDUNES_solveNewtonEquationBottomUp(	qpData_t* const qpData,
 		{
 			sum = gradient->data[kk * _NX_ + ii];
 			/* subtract all previously resolved unknowns ... */
-			for (jj = ii + 1; jj < _NX_; ++jj) { /* ... of corresponding diagonal block */
-				sum -= accCholHessian(kk,0,jj,ii)* res->data[kk*_NX_+jj]; /* transposed access */
+			if (cholBlockSparsity[kk] != QPDUNES_DIAGONAL) { /* ... of corresponding diagonal block (if not diagonal) */
+				for (jj = ii + 1; jj < _NX_; ++jj) {
+					sum -= accCholHessian(kk,0,jj,ii)* res->data[kk*_NX_+jj]; /* transposed access */
+				}
 			}
 			if (kk < _NI_ - 1) { /* ... of corresponding superdiagonal block, access via following row's subdiagonal block (if not first block row from bottom) */
 				for (jj = 0; jj < _NX_; ++jj) {
@@ -1426,8 +2201,10 @@ return_t qpDUNES_solveNewtonEquationBottomUp(	qpData_t* const qpData,
 					sum -= accCholHessian(kk,-1,ii,jj)* res->data[(kk-1)*_NX_+jj];
 				}
 			}
-			for (jj = 0; jj < ii; ++jj) { /* ... of corresponding diagonal block */
-				sum -= accCholHessian(kk,0,ii,jj)* res->data[kk*_NX_+jj];
+			if (cholBlockSparsity[kk] != QPDUNES_DIAGONAL) { /* ... of corresponding diagonal block (if not diagonal) */
+				for (jj = 0; jj < ii; ++jj) {
+					sum -= accCholHessian(kk,0,ii,jj)* res->data[kk*_NX_+jj];
+				}
 			}
 
 			/* divide by diagonal element */
@@ -1449,61 +2226,640 @@ return_t qpDUNES_solveNewtonEquationBottomUp(	qpData_t* const qpData,
 
 
 /* ----------------------------------------------
- * special multiplication routine for Newton Hessian with a vector
+ * Parallel block cyclic reduction for block tridiagonal Newton matrix
+ *
+ * On every level the odd block rows are eliminated; their Schur complements
+ * form a block tridiagonal system of half size on the next level. All levels
+ * are stored below each other in cholHessian, starting with level 0 (the full
+ * Newton Hessian); odd diagonal blocks hold their lower Cholesky factors.
  *
  >>>>>>                                           */
-return_t qpDUNES_multiplyNewtonHessianVector(	qpData_t* const qpData,
-												xn_vector_t* const res,
-												const xn2x_matrix_t* const hessian, /**< Newton Hessian */
-												const xn_vector_t* const vec	)
+return_t qpDUNES_factorizeNewtonHessianCyclicReduction(	qpData_t* const qpData,
+														xn2x_matrix_t* const cholHessian,
+														xn2x_matrix_t* const hessian,
+														boolean_t* isHessianRegularized
+														)
 {
-	// TODO: switch to upper triangular matrix for higher cache efficiency!!
-	int_t ii, jj, kk;
+	int_t ii, jj, kk, ll;
+	real_t sum;
 
+	int_t nBlocks = _NI_;		/* number of block rows on current level */
+	int_t offset = 0;			/* first block row of current level in cholHessian */
+	int_t offsetNext;
+	int_t errCntr = 0;
+	int_t regCntr = 0;			/* regularized blocks; the shared flag is written outside of the parallel loop */
+	boolean_t isBlockRegularized;
 
-	for (kk = 0; kk < _NI_; ++kk) 			/* go by block rows top down */
-	{
-		/* empty full result vector chunk beforehand, needed for cache-efficient transposed multiplication */
-		for (ii = 0; ii < _NX_; ++ii)
-		{
-			res->data[kk * _NX_ + ii] = 0.0;
-		}
+	/* level 0 is the Newton Hessian itself */
+	for (ii = 0; ii < _NI_*qpData->nhLayout.blockRowStride; ++ii) {
+		cholHessian->data[ii] = hessian->data[ii];
+	}
 
-		/* write result */
-		for (ii = 0; ii < _NX_; ++ii) 		/* go by in-block rows top down */
-		{
-			if (kk > 0)
-			{
-				/* go through subdiagonal block by columns */
-				for (jj = 0; jj < _NX_; ++jj)
-				{
-					res->data[kk*_NX_ + ii] += accHessian(kk,-1,ii,jj) * vec->data[(kk-1)*_NX_ + jj];
-				}
-			}
+	while (nBlocks > 1) {
+		offsetNext = offset + nBlocks;
 
-			/* go through diagonal block by columns */
-			for (jj = 0; jj < _NX_; ++jj)
-			{
-				res->data[kk*_NX_ + ii] += accHessian(kk,0,ii,jj) * vec->data[kk*_NX_ + jj];
+		/* 1) factorize odd diagonal blocks, compute X = D^-1*L(k) and Y' = L(k+1)*D^-1 */
+		#pragma omp parallel for private(kk,ii,jj,isBlockRegularized) reduction(+:errCntr,regCntr) schedule(static)
+		for (kk = 1; kk < nBlocks; kk += 2) {
+			isBlockRegularized = QPDUNES_FALSE;
+			if ( qpDUNES_factorizeNewtonHessianBlock( qpData, &accCholHessian(offset+kk,0,0,0), &isBlockRegularized ) != QPDUNES_OK ) {
+				errCntr++;
+				continue;
 			}
-
-			if (kk < _NI_-1)
-			{
-				/* go through superdiagonal block by columns; transposed access though */
-				for (jj = 0; jj < _NX_; ++jj)
-				{
-//					res->data[kk*_NX_ + ii] = accHessian(kk-1,-1,jj,ii) * vec[(kk-1)*_NI_ + jj];	/* transposed access of Newton Hessian */
-					/* by-column multiplication for higher cache efficiency in Newton Hessian (transposed access of Newton Hessian) */
-					res->data[kk*_NX_ + jj] += accHessian(kk+1,-1,ii,jj) * vec->data[(kk+1)*_NX_ + ii];
-//					res->data[kk*_NX_ + ii] += accHessian(kk+1,-1,ii,jj) * vec->data[(kk+1)*_NX_ + jj];
+			if ( isBlockRegularized == QPDUNES_TRUE ) {
+				regCntr++;
+			}
+			for (jj = 0; jj < _NX_; ++jj) {		/* by columns of L(k) */
+				for (ii = 0; ii < _NX_; ++ii) {
+					accCyclicReductionTmp(kk,-1,ii,jj) = accCholHessian(offset+kk,-1,ii,jj);
 				}
+				qpDUNES_solveNewtonHessianBlock( qpData, &accCyclicReductionTmp(kk,-1,0,jj), &accCholHessian(offset+kk,0,0,0), _NH_LD_ );
 			}
-		} 	/* end of in-block rows */
-	}		/* end of block rows */
-
-	return QPDUNES_OK;
-}
-/*<<< END OF qpDUNES_multiplyNewtonHessianVector */
+			if (kk < nBlocks - 1) {
+				for (ii = 0; ii < _NX_; ++ii) {		/* by rows of L(k+1) */
+					for (jj = 0; jj < _NX_; ++jj) {
+						accCyclicReductionTmp(kk,0,ii,jj) = accCholHessian(offset+kk+1,-1,ii,jj);
+					}
+					qpDUNES_solveNewtonHessianBlock( qpData, &accCyclicReductionTmp(kk,0,ii,0), &accCholHessian(offset+kk,0,0,0), 1 );
+				}
+			}
+		}
+		if (regCntr > 0) {
+			*isHessianRegularized = QPDUNES_TRUE;
+		}
+		if (errCntr > 0) {	/* matrix not positive definite */
+			return QPDUNES_ERR_DIVISION_BY_ZERO;
+		}
+
+		/* 2) Schur complements of even blocks form the next level */
+		#pragma omp parallel for private(kk,ii,jj,ll,sum) schedule(static)
+		for (kk = 0; kk < nBlocks; kk += 2) {
+			for (ii = 0; ii < _NX_; ++ii) {
+				for (jj = 0; jj < _NX_; ++jj) {
+					/* diagonal block: D(k) - L(k)*D(k-1)^-1*L(k)' - L(k+1)'*D(k+1)^-1*L(k+1) */
+					sum = accCholHessian(offset+kk,0,ii,jj);
+					if (kk > 0) {
+						for (ll = 0; ll < _NX_; ++ll) {
+							sum -= accCholHessian(offset+kk,-1,ii,ll) * accCyclicReductionTmp(kk-1,0,jj,ll);
+						}
+					}
+					if (kk < nBlocks - 1) {
+						for (ll = 0; ll < _NX_; ++ll) {
+							sum -= accCholHessian(offset+kk+1,-1,ll,ii) * accCyclicReductionTmp(kk+1,-1,ll,jj);	/* transposed access */
+						}
+					}
+					accCholHessian(offsetNext+kk/2,0,ii,jj) = sum;
+
+					/* subdiagonal block: -L(k)*D(k-1)^-1*L(k-1) */
+					if (kk > 0) {
+						sum = 0.;
+						for (ll = 0; ll < _NX_; ++ll) {
+							sum -= accCholHessian(offset+kk,-1,ii,ll) * accCyclicReductionTmp(kk-1,-1,ll,jj);
+						}
+						accCholHessian(offsetNext+kk/2,-1,ii,jj) = sum;
+					}
+				}
+			}
+		}
+
+		offset = offsetNext;
+		nBlocks = (nBlocks + 1) / 2;
+	}
+
+	/* factorize remaining block */
+	return qpDUNES_factorizeNewtonHessianBlock( qpData, &accCholHessian(offset,0,0,0), isHessianRegularized );
+}
+/*<<< END OF qpDUNES_factorizeNewtonHessianCyclicReduction */
+
+
+/* ----------------------------------------------
+ * in-place Cholesky factorization of a single
+ * diagonal block in Newton Hessian storage format
+ *
+ >>>>>>                                           */
+return_t qpDUNES_factorizeNewtonHessianBlock(	qpData_t* const qpData,
+												real_t* const block,			/**< pointer to first element of diagonal block; row stride _NH_LD_ */
+												boolean_t* isHessianRegularized
+												)
+{
+	int_t ii, jj, ll;
+	real_t sum;
+
+	for (jj = 0; jj < _NX_; ++jj) {
+		/* 1) compute diagonal element */
+		sum = block[jj*_NH_LD_+jj];
+		for (ll = 0; ll < jj; ++ll) {
+			sum -= block[jj*_NH_LD_+ll] * block[jj*_NH_LD_+ll];
+		}
+
+		/* 2) check for too small diagonal elements */
+		if ( (qpData->options.regType == QPDUNES_REG_SINGULAR_DIRECTIONS) &&
+			 (sum < qpData->options.newtonHessDiagRegTolerance) )
+		{
+			sum += qpData->options.regParam;
+			*isHessianRegularized = QPDUNES_TRUE;
+		}
+		else {
+			if ( sum < qpData->options.newtonHessDiagRegTolerance ) {	/* matrix not positive definite */
+				return QPDUNES_ERR_DIVISION_BY_ZERO;
+			}
+		}
+		block[jj*_NH_LD_+jj] = sqrt( sum );
+
+		/* 3) write remainder of jj-th column */
+		for (ii = jj + 1; ii < _NX_; ++ii) {
+			sum = block[ii*_NH_LD_+jj];
+			for (ll = 0; ll < jj; ++ll) {
+				sum -= block[ii*_NH_LD_+ll] * block[jj*_NH_LD_+ll];
+			}
+			block[ii*_NH_LD_+jj] = sum / block[jj*_NH_LD_+jj];
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_factorizeNewtonHessianBlock */
+
+
+/* ----------------------------------------------
+ * in-place solve L*L'*res = res with a factorized
+ * diagonal block in Newton Hessian storage format
+ *
+ >>>>>>                                           */
+void qpDUNES_solveNewtonHessianBlock(	qpData_t* const qpData,
+										real_t* const res,
+										const real_t* const cholBlock,	/**< lower triangular factor; row stride _NH_LD_ */
+										int_t incr						/**< stride between elements of res */
+										)
+{
+	qpDUNES_solveNewtonHessianBlockL( qpData, res, cholBlock, incr );
+	qpDUNES_solveNewtonHessianBlockLT( qpData, res, cholBlock, incr );
+}
+/*<<< END OF qpDUNES_solveNewtonHessianBlock */
+
+
+/* ----------------------------------------------
+ * in-place solve L*res = res with a factorized
+ * diagonal block in Newton Hessian storage format
+ *
+ >>>>>>                                           */
+void qpDUNES_solveNewtonHessianBlockL(	qpData_t* const qpData,
+										real_t* const res,
+										const real_t* const cholBlock,	/**< lower triangular factor; row stride _NH_LD_ */
+										int_t incr						/**< stride between elements of res */
+										)
+{
+	int_t ii, jj;
+	real_t sum;
+
+	for (ii = 0; ii < _NX_; ++ii) {
+		sum = res[ii*incr];
+		for (jj = 0; jj < ii; ++jj) {
+			sum -= cholBlock[ii*_NH_LD_+jj] * res[jj*incr];
+		}
+		res[ii*incr] = sum / cholBlock[ii*_NH_LD_+ii];
+	}
+}
+/*<<< END OF qpDUNES_solveNewtonHessianBlockL */
+
+
+/* ----------------------------------------------
+ * in-place solve L'*res = res with a factorized
+ * diagonal block in Newton Hessian storage format
+ *
+ >>>>>>                                           */
+void qpDUNES_solveNewtonHessianBlockLT(	qpData_t* const qpData,
+										real_t* const res,
+										const real_t* const cholBlock,	/**< lower triangular factor; row stride _NH_LD_ */
+										int_t incr						/**< stride between elements of res */
+										)
+{
+	int_t ii, jj;
+	real_t sum;
+
+	for (ii = _NX_ - 1; ii >= 0; --ii) {
+		sum = res[ii*incr];
+		for (jj = ii + 1; jj < _NX_; ++jj) {
+			sum -= cholBlock[jj*_NH_LD_+ii] * res[jj*incr];	/* transposed access */
+		}
+		res[ii*incr] = sum / cholBlock[ii*_NH_LD_+ii];
+	}
+}
+/*<<< END OF qpDUNES_solveNewtonHessianBlockLT */
+
+
+/* ----------------------------------------------
+ * backsolve for cyclic reduction factorized
+ * block tridiagonal Newton matrix
+ *
+ >>>>>>                                           */
+return_t qpDUNES_solveNewtonEquationCyclicReduction(	qpData_t* const qpData,
+														xn_vector_t* const res,
+														const xn2x_matrix_t* const cholHessian,	/**< cyclic reduction Newton Hessian factor */
+														const xn_vector_t* const gradient
+														)
+{
+	int_t ii, jj, kk, ll;
+	real_t sum;
+
+	real_t* rhs = qpData->cyclicReductionRhs.data;	/* right hand sides (later solutions) of all levels */
+
+	int_t nBlocks = _NI_;
+	int_t offset = 0;
+	int_t offsetNext;
+	int_t nLevels = 0;
+	int_t level;
+
+	for (ii = 0; ii < _NI_*_NX_; ++ii) {
+		rhs[ii] = gradient->data[ii];
+	}
+
+	/* 1) reduce right hand side level by level; res is used as workspace for D^-1*rhs of the odd blocks */
+	while (nBlocks > 1) {
+		offsetNext = offset + nBlocks;
+
+		#pragma omp parallel for private(kk,ii) schedule(static)
+		for (kk = 1; kk < nBlocks; kk += 2) {
+			for (ii = 0; ii < _NX_; ++ii) {
+				res->data[kk*_NX_+ii] = rhs[(offset+kk)*_NX_+ii];
+			}
+			qpDUNES_solveNewtonHessianBlock( qpData, &(res->data[kk*_NX_]), &accCholHessian(offset+kk,0,0,0), 1 );
+		}
+
+		#pragma omp parallel for private(kk,ii,jj,sum) schedule(static)
+		for (kk = 0; kk < nBlocks; kk += 2) {
+			for (ii = 0; ii < _NX_; ++ii) {
+				sum = rhs[(offset+kk)*_NX_+ii];
+				if (kk > 0) {
+					for (jj = 0; jj < _NX_; ++jj) {
+						sum -= accCholHessian(offset+kk,-1,ii,jj) * res->data[(kk-1)*_NX_+jj];
+					}
+				}
+				if (kk < nBlocks - 1) {
+					for (jj = 0; jj < _NX_; ++jj) {
+						sum -= accCholHessian(offset+kk+1,-1,jj,ii) * res->data[(kk+1)*_NX_+jj];	/* transposed access */
+					}
+				}
+				rhs[(offsetNext+kk/2)*_NX_+ii] = sum;
+			}
+		}
+
+		offset = offsetNext;
+		nBlocks = (nBlocks + 1) / 2;
+		nLevels++;
+	}
+
+	/* 2) solve remaining block */
+	qpDUNES_solveNewtonHessianBlock( qpData, &(rhs[offset*_NX_]), &accCholHessian(offset,0,0,0), 1 );
+
+	/* 3) substitute back, deepest level first */
+	for (level = nLevels - 1; level >= 0; --level) {
+		nBlocks = _NI_;
+		offset = 0;
+		for (ll = 0; ll < level; ++ll) {
+			offset += nBlocks;
+			nBlocks = (nBlocks + 1) / 2;
+		}
+		offsetNext = offset + nBlocks;
+
+		#pragma omp parallel for private(kk,ii,jj,sum) schedule(static)
+		for (kk = 0; kk < nBlocks; ++kk) {
+			if (kk % 2 == 0) {	/* kept block: solution known from next level */
+				for (ii = 0; ii < _NX_; ++ii) {
+					rhs[(offset+kk)*_NX_+ii] = rhs[(offsetNext+kk/2)*_NX_+ii];
+				}
+			}
+			else {				/* eliminated block */
+				for (ii = 0; ii < _NX_; ++ii) {
+					sum = rhs[(offset+kk)*_NX_+ii];
+					for (jj = 0; jj < _NX_; ++jj) {
+						sum -= accCholHessian(offset+kk,-1,ii,jj) * rhs[(offsetNext+kk/2)*_NX_+jj];
+					}
+					if (kk < nBlocks - 1) {
+						for (jj = 0; jj < _NX_; ++jj) {
+							sum -= accCholHessian(offset+kk+1,-1,jj,ii) * rhs[(offsetNext+kk/2+1)*_NX_+jj];	/* transposed access */
+						}
+					}
+					rhs[(offset+kk)*_NX_+ii] = sum;
+				}
+				qpDUNES_solveNewtonHessianBlock( qpData, &(rhs[(offset+kk)*_NX_]), &accCholHessian(offset+kk,0,0,0), 1 );
+			}
+		}
+	}
+
+	for (ii = 0; ii < _NI_*_NX_; ++ii) {
+		res->data[ii] = rhs[ii];
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_solveNewtonEquationCyclicReduction */
+
+
+/* ----------------------------------------------
+ * Twisted block tridiagonal Cholesky for special storage format of Newton matrix
+ *
+ * Block rows above the twist index t hold the top-down factor (as in
+ * qpDUNES_factorizeNewtonHessian), block rows below t hold the bottom-up
+ * factor (as in qpDUNES_factorizeNewtonHessianBottomUp), and block row t
+ * holds the factor of the Schur complement in which both meet.
+ * Since the top-down factor of row k only depends on rows 0..k and the
+ * bottom-up factor only on rows k.._NI_-1, only the rows between the changed
+ * rows and the old twist index need to be recomputed; the twist index is
+ * then moved to the center of the changed rows, so that active-set changes
+ * in the middle of the horizon do not trigger a refactorization of either end.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_factorizeNewtonHessianTwisted(	qpData_t* const qpData,
+												xn2x_matrix_t* const cholHessian,
+												xn2x_matrix_t* const hessian,
+												int_t firstActSetChangeIdx,			/**< first block row with changed Newton Hessian data */
+												int_t lastActSetChangeIdx,			/**< last block row with changed Newton Hessian data */
+												int_t* const twistIdx,				/**< twist index of current factor (in), of new factor (out); -1 if none */
+												int_t* const nRefactoredBlocks,
+												boolean_t* isHessianRegularized
+												)
+{
+	int_t ii, jj, kk, ll;
+	real_t sum;
+
+	int_t twistIdxNew;
+	int_t firstRefactorIdx, lastRefactorIdx;
+	int_t errCntr = 0;
+
+	boolean_t isTopRegularized = QPDUNES_FALSE;
+	boolean_t isBottomRegularized = QPDUNES_FALSE;
+
+	if ( ( *twistIdx < 0 ) || ( *twistIdx >= _NI_ ) || ( lastActSetChangeIdx >= _NI_ ) ) {
+		/* no valid factor available, refactor full hessian */
+		twistIdxNew = (_NI_ - 1) / 2;
+		firstRefactorIdx = 0;
+		lastRefactorIdx = _NI_ - 1;
+	}
+	else {
+		if ( lastActSetChangeIdx < 0 ) {	/* factor is up to date */
+			*nRefactoredBlocks = 0;
+			return QPDUNES_OK;
+		}
+		firstActSetChangeIdx = qpDUNES_max( firstActSetChangeIdx, 0 );
+		twistIdxNew = ( firstActSetChangeIdx + lastActSetChangeIdx ) / 2;
+		firstRefactorIdx = qpDUNES_min( firstActSetChangeIdx, *twistIdx );
+		lastRefactorIdx = qpDUNES_max( lastActSetChangeIdx, *twistIdx );
+	}
+	*twistIdx = -1;		/* invalid until factorization succeeded */
+	*nRefactoredBlocks = lastRefactorIdx - firstRefactorIdx + 1;
+
+	/* top and bottom part are independent of each other */
+	#pragma omp parallel sections private(kk,ii,jj,ll,sum) reduction(+:errCntr) num_threads(qpData->nThreads)
+	{
+		/* 1) top-down factorization of block rows firstRefactorIdx..twistIdxNew-1 */
+		#pragma omp section
+		for (kk = firstRefactorIdx; kk <= twistIdxNew; ++kk) {
+			/* L(k,k-1) = M(k,k-1) * L(k-1,k-1)^-T, by rows */
+			if (kk > 0) {
+				for (ii = 0; ii < _NX_; ++ii) {
+					for (jj = 0; jj < _NX_; ++jj) {
+						accCholHessian(kk,-1,ii,jj) = accHessian(kk,-1,ii,jj);
+					}
+					qpDUNES_solveNewtonHessianBlockL( qpData, &accCholHessian(kk,-1,ii,0), &accCholHessian(kk-1,0,0,0), 1 );
+				}
+			}
+			if (kk == twistIdxNew)	break;
+
+			/* L(k,k) = chol( M(k,k) - L(k,k-1)*L(k,k-1)' ) */
+			for (ii = 0; ii < _NX_; ++ii) {
+				for (jj = 0; jj <= ii; ++jj) {
+					sum = accHessian(kk,0,ii,jj);
+					if (kk > 0) {
+						for (ll = 0; ll < _NX_; ++ll) {
+							sum -= accCholHessian(kk,-1,ii,ll) * accCholHessian(kk,-1,jj,ll);
+						}
+					}
+					accCholHessian(kk,0,ii,jj) = sum;
+				}
+			}
+			if ( qpDUNES_factorizeNewtonHessianBlock( qpData, &accCholHessian(kk,0,0,0), &isTopRegularized ) != QPDUNES_OK ) {
+				errCntr++;
+				break;
+			}
+		}
+
+		/* 2) bottom-up factorization of block rows lastRefactorIdx..twistIdxNew+1 */
+		#pragma omp section
+		for (kk = lastRefactorIdx; kk > twistIdxNew; --kk) {
+			/* W(k,k) = chol( M(k,k) - G(k+1)'*G(k+1) ) */
+			for (ii = 0; ii < _NX_; ++ii) {
+				for (jj = 0; jj <= ii; ++jj) {
+					sum = accHessian(kk,0,ii,jj);
+					if (kk < _NI_ - 1) {
+						for (ll = 0; ll < _NX_; ++ll) {
+							sum -= accCholHessian(kk+1,-1,ll,ii) * accCholHessian(kk+1,-1,ll,jj);
+						}
+					}
+					accCholHessian(kk,0,ii,jj) = sum;
+				}
+			}
+			if ( qpDUNES_factorizeNewtonHessianBlock( qpData, &accCholHessian(kk,0,0,0), &isBottomRegularized ) != QPDUNES_OK ) {
+				errCntr++;
+				break;
+			}
+
+			/* G(k) = W(k,k)^-1 * M(k,k-1), by columns */
+			for (jj = 0; jj < _NX_; ++jj) {
+				for (ii = 0; ii < _NX_; ++ii) {
+					accCholHessian(kk,-1,ii,jj) = accHessian(kk,-1,ii,jj);
+				}
+				qpDUNES_solveNewtonHessianBlockL( qpData, &accCholHessian(kk,-1,0,jj), &accCholHessian(kk,0,0,0), _NH_LD_ );
+			}
+		}
+	}
+
+	if ( ( isTopRegularized == QPDUNES_TRUE ) || ( isBottomRegularized == QPDUNES_TRUE ) ) {
+		*isHessianRegularized = QPDUNES_TRUE;
+	}
+	if (errCntr > 0) {
+		return QPDUNES_ERR_DIVISION_BY_ZERO;
+	}
+
+	/* 3) twist block T = chol( M(t,t) - L(t,t-1)*L(t,t-1)' - G(t+1)'*G(t+1) ) */
+	kk = twistIdxNew;
+	for (ii = 0; ii < _NX_; ++ii) {
+		for (jj = 0; jj <= ii; ++jj) {
+			sum = accHessian(kk,0,ii,jj);
+			if (kk > 0) {
+				for (ll = 0; ll < _NX_; ++ll) {
+					sum -= accCholHessian(kk,-1,ii,ll) * accCholHessian(kk,-1,jj,ll);
+				}
+			}
+			if (kk < _NI_ - 1) {
+				for (ll = 0; ll < _NX_; ++ll) {
+					sum -= accCholHessian(kk+1,-1,ll,ii) * accCholHessian(kk+1,-1,ll,jj);
+				}
+			}
+			accCholHessian(kk,0,ii,jj) = sum;
+		}
+	}
+	if ( qpDUNES_factorizeNewtonHessianBlock( qpData, &accCholHessian(kk,0,0,0), isHessianRegularized ) != QPDUNES_OK ) {
+		return QPDUNES_ERR_DIVISION_BY_ZERO;
+	}
+
+	*twistIdx = twistIdxNew;
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_factorizeNewtonHessianTwisted */
+
+
+/* ----------------------------------------------
+ * special backsolve for twisted factorized block tridiagonal Newton matrix
+ *
+ >>>>>>                                           */
+return_t qpDUNES_solveNewtonEquationTwisted(	qpData_t* const qpData,
+												xn_vector_t* const res,
+												const xn2x_matrix_t* const cholHessian,	/**< twisted Newton Hessian factor */
+												const xn_vector_t* const gradient,
+												int_t twistIdx
+												)
+{
+	int_t ii, jj, kk;
+	real_t sum;
+
+	if ( ( twistIdx < 0 ) || ( twistIdx >= _NI_ ) ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "No valid twisted Newton Hessian factor available." );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	/* 1) eliminate top down until twist block */
+	for (kk = 0; kk < twistIdx; ++kk) {
+		for (ii = 0; ii < _NX_; ++ii) {
+			sum = gradient->data[kk*_NX_+ii];
+			if (kk > 0) {
+				for (jj = 0; jj < _NX_; ++jj) {
+					sum -= accCholHessian(kk,-1,ii,jj) * res->data[(kk-1)*_NX_+jj];
+				}
+			}
+			res->data[kk*_NX_+ii] = sum;
+		}
+		qpDUNES_solveNewtonHessianBlockL( qpData, &(res->data[kk*_NX_]), &accCholHessian(kk,0,0,0), 1 );
+	}
+
+	/* 2) eliminate bottom up until twist block */
+	for (kk = _NI_ - 1; kk > twistIdx; --kk) {
+		for (ii = 0; ii < _NX_; ++ii) {
+			sum = gradient->data[kk*_NX_+ii];
+			if (kk < _NI_ - 1) {
+				for (jj = 0; jj < _NX_; ++jj) {
+					sum -= accCholHessian(kk+1,-1,jj,ii) * res->data[(kk+1)*_NX_+jj];	/* transposed access */
+				}
+			}
+			res->data[kk*_NX_+ii] = sum;
+		}
+		qpDUNES_solveNewtonHessianBlockL( qpData, &(res->data[kk*_NX_]), &accCholHessian(kk,0,0,0), 1 );
+	}
+
+	/* 3) solve for twist block */
+	kk = twistIdx;
+	for (ii = 0; ii < _NX_; ++ii) {
+		sum = gradient->data[kk*_NX_+ii];
+		if (kk > 0) {
+			for (jj = 0; jj < _NX_; ++jj) {
+				sum -= accCholHessian(kk,-1,ii,jj) * res->data[(kk-1)*_NX_+jj];
+			}
+		}
+		if (kk < _NI_ - 1) {
+			for (jj = 0; jj < _NX_; ++jj) {
+				sum -= accCholHessian(kk+1,-1,jj,ii) * res->data[(kk+1)*_NX_+jj];	/* transposed access */
+			}
+		}
+		res->data[kk*_NX_+ii] = sum;
+	}
+	qpDUNES_solveNewtonHessianBlock( qpData, &(res->data[kk*_NX_]), &accCholHessian(kk,0,0,0), 1 );
+
+	/* 4) substitute back upwards from twist block */
+	for (kk = twistIdx - 1; kk >= 0; --kk) {
+		for (ii = 0; ii < _NX_; ++ii) {
+			sum = res->data[kk*_NX_+ii];
+			for (jj = 0; jj < _NX_; ++jj) {
+				sum -= accCholHessian(kk+1,-1,jj,ii) * res->data[(kk+1)*_NX_+jj];	/* transposed access */
+			}
+			res->data[kk*_NX_+ii] = sum;
+		}
+		qpDUNES_solveNewtonHessianBlockLT( qpData, &(res->data[kk*_NX_]), &accCholHessian(kk,0,0,0), 1 );
+	}
+
+	/* 5) substitute back downwards from twist block */
+	for (kk = twistIdx + 1; kk < _NI_; ++kk) {
+		for (ii = 0; ii < _NX_; ++ii) {
+			sum = res->data[kk*_NX_+ii];
+			for (jj = 0; jj < _NX_; ++jj) {
+				sum -= accCholHessian(kk,-1,ii,jj) * res->data[(kk-1)*_NX_+jj];
+			}
+			res->data[kk*_NX_+ii] = sum;
+		}
+		qpDUNES_solveNewtonHessianBlockLT( qpData, &(res->data[kk*_NX_]), &accCholHessian(kk,0,0,0), 1 );
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_solveNewtonEquationTwisted */
+
+
+/* ----------------------------------------------
+ * special multiplication routine for Newton Hessian with a vector
+ *
+ >>>>>>                                           */
+return_t qpDUNES_multiplyNewtonHessianVector(	qpData_t* const qpData,
+												xn_vector_t* const res,
+												const xn2x_matrix_t* const hessian, /**< Newton Hessian */
+												const xn_vector_t* const vec	)
+{
+	// TODO: switch to upper triangular matrix for higher cache efficiency!!
+	int_t ii, jj, kk;
+
+
+	for (kk = 0; kk < _NI_; ++kk) 			/* go by block rows top down */
+	{
+		/* empty full result vector chunk beforehand, needed for cache-efficient transposed multiplication */
+		for (ii = 0; ii < _NX_; ++ii)
+		{
+			res->data[kk * _NX_ + ii] = 0.0;
+		}
+
+		/* write result */
+		for (ii = 0; ii < _NX_; ++ii) 		/* go by in-block rows top down */
+		{
+			if (kk > 0)
+			{
+				/* go through subdiagonal block by columns */
+				for (jj = 0; jj < _NX_; ++jj)
+				{
+					res->data[kk*_NX_ + ii] += accHessian(kk,-1,ii,jj) * vec->data[(kk-1)*_NX_ + jj];
+				}
+			}
+
+			/* go through diagonal block by columns */
+			for (jj = 0; jj < _NX_; ++jj)
+			{
+				res->data[kk*_NX_ + ii] += accHessian(kk,0,ii,jj) * vec->data[kk*_NX_ + jj];
+			}
+
+			if (kk < _NI_-1)
+			{
+				/* go through superdiagonal block by columns; transposed access though */
+				for (jj = 0; jj < _NX_; ++jj)
+				{
+//					res->data[kk*_NX_ + ii] = accHessian(kk-1,-1,jj,ii) * vec[(kk-1)*_NI_ + jj];	/* transposed access of Newton Hessian */
+					/* by-column multiplication for higher cache efficiency in Newton Hessian (transposed access of Newton Hessian) */
+					res->data[kk*_NX_ + jj] += accHessian(kk+1,-1,ii,jj) * vec->data[(kk+1)*_NX_ + ii];
+//					res->data[kk*_NX_ + ii] += accHessian(kk+1,-1,ii,jj) * vec->data[(kk+1)*_NX_ + jj];
+				}
+			}
+		} 	/* end of in-block rows */
+	}		/* end of block rows */
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_multiplyNewtonHessianVector */
 
 
 
@@ -1532,12 +2888,18 @@ return_t qpDUNES_determineStepLength(	qpData_t* const qpData,
 	*itCntr = 0;
 
 	int_t kk;
+	int_t errCntr = 0;
 	interval_t* interval;
 
+	/* no trial step evaluated yet */
+	qpData->gradientCacheAlpha = -1.;
+	qpData->isGradientCacheValid = QPDUNES_FALSE;
+
 
 	/* compute minimum step size for active set change */
 	if ( newtonHessianRegularized != QPDUNES_TRUE )	{
 		alphaMin = qpData->options.QPDUNES_INFTY;
+		#pragma omp parallel for private(kk) reduction(min:alphaMin) reduction(+:errCntr) schedule(static) num_threads(qpData->nThreads)
 		for ( kk = 0; kk < _NI_ + 1; ++kk )
 		{
 			switch (qpData->intervals[kk]->qpSolverSpecification)
@@ -1548,16 +2910,20 @@ return_t qpDUNES_determineStepLength(	qpData_t* const qpData,
 					break;
 
 				case QPDUNES_STAGE_QP_SOLVER_QPOASES:
+				case QPDUNES_STAGE_QP_SOLVER_BOXQP:		/* logs its homotopy in the same format */
 					/* do check based on shortest homotopy step */
 					qpOASES_getMinStepsize( qpData, qpData->intervals[kk], &alphaMin );
 					break;
 
 				default:
 					qpDUNES_printError(qpData, __FILE__, __LINE__, "Stage QP solver undefined! Bailing out...");
-					return QPDUNES_ERR_INVALID_ARGUMENT;
+					errCntr++;
 			}
 	//		qpDUNES_printf("[qpDUNES] kk = %d, Minimum stepsize leading to first AS Change =  %.3e", kk, alphaMin );
 		}
+		if (errCntr > 0) {
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+		}
 	}
 	else	{
 		/* Existence of AS change cannot be concluded if Hessian is regularized */
@@ -1584,28 +2950,9 @@ return_t qpDUNES_determineStepLength(	qpData_t* const qpData,
 		*alpha = 1.;
 
 		addVectorScaledVector(lambda, lambda, *alpha, deltaLambdaFS, nV); /* temporary; TODO: move out to mother function */
-		for (kk = 0; kk < _NI_ + 1; ++kk) {
-			interval = qpData->intervals[kk];
-			/* update primal, dual, and internal QP solver variables */
-			switch (interval->qpSolverSpecification) {
-				case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
-					directQpSolver_doStep(qpData, interval,
-							&(interval->qpSolverClipping.dz), *alpha,
-							&(interval->qpSolverClipping.zUnconstrained),
-							&(interval->z), &(interval->y), &(interval->q),
-							&(interval->p));
-					break;
-
-				case QPDUNES_STAGE_QP_SOLVER_QPOASES:
-					qpOASES_doStep(qpData, interval->qpSolverQpoases.qpoasesObject,
-							interval, *alpha, &(interval->z), &(interval->y),
-							&(interval->q), &(interval->p));
-					break;
-
-				default:
-					qpDUNES_printError(qpData, __FILE__, __LINE__, "Stage QP solver undefined! Bailing out...");
-					return QPDUNES_ERR_UNKNOWN_ERROR;
-			}
+		/* update primal, dual, and internal QP solver variables */
+		if (qpDUNES_doStepAllLocalQPs(qpData, *alpha) != QPDUNES_OK) {
+			return QPDUNES_ERR_UNKNOWN_ERROR;
 		}
 		*objValIncumbent = qpDUNES_computeObjectiveValue(qpData);
 		return QPDUNES_OK;
@@ -1675,6 +3022,26 @@ return_t qpDUNES_determineStepLength(	qpData_t* const qpData,
 
 	case QPDUNES_LS_HOMOTOPY_GRID_SEARCH:
 		statusFlag = qpDUNES_homotopyGridSearch(	qpData, alpha, itCntr );
+		if ( statusFlag == QPDUNES_ERR_INVALID_ARGUMENT ) {		/* not all stage QPs solved by qpOASES: no homotopy available */
+			statusFlag = qpDUNES_backTrackingLineSearch( qpData, alpha, itCntr, deltaLambdaFS, lambdaTry, nV, 0., alphaMax, *objValIncumbent );
+		}
+		if (statusFlag == QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE) {
+			return statusFlag;
+		}
+		break;
+
+	case QPDUNES_LS_PIECEWISE_QUADRATIC_LS:
+		statusFlag = qpDUNES_piecewiseQuadraticLineSearch( qpData, alpha, itCntr, qpData->options.lineSearchMaxStepSize );
+		if ( statusFlag == QPDUNES_ERR_INVALID_ARGUMENT ) {		/* not all stage QPs solved by clipping: no breakpoints available */
+			statusFlag = qpDUNES_backTrackingLineSearch( qpData, alpha, itCntr, deltaLambdaFS, lambdaTry, nV, 0., alphaMax, *objValIncumbent );
+		}
+		if (statusFlag == QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE) {
+			return statusFlag;
+		}
+		break;
+
+	case QPDUNES_LS_NEWTON_LS:
+		statusFlag = qpDUNES_newtonLineSearch( qpData, alpha, itCntr, deltaLambdaFS, nV, alphaMin, alphaMax );
 		break;
 
 	default:
@@ -1687,14 +3054,46 @@ return_t qpDUNES_determineStepLength(	qpData_t* const qpData,
 //	addVectorScaledVector( lambda, lambda, *alpha, deltaLambdaFS, nV );
 	addScaledVector(lambda, *alpha, deltaLambdaFS, nV);
 	/* stage QP variables */
+	if ( *alpha == qpData->gradientCacheAlpha ) {
+		/* accepted step was the last one tried in the line search: keep its primal variables and gradient */
+		if (qpDUNES_doTrialStepAllLocalQPs(qpData, *alpha) != QPDUNES_OK) {
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+		}
+		qpData->isGradientCacheValid = QPDUNES_TRUE;
+	}
+	else {
+		if (qpDUNES_doStepAllLocalQPs(qpData, *alpha) != QPDUNES_OK) {
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+		}
+	}
+	*objValIncumbent = qpDUNES_computeObjectiveValue(qpData);
+
+	/* return */
+	return statusFlag;
+}
+/*<<< END OF qpDUNES_determineStepLength */
+
+
+/* ----------------------------------------------
+ * update primal, dual, and internal QP solver
+ * variables of all local QPs for step size alpha
+ *
+ >>>>>>                                           */
+return_t qpDUNES_doStepAllLocalQPs(	qpData_t* const qpData,
+									real_t alpha
+									)
+{
+	int_t kk;
+	int_t errCntr = 0;
+	interval_t* interval;
+
+	#pragma omp parallel for private(kk,interval) reduction(+:errCntr) schedule(static) num_threads(qpData->nThreads)
 	for (kk = 0; kk < _NI_ + 1; ++kk) {
 		interval = qpData->intervals[kk];
-		/* TODO: this might have already been done in line search; do not redo */
-		/* update primal, dual, and internal QP solver variables */
 		switch (interval->qpSolverSpecification) {
 			case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
 				directQpSolver_doStep(qpData, interval,
-						&(interval->qpSolverClipping.dz), *alpha,
+						&(interval->qpSolverClipping.dz), alpha,
 						&(interval->qpSolverClipping.zUnconstrained),
 						&(interval->z), &(interval->y), &(interval->q),
 						&(interval->p));
@@ -1702,21 +3101,64 @@ return_t qpDUNES_determineStepLength(	qpData_t* const qpData,
 
 			case QPDUNES_STAGE_QP_SOLVER_QPOASES:
 				qpOASES_doStep(qpData, interval->qpSolverQpoases.qpoasesObject,
-						interval, *alpha, &(interval->z), &(interval->y),
+						interval, alpha, &(interval->z), &(interval->y),
 						&(interval->q), &(interval->p));
 				break;
 
+			case QPDUNES_STAGE_QP_SOLVER_BOXQP:
+				if ( boxQpSolver_doStep( qpData, interval, alpha, &(interval->z), &(interval->y), &(interval->q), &(interval->p) ) != QPDUNES_OK ) {
+					errCntr++;
+				}
+				break;
+
 			default:
 				qpDUNES_printError(qpData, __FILE__, __LINE__, "Stage QP solver undefined! Bailing out...");
-				return QPDUNES_ERR_INVALID_ARGUMENT;
+				errCntr++;
 		}
 	}
-	*objValIncumbent = qpDUNES_computeObjectiveValue(qpData);
+	if (errCntr > 0) {
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
 
-	/* return */
-	return statusFlag;
+	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_determineStepLength */
+/*<<< END OF qpDUNES_doStepAllLocalQPs */
+
+
+/* ----------------------------------------------
+ * update all local QPs for step size alpha from
+ * the trial primal variables of the line search
+ * (clipping stage QPs only)
+ *
+ >>>>>>                                           */
+return_t qpDUNES_doTrialStepAllLocalQPs(	qpData_t* const qpData,
+											real_t alpha
+											)
+{
+	int_t kk;
+	int_t errCntr = 0;
+	interval_t* interval;
+
+	#pragma omp parallel for private(kk,interval) reduction(+:errCntr) schedule(static) num_threads(qpData->nThreads)
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
+		switch (interval->qpSolverSpecification) {
+			case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
+				directQpSolver_doTrialStep( interval, &(interval->qpSolverClipping.dz), alpha, &(interval->zVecTmp) );
+				break;
+
+			default:
+				qpDUNES_printError(qpData, __FILE__, __LINE__, "No trial step available for stage QP solver on stage %d.", kk);
+				errCntr++;
+		}
+	}
+	if (errCntr > 0) {
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_doTrialStepAllLocalQPs */
 
 
 /* ----------------------------------------------
@@ -1965,42 +3407,14 @@ return_t qpDUNES_bisectionIntervalSearch(	qpData_t* const qpData,
 	real_t slopeNormalization = fmin( 1., vectorNorm((vector_t*)deltaLambdaFS,nV) ); 	/* demand more stationarity for smaller steps */
 	/* FIXME: is this meaningful? */
 
-	/* todo: get memory passed on from determine step length */
-	xn_vector_t* gradientTry = &(qpData->xnVecTmp2);
-	/* todo: no need to recompute gradient in next Newton iteration! */
-
-	int_t kk, ii;
-	interval_t* interval;
+	/* trial gradients are kept for the next Newton iteration (see qpDUNES_updateNewtonGradient) */
+	xn_vector_t* gradientTry = &(qpData->gradientCache);
 
 	/* TODO: take line search iterations and maxNumLineSearchRefinementIterations together! */
 	/** (1) check if full step is stationary or even still ascent direction */
 	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr)) {
-		/* update z locally according to alpha guess */
-		for (kk = 0; kk < _NI_ + 1; ++kk) {
-			interval = qpData->intervals[kk];
-			z_vector_t* zTry = &(interval->zVecTmp);
-			/* get primal variables for trial step length */
-			addVectorScaledVector(zTry,	&(interval->qpSolverClipping.zUnconstrained), alphaMax,	&(interval->qpSolverClipping.dz), interval->nV);
-			directQpSolver_saturateVector(qpData, zTry, &(interval->y), &(interval->zLow), &(interval->zUpp), &(interval->H), interval->nV);
-		}
-
-		/* manual gradient computation; TODO: use function, but watch out with z, dz, zTry, etc. */
-		for (kk = 0; kk < _NI_; ++kk) {
-			/* ( A_kk*x_kk^opt + B_kk*u_kk^opt + c_kk ) - x_(kk+1)^opt */
-			multiplyCz( qpData, &(qpData->xVecTmp), &(qpData->intervals[kk]->C), &(qpData->intervals[kk]->zVecTmp) );
-			addToVector(&(qpData->xVecTmp), &(qpData->intervals[kk]->c), _NX_); /* TODO: avoid using global memory!!! */
-
-			/* subtractFromVector( xVecTmp, &(intervals[kk+1]->x), _NX_ ); */
-			for (ii = 0; ii < _NX_; ++ii) {
-				qpData->xVecTmp.data[ii] -=	qpData->intervals[kk + 1]->zVecTmp.data[ii];
-			}
-
-			/* write gradient part */
-			for (ii = 0; ii < _NX_; ++ii) {
-				gradientTry->data[kk * _NX_ + ii] = qpData->xVecTmp.data[ii];
-			}
-		}
-//		computeNewtonGradient( qpData, gradientTry, &(qpData->xVecTmp) );	/* TODO: avoid to use own memory here! */
+		/* update z locally according to alpha guess and compute gradient */
+		qpData->gradientCacheAlpha = ( qpDUNES_computeParametricNewtonGradient( qpData, gradientTry, alphaMax ) == QPDUNES_OK ) ? alphaMax : -1.;
 		alphaSlope = scalarProd(gradientTry, deltaLambdaFS, nV);
 
 		/* take full step if stationary */
@@ -2036,32 +3450,8 @@ return_t qpDUNES_bisectionIntervalSearch(	qpData_t* const qpData,
 	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr) ) {
 		alphaC = 0.5 * (alphaMin + alphaMax);
 
-		/* update z locally according to alpha guess */
-		for (kk = 0; kk < _NI_ + 1; ++kk) {
-			interval = qpData->intervals[kk];
-			z_vector_t* zTry = &(interval->zVecTmp);
-			/* get primal variables for trial step length */
-			addVectorScaledVector( zTry, &(interval->qpSolverClipping.zUnconstrained), alphaC, &(interval->qpSolverClipping.dz), interval->nV );
-			directQpSolver_saturateVector( qpData, zTry, &(interval->y), &(interval->zLow), &(interval->zUpp), &(interval->H), interval->nV );
-		}
-
-		/* manual gradient computation; TODO: use function, but watch out with z, dz, zTry, etc. */
-		for (kk = 0; kk < _NI_; ++kk) {
-			/* ( A_kk*x_kk^opt + B_kk*u_kk^opt + c_kk ) - x_(kk+1)^opt */
-			multiplyCz( qpData, &(qpData->xVecTmp), &(qpData->intervals[kk]->C), &(qpData->intervals[kk]->zVecTmp) );
-			addToVector( &(qpData->xVecTmp), &(qpData->intervals[kk]->c), _NX_ );
-
-			/* subtractFromVector( xVecTmp, &(intervals[kk+1]->x), _NX_ ); */
-			for (ii = 0; ii < _NX_; ++ii) {
-				qpData->xVecTmp.data[ii] -= qpData->intervals[kk + 1]->zVecTmp.data[ii];
-			}
-
-			/* write gradient part */
-			for (ii = 0; ii < _NX_; ++ii) {
-				gradientTry->data[kk * _NX_ + ii] = qpData->xVecTmp.data[ii];
-			}
-		}
-//		computeNewtonGradient( qpData, gradientTry, &(qpData->xVecTmp) );	/* TODO: avoid to use own memory here! */
+		/* update z locally according to alpha guess and compute gradient */
+		qpData->gradientCacheAlpha = ( qpDUNES_computeParametricNewtonGradient( qpData, gradientTry, alphaC ) == QPDUNES_OK ) ? alphaC : -1.;
 		alphaSlope = scalarProd(gradientTry, deltaLambdaFS, nV);
 
 		/* check for stationarity in search direction */
@@ -2119,12 +3509,8 @@ return_t qpDUNES_qpadApproxIntervalSearch(	qpData_t* const qpData,
 //	real_t slopeNormalization = fmin( 1., vectorNorm( (vector_t*)deltaLambdaFS, nV ));	/* demand more stationarity for smaller steps */
 	/* FIXME: is this meaningful? */
 
-	/* todo: get memory passed on from determine step length */
-	xn_vector_t* gradientTry = &(qpData->xnVecTmp2);
-	/* todo: no need to recompute gradient in next Newton iteration! */
-
-	int_t kk, ii;
-	interval_t* interval;
+	/* trial gradients are kept for the next Newton iteration (see qpDUNES_updateNewtonGradient) */
+	xn_vector_t* gradientTry = &(qpData->gradientCache);
 
 	/* get objective value */
 	/** get first alphaC and function values */
@@ -2151,31 +3537,8 @@ return_t qpDUNES_qpadApproxIntervalSearch(	qpData_t* const qpData,
 //		first in the cheap way, though gradient is not so much more expensive...
 //        alphaSlope = qpDUNES_fmax( fabs(sCL) , fabs(sRC) );
 //      cleaner, using gradient:
-		/* update z locally according to alpha guess */
-		for (kk = 0; kk < _NI_ + 1; ++kk) {
-			interval = qpData->intervals[kk];
-			z_vector_t* zTry = &(interval->zVecTmp);
-			/* get primal variables for trial step length */
-			addVectorScaledVector(zTry, &(interval->qpSolverClipping.zUnconstrained), alphaD, &(interval->qpSolverClipping.dz), interval->nV);
-			directQpSolver_saturateVector(qpData, zTry, &(interval->y),	&(interval->zLow), &(interval->zUpp), &(interval->H), interval->nV);
-		}
-
-		/* manual gradient computation; TODO: use function, but watch out with z, dz, zTry, etc. */
-		for (kk = 0; kk < _NI_; ++kk) {
-			/* ( A_kk*x_kk^opt + B_kk*u_kk^opt + c_kk ) - x_(kk+1)^opt */
-			multiplyCz(qpData, &(qpData->xVecTmp), &(qpData->intervals[kk]->C), &(qpData->intervals[kk]->zVecTmp));
-			addToVector(&(qpData->xVecTmp), &(qpData->intervals[kk]->c), _NX_);
-
-			/* subtractFromVector( xVecTmp, &(intervals[kk+1]->x), _NX_ ); */
-			for (ii = 0; ii < _NX_; ++ii) {
-				qpData->xVecTmp.data[ii] -=	qpData->intervals[kk + 1]->zVecTmp.data[ii];
-			}
-
-			/* write gradient part */
-			for (ii = 0; ii < _NX_; ++ii) {
-				gradientTry->data[kk * _NX_ + ii] = qpData->xVecTmp.data[ii];
-			}
-		}
+		/* update z locally according to alpha guess and compute gradient */
+		qpData->gradientCacheAlpha = ( qpDUNES_computeParametricNewtonGradient( qpData, gradientTry, alphaD ) == QPDUNES_OK ) ? alphaD : -1.;
 		alphaSlope = fabs(scalarProd(gradientTry, deltaLambdaFS, nV));
 //		end of cleaner...
 
@@ -2246,52 +3609,151 @@ return_t qpDUNES_qpadApproxIntervalSearch(	qpData_t* const qpData,
 		}
 	}
 
-	qpDUNES_printError(qpData, __FILE__, __LINE__,
-			"Quadratic approximation interval search: Maximum number of iterations reached (itCntr = %d, last alpha: %.3e)",
-			*itCntr, alphaC);
-	*alpha = alphaC;
-	return QPDUNES_ERR_NUMBER_OF_MAX_LINESEARCH_ITERATIONS_REACHED;
+	qpDUNES_printError(qpData, __FILE__, __LINE__,
+			"Quadratic approximation interval search: Maximum number of iterations reached (itCntr = %d, last alpha: %.3e)",
+			*itCntr, alphaC);
+	*alpha = alphaC;
+	return QPDUNES_ERR_NUMBER_OF_MAX_LINESEARCH_ITERATIONS_REACHED;
+}
+/*<<< END OF qpDUNES_qpadApproxIntervalSearch */
+
+
+/* ----------------------------------------------
+ * ...
+ *
+ >>>>>>                                           */
+return_t qpDUNES_gridSearch(	qpData_t* const qpData,
+								real_t* const alpha,
+								uint_t* const itCntr,
+								real_t* const objValIncumbent,
+								real_t alphaMin,
+								real_t alphaMax
+								)
+{
+	int_t kk;
+	int_t nGridPoints = qpData->options.lineSearchNbrGridPoints;
+	return_t statusFlag;
+
+	real_t* alphaGrid = qpData->lineSearchGrid.data;
+	real_t* objValGrid = alphaGrid + nGridPoints;
+
+	if ( alphaGrid == 0 ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Grid line search: memory not allocated; lsType has to be set before setup." );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	for (kk = 0; kk < nGridPoints; ++kk) {
+		alphaGrid[kk] = alphaMin + kk * (alphaMax - alphaMin) / (nGridPoints - 1);
+	}
+
+	/* all grid points in one pass over the stages */
+	statusFlag = qpDUNES_computeParametricObjectiveValues( qpData, alphaGrid, objValGrid, nGridPoints );
+	if ( statusFlag != QPDUNES_OK ) {
+		return statusFlag;
+	}
+
+	for (kk = 0; kk < nGridPoints; ++kk) {
+//		qpDUNES_printf("[ %.12e\t %.12e ];", alphaGrid[kk], objValGrid[kk] );
+		if (objValGrid[kk] > *objValIncumbent) {
+			*objValIncumbent = objValGrid[kk];
+			*alpha = alphaGrid[kk];
+		}
+	}
+	*itCntr += nGridPoints;
+
+	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_qpadApproxIntervalSearch */
+/*<<< END OF qpDUNES_gridSearch */
 
 
 /* ----------------------------------------------
- * ...
+ * merge the homotopy breakpoints of all stages
+ * into one list sorted by alpha
+ *
+ *   Every stage's breakpoints are already ordered, so the stage runs are
+ *   merged pairwise in log2(N+1) rounds; the merges within one round are
+ *   independent. Ties are resolved by stage index, so the result does not
+ *   depend on the number of threads.
  *
  >>>>>>                                           */
-return_t qpDUNES_gridSearch(	qpData_t* const qpData,
-								real_t* const alpha,
-								uint_t* const itCntr,
-								real_t* const objValIncumbent,
-								real_t alphaMin,
-								real_t alphaMax
-								)
+return_t qpDUNES_mergeHomotopyBreakpoints(	qpData_t* const qpData,
+											real_t** const alphaSorted,
+											int_t** const idxSorted,
+											int_t* const nBreakpoints
+											)
 {
-	int_t kk;
+	int_t kk, ii;
+	int_t width, gg;
+	int_t lIdx, lEnd, rIdx, rEnd, tIdx;
+	int_t idxStride = qpData->options.maxNumQpoasesIterations + 2;
+	int_t nBreakpointsTotal = (_NI_+1) * qpData->options.maxNumQpoasesIterations;
 
-	real_t alphaTry;
-	real_t objValTry;
-
-//	qpDUNES_printf("[");
-	/* todo: maybe do more efficiently for a parallelized version by passing grid directly to QP nodes */
-	for (kk = 0; kk < qpData->options.lineSearchNbrGridPoints; ++kk) {
-		alphaTry = alphaMin
-				+ kk * (alphaMax - alphaMin)
-						/ (qpData->options.lineSearchNbrGridPoints - 1);
-		objValTry = qpDUNES_computeParametricObjectiveValue(qpData, alphaTry);
-//		qpDUNES_printf("[ %.12e\t %.12e ];", alphaTry, objValTry );
-		if (objValTry > *objValIncumbent) {
-			*objValIncumbent = objValTry;
-			*alpha = alphaTry;
+	interval_t* interval;
+
+	int_t* runStart = qpData->homotopyRunStart.data;
+	real_t* alphaSrc = qpData->homotopyBreakpoints.data;
+	real_t* alphaDst = alphaSrc + nBreakpointsTotal;
+	int_t* idxSrc = qpData->homotopyBreakpointIdx.data;
+	int_t* idxDst = idxSrc + nBreakpointsTotal;
+	real_t* alphaSwap;
+	int_t* idxSwap;
+
+	if ( runStart == 0 ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Homotopy grid search: memory not allocated; lsType has to be set before setup." );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	/* runs: interior base points of each stage homotopy */
+	runStart[0] = 0;
+	for (kk = 0; kk < _NI_+1; ++kk) {
+		interval = qpData->intervals[kk];
+		if ( ( interval->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_QPOASES ) &&
+			 ( interval->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_BOXQP ) ) {
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Homotopy grid search requires qpOASES or the box QP solver on all stages; no homotopy available on stage %d.", kk );
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+		}
+		runStart[kk+1] = runStart[kk] + qpDUNES_max( interval->parametricObjFctn_nBasePoints - 2, 0 );
+	}
+
+	#pragma omp parallel for private(kk,ii,interval) schedule(static) num_threads(qpData->nThreads)
+	for (kk = 0; kk < _NI_+1; ++kk) {
+		interval = qpData->intervals[kk];
+		for ( ii = 1; ii < interval->parametricObjFctn_nBasePoints-1; ++ii ) {
+			alphaSrc[runStart[kk]+ii-1] = interval->parametricObjFctn_alpha.data[ii];
+			idxSrc[runStart[kk]+ii-1] = kk*idxStride + ii;
+		}
+	}
+
+	/* pairwise merge of neighboring runs */
+	for (width = 1; width < _NI_+1; width *= 2) {
+		#pragma omp parallel for private(gg,lIdx,lEnd,rIdx,rEnd,tIdx) schedule(static) num_threads(qpData->nThreads)
+		for (gg = 0; gg < _NI_+1; gg += 2*width) {
+			lIdx = runStart[gg];
+			lEnd = runStart[qpDUNES_min( gg+width, _NI_+1 )];
+			rIdx = lEnd;
+			rEnd = runStart[qpDUNES_min( gg+2*width, _NI_+1 )];
+			for (tIdx = lIdx; tIdx < rEnd; ++tIdx) {
+				if ( ( rIdx >= rEnd ) || ( ( lIdx < lEnd ) && ( alphaSrc[lIdx] <= alphaSrc[rIdx] ) ) ) {
+					alphaDst[tIdx] = alphaSrc[lIdx];
+					idxDst[tIdx] = idxSrc[lIdx++];
+				}
+				else {
+					alphaDst[tIdx] = alphaSrc[rIdx];
+					idxDst[tIdx] = idxSrc[rIdx++];
+				}
+			}
 		}
+		alphaSwap = alphaSrc;	alphaSrc = alphaDst;	alphaDst = alphaSwap;
+		idxSwap = idxSrc;		idxSrc = idxDst;		idxDst = idxSwap;
 	}
-	*itCntr += qpData->options.lineSearchNbrGridPoints;
 
-//	qpDUNES_printf("]");
+	*alphaSorted = alphaSrc;
+	*idxSorted = idxSrc;
+	*nBreakpoints = runStart[_NI_+1];
 
 	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_gridSearch */
+/*<<< END OF qpDUNES_mergeHomotopyBreakpoints */
 
 
 /* ----------------------------------------------
@@ -2304,67 +3766,64 @@ return_t qpDUNES_homotopyGridSearch(	qpData_t* const qpData,
 										uint_t* const itCntr
 										)
 {
-	int_t kkThis, kkOther, ii;
+	int_t kk, ii, bb;
+	int_t idxStride = qpData->options.maxNumQpoasesIterations + 2;
+	int_t nBreakpoints;
+	return_t statusFlag;
+
+	interval_t* interval;
+
+	real_t* alphaSorted;
+	int_t* idxSorted;
 
-	interval_t* intervalThis;
+	real_t alphaBase;
+	real_t objCoeff[3];			/* coefficients of the total objective on the current section, in powers of alpha */
 
-	real_t alphaIncumbent;
+	real_t alphaIncumbent = 0.;
 	real_t objVal_alphaIncumbent = -qpData->options.QPDUNES_INFTY;
+	real_t objVal;
 	real_t dfdAlpha;
 	int_t dfdAlphaSign;
 	real_t ddfdAlpha;
 
 
-	/* (1) sum up objective function values at all active set changes */
-	for (kkThis = 0; kkThis < _NI_+1; ++kkThis) {
-		intervalThis = qpData->intervals[kkThis];
-
-		/* initialize sums at alpha points of this node */
-		for ( ii=1; ii<intervalThis->parametricObjFctn_nBasePoints-1; ++ii )	{
-			intervalThis->parametricObjFctn_fSum.data[ii] = intervalThis->parametricObjFctn_f.data[ii];
-		}
-
-		/* sum function values of all other nodes at alpha points of this node
-		 * note: this loop must not be parallelized, otherwise race conditions may appear; maximally cyclic reduction */
-		for ( kkOther = 0; kkOther < _NI_+1; ++kkOther )	{
-			if (kkOther == kkThis)	continue;
-//			///
-//			qpDUNES_printf_noNewLine( "interval %d sums before %d :\t", intervalThis->id, kkOther );
-//			for ( ii=1; ii<intervalThis->parametricObjFctn_nBasePoints-1; ++ii )	{
-//				qpDUNES_printf_noNewLine( "%.6e\t", intervalThis->parametricObjFctn_fSum.data[ii] );
-//			}
-//			qpDUNES_printf("");
-//			///
-
-			qpOASES_evalAddParametricObjFctn( 	qpData,
-												qpData->intervals[kkOther],
-												&(intervalThis->parametricObjFctn_fSum),
-												&(intervalThis->parametricObjFctn_alpha),
-												intervalThis->parametricObjFctn_nBasePoints
-												);
-		}
-//		///
-//		qpDUNES_printf_noNewLine( "interval %d sums after %d :\t", intervalThis->id, _NI_+1 );
-//		for ( ii=1; ii<intervalThis->parametricObjFctn_nBasePoints-1; ++ii )	{
-//			qpDUNES_printf_noNewLine( "%.6e\t", intervalThis->parametricObjFctn_fSum.data[ii] );
-//		}
-//		qpDUNES_printf("");
-//		qpDUNES_printf_noNewLine( "Validation interval %d    :\t", intervalThis->id );
-//		for ( ii=1; ii<intervalThis->parametricObjFctn_nBasePoints-1; ++ii )	{
-//			real_t validationVal = qpDUNES_computeParametricObjectiveValue( qpData, intervalThis->parametricObjFctn_alpha.data[ii] );
-//			qpDUNES_printf_noNewLine( "%.6e\t", validationVal );
-//		}
-//		qpDUNES_printf("");
-//		///
+	/* (1) merge the active set changes of all stages */
+	statusFlag = qpDUNES_mergeHomotopyBreakpoints( qpData, &alphaSorted, &idxSorted, &nBreakpoints );
+	if ( statusFlag != QPDUNES_OK ) {
+		return statusFlag;
+	}
 
-		/* (2) take the alpha value with the largest objective function value
-		 */
-		for ( ii=1; ii<intervalThis->parametricObjFctn_nBasePoints-1; ++ii )	{
-//			qpDUNES_printf("this = %d, had fsum[%d] = %.5e (alpha = %.3e)", kkThis, ii, intervalThis->parametricObjFctn_fSum.data[ii], intervalThis->parametricObjFctn_alpha.data[ii]);
-			if ( intervalThis->parametricObjFctn_fSum.data[ii] > objVal_alphaIncumbent )	{
-				objVal_alphaIncumbent = intervalThis->parametricObjFctn_fSum.data[ii];
-				alphaIncumbent = intervalThis->parametricObjFctn_alpha.data[ii];
-			}
+	/* (2) sweep over the merged breakpoints: the total objective is quadratic
+	 *     in between, each breakpoint only switches the section of one stage */
+	objCoeff[0] = 0.;
+	objCoeff[1] = 0.;
+	objCoeff[2] = 0.;
+	for (kk = 0; kk < _NI_+1; ++kk) {
+		interval = qpData->intervals[kk];
+		alphaBase = interval->parametricObjFctn_alpha.data[0];
+		objCoeff[0] += interval->parametricObjFctn_f.data[0] - alphaBase * ( interval->parametricObjFctn_fPrime.data[0] - .5 * alphaBase * interval->parametricObjFctn_fPrimePrime.data[0] );
+		objCoeff[1] += interval->parametricObjFctn_fPrime.data[0] - alphaBase * interval->parametricObjFctn_fPrimePrime.data[0];
+		objCoeff[2] += interval->parametricObjFctn_fPrimePrime.data[0];
+	}
+	for (bb = 0; bb < nBreakpoints; ++bb) {
+		interval = qpData->intervals[idxSorted[bb] / idxStride];
+		ii = idxSorted[bb] % idxStride;
+
+		/* replace section ii-1 of this stage by section ii */
+		alphaBase = interval->parametricObjFctn_alpha.data[ii];
+		objCoeff[0] += interval->parametricObjFctn_f.data[ii] - alphaBase * ( interval->parametricObjFctn_fPrime.data[ii] - .5 * alphaBase * interval->parametricObjFctn_fPrimePrime.data[ii] );
+		objCoeff[1] += interval->parametricObjFctn_fPrime.data[ii] - alphaBase * interval->parametricObjFctn_fPrimePrime.data[ii];
+		objCoeff[2] += interval->parametricObjFctn_fPrimePrime.data[ii];
+		alphaBase = interval->parametricObjFctn_alpha.data[ii-1];
+		objCoeff[0] -= interval->parametricObjFctn_f.data[ii-1] - alphaBase * ( interval->parametricObjFctn_fPrime.data[ii-1] - .5 * alphaBase * interval->parametricObjFctn_fPrimePrime.data[ii-1] );
+		objCoeff[1] -= interval->parametricObjFctn_fPrime.data[ii-1] - alphaBase * interval->parametricObjFctn_fPrimePrime.data[ii-1];
+		objCoeff[2] -= interval->parametricObjFctn_fPrimePrime.data[ii-1];
+
+		/* take the alpha value with the largest objective function value */
+		objVal = objCoeff[0] + alphaSorted[bb] * ( objCoeff[1] + .5 * alphaSorted[bb] * objCoeff[2] );
+		if ( objVal > objVal_alphaIncumbent )	{
+			objVal_alphaIncumbent = objVal;
+			alphaIncumbent = alphaSorted[bb];
 		}
 	}
 
@@ -2375,9 +3834,8 @@ return_t qpDUNES_homotopyGridSearch(	qpData_t* const qpData,
 
 	/* evaluate gradient at alphaIncumbent */
 	dfdAlpha = 0.0;
-	for (kkOther = 0; kkOther < _NI_+1; ++kkOther)	{
-//		if (kkOther == alphaMaxIdx)	continue;
-		dfdAlpha += qpOASES_getParametricObjFctnGrad( qpData, qpData->intervals[kkOther], alphaIncumbent );
+	for (kk = 0; kk < _NI_+1; ++kk)	{
+		dfdAlpha += qpOASES_getParametricObjFctnGrad( qpData, qpData->intervals[kk], alphaIncumbent );
 		/* todo: write this function */
 		/* sum all other hessians...problem, if AS change at exactly the same problem... */
 	}
@@ -2401,8 +3859,8 @@ return_t qpDUNES_homotopyGridSearch(	qpData_t* const qpData,
 
 	/* get hessian depending on gradient direction */
 	ddfdAlpha = 0.0;
-	for (kkOther = 0; kkOther < _NI_+1; ++kkOther)	{
-		ddfdAlpha += qpOASES_getParametricObjFctnHess( qpData, qpData->intervals[kkOther], alphaIncumbent, dfdAlphaSign );
+	for (kk = 0; kk < _NI_+1; ++kk)	{
+		ddfdAlpha += qpOASES_getParametricObjFctnHess( qpData, qpData->intervals[kk], alphaIncumbent, dfdAlphaSign );
 	}
 
 
@@ -2419,8 +3877,8 @@ return_t qpDUNES_homotopyGridSearch(	qpData_t* const qpData,
 #ifdef __DO_UNIT_TESTS__
 	/* Unit test 1: check whether predicted gradient is zero at alpha */
 	dfdAlpha = 0.0;
-	for (kkOther = 0; kkOther < _NI_+1; ++kkOther)	{
-		dfdAlpha += qpOASES_getParametricObjFctnGrad( qpData, qpData->intervals[kkOther], *alpha );
+	for (kk = 0; kk < _NI_+1; ++kk)	{
+		dfdAlpha += qpOASES_getParametricObjFctnGrad( qpData, qpData->intervals[kk], *alpha );
 	}
 	qpDUNES_printf( "[qpDUNES] homotopyGridSearch UNIT TEST 1:\n          line search function model stationarity at found alpha=%.3e is %.3e", *alpha, dfdAlpha );
 
@@ -2448,6 +3906,304 @@ return_t qpDUNES_homotopyGridSearch(	qpData_t* const qpData,
 /*<<< END OF qpDUNES_homotopyGridSearch */
 
 
+/* ----------------------------------------------
+ * exact line search for clipping stage QPs
+ *
+ *   The dual function is concave and piecewise quadratic along the search
+ *   direction, with breakpoints where a component of a stage QP solution hits
+ *   or leaves a bound. All breakpoints are collected and sorted once; the
+ *   slope is then tracked piece by piece until it vanishes. No stage QP is
+ *   re-solved. Returns QPDUNES_ERR_INVALID_ARGUMENT if a stage QP is not solved
+ *   by clipping.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_piecewiseQuadraticLineSearch(	qpData_t* const qpData,
+												real_t* const alpha,
+												uint_t* const itCntr,
+												real_t alphaMax
+												)
+{
+	int_t kk;
+	int_t nBreakpoints = 0;
+
+	real_t* breakpoints = qpData->lineSearchBreakpoints.data;
+
+	real_t slope = 0.;			/* slope of dual function at alphaLeft */
+	real_t curvature = 0.;		/* curvature of dual function right of alphaLeft */
+	real_t curvatureComp = 0.;	/* compensation term of curvature sum */
+	real_t curvatureSum;
+	real_t slopeRight;
+	real_t alphaLeft = 0.;
+	real_t alphaRight;
+
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		if ( qpData->intervals[kk]->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_CLIPPING ) {
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+		}
+	}
+	if ( breakpoints == 0 ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Piecewise quadratic line search: memory not allocated; lsType has to be set before setup." );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	/** (1) collect breakpoints of all stages */
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		clippingQpSolver_getBreakpoints( qpData->intervals[kk], alphaMax, breakpoints, &nBreakpoints, &slope, &curvature );
+	}
+	qsort( breakpoints, nBreakpoints, 2*sizeof(real_t), qpDUNES_compareBreakpoints );
+	++(*itCntr);
+
+	if ( slope <= 0. ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Piecewise quadratic line search: no ascent direction (slope = %.3e).", slope );
+		*alpha = 0.;
+		return QPDUNES_ERR_DECEEDED_MIN_LINESEARCH_STEPSIZE;
+	}
+
+	/** (2) sweep pieces until slope vanishes */
+	for (kk = 0; kk <= nBreakpoints; ++kk) {
+		alphaRight = ( kk < nBreakpoints ) ? breakpoints[2*kk] : alphaMax;
+		slopeRight = slope + (curvature + curvatureComp) * (alphaRight - alphaLeft);
+
+		if ( slopeRight <= 0. ) {	/* stationary point in this piece; curvature < 0 */
+			*alpha = qpDUNES_fmin( alphaRight, alphaLeft - slope / (curvature + curvatureComp) );
+			return QPDUNES_OK;
+		}
+
+		if ( kk < nBreakpoints ) {
+			slope = slopeRight;
+			/* compensated summation: components that enter and leave almost
+			 * immediately add and remove huge curvatures, which must not wipe out
+			 * the remaining ones */
+			curvatureSum = curvature + breakpoints[2*kk+1];
+			if ( fabs( curvature ) >= fabs( breakpoints[2*kk+1] ) ) {
+				curvatureComp += ( curvature - curvatureSum ) + breakpoints[2*kk+1];
+			}
+			else {
+				curvatureComp += ( breakpoints[2*kk+1] - curvatureSum ) + curvature;
+			}
+			curvature = curvatureSum;
+			alphaLeft = alphaRight;
+		}
+	}
+
+	*alpha = alphaMax;
+	if ( qpData->options.printLevel >= 3 ) {
+		qpDUNES_printf("[qpDUNES] Piecewise quadratic line search reached maximum step size");
+	}
+	return QPDUNES_ERR_EXCEEDED_MAX_LINESEARCH_STEPSIZE;
+}
+/*<<< END OF qpDUNES_piecewiseQuadraticLineSearch */
+
+
+/* ----------------------------------------------
+ * qsort comparison of (alpha, ...) pairs
+ *
+ >>>>>>                                           */
+int qpDUNES_compareBreakpoints(	const void* a,
+								const void* b
+								)
+{
+	real_t alphaA = *((const real_t*)a);
+	real_t alphaB = *((const real_t*)b);
+
+	return ( alphaA > alphaB ) - ( alphaA < alphaB );
+}
+/*<<< END OF qpDUNES_compareBreakpoints */
+
+
+/* ----------------------------------------------
+ * safeguarded Newton line search
+ *
+ *   Newton iterations on the slope of the dual function along the search
+ *   direction, with slope and curvature summed up from the analytic stage
+ *   derivatives. The dual function is concave and piecewise quadratic, so a
+ *   Newton step lands on the maximum of the current piece. Steps leaving the
+ *   bracket of the maximum are replaced by the Newton step from the opposite
+ *   bracket end or by a bisection step, which is also forced whenever the
+ *   bracket did not shrink by half over two iterations (Newton steps may jump
+ *   back and forth between pieces). Brackets spanning more than an order of
+ *   magnitude are bisected geometrically.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_newtonLineSearch(	qpData_t* const qpData,
+									real_t* const alpha,
+									uint_t* const itCntr,
+									const xn_vector_t* const deltaLambdaFS,
+									int_t nV,
+									real_t alphaMin,
+									real_t alphaMax
+									)
+{
+	int_t kk;
+
+	real_t alphaTry = alphaMax;		/* start with full step */
+	real_t alphaNext;
+	real_t alphaLow = alphaMin;		/* slope positive left of alphaLow */
+	real_t alphaUpp = qpData->options.lineSearchMaxStepSize;
+	real_t slope, curvature;
+	real_t slopeLow = 0., slopeUpp = 0.;
+	real_t curvatureLow = 0., curvatureUpp = 0.;
+	real_t widthPrev = qpData->options.QPDUNES_INFTY;		/* bracket widths of the last two iterations */
+	real_t widthPrevPrev = qpData->options.QPDUNES_INFTY;
+	boolean_t isSlopeLowKnown = QPDUNES_FALSE;
+	boolean_t isBracketed = QPDUNES_FALSE;
+	boolean_t isProgressSlow;
+
+	real_t slopeNormalization = fmin( 1., vectorNorm((vector_t*)deltaLambdaFS,nV) ); 	/* demand more stationarity for smaller steps */
+
+	/* qpOASES and box QP homotopies are only logged up to the full step */
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		if ( ( qpData->intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_QPOASES ) ||
+			 ( qpData->intervals[kk]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_BOXQP ) ) {
+			alphaUpp = qpDUNES_fmin( alphaUpp, 1. );
+			break;
+		}
+	}
+	alphaTry = qpDUNES_fmin( alphaTry, alphaUpp );
+
+	for ( /*continuous itCntr*/; (*itCntr) < qpData->options.maxNumLineSearchRefinementIterations; ++(*itCntr) ) {
+		if ( qpDUNES_computeParametricObjectiveDerivatives( qpData, alphaTry, &slope, &curvature ) != QPDUNES_OK ) {
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+		}
+
+		/* check for stationarity in search direction */
+		if ( fabs(slope / slopeNormalization) <= qpData->options.lineSearchStationarityTolerance ) {
+			if ( qpData->options.printLevel >= 4 ) {
+				qpDUNES_printf("Alpha = %.5e is stationary, alphaSlope = %.3e, normalization = %.3e", alphaTry, slope, slopeNormalization );
+			}
+			*alpha = alphaTry;
+			return QPDUNES_OK;
+		}
+
+		/* update bracket */
+		if ( slope > 0. ) {
+			if ( alphaTry >= alphaUpp ) {	/* still ascent at largest permitted step */
+				*alpha = alphaTry;
+				if ( qpData->options.printLevel >= 3 ) {
+					qpDUNES_printf("[qpDUNES] Newton line search reached maximum step size");
+				}
+				return QPDUNES_ERR_EXCEEDED_MAX_LINESEARCH_STEPSIZE;
+			}
+			alphaLow = alphaTry;
+			slopeLow = slope;
+			curvatureLow = curvature;
+			isSlopeLowKnown = QPDUNES_TRUE;
+		}
+		else {
+			alphaUpp = alphaTry;
+			slopeUpp = slope;
+			curvatureUpp = curvature;
+			isBracketed = QPDUNES_TRUE;
+		}
+		isProgressSlow = ( ( isBracketed == QPDUNES_TRUE ) && ( alphaUpp - alphaLow > 0.5 * widthPrevPrev ) ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+		widthPrevPrev = widthPrev;
+		widthPrev = alphaUpp - alphaLow;
+
+		/* Newton step on the current piece */
+		alphaNext = ( curvature < 0. ) ? alphaTry - slope / curvature : alphaUpp;
+
+		/* safeguards */
+		if ( ( isProgressSlow == QPDUNES_FALSE ) && ( ( alphaNext <= alphaLow ) || ( alphaNext >= alphaUpp ) ) ) {
+			if ( isBracketed == QPDUNES_FALSE ) {
+				alphaNext = alphaUpp;		/* maximum might be beyond, try largest permitted step */
+			}
+			else if ( slope > 0. ) {		/* Newton step from upper end */
+				alphaNext = ( curvatureUpp < 0. ) ? alphaUpp - slopeUpp / curvatureUpp : alphaUpp;
+			}
+			else if ( isSlopeLowKnown == QPDUNES_TRUE ) {		/* Newton step from lower end */
+				alphaNext = ( curvatureLow < 0. ) ? alphaLow - slopeLow / curvatureLow : alphaLow;
+			}
+		}
+		if ( ( isProgressSlow == QPDUNES_TRUE ) || ( alphaNext <= alphaLow ) || ( alphaNext >= alphaUpp ) ) {
+			if ( isBracketed == QPDUNES_FALSE ) {
+				alphaNext = alphaUpp;
+			}
+			else if ( alphaUpp > 10. * alphaLow && alphaLow > 0. ) {
+				alphaNext = sqrt( alphaLow * alphaUpp );
+			}
+			else {
+				alphaNext = 0.5 * (alphaLow + alphaUpp);
+			}
+		}
+		alphaTry = alphaNext;
+	}
+
+	qpDUNES_printWarning( qpData, __FILE__, __LINE__,	"Newton line search: Maximum number of iterations reached!" );
+	*alpha = alphaLow;
+
+	return QPDUNES_ERR_NUMBER_OF_MAX_LINESEARCH_ITERATIONS_REACHED;
+}
+/*<<< END OF qpDUNES_newtonLineSearch */
+
+
+/* ----------------------------------------------
+ * first and second derivative of the dual
+ * function along the search direction at alpha
+ *
+ *   The second derivative is taken in direction of ascent, which matters
+ *   at breakpoints only.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_computeParametricObjectiveDerivatives(	qpData_t* const qpData,
+														real_t alpha,
+														real_t* const slope,
+														real_t* const curvature
+														)
+{
+	int_t kk;
+	int_t errCntr = 0;
+	int_t direction;
+
+	real_t slopeSum = 0.;
+	real_t curvatureSum = 0.;
+
+	interval_t* interval;
+
+	#pragma omp parallel for private(kk,interval) reduction(+:slopeSum,errCntr) schedule(static) num_threads(qpData->nThreads)
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
+		switch (interval->qpSolverSpecification) {
+			case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
+				slopeSum += clippingQpSolver_getParametricObjFctnGrad( interval, alpha );
+				break;
+
+			case QPDUNES_STAGE_QP_SOLVER_QPOASES:
+			case QPDUNES_STAGE_QP_SOLVER_BOXQP:		/* logs its homotopy in the same format */
+				slopeSum += qpOASES_getParametricObjFctnGrad( qpData, interval, alpha );
+				break;
+
+			default:
+				qpDUNES_printError(qpData, __FILE__, __LINE__,	"Stage QP solver undefined! Bailing out...");
+				errCntr++;
+		}
+	}
+	if (errCntr > 0) {
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	direction = ( slopeSum > 0. ) ? +1 : -1;
+
+	#pragma omp parallel for private(kk,interval) reduction(+:curvatureSum) schedule(static) num_threads(qpData->nThreads)
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
+		switch (interval->qpSolverSpecification) {
+			case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
+				curvatureSum += clippingQpSolver_getParametricObjFctnHess( interval, alpha, direction );
+				break;
+
+			default:	/* QPDUNES_STAGE_QP_SOLVER_QPOASES, QPDUNES_STAGE_QP_SOLVER_BOXQP */
+				curvatureSum += qpOASES_getParametricObjFctnHess( qpData, interval, alpha, direction );
+		}
+	}
+
+	*slope = slopeSum;
+	*curvature = curvatureSum;
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_computeParametricObjectiveDerivatives */
+
+
 /* ----------------------------------------------
  * temporary infeasibility check...
  *
@@ -2565,6 +4321,7 @@ return_t qpDUNES_getDualSol(const qpData_t* const qpData, real_t* const lambda,
 				break;
 
 			case QPDUNES_STAGE_QP_SOLVER_QPOASES:
+			case QPDUNES_STAGE_QP_SOLVER_BOXQP:
 				qpDUNES_copyArray( &(y[nDOffset]), qpData->intervals[kk]->y.data, nStageMult );
 				break;
 
@@ -2626,17 +4383,23 @@ real_t qpDUNES_computeParametricObjectiveValue(	qpData_t* const qpData,
 												)
 {
 	int_t kk;
+	int_t errCntr = 0;
 
 	real_t objVal = 0.;
 
 	interval_t* interval;
+	z_vector_t* qTry;
+	real_t pTry;
+
+	/* stage workspace and multipliers are overwritten, trial step of line search is lost */
+	qpData->gradientCacheAlpha = -1.;
 
 	/* TODO: move to own function in direct QP solver, a la getObjVal( qpData, interval, alpha ) */
+	#pragma omp parallel for private(kk,interval,qTry,pTry) reduction(+:objVal,errCntr) schedule(static) num_threads(qpData->nThreads)
 	for (kk = 0; kk < _NI_ + 1; ++kk) {
 		interval = qpData->intervals[kk];
-		z_vector_t* qTry = &(interval->zVecTmp);
+		qTry = &(interval->zVecTmp);
 //		qpDUNES_copyVector( qTry, &(interval->q), interval->nV );
-		real_t pTry;
 
 		/* get primal variables for trial step length */
 		switch (interval->qpSolverSpecification) {
@@ -2648,9 +4411,17 @@ real_t qpDUNES_computeParametricObjectiveValue(	qpData_t* const qpData,
 				qpOASES_doStep( qpData, interval->qpSolverQpoases.qpoasesObject, interval, alpha, &(interval->z), &(interval->y), qTry, &pTry );
 				break;
 
+			case QPDUNES_STAGE_QP_SOLVER_BOXQP:
+				if ( boxQpSolver_doStep( qpData, interval, alpha, &(interval->z), &(interval->y), qTry, &pTry ) != QPDUNES_OK ) {
+					errCntr++;
+					continue;
+				}
+				break;
+
 			default:
 				qpDUNES_printError(qpData, __FILE__, __LINE__,	"Stage QP solver undefined! Bailing out...");
-				return QPDUNES_ERR_INVALID_ARGUMENT;
+				errCntr++;
+				continue;
 		}
 //		addVectorScaledVector( &(interval->z), &(interval->qpSolverClipping.zUnconstrained), alpha, &(interval->qpSolverClipping.dz), interval->nV );
 //		directQpSolver_saturateVector( qpData, &(interval->z), &(interval->y), &(interval->dLow), &(interval->dUpp), interval->nV );
@@ -2666,12 +4437,101 @@ real_t qpDUNES_computeParametricObjectiveValue(	qpData_t* const qpData,
 
 		objVal += interval->optObjVal;
 	}
+	if (errCntr > 0) {
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
 
 	return objVal;
 }
 /*<<< END OF qpDUNES_computeObjectiveValue */
 
 
+/* ----------------------------------------------
+ * dual objective values for several step sizes
+ *
+ *   Every stage evaluates all step sizes in one call into its row of
+ *   lineSearchStageObjVals (stages in parallel); the rows are summed up in
+ *   stage order afterwards.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_computeParametricObjectiveValues(	qpData_t* const qpData,
+													const real_t* const alphas,
+													real_t* const objVals,
+													int_t nAlphas
+													)
+{
+	int_t kk, jj;
+	int_t errCntr = 0;
+
+	interval_t* interval;
+	z_vector_t* qTry;
+	real_t pTry;
+
+	real_t* stageObjVals = qpData->lineSearchStageObjVals.data;
+
+	/* qpOASES stages overwrite their workspace, trial step of line search is lost */
+	qpData->gradientCacheAlpha = -1.;
+
+	#pragma omp parallel for private(kk,jj,interval,qTry,pTry) reduction(+:errCntr) schedule(static) num_threads(qpData->nThreads)
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		interval = qpData->intervals[kk];
+
+		switch (interval->qpSolverSpecification) {
+			case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
+				if ( directQpSolver_getParametricObjectiveValues( qpData, interval, alphas, &(stageObjVals[kk*nAlphas]), nAlphas ) != QPDUNES_OK ) {
+					errCntr++;
+				}
+				break;
+
+			case QPDUNES_STAGE_QP_SOLVER_QPOASES:
+				/* no closed form available, step along homotopy for every step size */
+				qTry = &(interval->zVecTmp);
+				for (jj = 0; jj < nAlphas; ++jj) {
+					qpOASES_doStep( qpData, interval->qpSolverQpoases.qpoasesObject, interval, alphas[jj], &(interval->z), &(interval->y), qTry, &pTry );
+					stageObjVals[kk*nAlphas+jj] = 0.5 * multiplyzHz(qpData, &(interval->H), &(interval->z), interval->nV)
+												  + scalarProd(qTry, &(interval->z), interval->nV)
+												  + pTry;
+				}
+				break;
+
+			case QPDUNES_STAGE_QP_SOLVER_BOXQP:
+				/* step along homotopy for every step size; cheap for sorted step sizes */
+				qTry = &(interval->zVecTmp);
+				for (jj = 0; jj < nAlphas; ++jj) {
+					if ( boxQpSolver_doStep( qpData, interval, alphas[jj], &(interval->z), &(interval->y), qTry, &pTry ) != QPDUNES_OK ) {
+						errCntr++;
+						break;
+					}
+					stageObjVals[kk*nAlphas+jj] = 0.5 * multiplyzHz(qpData, &(interval->H), &(interval->z), interval->nV)
+												  + scalarProd(qTry, &(interval->z), interval->nV)
+												  + pTry;
+				}
+				break;
+
+			default:
+				qpDUNES_printError(qpData, __FILE__, __LINE__,	"Stage QP solver undefined! Bailing out...");
+				errCntr++;
+		}
+	}
+	if (errCntr > 0) {
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	/* reduction over stages */
+	for (jj = 0; jj < nAlphas; ++jj) {
+		objVals[jj] = 0.;
+	}
+	for (kk = 0; kk < _NI_ + 1; ++kk) {
+		for (jj = 0; jj < nAlphas; ++jj) {
+			objVals[jj] += stageObjVals[kk*nAlphas+jj];
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_computeParametricObjectiveValues */
+
+
 
 
 /* ----------------------------------------------
@@ -2739,6 +4599,19 @@ return_t qpDUNES_getActSetChanges(	const qpData_t* const qpData,
 				}
 				break;
 
+			case QPDUNES_STAGE_QP_SOLVER_BOXQP:
+				/* compare against active set the Newton Hessian block was built on */
+				interval->rebuildHessianBlock = QPDUNES_FALSE;
+				for (ii = 0; ii < _NV(kk); ++ii ) {
+					isBoundActive = ( interval->qpSolverBoxQp.actSet.data[ii] != 0 ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+					if ( isBoundActive != (boolean_t)interval->hessianActSet.data[ii] ) {
+						++(*nChgdConstr);
+						interval->rebuildHessianBlock = QPDUNES_TRUE;
+					}
+					*nActConstr += isBoundActive;
+				}
+				break;
+
 			default:
 				qpDUNES_printError( qpData, __FILE__, __LINE__, "Stage QP solver undefined! Bailing out..." );
 				return QPDUNES_ERR_INVALID_ARGUMENT;
@@ -0,0 +1,359 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file src/factor_cache.c
+ *	\version 1.0beta
+ */
+
+
+#include <qp/factor_cache.h>
+
+
+/* ----------------------------------------------
+ * number of stored elements of a matrix of
+ * dimension nV (-1 if not defined)
+ *
+#>>>>>>                                           */
+static int_t qpDUNES_getStoredMatrixSize(	sparsityType_t sparsityType,
+											int_t nV
+											)
+{
+	switch( sparsityType )
+	{
+		case QPDUNES_DENSE		:
+		case QPDUNES_SPARSE	:
+			return nV*nV;
+		case QPDUNES_DIAGONAL	:
+			return nV;				/* matrix diagonal is saved in first line */
+		case QPDUNES_IDENTITY	:
+			return 0;
+		default				:
+			return -1;
+	}
+}
+/*<<< END OF qpDUNES_getStoredMatrixSize */
+
+
+/* ----------------------------------------------
+ * FNV-1a hash of dimension, sparsity type and
+ * data of a matrix
+ *
+#>>>>>>                                           */
+static uint_t qpDUNES_hashMatrix(	const matrix_t* const M,
+									int_t nV,
+									int_t nStored
+									)
+{
+	int_t ii;
+	uint_t hash = 2166136261u;
+	const unsigned char* bytes = (const unsigned char*)M->data;
+
+	hash = ( hash ^ (uint_t)nV ) * 16777619u;
+	hash = ( hash ^ (uint_t)M->sparsityType ) * 16777619u;
+	for( ii=0; ii<nStored*(int_t)sizeof(real_t); ++ii ) {
+		hash = ( hash ^ bytes[ii] ) * 16777619u;
+	}
+
+	return hash;
+}
+/*<<< END OF qpDUNES_hashMatrix */
+
+
+/* ----------------------------------------------
+ * let interval use the factor of entry
+ *
+#>>>>>>                                           */
+static void qpDUNES_joinFactor(	qpData_t* const qpData,
+								interval_t* const interval,
+								factorCacheEntry_t* const entry
+								)
+{
+	interval->factorCacheEntry = entry;
+	interval->cholH.data = entry->data;
+	interval->cholH.sparsityType = entry->sparsityType;
+	entry->nRefs += 1;
+
+	qpData->factorCache.nSharedFactors += 1;
+}
+/*<<< END OF qpDUNES_joinFactor */
+
+
+/* ----------------------------------------------
+ * factorize the stage Hessian into cholH, or
+ * use the factor of a stage with equal Hessian
+ *
+#>>>>>>                                           */
+return_t qpDUNES_factorizeStageHessian(	qpData_t* const qpData,
+										interval_t* const interval
+										)
+{
+	int_t ii, kk;
+	return_t statusFlag;
+
+	factorCache_t* cache = &(qpData->factorCache);
+	factorCacheEntry_t* entry;
+	factorCacheEntry_t* freeEntry = 0;
+
+	int_t nV = interval->nV;
+	int_t nStored = qpDUNES_getStoredMatrixSize( interval->H.sparsityType, nV );
+	uint_t hash;
+
+	/* the old factor may still be used by other stages */
+	qpDUNES_releaseStageFactor( qpData, interval );
+
+	if ( ( cache->entries == 0 ) || ( nStored < 0 ) ) {
+		cache->nFactorizations += 1;
+		return factorizeH( qpData, &(interval->cholH), &(interval->H), nV );
+	}
+
+	/* (1) look up factor of an equal Hessian */
+	hash = qpDUNES_hashMatrix( &(interval->H), nV, nStored );
+	for( kk=0; kk<(int_t)_NI_+1; ++kk ) {
+		entry = &(cache->entries[kk]);
+		if ( entry->data == 0 ) {
+			if ( freeEntry == 0 )	freeEntry = entry;
+			continue;
+		}
+		if ( ( entry->hash != hash ) || ( entry->nV != nV ) || ( entry->key.sparsityType != interval->H.sparsityType ) ) {
+			continue;
+		}
+		for( ii=0; ii<nStored; ++ii ) {
+			if ( entry->key.data[ii] != interval->H.data[ii] )	break;
+		}
+		if ( ii == nStored ) {
+			qpDUNES_joinFactor( qpData, interval, entry );
+			return QPDUNES_OK;
+		}
+	}
+
+	/* (2) factorize into own storage and offer the factor to other stages */
+	cache->nFactorizations += 1;
+	statusFlag = factorizeH( qpData, &(interval->cholH), &(interval->H), nV );
+	if ( ( statusFlag != QPDUNES_OK ) || ( freeEntry == 0 ) ) {
+		return statusFlag;
+	}
+
+	freeEntry->hash = hash;
+	freeEntry->nV = nV;
+	freeEntry->key.sparsityType = interval->H.sparsityType;
+	for( ii=0; ii<nStored; ++ii ) {
+		freeEntry->key.data[ii] = interval->H.data[ii];
+	}
+	freeEntry->sparsityType = interval->cholH.sparsityType;
+	freeEntry->data = interval->cholHStorage;
+	freeEntry->nRefs = 1;
+	freeEntry->generation += 1;		/* invalidates Newton Hessian contributions memoized for an earlier factor */
+	interval->factorCacheEntry = freeEntry;
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_factorizeStageHessian */
+
+
+/* ----------------------------------------------
+ * use the Hessian factor of stage source
+ *
+#>>>>>>                                           */
+return_t qpDUNES_shareStageFactor(	qpData_t* const qpData,
+									interval_t* const interval,
+									const interval_t* const source
+									)
+{
+	if ( ( source->factorCacheEntry != 0 ) && ( interval->factorCacheEntry == source->factorCacheEntry ) ) {
+		return QPDUNES_OK;
+	}
+
+	qpDUNES_releaseStageFactor( qpData, interval );
+
+	if ( ( source->factorCacheEntry == 0 ) || ( source->nV != interval->nV ) ) {
+		return qpDUNES_copyMatrix( &(interval->cholH), &(source->cholH), interval->nV, interval->nV );
+	}
+
+	qpDUNES_joinFactor( qpData, interval, source->factorCacheEntry );
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_shareStageFactor */
+
+
+/* ----------------------------------------------
+ * stop using a shared Hessian factor
+ *
+#>>>>>>                                           */
+void qpDUNES_releaseStageFactor(	qpData_t* const qpData,
+									interval_t* const interval
+									)
+{
+	int_t ii, kk;
+	int_t nStored;
+	interval_t* newOwner = 0;
+	factorCacheEntry_t* entry = interval->factorCacheEntry;
+
+	if ( entry == 0 ) {
+		return;
+	}
+
+	interval->factorCacheEntry = 0;
+	entry->nRefs -= 1;
+
+	/* the factor lives in the storage of this stage: hand it over to another stage using it */
+	if ( entry->data == interval->cholHStorage ) {
+		for( kk=0; kk<(int_t)_NI_+1; ++kk ) {
+			if ( qpData->intervals[kk]->factorCacheEntry == entry ) {
+				newOwner = qpData->intervals[kk];
+				break;
+			}
+		}
+
+		if ( newOwner != 0 ) {
+			nStored = qpDUNES_getStoredMatrixSize( entry->sparsityType, entry->nV );
+			for( ii=0; ii<nStored; ++ii ) {
+				newOwner->cholHStorage[ii] = entry->data[ii];
+			}
+			entry->data = newOwner->cholHStorage;
+			for( kk=0; kk<(int_t)_NI_+1; ++kk ) {
+				if ( qpData->intervals[kk]->factorCacheEntry == entry ) {
+					qpData->intervals[kk]->cholH.data = entry->data;
+				}
+			}
+		}
+		else {
+			entry->data = 0;		/* entry unused */
+		}
+	}
+
+	interval->cholH.data = interval->cholHStorage;
+}
+/*<<< END OF qpDUNES_releaseStageFactor */
+
+
+/* ----------------------------------------------
+ * release the shared factors of all stages
+ *
+#>>>>>>                                           */
+void qpDUNES_resetFactorCache(	qpData_t* const qpData
+								)
+{
+	int_t kk;
+	factorCache_t* cache = &(qpData->factorCache);
+
+	for( kk=0; kk<(int_t)_NI_+1; ++kk ) {
+		qpData->intervals[kk]->factorCacheEntry = 0;
+		qpData->intervals[kk]->cholH.data = qpData->intervals[kk]->cholHStorage;
+
+		if ( cache->entries != 0 ) {
+			cache->entries[kk].data = 0;
+			cache->entries[kk].nRefs = 0;
+		}
+	}
+}
+/*<<< END OF qpDUNES_resetFactorCache */
+
+
+/* ----------------------------------------------
+ * find unconstrained Newton Hessian blocks that
+ * equal a block further up
+ *
+ * Diagonal block kk depends on the factors of
+ * stages kk and kk+1 and on C_kk, sub-diagonal
+ * block kk on the factor of stage kk and C_kk.
+ * Blocks are compared with the first stage
+ * using the same factor only.
+ *
+#>>>>>>                                           */
+int_t qpDUNES_findSharedNewtonBlocks(	qpData_t* const qpData
+										)
+{
+	int_t ii, kk, jj;
+	int_t nShared = 0;
+
+	factorCache_t* cache = &(qpData->factorCache);
+	int_t* diagSource = cache->newtonBlockSource.data;
+	int_t* subDiagSource = &(cache->newtonBlockSource.data[_NI_]);
+	interval_t** intervals = qpData->intervals;
+	factorCacheEntry_t* entry;
+	boolean_t isEqualC;
+
+	for( kk=0; kk<(int_t)_NI_+1; ++kk ) {
+		cache->entries[kk].newtonDiagStage = -1;
+		cache->entries[kk].newtonSubDiagStage = -1;
+	}
+
+	for( kk=0; kk<(int_t)_NI_; ++kk ) {
+		diagSource[kk] = kk;
+		subDiagSource[kk] = kk;
+
+		entry = intervals[kk]->factorCacheEntry;
+		if ( entry == 0 ) {
+			continue;
+		}
+
+		/* diagonal block */
+		jj = entry->newtonDiagStage;
+		if ( jj < 0 ) {
+			entry->newtonDiagStage = kk;
+		}
+		else if ( intervals[jj+1]->factorCacheEntry == intervals[kk+1]->factorCacheEntry ) {
+			isEqualC = ( intervals[jj]->C.sparsityType == intervals[kk]->C.sparsityType ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+			for( ii=0; ( ii<(int_t)(_NX_*_NZ_) ) && ( isEqualC == QPDUNES_TRUE ); ++ii ) {
+				if ( intervals[jj]->C.data[ii] != intervals[kk]->C.data[ii] )	isEqualC = QPDUNES_FALSE;
+			}
+			if ( ( isEqualC == QPDUNES_TRUE ) && ( intervals[kk+1]->factorCacheEntry != 0 ) ) {
+				diagSource[kk] = jj;
+				nShared += 1;
+			}
+		}
+
+		/* sub-diagonal block (block rows 1 to nI-1) */
+		if ( kk == 0 ) {
+			continue;
+		}
+		jj = entry->newtonSubDiagStage;
+		if ( jj < 0 ) {
+			entry->newtonSubDiagStage = kk;
+		}
+		else {
+			isEqualC = ( intervals[jj]->C.sparsityType == intervals[kk]->C.sparsityType ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+			for( ii=0; ( ii<(int_t)(_NX_*_NZ_) ) && ( isEqualC == QPDUNES_TRUE ); ++ii ) {
+				if ( intervals[jj]->C.data[ii] != intervals[kk]->C.data[ii] )	isEqualC = QPDUNES_FALSE;
+			}
+			if ( isEqualC == QPDUNES_TRUE ) {
+				subDiagSource[kk] = jj;
+				nShared += 1;
+			}
+		}
+	}
+
+	cache->nSharedNewtonBlocks = nShared;
+
+	return nShared;
+}
+/*<<< END OF qpDUNES_findSharedNewtonBlocks */
+
+
+/*
+ *	end of file
+ */
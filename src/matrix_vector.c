@@ -31,6 +31,7 @@
 
 
 #include <qp/matrix_vector.h>
+#include <qp/matrix_vector_small.h>
 
 /* ---------------------------------------------- 
  * Matrix-vector product y = Q*x
@@ -159,6 +160,11 @@ return_t multiplyCz(	qpData_t* const qpData,
 	/** only dense multiplication */
 	int_t ii, jj;
 	
+	if ( qpData->smallKernels.multiplyCz != 0 ) {
+		qpData->smallKernels.multiplyCz( res->data, C->data, z->data );
+		return QPDUNES_OK;
+	}
+
 	for( ii = 0; ii < _NX_; ++ii ) {
 		res->data[ii] = 0.;
 		for( jj = 0; jj < _NZ_; ++jj ) {
@@ -213,6 +219,11 @@ return_t multiplyCTy(	qpData_t* const qpData,
 	/** only dense multiplication */
 	int_t ii, jj;
 	
+	if ( qpData->smallKernels.multiplyCTy != 0 ) {
+		qpData->smallKernels.multiplyCTy( res->data, C->data, y->data );
+		return QPDUNES_OK;
+	}
+
 	/* change multiplication order for more efficient memory access */
 	for( jj = 0; jj < _NZ_; ++jj ) {
 		res->data[jj] = 0.;
@@ -371,12 +382,13 @@ return_t addCInvHCT(	qpData_t* const qpData,
 						const d2_vector_t* const y,
 						xx_matrix_t* const xxMatTmp,
 						ux_matrix_t* const uxMatTmp,
-						zx_matrix_t* const zxMatTmp
+						zx_matrix_t* const zxMatTmp,
+						x_vector_t* const xVecTmp
 						)
 {
 	/* TODO: summarize to one function */
 	return addMultiplyMatrixInvMatrixMatrixT(qpData, res, cholH, C, (y == 0 ? 0 : y->data),
-			zxMatTmp, &(qpData->xVecTmp), _NX_, _NZ_);
+			zxMatTmp, xVecTmp, _NX_, _NZ_);
 
 	return QPDUNES_OK;
 }
@@ -1229,6 +1241,8 @@ return_t backsolveMatrixDiagonalIdentity( qpData_t* const qpData,
 /* ----------------------------------------------
  * Matrix backsolve for L, M both dense
  * compute res for L*res = M^T
+ * M is dim0 x dim1 and stored row-wise, L and
+ * res are dim1 x dim1 and dim1 x dim0
  * 
  >>>>>                                            */
 return_t backsolveMatrixTDenseDenseL( qpData_t* const qpData,
@@ -1249,7 +1263,7 @@ return_t backsolveMatrixTDenseDenseL( qpData_t* const qpData,
 		for( ii=0; ii<dim1; ++ii )	/* go by rows */
 		{
 			for( kk=0; kk<dim0; ++kk ) {
-				sums[kk] = accM(kk,ii,dim0);
+				sums[kk] = accM(kk,ii,dim1);
 			}
 			for( jj=0; jj<ii; ++jj ) {
 				for( kk=0; kk<dim0; ++kk ) {
@@ -1275,7 +1289,7 @@ return_t backsolveMatrixTDenseDenseL( qpData_t* const qpData,
 		for( ii=(dim1-1); ii>=0; --ii )		/* go by rows, bottom-up */
 		{
 			for( kk=0; kk<dim0; ++kk ) {
-				sums[kk] = accM(kk,ii,dim0);
+				sums[kk] = accM(kk,ii,dim1);
 			}
 			for( jj=(ii+1); jj<dim1; ++jj ) {
 				for( kk=0; kk<dim0; ++kk ) {
@@ -2108,47 +2122,114 @@ void multiplyMatrixMatrixTDenseDense(	real_t* const res,
 
 
 /* ----------------------------------------------
- *  M2 * M1^-1 * M2.T
- *  result gets added to res, not overwritten
+ * Transposed matrix-matrix product res = M1.T*M2
+ * for M1, M2 of size nRows x nX
+ *
+ >>>>>                                            */
+void multiplyZxTZx(	qpData_t* const qpData,
+					xx_matrix_t* const res,
+					const zx_matrix_t* const M1,
+					const zx_matrix_t* const M2,
+					int_t nRows,
+					boolean_t addToRes			/**< flag to specify whether to overwrite res, or simply add to it */
+					)
+{
+	if ( qpData->smallKernels.multiplyZxTZx != 0 ) {
+		qpData->smallKernels.multiplyZxTZx( res->data, M1->data, M2->data, nRows, addToRes );
+	}
+	else {
+		multiplyMatrixTMatrixDenseDense( res->data, M1->data, M2->data, nRows, _NX_, _NX_, addToRes );
+	}
+
+	return;
+}
+/*<<< END OF multiplyZxTZx */
+
+
+/* ----------------------------------------------
+ *  factor Z of M2 * M1^-1 * M2.T, i.e.,
+ *  Z = M1^-1/2 * M2.T, or Z = M1^-1 * M2.T for
+ *  diagonal M1 (Z is of shape dim1 x dim0)
  *
  * >>>>>>                                           */
-return_t addMultiplyMatrixInvMatrixMatrixT(	qpData_t* const qpData,
-											matrix_t* const res,
+return_t getMatrixInvMatrixMatrixTFactor(	qpData_t* const qpData,
+											matrix_t* const Z,
 											const matrix_t* const cholM1,
 											const matrix_t* const M2,
-											const real_t* const y, /**< vector containing non-zeros for columns of M2 to be eliminated for unconstrained case */
-											matrix_t* const Ztmp, /**< temporary matrix of shape dim1 x dim0 */
 											vector_t* const vecTmp,
 											int_t dim0, /**< dimensions of M2 */
 											int_t dim1
 											)
 {
-	int_t ii, jj, ll;
-
 	/* always assuming M2 is dense */
-//	assert( M2->sparsityType == QPDUNES_DENSE );
-	/* compute M1^-1/2 * M2.T */
 	switch (cholM1->sparsityType) {
 	case QPDUNES_DENSE:
 	case QPDUNES_SPARSE:
-		backsolveMatrixTDenseDenseL(qpData, Ztmp->data, cholM1->data, M2->data,
+		if ( ( qpData->smallKernels.backsolveCT != 0 ) && ( dim0 == (int_t)_NX_ ) && ( dim1 == (int_t)_NZ_ ) ) {
+			if ( qpData->smallKernels.backsolveCT( Z->data, cholM1->data, M2->data, qpData->options.QPDUNES_ZERO ) != QPDUNES_TRUE ) {
+				qpDUNES_printError( qpData, __FILE__, __LINE__, "Division by 0 in backsolveMatrixTDenseDenseL. Rank-deficient Matrix?" );
+				return QPDUNES_ERR_DIVISION_BY_ZERO;
+			}
+			return QPDUNES_OK;
+		}
+		backsolveMatrixTDenseDenseL(qpData, Z->data, cholM1->data, M2->data,
 				vecTmp->data, QPDUNES_FALSE, dim0, dim1);
-		break;
+		return QPDUNES_OK;
 
 	case QPDUNES_DIAGONAL:
-		backsolveMatrixTDiagonalDense(qpData, Ztmp->data, cholM1->data,
-				M2->data, dim0, dim1); /* computes full inverse times M2! */
-		break;
+		/* computes full inverse times M2! */
+		return backsolveMatrixTDiagonalDense(qpData, Z->data, cholM1->data,
+				M2->data, dim0, dim1);
 
 	case QPDUNES_IDENTITY:
-		qpDUNES_transposeMatrix(Ztmp, M2, dim0, dim1);
-		break;
+		qpDUNES_transposeMatrix(Z, M2, dim0, dim1);
+		return QPDUNES_OK;
 
 	default:
 		return QPDUNES_ERR_UNKNOWN_MATRIX_SPARSITY_TYPE;
 	}
+}
+/*<<< END OF getMatrixInvMatrixMatrixTFactor */
+
+
+/* ----------------------------------------------
+ *  M2 * M1^-1 * M2.T from the factor Z computed
+ *  by getMatrixInvMatrixMatrixTFactor
+ *  result gets added to res, not overwritten
+ *
+ * >>>>>>                                           */
+return_t addMultiplyMatrixInvMatrixMatrixTFromFactor(	qpData_t* const qpData,
+														matrix_t* const res,
+														const matrix_t* const cholM1,
+														const matrix_t* const M2,
+														const real_t* const y, /**< vector containing non-zeros for columns of M2 to be eliminated for unconstrained case */
+														const matrix_t* const Z,
+														int_t dim0, /**< dimensions of M2 */
+														int_t dim1
+														)
+{
+	int_t ii, jj, ll;
 
 	qpDUNES_makeMatrixDense(res, dim0, dim0);
+
+	/* specialized kernels for stage dimensions */
+	if ( ( qpData->smallKernels.backsolveCT != 0 ) && ( dim0 == (int_t)_NX_ ) && ( dim1 == (int_t)_NZ_ ) ) {
+		switch (cholM1->sparsityType) {
+		case QPDUNES_DENSE:
+		case QPDUNES_SPARSE:
+		case QPDUNES_IDENTITY:
+			qpData->smallKernels.addMaskedZTZ( res->data, Z->data, y, qpData->options.equalityTolerance );
+			return QPDUNES_OK;
+
+		case QPDUNES_DIAGONAL:
+			qpData->smallKernels.addMaskedCZ( res->data, M2->data, Z->data, y, qpData->options.equalityTolerance );
+			return QPDUNES_OK;
+
+		default:
+			return QPDUNES_ERR_UNKNOWN_MATRIX_SPARSITY_TYPE;
+		}
+	}
+
 	if (cholM1->sparsityType != QPDUNES_DIAGONAL)
 	{
 		/* compute Z.T * Z as dyadic products */
@@ -2162,7 +2243,7 @@ return_t addMultiplyMatrixInvMatrixMatrixT(	qpData_t* const qpData,
 				for (ii = 0; ii < dim0; ++ii) {
 					for (jj = 0; jj < dim0; ++jj) {
 						/* since M2 is dense, so is Z */
-						res->data[ii * dim0 + jj] += Ztmp->data[ll * dim0 + ii]	* Ztmp->data[ll * dim0 + jj];
+						res->data[ii * dim0 + jj] += Z->data[ll * dim0 + ii]	* Z->data[ll * dim0 + jj];
 					}
 				}
 			} /* end of dyadic addend */
@@ -2180,7 +2261,7 @@ return_t addMultiplyMatrixInvMatrixMatrixT(	qpData_t* const qpData,
 				for (ii = 0; ii < dim0; ++ii) {
 					for (jj = 0; jj < dim0; ++jj) {
 						/* since M2 is dense, so is Z */
-						res->data[ii * dim0 + jj] += M2->data[ii * dim1 + ll] * Ztmp->data[ll * dim0 + jj];
+						res->data[ii * dim0 + jj] += M2->data[ii * dim1 + ll] * Z->data[ll * dim0 + jj];
 					}
 				}
 			} /* end of dyadic addend */
@@ -2189,6 +2270,35 @@ return_t addMultiplyMatrixInvMatrixMatrixT(	qpData_t* const qpData,
 
 	return QPDUNES_OK;
 }
+/*<<< END OF addMultiplyMatrixInvMatrixMatrixTFromFactor */
+
+
+/* ----------------------------------------------
+ *  M2 * M1^-1 * M2.T
+ *  result gets added to res, not overwritten
+ *
+ * >>>>>>                                           */
+return_t addMultiplyMatrixInvMatrixMatrixT(	qpData_t* const qpData,
+											matrix_t* const res,
+											const matrix_t* const cholM1,
+											const matrix_t* const M2,
+											const real_t* const y, /**< vector containing non-zeros for columns of M2 to be eliminated for unconstrained case */
+											matrix_t* const Ztmp, /**< temporary matrix of shape dim1 x dim0 */
+											vector_t* const vecTmp,
+											int_t dim0, /**< dimensions of M2 */
+											int_t dim1
+											)
+{
+	return_t statusFlag;
+
+	/* compute M1^-1/2 * M2.T */
+	statusFlag = getMatrixInvMatrixMatrixTFactor( qpData, Ztmp, cholM1, M2, vecTmp, dim0, dim1 );
+	if ( statusFlag != QPDUNES_OK ) {
+		return statusFlag;
+	}
+
+	return addMultiplyMatrixInvMatrixMatrixTFromFactor( qpData, res, cholM1, M2, y, Ztmp, dim0, dim1 );
+}
 /*<<< END OF addMultiplyMatrixInvMatrixMatrixT */
 
 
@@ -2268,6 +2378,15 @@ return_t denseCholeskyFactorization(	qpData_t* const qpData,
 	int_t ii, jj, kk;
 	real_t sum;
 	
+	if ( ( qpData->smallKernels.choleskyZZ != 0 ) && ( dim0 == (int_t)_NZ_ ) ) {
+		if ( qpData->smallKernels.choleskyZZ( cholM->data, M->data, qpData->options.QPDUNES_ZERO ) != QPDUNES_TRUE ) {
+			/* matrix not positive definite */
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Matrix not positive definite. Cholesky factorization could not be performed." );
+			return QPDUNES_ERR_DIVISION_BY_ZERO;
+		}
+		return QPDUNES_OK;
+	}
+
 	/* go by columns */
 	for( ii=0; ii<dim0; ++ii )
 	{
@@ -0,0 +1,112 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qp42; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file src/matrix_vector_small.c
+ *	\version 1.0beta
+ *
+ *	Instantiation and run-time selection of the dense stage kernels in
+ *	matrix_vector_small_template.h for nX = 1..12, nU = 1..4.
+ */
+
+
+#include <qp/matrix_vector_small.h>
+#include <math.h>
+
+
+#define SMALL_KERNEL_NAME( NAME, NX, NU )	NAME##_##NX##_##NU
+#define SMALL_KERNEL_NAME2( NAME, NX, NU )	SMALL_KERNEL_NAME( NAME, NX, NU )
+#define SMALL_KERNEL( NAME )				SMALL_KERNEL_NAME2( NAME, SMALL_NX, SMALL_NU )
+
+
+/** instantiate kernels for nU = 1..4 and given SMALL_NX */
+#define SMALL_NU 1
+#include <qp/matrix_vector_small_nx.h>
+#undef SMALL_NU
+#define SMALL_NU 2
+#include <qp/matrix_vector_small_nx.h>
+#undef SMALL_NU
+#define SMALL_NU 3
+#include <qp/matrix_vector_small_nx.h>
+#undef SMALL_NU
+#define SMALL_NU 4
+#include <qp/matrix_vector_small_nx.h>
+#undef SMALL_NU
+
+
+/** kernel table setup functions, indexed by [nX-1][nU-1] */
+#define SMALL_KERNEL_ROW( NX )	{ &setupSmallKernels_##NX##_1, &setupSmallKernels_##NX##_2, &setupSmallKernels_##NX##_3, &setupSmallKernels_##NX##_4 }
+
+static void (* const smallKernelSetupTable[QPDUNES_SMALL_KERNELS_NX_MAX][QPDUNES_SMALL_KERNELS_NU_MAX])( smallKernels_t* const ) =
+{
+	SMALL_KERNEL_ROW( 1 ),
+	SMALL_KERNEL_ROW( 2 ),
+	SMALL_KERNEL_ROW( 3 ),
+	SMALL_KERNEL_ROW( 4 ),
+	SMALL_KERNEL_ROW( 5 ),
+	SMALL_KERNEL_ROW( 6 ),
+	SMALL_KERNEL_ROW( 7 ),
+	SMALL_KERNEL_ROW( 8 ),
+	SMALL_KERNEL_ROW( 9 ),
+	SMALL_KERNEL_ROW( 10 ),
+	SMALL_KERNEL_ROW( 11 ),
+	SMALL_KERNEL_ROW( 12 )
+};
+
+
+/* ----------------------------------------------
+ * Select specialized kernels for problem dimensions
+ *
+ >>>>>>                                           */
+boolean_t qpDUNES_setupSmallKernels(	qpData_t* const qpData
+										)
+{
+	smallKernels_t* kernels = &(qpData->smallKernels);
+
+	kernels->multiplyCz = 0;
+	kernels->multiplyCTy = 0;
+	kernels->backsolveCT = 0;
+	kernels->addMaskedZTZ = 0;
+	kernels->addMaskedCZ = 0;
+	kernels->multiplyZxTZx = 0;
+	kernels->choleskyZZ = 0;
+
+	if ( ( qpData->options.useSmallKernels != QPDUNES_TRUE ) ||
+		 ( qpData->nX < 1 ) || ( qpData->nX > QPDUNES_SMALL_KERNELS_NX_MAX ) ||
+		 ( qpData->nU < 1 ) || ( qpData->nU > QPDUNES_SMALL_KERNELS_NU_MAX ) )
+	{
+		return QPDUNES_FALSE;
+	}
+
+	smallKernelSetupTable[qpData->nX-1][qpData->nU-1]( kernels );
+
+	return QPDUNES_TRUE;
+}
+/*<<< END OF qpDUNES_setupSmallKernels */
+
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,359 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file src/newton_memo.c
+ *	\version 1.0beta
+ */
+
+
+#include <qp/newton_memo.h>
+#include <qp/dual_qp.h>
+
+
+#define QPDUNES_ACTSET_BIT( actSet, idx )	( ( (actSet)[(idx)/32] >> ( (idx)%32 ) ) & 1u )
+
+
+/* ----------------------------------------------
+ * active set bitmask of a stage; FALSE if the
+ * contribution of the stage is not memoized
+ *
+#>>>>>>                                           */
+static boolean_t qpDUNES_getNewtonMemoActSet(	const qpData_t* const qpData,
+												const interval_t* const interval,
+												uint_t* const actSet
+												)
+{
+	int_t ii;
+
+	/* stage Hessians are identified by their shared factor */
+	if ( interval->factorCacheEntry == 0 ) {
+		return QPDUNES_FALSE;
+	}
+
+	for( ii=0; ii<qpData->newtonMemo.nActSetWords; ++ii ) {
+		actSet[ii] = 0;
+	}
+
+	switch ( interval->qpSolverSpecification )
+	{
+		case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
+			if ( ( interval->cholH.sparsityType != QPDUNES_DIAGONAL ) && ( interval->cholH.sparsityType != QPDUNES_IDENTITY ) ) {
+				return QPDUNES_FALSE;
+			}
+			for( ii=0; ii<(int_t)interval->nV; ++ii ) {
+				if ( qpDUNES_isBoundActiveInNewtonHessian( qpData, interval, ii ) == QPDUNES_TRUE ) {
+					actSet[ii/32] |= 1u << ( ii%32 );
+				}
+			}
+			return QPDUNES_TRUE;
+
+		case QPDUNES_STAGE_QP_SOLVER_BOXQP:
+			for( ii=0; ii<(int_t)interval->nV; ++ii ) {
+				if ( interval->qpSolverBoxQp.actSet.data[ii] != 0 ) {
+					actSet[ii/32] |= 1u << ( ii%32 );
+				}
+			}
+			return QPDUNES_TRUE;
+
+		default:
+			/* active set of qpOASES stages includes affine constraints */
+			return QPDUNES_FALSE;
+	}
+}
+/*<<< END OF qpDUNES_getNewtonMemoActSet */
+
+
+/* ----------------------------------------------
+ * FNV-1a hash of factor and active set
+ *
+#>>>>>>                                           */
+static uint_t qpDUNES_hashNewtonMemoKey(	const qpData_t* const qpData,
+											const factorCacheEntry_t* const factor,
+											boolean_t hasC,
+											const uint_t* const actSet
+											)
+{
+	int_t ii;
+	uint_t hash = 2166136261u;
+
+	hash = ( hash ^ (uint_t)( factor - qpData->factorCache.entries ) ) * 16777619u;
+	hash = ( hash ^ factor->generation ) * 16777619u;
+	hash = ( hash ^ (uint_t)hasC ) * 16777619u;
+	for( ii=0; ii<qpData->newtonMemo.nActSetWords; ++ii ) {
+		hash = ( hash ^ actSet[ii] ) * 16777619u;
+	}
+
+	return hash;
+}
+/*<<< END OF qpDUNES_hashNewtonMemoKey */
+
+
+/* ----------------------------------------------
+ * check whether a slot holds the contribution of
+ * interval for the given active set
+ *
+#>>>>>>                                           */
+static boolean_t qpDUNES_isNewtonMemoMatch(	const qpData_t* const qpData,
+											const newtonMemoSlot_t* const slot,
+											const interval_t* const interval,
+											boolean_t hasC,
+											uint_t hash,
+											const uint_t* const actSet
+											)
+{
+	int_t ii;
+
+	if ( ( slot->factor != interval->factorCacheEntry ) || ( slot->hash != hash ) ||
+		 ( slot->factorGeneration != interval->factorCacheEntry->generation ) || ( slot->hasC != hasC ) )
+	{
+		return QPDUNES_FALSE;
+	}
+	for( ii=0; ii<qpData->newtonMemo.nActSetWords; ++ii ) {
+		if ( slot->actSet[ii] != actSet[ii] )	return QPDUNES_FALSE;
+	}
+	if ( hasC == QPDUNES_TRUE ) {
+		if ( slot->C.sparsityType != interval->C.sparsityType ) {
+			return QPDUNES_FALSE;
+		}
+		for( ii=0; ii<(int_t)(_NX_*_NZ_); ++ii ) {
+			if ( slot->C.data[ii] != interval->C.data[ii] )	return QPDUNES_FALSE;
+		}
+	}
+
+	return QPDUNES_TRUE;
+}
+/*<<< END OF qpDUNES_isNewtonMemoMatch */
+
+
+/* ----------------------------------------------
+ * find the memoized contributions of all stages
+ * needed for the Newton Hessian blocks to be
+ * rebuilt; assigns slots to the contributions
+ * that have to be computed
+ *
+ * Stage kk contributes to the diagonal blocks
+ * kk-1 and kk and to the sub-diagonal block kk.
+ * Slots used in the current setup are not
+ * replaced; contributions that do not fit are
+ * computed in place by qpDUNES_setupNewtonSystem.
+ *
+#>>>>>>                                           */
+void qpDUNES_lookupNewtonMemo(	qpData_t* const qpData
+								)
+{
+	int_t ii, kk, ss;
+
+	newtonMemo_t* memo = &(qpData->newtonMemo);
+	interval_t** intervals = qpData->intervals;
+	int_t* stageSlot = memo->stageSlot.data;
+	uint_t* actSet = &( memo->actSets[memo->nSlots*memo->nActSetWords] );	/* lookup key */
+	newtonMemoSlot_t* slot;
+	int_t victimIdx;
+	boolean_t hasC;
+	uint_t hash;
+
+	memo->clock += 1;
+
+	for( kk=0; kk<(int_t)_NI_+1; ++kk ) {
+		stageSlot[kk] = -1;
+
+		if ( ( intervals[kk]->rebuildHessianBlock == QPDUNES_FALSE ) &&
+			 ( ( kk == 0 ) || ( intervals[kk-1]->rebuildHessianBlock == QPDUNES_FALSE ) ) &&
+			 ( ( kk == (int_t)_NI_ ) || ( intervals[kk+1]->rebuildHessianBlock == QPDUNES_FALSE ) ) )
+		{
+			continue;	/* contribution not needed */
+		}
+		if ( qpDUNES_getNewtonMemoActSet( qpData, intervals[kk], actSet ) == QPDUNES_FALSE ) {
+			continue;
+		}
+
+		hasC = ( kk < (int_t)_NI_ ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+		hash = qpDUNES_hashNewtonMemoKey( qpData, intervals[kk]->factorCacheEntry, hasC, actSet );
+
+		/* look up contribution, remember least recently used slot */
+		victimIdx = -1;
+		for( ss=0; ss<memo->nSlots; ++ss ) {
+			slot = &(memo->slots[ss]);
+			if ( qpDUNES_isNewtonMemoMatch( qpData, slot, intervals[kk], hasC, hash, actSet ) == QPDUNES_TRUE ) {
+				break;
+			}
+			if ( ( slot->lastUse != memo->clock ) &&
+				 ( ( victimIdx < 0 ) || ( slot->lastUse < memo->slots[victimIdx].lastUse ) ) )
+			{
+				victimIdx = ss;
+			}
+		}
+
+		if ( ss < memo->nSlots ) {
+			/* hit (possibly on a contribution computed by another stage in this setup) */
+			memo->slots[ss].lastUse = memo->clock;
+			stageSlot[kk] = ss;
+			memo->nHits += 1;
+			continue;
+		}
+
+		memo->nMisses += 1;
+		if ( victimIdx < 0 ) {
+			continue;
+		}
+
+		/* claim slot for the contribution of this stage */
+		slot = &(memo->slots[victimIdx]);
+		slot->factor = intervals[kk]->factorCacheEntry;
+		slot->factorGeneration = intervals[kk]->factorCacheEntry->generation;
+		slot->hash = hash;
+		slot->hasC = hasC;
+		for( ii=0; ii<memo->nActSetWords; ++ii ) {
+			slot->actSet[ii] = actSet[ii];
+		}
+		if ( hasC == QPDUNES_TRUE ) {
+			slot->C.sparsityType = intervals[kk]->C.sparsityType;
+			for( ii=0; ii<(int_t)(_NX_*_NZ_); ++ii ) {
+				slot->C.data[ii] = intervals[kk]->C.data[ii];
+			}
+		}
+		slot->lastUse = memo->clock;
+		slot->fillStage = kk;
+		stageSlot[kk] = victimIdx;
+	}
+}
+/*<<< END OF qpDUNES_lookupNewtonMemo */
+
+
+/* ----------------------------------------------
+ * compute the contribution of a stage into the
+ * slot assigned by qpDUNES_lookupNewtonMemo
+ *
+ *   E P E', C P C' and C P E' with the projected
+ *   inverse Hessian P = Z (Z'HZ)^-1 Z', computed
+ *   as in qpDUNES_setupNewtonSystem; C P C' is
+ *   kept as factor, see newtonMemoSlot_t
+ *
+#>>>>>>                                           */
+return_t qpDUNES_fillNewtonMemo(	qpData_t* const qpData,
+									interval_t* const interval,
+									newtonMemoSlot_t* const slot
+									)
+{
+	int_t ii, jj;
+	int_t nFree;
+	return_t statusFlag = QPDUNES_OK;
+
+	/* workspace of the executing thread */
+	threadWorkspace_t* workspace = &(qpData->threadWorkspace[qpDUNES_getThreadNum()]);
+	x_vector_t* xVecTmp = &(workspace->xVecTmp);
+	zx_matrix_t* zxMatTmp = &(workspace->zxMatTmp);
+	zx_matrix_t* zxMatTmp2 = &(workspace->xzMatTmp);
+
+	zz_matrix_t ZT;
+	ZT.data = 0;
+	ZT.sparsityType = QPDUNES_DENSE;
+	zz_matrix_t cholProjHess;
+	cholProjHess.data = 0;
+	cholProjHess.sparsityType = QPDUNES_DENSE;
+
+	switch ( interval->qpSolverSpecification )
+	{
+		case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
+			/* E P E': inverse Hessian of the states (first nX diagonal entries) with rows and columns of active bounds removed */
+			statusFlag = getInvQ( qpData, &(slot->EPE), &(interval->cholH), _NX_ );
+			qpDUNES_makeMatrixDense( &(slot->EPE), _NX_, _NX_ );
+			for( ii=0; ii<(int_t)_NX_; ++ii ) {
+				if ( QPDUNES_ACTSET_BIT( slot->actSet, ii ) != 0 ) {
+					slot->EPE.data[ii*_NX_+ii] = 0.;
+				}
+			}
+			if ( ( slot->hasC == QPDUNES_FALSE ) || ( statusFlag != QPDUNES_OK ) ) {
+				break;
+			}
+
+			/* factor of C P C' (the product is formed on top of E P E' of the next stage) */
+			slot->CPCFactor.sparsityType = QPDUNES_DENSE;
+			statusFlag = getMatrixInvMatrixMatrixTFactor( qpData, &(slot->CPCFactor), &(interval->cholH), &(interval->C), xVecTmp, _NX_, _NZ_ );
+			if ( statusFlag != QPDUNES_OK ) {
+				break;
+			}
+
+			/* C P E': columns of active bounds vanish */
+			statusFlag = multiplyAInvQ( qpData, &(slot->CPE), &(interval->C), &(interval->cholH) );
+			for( ii=0; ii<(int_t)_NX_; ++ii ) {
+				for( jj=0; jj<(int_t)_NX_; ++jj ) {
+					if ( QPDUNES_ACTSET_BIT( slot->actSet, jj ) != 0 ) {
+						slot->CPE.data[ii*_NX_+jj] = 0.;
+					}
+				}
+			}
+			break;
+
+		case QPDUNES_STAGE_QP_SOLVER_BOXQP:
+			for( ii=0; ii<(int_t)(_NX_*_NZ_); ++ii ) {
+				zxMatTmp->data[ii] = 0.;	/* wipe out matrices for safety */
+				zxMatTmp2->data[ii] = 0.;
+			}
+			boxQpSolver_getZT( qpData, interval, &nFree, &ZT );
+			boxQpSolver_getCholZTHZ( qpData, interval, &cholProjHess );
+
+			/* E P E' */
+			slot->EPE.sparsityType = QPDUNES_DENSE;
+			backsolveRT_ZTET( qpData, zxMatTmp2, &cholProjHess, &ZT, xVecTmp, interval->nV, nFree );
+			multiplyZxTZx( qpData, &(slot->EPE), zxMatTmp2, zxMatTmp2, nFree, QPDUNES_FALSE );
+			if ( slot->hasC == QPDUNES_FALSE ) {
+				break;
+			}
+
+			/* "squareroot" (Z'HZ)^-T Z'C' of C P C' */
+			slot->CPCFactor.sparsityType = QPDUNES_DENSE;
+			slot->nFree = nFree;
+			for( ii=0; ii<(int_t)(_NX_*_NZ_); ++ii ) {
+				slot->CPCFactor.data[ii] = 0.;
+			}
+			multiplyMatrixMatrixTDenseDense( zxMatTmp->data, ZT.data, interval->C.data, nFree, _NZ_, _NX_ );
+			backsolveRT_ZTCT( qpData, &(slot->CPCFactor), &cholProjHess, zxMatTmp, xVecTmp, interval->nV, nFree );
+
+			/* C P E' */
+			slot->CPE.sparsityType = QPDUNES_DENSE;
+			backsolveRT_ZTET( qpData, zxMatTmp, &cholProjHess, &ZT, xVecTmp, interval->nV, nFree );
+			multiplyZxTZx( qpData, &(slot->CPE), &(slot->CPCFactor), zxMatTmp, nFree, QPDUNES_FALSE );
+			break;
+
+		default:
+			statusFlag = QPDUNES_ERR_INVALID_ARGUMENT;
+			break;
+	}
+
+	slot->fillStage = -1;
+	if ( statusFlag != QPDUNES_OK ) {
+		slot->factor = 0;	/* do not reuse */
+	}
+
+	return statusFlag;
+}
+/*<<< END OF qpDUNES_fillNewtonMemo */
+
+
+/*
+ *	end of file
+ */
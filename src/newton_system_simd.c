@@ -0,0 +1,161 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qp42; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file src/newton_system_simd.c
+ *	\version 1.0beta
+ *
+ *	Instantiation of newton_system_simd_template.h for AVX2+FMA and AVX-512
+ *	and run-time selection by CPU feature detection. Each instantiation is
+ *	compiled for its instruction set via function attributes, so the library
+ *	itself does not need to be built with -mavx2 and still runs on older CPUs.
+ */
+
+
+#include <qp/newton_system_simd.h>
+#include <math.h>
+
+
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) ) && !defined(__USE_SINGLE_PRECISION__)
+	#define QPDUNES_NEWTON_SIMD_AVAILABLE
+#endif
+
+
+#ifdef QPDUNES_NEWTON_SIMD_AVAILABLE
+
+#include <immintrin.h>
+
+
+/** AVX2 + FMA, 4 doubles per register */
+#define SIMD_NAME( NAME )	NAME##_avx2
+#define SIMD_FUNCTION		static __attribute__((target("avx2,fma")))
+#define SIMD_WIDTH			4
+#define SIMD_VEC			__m256d
+#define SIMD_LOAD			_mm256_loadu_pd
+#define SIMD_STORE			_mm256_storeu_pd
+#define SIMD_SET1			_mm256_set1_pd
+#define SIMD_ZERO			_mm256_setzero_pd
+#define SIMD_FMADD			_mm256_fmadd_pd
+#define SIMD_FNMADD			_mm256_fnmadd_pd
+#define SIMD_REDUCE			reduce_avx2
+
+SIMD_FUNCTION real_t reduce_avx2( __m256d v )
+{
+	__m128d s = _mm_add_pd( _mm256_castpd256_pd128( v ), _mm256_extractf128_pd( v, 1 ) );
+	return _mm_cvtsd_f64( _mm_add_sd( s, _mm_unpackhi_pd( s, s ) ) );
+}
+
+#include <qp/newton_system_simd_template.h>
+
+#undef SIMD_NAME
+#undef SIMD_FUNCTION
+#undef SIMD_WIDTH
+#undef SIMD_VEC
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_ZERO
+#undef SIMD_FMADD
+#undef SIMD_FNMADD
+#undef SIMD_REDUCE
+
+
+/** AVX-512, 8 doubles per register */
+#define SIMD_NAME( NAME )	NAME##_avx512
+#define SIMD_FUNCTION		static __attribute__((target("avx512f")))
+#define SIMD_WIDTH			8
+#define SIMD_VEC			__m512d
+#define SIMD_LOAD			_mm512_loadu_pd
+#define SIMD_STORE			_mm512_storeu_pd
+#define SIMD_SET1			_mm512_set1_pd
+#define SIMD_ZERO			_mm512_setzero_pd
+#define SIMD_FMADD			_mm512_fmadd_pd
+#define SIMD_FNMADD			_mm512_fnmadd_pd
+#define SIMD_REDUCE			_mm512_reduce_add_pd
+
+#include <qp/newton_system_simd_template.h>
+
+#undef SIMD_NAME
+#undef SIMD_FUNCTION
+#undef SIMD_WIDTH
+#undef SIMD_VEC
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_ZERO
+#undef SIMD_FMADD
+#undef SIMD_FNMADD
+#undef SIMD_REDUCE
+
+#endif	/* QPDUNES_NEWTON_SIMD_AVAILABLE */
+
+
+/* ----------------------------------------------
+ * Select vectorized Newton system kernels
+ *
+ >>>>>>                                           */
+boolean_t qpDUNES_setupNewtonKernels(	qpData_t* const qpData
+										)
+{
+	newtonKernels_t* kernels = &(qpData->newtonKernels);
+
+	kernels->factorizeForward = 0;
+	kernels->factorizeReverse = 0;
+	kernels->solveForward = 0;
+	kernels->solveReverse = 0;
+
+	if ( ( qpData->options.useSimdNewtonKernels != QPDUNES_TRUE ) ||
+		 ( qpData->nX < QPDUNES_NEWTON_SIMD_NX_MIN ) )
+	{
+		return QPDUNES_FALSE;
+	}
+
+	#ifdef QPDUNES_NEWTON_SIMD_AVAILABLE
+	__builtin_cpu_init();
+
+	if ( __builtin_cpu_supports( "avx512f" ) ) {
+		kernels->factorizeForward = &factorizeForward_avx512;
+		kernels->factorizeReverse = &factorizeReverse_avx512;
+		kernels->solveForward = &solveForward_avx512;
+		kernels->solveReverse = &solveReverse_avx512;
+		return QPDUNES_TRUE;
+	}
+	if ( __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" ) ) {
+		kernels->factorizeForward = &factorizeForward_avx2;
+		kernels->factorizeReverse = &factorizeReverse_avx2;
+		kernels->solveForward = &solveForward_avx2;
+		kernels->solveReverse = &solveReverse_avx2;
+		return QPDUNES_TRUE;
+	}
+	#endif	/* QPDUNES_NEWTON_SIMD_AVAILABLE */
+
+	return QPDUNES_FALSE;
+}
+/*<<< END OF qpDUNES_setupNewtonKernels */
+
+
+
+/*
+ *	end of file
+ */
@@ -32,21 +32,38 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include <stdint.h>
 
 #include <qp/qpdunes_utils.h>
 
 
+#if defined(__STATIC_MEMORY__)
+/* memory pool for all solver data; union members ensure alignment for all data types */
+typedef union
+{
+	real_t r;
+	int_t i;
+	void* p;
+} staticMemoryUnit_t;
+
+static staticMemoryUnit_t qpDUNES_staticMemory[ QPDUNES_STATIC_MEMORY_SIZE / sizeof(staticMemoryUnit_t) + 1 ];
+static uint_t qpDUNES_staticMemoryUsed = 0;
+#endif
+
+
 /* ----------------------------------------------
  * safe free routine
  * 
  > >>>>>                  *                         */
-void qpDUNES_free(	real_t** data
+void qpDUNES_free(	memoryArena_t* const arena,
+					real_t** data
 				)
 {
 	if ( *data != 0 )
 	{
-		free( *data );
+		qpDUNES_freeMemory( arena, *data );
 		*data = 0;
 	}
 }
@@ -57,18 +74,296 @@ void qpDUNES_free(	real_t** data
  * safe free routine
  *
  > >>>>>                  *                         */
-void qpDUNES_intFree(	int_t** data
+void qpDUNES_intFree(	memoryArena_t* const arena,
+						int_t** data
 					)
 {
 	if ( *data != 0 )
 	{
-		free( *data );
+		qpDUNES_freeMemory( arena, *data );
 		*data = 0;
 	}
 }
 /*<<< END OF qpDUNES_intFree */
 
 
+/* ----------------------------------------------
+ * zero-initialized memory allocation
+ *
+ > >>>>>                  *                         */
+void* qpDUNES_calloc(	memoryArena_t* const arena,
+						uint_t num,
+						uint_t size
+						)
+{
+	#if !defined(__STATIC_MEMORY__)
+	void* block = qpDUNES_arenaCalloc( arena, num*size, QPDUNES_MEMORY_BLOCK_ALIGNMENT );
+
+	if ( block != 0 ) {
+		return block;
+	}
+	if ( ( arena != 0 ) && ( arena->buffer != 0 ) && ( arena->isOwned == QPDUNES_FALSE ) ) {	/* user-supplied memory block is full */
+		return 0;
+	}
+	return calloc( num, size );
+	#else
+	uint_t nBytes = QPDUNES_STATIC_BLOCK_SIZE( num*size, char );
+	char* block;
+
+	(void)arena;		/* all solver data is taken from the static memory pool */
+
+	if ( qpDUNES_staticMemoryUsed + nBytes > sizeof(qpDUNES_staticMemory) ) {
+		return 0;
+	}
+	block = (char*)qpDUNES_staticMemory + qpDUNES_staticMemoryUsed;
+	qpDUNES_staticMemoryUsed += nBytes;
+	memset( block, 0, nBytes );
+
+	return block;
+	#endif
+}
+/*<<< END OF qpDUNES_calloc */
+
+
+/* ----------------------------------------------
+ * free memory obtained from qpDUNES_calloc
+ *
+ > >>>>>                  *                         */
+void qpDUNES_freeMemory(	memoryArena_t* const arena,
+							void* data
+							)
+{
+	#if !defined(__STATIC_MEMORY__)
+	if ( !qpDUNES_isArenaMemory( arena, data ) ) {	/* arena is released as a whole */
+		free( data );
+	}
+	#else
+	(void)arena;
+	(void)data;		/* static memory is released as a whole */
+	#endif
+}
+/*<<< END OF qpDUNES_freeMemory */
+
+
+/* ----------------------------------------------
+ * zero-initialized memory allocation aligned to
+ * QPDUNES_MEMORY_ALIGNMENT bytes
+ *
+ > >>>>>                  *                         */
+void* qpDUNES_callocAligned(	memoryArena_t* const arena,
+								uint_t num,
+								uint_t size
+								)
+{
+	#if !defined(__STATIC_MEMORY__)
+	char* block = (char*)qpDUNES_arenaCalloc( arena, num*size, QPDUNES_MEMORY_ALIGNMENT );
+	char* aligned;
+
+	if ( block != 0 ) {
+		return block;
+	}
+	if ( ( arena != 0 ) && ( arena->buffer != 0 ) && ( arena->isOwned == QPDUNES_FALSE ) ) {	/* user-supplied memory block is full */
+		return 0;
+	}
+
+	/* over-allocate and keep the original pointer right before the aligned block */
+	block = (char*)calloc( num*size + QPDUNES_MEMORY_ALIGNMENT + sizeof(void*), 1 );
+	if ( block == 0 ) {
+		return 0;
+	}
+	aligned = block + sizeof(void*);
+	aligned += ( QPDUNES_MEMORY_ALIGNMENT - (uintptr_t)aligned % QPDUNES_MEMORY_ALIGNMENT ) % QPDUNES_MEMORY_ALIGNMENT;
+	((void**)aligned)[-1] = block;
+
+	return aligned;
+	#else
+	/* skip to next aligned address in pool */
+	uint_t misalignment = (uint_t)( (uintptr_t)( (char*)qpDUNES_staticMemory + qpDUNES_staticMemoryUsed ) % QPDUNES_MEMORY_ALIGNMENT );
+
+	if ( misalignment != 0 ) {
+		qpDUNES_staticMemoryUsed += QPDUNES_MEMORY_ALIGNMENT - misalignment;
+	}
+
+	return qpDUNES_calloc( arena, num, size );
+	#endif
+}
+/*<<< END OF qpDUNES_callocAligned */
+
+
+/* ----------------------------------------------
+ * safe free routine for memory obtained from
+ * qpDUNES_callocAligned
+ *
+ > >>>>>                  *                         */
+void qpDUNES_freeAligned(	memoryArena_t* const arena,
+							real_t** data
+							)
+{
+	if ( *data != 0 )
+	{
+		qpDUNES_freeAlignedMemory( arena, *data );
+		*data = 0;
+	}
+}
+/*<<< END OF qpDUNES_freeAligned */
+
+
+/* ----------------------------------------------
+ * free memory obtained from
+ * qpDUNES_callocAligned
+ *
+ > >>>>>                  *                         */
+void qpDUNES_freeAlignedMemory(	memoryArena_t* const arena,
+								void* data
+								)
+{
+	#if !defined(__STATIC_MEMORY__)
+	if ( ( data != 0 ) && ( !qpDUNES_isArenaMemory( arena, data ) ) ) {
+		free( ((void**)data)[-1] );
+	}
+	#else
+	(void)arena;
+	(void)data;		/* static memory is released as a whole */
+	#endif
+}
+/*<<< END OF qpDUNES_freeAlignedMemory */
+
+
+/* ----------------------------------------------
+ * bytes needed for a memory block of num*size
+ * bytes behind memorySize bytes of a memory arena,
+ * in the same way as qpDUNES_calloc places it
+ *
+ > >>>>>                  *                         */
+void qpDUNES_reserveMemory(	uint_t* const memorySize,
+							uint_t num,
+							uint_t size
+							)
+{
+	*memorySize = QPDUNES_ALIGN_UP( *memorySize, QPDUNES_MEMORY_BLOCK_ALIGNMENT ) + num*size;
+}
+/*<<< END OF qpDUNES_reserveMemory */
+
+
+/* ----------------------------------------------
+ * same for qpDUNES_callocAligned
+ *
+ > >>>>>                  *                         */
+void qpDUNES_reserveMemoryAligned(	uint_t* const memorySize,
+									uint_t num,
+									uint_t size
+									)
+{
+	*memorySize = QPDUNES_ALIGN_UP( *memorySize, QPDUNES_MEMORY_ALIGNMENT ) + num*size;
+}
+/*<<< END OF qpDUNES_reserveMemoryAligned */
+
+
+#if !defined(__STATIC_MEMORY__)
+/* ----------------------------------------------
+ * zero-initialized memory block from a memory
+ * arena; 0 if there is no arena or it is full
+ *
+ > >>>>>                  *                         */
+void* qpDUNES_arenaCalloc(	memoryArena_t* const arena,
+							uint_t nBytes,
+							uint_t alignment
+							)
+{
+	uint_t offset;
+
+	if ( ( arena == 0 ) || ( arena->buffer == 0 ) ) {
+		return 0;
+	}
+	offset = QPDUNES_ALIGN_UP( arena->used, alignment );
+	if ( offset + nBytes > arena->size ) {
+		arena->isExhausted = QPDUNES_TRUE;
+		return 0;
+	}
+	arena->used = offset + nBytes;
+	memset( arena->buffer + offset, 0, nBytes );
+
+	return arena->buffer + offset;
+}
+/*<<< END OF qpDUNES_arenaCalloc */
+
+
+/* ----------------------------------------------
+ * check whether data lies in the memory block of
+ * an arena
+ *
+ > >>>>>                  *                         */
+boolean_t qpDUNES_isArenaMemory(	const memoryArena_t* const arena,
+									const void* const data
+									)
+{
+	if ( ( arena == 0 ) || ( arena->buffer == 0 ) ) {
+		return QPDUNES_FALSE;
+	}
+	if ( ( (const char*)data >= arena->buffer ) && ( (const char*)data <= arena->buffer + arena->size ) ) {	/* empty blocks may sit at the very end */
+		return QPDUNES_TRUE;
+	}
+	return QPDUNES_FALSE;
+}
+/*<<< END OF qpDUNES_isArenaMemory */
+#endif
+
+
+#if defined(__STATIC_MEMORY__)
+/* ----------------------------------------------
+ * release the whole static memory pool
+ *
+ > >>>>>                  *                         */
+void qpDUNES_resetStaticMemory( void )
+{
+	qpDUNES_staticMemoryUsed = 0;
+}
+/*<<< END OF qpDUNES_resetStaticMemory */
+
+
+/* ----------------------------------------------
+ * bytes taken from the static memory pool
+ *
+ > >>>>>                  *                         */
+uint_t qpDUNES_getStaticMemoryUsage( void )
+{
+	return qpDUNES_staticMemoryUsed;
+}
+/*<<< END OF qpDUNES_getStaticMemoryUsage */
+#endif
+
+
+
+/* ----------------------------------------------
+ * thread index within the current team
+ *
+ > >>>>>                  *                         */
+int_t qpDUNES_getThreadNum( void )
+{
+	#ifdef __QPDUNES_PARALLEL__
+	return (int_t)omp_get_thread_num();
+	#else
+	return 0;
+	#endif
+}
+/*<<< END OF qpDUNES_getThreadNum */
+
+
+/* ----------------------------------------------
+ * maximum size of a thread team
+ *
+ > >>>>>                  *                         */
+int_t qpDUNES_getMaxThreads( void )
+{
+	#ifdef __QPDUNES_PARALLEL__
+	return (int_t)omp_get_max_threads();
+	#else
+	return 1;
+	#endif
+}
+/*<<< END OF qpDUNES_getMaxThreads */
+
+
 
 /* ----------------------------------------------
  * safe array offset routine, avoids NULL
@@ -247,10 +542,11 @@ return_t qpDUNES_setupZeroMatrix(	int_t nRows,
  * ...
  *
  >>>>>                                            */
-return_t qpDUNES_setMatrixNull(	matrix_t* const matrix
+return_t qpDUNES_setMatrixNull(	memoryArena_t* const arena,
+								matrix_t* const matrix
 								)
 {
-	qpDUNES_free( &(matrix->data) );
+	qpDUNES_free( arena, &(matrix->data) );
 	matrix->sparsityType = QPDUNES_MATRIX_UNDEFINED;
 	
 	return QPDUNES_OK;
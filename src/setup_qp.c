@@ -44,12 +44,42 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 						uint_t* nD,
 						qpOptions_t* options
 						)
+{
+	return qpDUNES_setupInMemory( qpData, nI, nX, nU, nD, options, 0, 0 );
+}
+/*<<< END OF qpDUNES_setup */
+
+
+/* ----------------------------------------------
+ * memory allocation in a given memory block
+ * (0: allocate one of qpDUNES_memoryRequirement
+ * bytes)
+ *
+#>>>>>>                                           */
+return_t qpDUNES_setupInMemory(	qpData_t* const qpData,
+								uint_t nI,
+								uint_t nX,
+								uint_t nU,
+								uint_t* nD,
+								qpOptions_t* options,
+								void* const memory,
+								uint_t memorySize
+								)
 {
 	uint_t ii, kk;
 	
 	int_t nZ = nX+nU;
 
-	int_t nDttl = 0;	/* total number of constraints */
+	int_t nDttl;		/* total number of constraints */
+
+	uint_t nFacBlocks;	/* number of block rows of the Newton Hessian factor */
+
+	uint_t nSlots, nWords;	/* Newton Hessian memo dimensions */
+	real_t* slotBlocks;
+
+	#if !defined(__STATIC_MEMORY__)
+	uint_t memorySizeNeeded;
+	#endif
 
 	/* set up options */
 	if (options != 0) {
@@ -59,49 +89,121 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 		qpData->options = qpDUNES_setupDefaultOptions();
 	}
 
-	/* set up dimensions */
-	qpData->nI = nI;
-	qpData->nX = nX;
-	qpData->nU = nU;
-	qpData->nZ = nZ;
-
+	#if defined(__STATIC_MEMORY__)
+	/* dimensions and memory size are fixed at compile time */
+	if ( ( nI != _NI_ ) || ( nX != _NX_ ) || ( nU != _NU_ ) ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Problem dimensions [nI = %d, nX = %d, nU = %d] do not match static memory dimensions [nI = %d, nX = %d, nU = %d].", nI, nX, nU, _NI_, _NX_, _NU_ );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
 	if (nD != 0) {
 		for( kk=0; kk<nI+1; ++kk ) {
-			nDttl += nD[kk];
+			if ( nD[kk] > _NDMAX_ ) {
+				qpDUNES_printError( qpData, __FILE__, __LINE__, "Number of constraints on interval %d (%d) exceeds static memory limit _NDMAX_ = %d.", kk, nD[kk], _NDMAX_ );
+				return QPDUNES_ERR_INVALID_ARGUMENT;
+			}
 		}
 	}
-	qpData->nDttl = nDttl;
+	if ( qpData->options.logLevel != QPDUNES_LOG_OFF ) {
+		qpDUNES_printWarning( qpData, __FILE__, __LINE__, "Iteration logging is not available in static memory version. Logging switched off." );
+		qpData->options.logLevel = QPDUNES_LOG_OFF;
+	}
+	if ( qpData->options.stageDataLayout != QPDUNES_STAGE_LAYOUT_BY_STAGE ) {
+		qpDUNES_printWarning( qpData, __FILE__, __LINE__, "Static memory pool is sized for stage-wise interval data. Switched to stage-wise layout." );
+		qpData->options.stageDataLayout = QPDUNES_STAGE_LAYOUT_BY_STAGE;
+	}
+	if ( qpData->options.maxNumQpoasesIterations > _NQPOASESITERMAX_ ) {
+		qpData->options.maxNumQpoasesIterations = _NQPOASESITERMAX_;
+	}
+	if ( qpData->options.lineSearchNbrGridPoints > _NGRIDPOINTSMAX_ ) {
+		qpData->options.lineSearchNbrGridPoints = _NGRIDPOINTSMAX_;
+	}
+	if ( qpData->options.nwtnHssnMemoSize > _NNEWTONMEMOMAX_ ) {
+		qpData->options.nwtnHssnMemoSize = _NNEWTONMEMOMAX_;
+	}
+	if ( memory != 0 ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "User-supplied memory is not available in static memory version." );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+	qpDUNES_resetStaticMemory();
+	#endif
 
-	qpData->intervals = (interval_t**)calloc( nI+1,sizeof(interval_t*) );
+	/* singular directions are regularized on the pivots of the elimination order; reduced blocks of the
+	 * cyclic reduction and the twist block pivot in a different order than the band factorization and
+	 * may end up with unregularized, nearly singular pivots (workspace sizes below depend on the algorithm) */
+	if ( ( qpData->options.regType == QPDUNES_REG_SINGULAR_DIRECTIONS ) &&
+		 ( ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_CYCLIC_REDUCTION ) ||
+		   ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_TWISTED ) ) )
+	{
+		qpDUNES_printWarning( qpData, __FILE__, __LINE__, "Singular directions regularization is not supported by cyclic reduction or twisted Newton Hessian factorization. Switched to reverse band factorization." );
+		qpData->options.nwtnHssnFacAlg = QPDUNES_NH_FAC_BAND_REVERSE;
+	}
 
+	/* set up dimensions, stage kernels and thread team */
+	qpDUNES_setupDimensions( qpData, nI, nX, nU, nD );
+	nDttl = qpData->nDttl;
 
-	/* normal intervals */
-	for( kk=0; kk<nI; ++kk )
-	{
-		qpData->intervals[kk] = qpDUNES_allocInterval( qpData, nX, nU, nZ, ( (nD != 0) ? nD[kk] : 0 ) );
-		
-//		qpDUNES_printf("after alloc %d", kk);
-//		qpOASES_getNbrActConstr( &(qpData->intervals[kk]->qpSolverQpoases) );
+	#if !defined(__STATIC_MEMORY__)
+	/* place all solver data in one memory block, stage by stage in order of allocation */
+	memorySizeNeeded = qpDUNES_getMemorySize( qpData, nD );
+	if ( memory != 0 ) {
+		if ( ( memorySize < memorySizeNeeded ) || ( (uintptr_t)memory % QPDUNES_MEMORY_ALIGNMENT != 0 ) ) {
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Memory block needs to hold %d bytes (has %d) and to be aligned to %d bytes.", memorySizeNeeded, memorySize, QPDUNES_MEMORY_ALIGNMENT );
+			return QPDUNES_ERR_INVALID_ARGUMENT;
+		}
+		qpData->arena.buffer = (char*)memory;
+		qpData->arena.size = memorySize;
+		qpData->arena.isOwned = QPDUNES_FALSE;
+	}
+	else {
+		qpData->arena.buffer = (char*)qpDUNES_callocAligned( 0, memorySizeNeeded, 1 );
+		qpData->arena.size = ( qpData->arena.buffer != 0 ) ? memorySizeNeeded : 0;	/* fall back to single allocations */
+		qpData->arena.isOwned = QPDUNES_TRUE;
+	}
+	qpData->arena.used = 0;
+	qpData->arena.isExhausted = QPDUNES_FALSE;
+
+	/* arrays of all intervals can only be released with the arena */
+	if ( qpData->arena.buffer == 0 ) {
+		qpData->options.stageDataLayout = QPDUNES_STAGE_LAYOUT_BY_STAGE;
+	}
+	#endif
 
-		qpData->intervals[kk]->id = kk;		/* give interval its initial stage index */
+	qpData->intervals = (interval_t**)qpDUNES_calloc( &(qpData->arena), nI+1,sizeof(interval_t*) );
 
-		qpData->intervals[kk]->xVecTmp.data  = (real_t*)calloc( nX,sizeof(real_t) );
-		qpData->intervals[kk]->uVecTmp.data  = (real_t*)calloc( nU,sizeof(real_t) );
-		qpData->intervals[kk]->zVecTmp.data  = (real_t*)calloc( nZ,sizeof(real_t) );
+	if ( qpData->options.stageDataLayout == QPDUNES_STAGE_LAYOUT_BY_FIELD )
+	{
+		qpDUNES_allocIntervalsByField( qpData, nD );
 	}
-	
+	else
+	{
+		/* normal intervals */
+		for( kk=0; kk<nI; ++kk )
+		{
+			qpData->intervals[kk] = qpDUNES_allocInterval( qpData, nX, nU, nZ, ( (nD != 0) ? nD[kk] : 0 ) );
 
-	/* last interval */
-	qpData->intervals[nI] = qpDUNES_allocInterval( qpData, nX, nU, nX, ( (nD != 0) ? nD[nI] : 0 ) );
-	
-	qpData->intervals[nI]->id = nI;		/* give interval its initial stage index */
+//			qpDUNES_printf("after alloc %d", kk);
+//			qpOASES_getNbrActConstr( &(qpData->intervals[kk]->qpSolverQpoases) );
 
-	qpDUNES_setMatrixNull( &( qpData->intervals[nI]->C ) );
-	qpDUNES_free( &(qpData->intervals[nI]->c.data) );
+			qpData->intervals[kk]->id = kk;		/* give interval its initial stage index */
 
-	qpData->intervals[nI]->xVecTmp.data  = (real_t*)calloc( nX,sizeof(real_t) );
-	qpData->intervals[nI]->uVecTmp.data  = (real_t*)calloc( nU,sizeof(real_t) );
-	qpData->intervals[nI]->zVecTmp.data  = (real_t*)calloc( nZ,sizeof(real_t) );
+			qpData->intervals[kk]->xVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nX,sizeof(real_t) );
+			qpData->intervals[kk]->uVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nU,sizeof(real_t) );
+			qpData->intervals[kk]->zVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nZ,sizeof(real_t) );
+		}
+
+
+		/* last interval */
+		qpData->intervals[nI] = qpDUNES_allocInterval( qpData, nX, nU, nX, ( (nD != 0) ? nD[nI] : 0 ) );
+
+		qpData->intervals[nI]->id = nI;		/* give interval its initial stage index */
+
+		qpDUNES_setMatrixNull( &(qpData->arena), &( qpData->intervals[nI]->C ) );
+		qpDUNES_free( &(qpData->arena), &(qpData->intervals[nI]->c.data) );
+
+		qpData->intervals[nI]->xVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nX,sizeof(real_t) );
+		qpData->intervals[nI]->uVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nU,sizeof(real_t) );
+		qpData->intervals[nI]->zVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nZ,sizeof(real_t) );
+	}
 	
 	
 	/* undefined not-defined lambda parts */
@@ -111,12 +213,19 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 
 
 	/* remainder of qpData struct */
-	qpData->lambda.data      = (real_t*)calloc( nX*nI,sizeof(real_t) );
-	qpData->deltaLambda.data = (real_t*)calloc( nX*nI,sizeof(real_t) );
+	qpData->lambda.data      = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nI,sizeof(real_t) );
+	qpData->deltaLambda.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nI,sizeof(real_t) );
 	
-	qpData->hessian.data  = (real_t*)calloc( (nX*2)*(nX*nI),sizeof(real_t) );
-	qpData->cholHessian.data  = (real_t*)calloc( (nX*2)*(nX*nI),sizeof(real_t) );
-	qpData->gradient.data = (real_t*)calloc( nX*nI,sizeof(real_t) );
+	/* cyclic reduction stores the factors of all reduction levels below each other */
+	nFacBlocks = ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_CYCLIC_REDUCTION ) ? qpDUNES_getCyclicReductionNumBlocks( nI ) : nI;
+
+	/* storage layout of Newton Hessian type matrices */
+	qpDUNES_setupNewtonHessianLayout( &(qpData->nhLayout), nX, qpData->options.nwtnHssnLayout );
+
+	qpData->hessian.data  = (real_t*)qpDUNES_callocAligned( &(qpData->arena), nI*qpData->nhLayout.blockRowStride,sizeof(real_t) );
+	qpData->cholHessian.data  = (real_t*)qpDUNES_callocAligned( &(qpData->arena), nFacBlocks*qpData->nhLayout.blockRowStride,sizeof(real_t) );
+	qpData->gradient.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nI,sizeof(real_t) );
+	qpData->gradientCache.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nI,sizeof(real_t) );
 	
 	/* allocate unconstrained hessian if needed*/
 	if( qpData->options.regType == QPDUNES_REG_UNCONSTRAINED_HESSIAN ||
@@ -124,22 +233,150 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 				qpData->options.regType == QPDUNES_REG_ADD_UNCONSTRAINED_HESSIAN_DIAG ||
 				(qpData->options.nbrInitialGradientSteps > 0))
 	{
-		qpData->unconstrainedHessian.data = (real_t*)calloc( (nX*2)*(nX*nI), sizeof(real_t));
-		qpData->cholUnconstrainedHessian.data = (real_t*)calloc( (nX*2)*(nX*nI), sizeof(real_t) );
+		qpData->unconstrainedHessian.data = (real_t*)qpDUNES_callocAligned( &(qpData->arena), nI*qpData->nhLayout.blockRowStride, sizeof(real_t));
+		qpData->cholUnconstrainedHessian.data = (real_t*)qpDUNES_callocAligned( &(qpData->arena), nFacBlocks*qpData->nhLayout.blockRowStride, sizeof(real_t) );
+		qpData->cholUnconstrainedHessianBlockSparsity = (sparsityType_t*)qpDUNES_calloc( &(qpData->arena), nI,sizeof(sparsityType_t) );
+	}
+	else {
+		qpData->unconstrainedHessian.data = 0;
+		qpData->cholUnconstrainedHessian.data = 0;
+		qpData->cholUnconstrainedHessianBlockSparsity = 0;
+	}
+	qpData->cholHessianBlockSparsity = (sparsityType_t*)qpDUNES_calloc( &(qpData->arena), nI,sizeof(sparsityType_t) );
+
+	/* no Newton Hessian factor yet that could be modified */
+	qpData->cholHessianTwistIdx = -1;
+	qpData->cholUnconstrainedHessianTwistIdx = -1;
+	qpData->isCholHessianUpdatable = QPDUNES_FALSE;
+	qpData->isCholHessianUpToDate = QPDUNES_FALSE;
+
+	/* no line search gradient to reuse yet */
+	qpData->gradientCacheAlpha = -1.;
+	qpData->isGradientCacheValid = QPDUNES_FALSE;
+
+	/* allocate cache of shared stage Hessian factors if needed */
+	qpData->factorCache.nFactorizations = 0;
+	qpData->factorCache.nSharedFactors = 0;
+	qpData->factorCache.nSharedNewtonBlocks = 0;
+	if ( qpData->options.shareStageFactors == QPDUNES_TRUE ) {
+		qpData->factorCache.entries = (factorCacheEntry_t*)qpDUNES_calloc( &(qpData->arena), nI+1, sizeof(factorCacheEntry_t) );
+		qpData->factorCache.keys = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ*nZ, sizeof(real_t) );
+		qpData->factorCache.newtonBlockSource.data = (int_t*)qpDUNES_calloc( &(qpData->arena), 2*nI, sizeof(int_t) );
+		for( ii=0; ii<nI+1; ++ii ) {
+			qpData->factorCache.entries[ii].key.data = &( qpData->factorCache.keys[ii*nZ*nZ] );
+		}
+	}
+	else {
+		qpData->factorCache.entries = 0;
+		qpData->factorCache.keys = 0;
+		qpData->factorCache.newtonBlockSource.data = 0;
+	}
+
+	/* allocate memo of stage contributions to the Newton Hessian if needed (keyed by shared factors) */
+	qpData->newtonMemo.nSlots = ( qpData->factorCache.entries != 0 ) ? qpDUNES_max( qpData->options.nwtnHssnMemoSize, 0 ) : 0;
+	qpData->newtonMemo.nActSetWords = ( nZ + 31 ) / 32;
+	qpData->newtonMemo.clock = 0;
+	qpData->newtonMemo.nHits = 0;
+	qpData->newtonMemo.nMisses = 0;
+	if ( qpData->newtonMemo.nSlots > 0 ) {
+		nSlots = (uint_t)qpData->newtonMemo.nSlots;
+		nWords = (uint_t)qpData->newtonMemo.nActSetWords;
+		qpData->newtonMemo.slots = (newtonMemoSlot_t*)qpDUNES_calloc( &(qpData->arena), nSlots, sizeof(newtonMemoSlot_t) );
+		qpData->newtonMemo.blocks = (real_t*)qpDUNES_calloc( &(qpData->arena), nSlots*(2*nX*nX+2*nX*nZ), sizeof(real_t) );
+		qpData->newtonMemo.actSets = (uint_t*)qpDUNES_calloc( &(qpData->arena), (nSlots+1)*nWords, sizeof(uint_t) );
+		qpData->newtonMemo.stageSlot.data = (int_t*)qpDUNES_calloc( &(qpData->arena), nI+1, sizeof(int_t) );
+		for( ii=0; ii<nSlots; ++ii ) {
+			slotBlocks = &( qpData->newtonMemo.blocks[ii*(2*nX*nX+2*nX*nZ)] );
+			qpData->newtonMemo.slots[ii].EPE.data = slotBlocks;
+			qpData->newtonMemo.slots[ii].CPE.data = &( slotBlocks[nX*nX] );
+			qpData->newtonMemo.slots[ii].CPCFactor.data = &( slotBlocks[2*nX*nX] );
+			qpData->newtonMemo.slots[ii].C.data = &( slotBlocks[2*nX*nX+nX*nZ] );
+			qpData->newtonMemo.slots[ii].actSet = &( qpData->newtonMemo.actSets[ii*nWords] );
+			qpData->newtonMemo.slots[ii].fillStage = -1;
+		}
+	}
+	else {
+		qpData->newtonMemo.slots = 0;
+		qpData->newtonMemo.blocks = 0;
+		qpData->newtonMemo.actSets = 0;
+		qpData->newtonMemo.stageSlot.data = 0;
+	}
+
+	/* allocate cyclic reduction workspace if needed */
+	if ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_CYCLIC_REDUCTION ) {
+		qpData->cyclicReductionTmp.data = (real_t*)qpDUNES_callocAligned( &(qpData->arena), nI*qpData->nhLayout.blockRowStride, sizeof(real_t) );
+		qpData->cyclicReductionRhs.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nFacBlocks, sizeof(real_t) );
+	}
+	else {
+		qpData->cyclicReductionTmp.data = 0;
+		qpData->cyclicReductionRhs.data = 0;
+	}
+
+	/* allocate workspace of vectorized Newton system kernels if needed */
+	if ( qpData->newtonKernels.factorizeForward != 0 ) {
+		qpData->newtonKernelTmp.data = (real_t*)qpDUNES_calloc( &(qpData->arena), 2*nX*nX+nX, sizeof(real_t) );
+	}
+	else {
+		qpData->newtonKernelTmp.data = 0;
+	}
+
+	/* allocate breakpoints of piecewise quadratic line search if needed (two per primal variable) */
+	if ( qpData->options.lsType == QPDUNES_LS_PIECEWISE_QUADRATIC_LS ) {
+		qpData->lineSearchBreakpoints.data = (real_t*)qpDUNES_calloc( &(qpData->arena), 4*(nI*nZ+nX), sizeof(real_t) );
+	}
+	else {
+		qpData->lineSearchBreakpoints.data = 0;
+	}
+
+	/* allocate grid line search buffers if needed */
+	if ( ( qpData->options.lsType == QPDUNES_LS_GRID_LS ) ||
+		 ( qpData->options.lsType == QPDUNES_LS_ACCELERATED_GRID_LS ) )
+	{
+		qpData->lineSearchGrid.data = (real_t*)qpDUNES_calloc( &(qpData->arena), 2*qpData->options.lineSearchNbrGridPoints, sizeof(real_t) );
+		qpData->lineSearchStageObjVals.data = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*qpData->options.lineSearchNbrGridPoints, sizeof(real_t) );
+	}
+	else {
+		qpData->lineSearchGrid.data = 0;
+		qpData->lineSearchStageObjVals.data = 0;
+	}
+
+	/* allocate homotopy breakpoint merge buffers if needed (at most one breakpoint per qpOASES iteration) */
+	if ( qpData->options.lsType == QPDUNES_LS_HOMOTOPY_GRID_SEARCH ) {
+		qpData->homotopyBreakpoints.data = (real_t*)qpDUNES_calloc( &(qpData->arena), 2*(nI+1)*qpData->options.maxNumQpoasesIterations, sizeof(real_t) );
+		qpData->homotopyBreakpointIdx.data = (int_t*)qpDUNES_calloc( &(qpData->arena), 2*(nI+1)*qpData->options.maxNumQpoasesIterations, sizeof(int_t) );
+		qpData->homotopyRunStart.data = (int_t*)qpDUNES_calloc( &(qpData->arena), nI+2, sizeof(int_t) );
+	}
+	else {
+		qpData->homotopyBreakpoints.data = 0;
+		qpData->homotopyBreakpointIdx.data = 0;
+		qpData->homotopyRunStart.data = 0;
 	}
 	
-	qpData->xVecTmp.data  = (real_t*)calloc( nX,sizeof(real_t) );
-	qpData->uVecTmp.data  = (real_t*)calloc( nU,sizeof(real_t) );
-	qpData->zVecTmp.data  = (real_t*)calloc( nZ,sizeof(real_t) );
-	qpData->xnVecTmp.data  = (real_t*)calloc( nX*nI,sizeof(real_t) );
-	qpData->xnVecTmp2.data  = (real_t*)calloc( nX*nI,sizeof(real_t) );
-	qpData->xxMatTmp.data = (real_t*)calloc( nX*nX,sizeof(real_t) );
-	qpData->xxMatTmp2.data = (real_t*)calloc( nX*nX,sizeof(real_t) );
-	qpData->xzMatTmp.data = (real_t*)calloc( nX*nZ,sizeof(real_t) );
-	qpData->uxMatTmp.data = (real_t*)calloc( nU*nX,sizeof(real_t) );
-	qpData->zxMatTmp.data = (real_t*)calloc( nZ*nX,sizeof(real_t) );
-	qpData->zzMatTmp.data = (real_t*)calloc( nZ*nZ,sizeof(real_t) );
-	qpData->zzMatTmp2.data = (real_t*)calloc( nZ*nZ,sizeof(real_t) );
+	qpData->xVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nX,sizeof(real_t) );
+	qpData->uVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nU,sizeof(real_t) );
+	qpData->zVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nZ,sizeof(real_t) );
+	qpData->xnVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nI,sizeof(real_t) );
+	qpData->xnVecTmp2.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nI,sizeof(real_t) );
+	qpData->xxMatTmp.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nX,sizeof(real_t) );
+	qpData->xxMatTmp2.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nX,sizeof(real_t) );
+	qpData->xzMatTmp.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nZ,sizeof(real_t) );
+	qpData->uxMatTmp.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nU*nX,sizeof(real_t) );
+	qpData->zxMatTmp.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nZ*nX,sizeof(real_t) );
+	qpData->zzMatTmp.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nZ*nZ,sizeof(real_t) );
+	qpData->zzMatTmp2.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nZ*nZ,sizeof(real_t) );
+
+	/* one workspace per thread of the team */
+	qpData->threadWorkspace = (threadWorkspace_t*)qpDUNES_calloc( &(qpData->arena), qpData->nThreads, sizeof(threadWorkspace_t) );
+	for( ii=0; ii<(uint_t)qpData->nThreads; ++ii ) {
+		qpData->threadWorkspace[ii].xVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nX,sizeof(real_t) );
+		qpData->threadWorkspace[ii].uVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nU,sizeof(real_t) );
+		qpData->threadWorkspace[ii].zVecTmp.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nZ,sizeof(real_t) );
+		qpData->threadWorkspace[ii].xxMatTmp.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nX,sizeof(real_t) );
+		qpData->threadWorkspace[ii].xxMatTmp2.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nX,sizeof(real_t) );
+		qpData->threadWorkspace[ii].uxMatTmp.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nU*nX,sizeof(real_t) );
+		qpData->threadWorkspace[ii].xzMatTmp.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nZ,sizeof(real_t) );
+		qpData->threadWorkspace[ii].zxMatTmp.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nZ*nX,sizeof(real_t) );
+	}
 	
 	
 	/* set incumbent objective function value to minus infinity */
@@ -150,50 +387,321 @@ return_t qpDUNES_setup(	qpData_t* const qpData,
 	if ( qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS )
 	{
 		qpDUNES_setupLog( qpData );
-		qpData->log.itLog = (itLog_t*)calloc( qpData->options.maxIter+1, sizeof(itLog_t) );
+		qpData->log.itLog = (itLog_t*)qpDUNES_calloc( &(qpData->arena), qpData->options.maxIter+1, sizeof(itLog_t) );
 
 		for( ii=0; ii<qpData->options.maxIter+1; ++ii ) {
-			qpData->log.itLog[ii].numQpoasesIter = (int_t*)calloc( nI+1,sizeof(int_t) );
+			qpData->log.itLog[ii].numQpoasesIter = (int_t*)qpDUNES_calloc( &(qpData->arena), nI+1,sizeof(int_t) );
 
 			if ( qpData->options.logLevel == QPDUNES_LOG_ALL_DATA )
 			{
-				qpData->log.itLog[ii].regDirections.data = (real_t*)calloc( nX*nI,sizeof(real_t) );
+				qpData->log.itLog[ii].regDirections.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nI,sizeof(real_t) );
 
-				qpData->log.itLog[ii].lambda.data      = (real_t*)calloc( nX*nI,sizeof(real_t) );
-				qpData->log.itLog[ii].deltaLambda.data = (real_t*)calloc( nX*nI,sizeof(real_t) );
+				qpData->log.itLog[ii].lambda.data      = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nI,sizeof(real_t) );
+				qpData->log.itLog[ii].deltaLambda.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nI,sizeof(real_t) );
 
-				qpData->log.itLog[ii].gradient.data = (real_t*)calloc( nX*nI,sizeof(real_t) );
-				qpData->log.itLog[ii].hessian.data  = (real_t*)calloc( (nX*2)*(nX*nI),sizeof(real_t) );
-				qpData->log.itLog[ii].cholHessian.data  = (real_t*)calloc( (nX*2)*(nX*nI),sizeof(real_t) );
+				qpData->log.itLog[ii].gradient.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nI,sizeof(real_t) );
+				qpData->log.itLog[ii].hessian.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nI*qpData->nhLayout.blockRowStride,sizeof(real_t) );
+				qpData->log.itLog[ii].cholHessian.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nI*qpData->nhLayout.blockRowStride,sizeof(real_t) );
 				#if defined(__ANALYZE_FACTORIZATION__)
-				qpData->log.itLog[ii].invHessian.data =  (real_t*)calloc( (nX*nI)*(nX*nI),sizeof(real_t) );
+				qpData->log.itLog[ii].invHessian.data =  (real_t*)qpDUNES_calloc( &(qpData->arena), (nX*nI)*(nX*nI),sizeof(real_t) );
 				#endif
 
-				qpData->log.itLog[ii].dz.data = (real_t*)calloc( nI*nZ+nX,sizeof(real_t) );
-				qpData->log.itLog[ii].zUnconstrained.data = (real_t*)calloc( nI*nZ+nX,sizeof(real_t) );
-				qpData->log.itLog[ii].z.data  = (real_t*)calloc( nI*nZ+nX,sizeof(real_t) );
-				qpData->log.itLog[ii].y.data  = (real_t*)calloc( 2*nZ + 2*nDttl,sizeof(real_t) );
+				qpData->log.itLog[ii].dz.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nI*nZ+nX,sizeof(real_t) );
+				qpData->log.itLog[ii].zUnconstrained.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nI*nZ+nX,sizeof(real_t) );
+				qpData->log.itLog[ii].z.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nI*nZ+nX,sizeof(real_t) );
+				qpData->log.itLog[ii].y.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), 2*nZ + 2*nDttl,sizeof(real_t) );
 				/* TODO: make multiplier definition clean! */
 			}
 		}
 	}
 	else {
-		qpData->log.itLog = (itLog_t*)calloc( 1, sizeof(itLog_t) );
+		qpData->log.itLog = (itLog_t*)qpDUNES_calloc( &(qpData->arena), 1, sizeof(itLog_t) );
 		/* allocate memory to save number of qpoases iterations */
-		qpData->log.itLog[0].numQpoasesIter = (int_t*)calloc( nI+1,sizeof(int_t) );
+		qpData->log.itLog[0].numQpoasesIter = (int_t*)qpDUNES_calloc( &(qpData->arena), nI+1,sizeof(int_t) );
 	}
 
 //	/* reset current active set to force initial Hessian factorization */
 //	qpDUNES_indicateDataChange( qpData );
 	/* this is done when data is passed */
 
+	#if !defined(__STATIC_MEMORY__)
+	if ( ( qpData->arena.isExhausted == QPDUNES_TRUE ) && ( qpData->arena.isOwned == QPDUNES_FALSE ) ) {	/* user-supplied memory block too small */
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Solver data does not fit into the memory block (size %d).", qpData->arena.size );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+	#endif
 
 	qpDUNES_printHeader( qpData );
 
 
 	return QPDUNES_OK;
 }
-/*<<< END OF qpDUNES_allocate */
+/*<<< END OF qpDUNES_setupInMemory */
+
+
+/* ----------------------------------------------
+ * memory allocation for a batch of QPs of equal
+ * dimensions, see qpDUNES_solveBatch
+ *
+#>>>>>>                                           */
+return_t qpDUNES_setupBatch(	qpData_t* const qpDataBatch,
+								int_t nBatch,
+								uint_t nI,
+								uint_t nX,
+								uint_t nU,
+								uint_t* nD,
+								qpOptions_t* options
+								)
+{
+	int_t bb;
+	return_t statusFlag;
+
+	#if defined(__STATIC_MEMORY__)
+	/* all QPs would be placed in the same static memory */
+	if ( nBatch > 1 ) {
+		qpDataBatch[0].options = ( options != 0 ) ? *options : qpDUNES_setupDefaultOptions();
+		qpDUNES_printError( &(qpDataBatch[0]), __FILE__, __LINE__, "Static memory version supports only one QP at a time, batch size is %d.", nBatch );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+	#endif
+
+	for( bb=0; bb<nBatch; ++bb ) {
+		statusFlag = qpDUNES_setup( &(qpDataBatch[bb]), nI, nX, nU, nD, options );
+		if ( statusFlag != QPDUNES_OK ) {
+			for( --bb; bb>=0; --bb ) {
+				qpDUNES_cleanup( &(qpDataBatch[bb]) );
+			}
+			return statusFlag;
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_setupBatch */
+
+
+/* ----------------------------------------------
+ * set up problem dimensions, stage kernels and
+ * thread team size
+ *
+#>>>>>>                                           */
+void qpDUNES_setupDimensions(	qpData_t* const qpData,
+								uint_t nI,
+								uint_t nX,
+								uint_t nU,
+								const uint_t* const nD
+								)
+{
+	uint_t kk;
+
+	qpData->nI = nI;
+	qpData->nX = nX;
+	qpData->nU = nU;
+	qpData->nZ = nX+nU;
+
+	qpData->nDttl = 0;
+	if (nD != 0) {
+		for( kk=0; kk<nI+1; ++kk ) {
+			qpData->nDttl += nD[kk];
+		}
+	}
+
+	/* choose dense stage kernels for problem dimensions */
+	qpDUNES_setupSmallKernels( qpData );
+	qpDUNES_setupNewtonKernels( qpData );
+	qpDUNES_setupClippingKernels( qpData );
+
+	/* size of thread team */
+	qpData->nThreads = ( qpData->options.nThreads > 0 ) ? qpDUNES_min( qpData->options.nThreads, qpDUNES_getMaxThreads() ) : qpDUNES_getMaxThreads();
+	#if defined(__STATIC_MEMORY__)
+	qpData->nThreads = qpDUNES_min( qpData->nThreads, _NTHREADSMAX_ );
+	#endif
+}
+/*<<< END OF qpDUNES_setupDimensions */
+
+
+#if !defined(__STATIC_MEMORY__)
+/* ----------------------------------------------
+ * size in bytes of the memory block holding all
+ * solver data, see qpDUNES_setupInMemory
+ *
+#>>>>>>                                           */
+uint_t qpDUNES_memoryRequirement(	uint_t nI,
+									uint_t nX,
+									uint_t nU,
+									const uint_t* const nD,
+									const qpOptions_t* const options
+									)
+{
+	qpData_t qpData;
+
+	qpData.options = ( options != 0 ) ? *options : qpDUNES_setupDefaultOptions();
+	qpDUNES_setupDimensions( &qpData, nI, nX, nU, nD );
+
+	return qpDUNES_getMemorySize( &qpData, nD );
+}
+/*<<< END OF qpDUNES_memoryRequirement */
+
+
+/* ----------------------------------------------
+ * size in bytes of the memory block holding all
+ * solver data of a qpData with dimensions and
+ * options set up; mirrors qpDUNES_setupInMemory
+ *
+#>>>>>>                                           */
+uint_t qpDUNES_getMemorySize(	const qpData_t* const qpData,
+								const uint_t* const nD
+								)
+{
+	uint_t ii, kk;
+
+	uint_t nI = qpData->nI;
+	uint_t nX = qpData->nX;
+	uint_t nU = qpData->nU;
+	uint_t nZ = qpData->nZ;
+	uint_t nDttl = qpData->nDttl;
+
+	uint_t nFacBlocks = ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_CYCLIC_REDUCTION ) ? qpDUNES_getCyclicReductionNumBlocks( nI ) : nI;
+	uint_t nGridPoints = qpData->options.lineSearchNbrGridPoints;
+	uint_t nHomotopyBreakpoints = 2*(nI+1)*qpData->options.maxNumQpoasesIterations;
+	nhLayout_t layout;
+
+	uint_t memorySize = 0;
+
+	qpDUNES_setupNewtonHessianLayout( &layout, nX, qpData->options.nwtnHssnLayout );
+
+	/* intervals */
+	qpDUNES_reserveMemory( &memorySize, nI+1, sizeof(interval_t*) );
+	if ( qpData->options.stageDataLayout == QPDUNES_STAGE_LAYOUT_BY_FIELD ) {
+		qpDUNES_getIntervalsByFieldMemorySize( qpData, &memorySize );
+	}
+	else {
+		for( kk=0; kk<nI+1; ++kk ) {
+			qpDUNES_getIntervalMemorySize( &memorySize, nX, ( kk < nI ) ? nZ : nX, ( nD != 0 ) ? nD[kk] : 0 );
+			qpDUNES_reserveMemory( &memorySize, nX, sizeof(real_t) );
+			qpDUNES_reserveMemory( &memorySize, nU, sizeof(real_t) );
+			qpDUNES_reserveMemory( &memorySize, nZ, sizeof(real_t) );
+		}
+	}
+
+	/* Newton system */
+	qpDUNES_reserveMemory( &memorySize, 2*nX*nI, sizeof(real_t) );	/* lambda, deltaLambda */
+	qpDUNES_reserveMemoryAligned( &memorySize, nI*layout.blockRowStride, sizeof(real_t) );
+	qpDUNES_reserveMemoryAligned( &memorySize, nFacBlocks*layout.blockRowStride, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nX*nI, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nX*nI, sizeof(real_t) );
+	if( qpData->options.regType == QPDUNES_REG_UNCONSTRAINED_HESSIAN ||
+				qpData->options.regType == QPDUNES_REG_ADD_UNCONSTRAINED_HESSIAN ||
+				qpData->options.regType == QPDUNES_REG_ADD_UNCONSTRAINED_HESSIAN_DIAG ||
+				(qpData->options.nbrInitialGradientSteps > 0))
+	{
+		qpDUNES_reserveMemoryAligned( &memorySize, nI*layout.blockRowStride, sizeof(real_t) );
+		qpDUNES_reserveMemoryAligned( &memorySize, nFacBlocks*layout.blockRowStride, sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, nI, sizeof(sparsityType_t) );
+	}
+	qpDUNES_reserveMemory( &memorySize, nI, sizeof(sparsityType_t) );
+	if ( qpData->options.shareStageFactors == QPDUNES_TRUE ) {
+		qpDUNES_reserveMemory( &memorySize, nI+1, sizeof(factorCacheEntry_t) );
+		qpDUNES_reserveMemory( &memorySize, (nI+1)*nZ*nZ, sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, 2*nI, sizeof(int_t) );
+	}
+	if ( ( qpData->options.shareStageFactors == QPDUNES_TRUE ) && ( qpData->options.nwtnHssnMemoSize > 0 ) ) {
+		qpDUNES_reserveMemory( &memorySize, qpData->options.nwtnHssnMemoSize, sizeof(newtonMemoSlot_t) );
+		qpDUNES_reserveMemory( &memorySize, qpData->options.nwtnHssnMemoSize*(2*nX*nX+2*nX*nZ), sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, (qpData->options.nwtnHssnMemoSize+1)*((nZ+31)/32), sizeof(uint_t) );
+		qpDUNES_reserveMemory( &memorySize, nI+1, sizeof(int_t) );
+	}
+	if ( qpData->options.nwtnHssnFacAlg == QPDUNES_NH_FAC_CYCLIC_REDUCTION ) {
+		qpDUNES_reserveMemoryAligned( &memorySize, nI*layout.blockRowStride, sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, nX*nFacBlocks, sizeof(real_t) );
+	}
+	if ( qpData->newtonKernels.factorizeForward != 0 ) {
+		qpDUNES_reserveMemory( &memorySize, 2*nX*nX+nX, sizeof(real_t) );
+	}
+
+	/* line search */
+	if ( qpData->options.lsType == QPDUNES_LS_PIECEWISE_QUADRATIC_LS ) {
+		qpDUNES_reserveMemory( &memorySize, 4*(nI*nZ+nX), sizeof(real_t) );
+	}
+	if ( ( qpData->options.lsType == QPDUNES_LS_GRID_LS ) ||
+		 ( qpData->options.lsType == QPDUNES_LS_ACCELERATED_GRID_LS ) )
+	{
+		qpDUNES_reserveMemory( &memorySize, 2*nGridPoints, sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, (nI+1)*nGridPoints, sizeof(real_t) );
+	}
+	if ( qpData->options.lsType == QPDUNES_LS_HOMOTOPY_GRID_SEARCH ) {
+		qpDUNES_reserveMemory( &memorySize, nHomotopyBreakpoints, sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, nHomotopyBreakpoints, sizeof(int_t) );
+		qpDUNES_reserveMemory( &memorySize, nI+2, sizeof(int_t) );
+	}
+
+	/* workspace */
+	qpDUNES_reserveMemory( &memorySize, nX, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nU, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nZ, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nX*nI, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nX*nI, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nX*nX, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nX*nX, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nX*nZ, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nU*nX, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nZ*nX, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nZ*nZ, sizeof(real_t) );
+	qpDUNES_reserveMemory( &memorySize, nZ*nZ, sizeof(real_t) );
+
+	qpDUNES_reserveMemory( &memorySize, qpData->nThreads, sizeof(threadWorkspace_t) );
+	for( ii=0; ii<(uint_t)qpData->nThreads; ++ii ) {
+		qpDUNES_reserveMemory( &memorySize, nX, sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, nU, sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, nZ, sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, nX*nX, sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, nX*nX, sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, nU*nX, sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, nX*nZ, sizeof(real_t) );
+		qpDUNES_reserveMemory( &memorySize, nZ*nX, sizeof(real_t) );
+	}
+
+	/* log */
+	if ( qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS )
+	{
+		qpDUNES_reserveMemory( &memorySize, qpData->options.maxIter+1, sizeof(itLog_t) );
+		for( ii=0; ii<qpData->options.maxIter+1; ++ii ) {
+			qpDUNES_reserveMemory( &memorySize, nI+1, sizeof(int_t) );
+
+			if ( qpData->options.logLevel == QPDUNES_LOG_ALL_DATA )
+			{
+				qpDUNES_reserveMemory( &memorySize, nX*nI, sizeof(real_t) );
+				qpDUNES_reserveMemory( &memorySize, nX*nI, sizeof(real_t) );
+				qpDUNES_reserveMemory( &memorySize, nX*nI, sizeof(real_t) );
+				qpDUNES_reserveMemory( &memorySize, nX*nI, sizeof(real_t) );
+				qpDUNES_reserveMemory( &memorySize, nI*layout.blockRowStride, sizeof(real_t) );
+				qpDUNES_reserveMemory( &memorySize, nI*layout.blockRowStride, sizeof(real_t) );
+				#if defined(__ANALYZE_FACTORIZATION__)
+				qpDUNES_reserveMemory( &memorySize, (nX*nI)*(nX*nI), sizeof(real_t) );
+				#endif
+				qpDUNES_reserveMemory( &memorySize, nI*nZ+nX, sizeof(real_t) );
+				qpDUNES_reserveMemory( &memorySize, nI*nZ+nX, sizeof(real_t) );
+				qpDUNES_reserveMemory( &memorySize, nI*nZ+nX, sizeof(real_t) );
+				qpDUNES_reserveMemory( &memorySize, 2*nZ + 2*nDttl, sizeof(real_t) );
+			}
+		}
+	}
+	else {
+		qpDUNES_reserveMemory( &memorySize, 1, sizeof(itLog_t) );
+		qpDUNES_reserveMemory( &memorySize, nI+1, sizeof(int_t) );
+	}
+
+	/* stage QP solvers, allocated in qpDUNES_setupAllLocalQPs in an order that
+	 * depends on the data; the end is padded such that any order fits */
+	for( kk=0; kk<nI+1; ++kk ) {
+		qpDUNES_getStageQpSolverMaxMemorySize( qpData, &memorySize, ( kk < nI ) ? nZ : nX, ( nD != 0 ) ? nD[kk] : 0 );
+	}
+	memorySize = QPDUNES_ALIGN_UP( memorySize, QPDUNES_MEMORY_BLOCK_ALIGNMENT );
+
+	return memorySize;
+}
+/*<<< END OF qpDUNES_getMemorySize */
+#endif
 
 
 /* ----------------------------------------------
@@ -206,66 +714,571 @@ interval_t* qpDUNES_allocInterval(	qpData_t* const qpData,
 									uint_t nD
 									)
 {
-	interval_t* interval = (interval_t*)calloc( 1,sizeof(interval_t) );
+	interval_t* interval = (interval_t*)qpDUNES_callocAligned( &(qpData->arena), 1,sizeof(interval_t) );	/* each stage's data starts on a new cache line */
 
 	interval->nD = nD;
 	interval->nV = nV;
 
-	interval->H.data = (real_t*)calloc( nV*nV,sizeof(real_t) );
+	interval->H.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV*nV,sizeof(real_t) );
 	interval->H.sparsityType = QPDUNES_MATRIX_UNDEFINED;
-	interval->cholH.data = (real_t*)calloc( nV*nV,sizeof(real_t) );
+	interval->cholH.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV*nV,sizeof(real_t) );
 	interval->cholH.sparsityType = QPDUNES_MATRIX_UNDEFINED;
+	interval->cholHStorage = interval->cholH.data;
 
-	interval->g.data  = (real_t*)calloc( nV,sizeof(real_t) );
+	interval->g.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
 
-	interval->q.data  = (real_t*)calloc( nV,sizeof(real_t) );
+	interval->q.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
 
-	interval->C.data = (real_t*)calloc( nX*nV,sizeof(real_t) );
+	interval->C.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX*nV,sizeof(real_t) );
 	interval->C.sparsityType = QPDUNES_MATRIX_UNDEFINED;
-	interval->c.data = (real_t*)calloc( nX,sizeof(real_t) );
+	interval->c.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX,sizeof(real_t) );
 
-	interval->zLow.data = (real_t*)calloc( nV,sizeof(real_t) );
-	interval->zUpp.data = (real_t*)calloc( nV,sizeof(real_t) );
+	interval->zLow.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+	interval->zUpp.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
 //	qpDUNES_printf("zUpp pointer = %d", (int)(interval->zUpp.data));
 
-	interval->D.data = (real_t*)calloc(  nD*nV,sizeof(real_t) );
+	interval->D.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nD*nV,sizeof(real_t) );
 	interval->D.sparsityType = QPDUNES_MATRIX_UNDEFINED;
-	interval->dLow.data = (real_t*)calloc( nD,sizeof(real_t) );
-	interval->dUpp.data = (real_t*)calloc( nD,sizeof(real_t) );
+	interval->dLow.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nD,sizeof(real_t) );
+	interval->dUpp.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nD,sizeof(real_t) );
+
+	interval->z.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+
+	interval->y.data = (real_t*)qpDUNES_calloc( &(qpData->arena), 2*nV + 2*nD,sizeof(real_t) );	/* TODO: clean multiplier definition */
+	interval->yPrev.data = (real_t*)qpDUNES_calloc( &(qpData->arena), 2*nV + 2*nD,sizeof(real_t) );
+	interval->hessianActSet.data = (int_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(int_t) );
+
+	interval->lambdaK.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX,sizeof(real_t) );
+	interval->lambdaK.isDefined = QPDUNES_TRUE;							/* define both lambda parts by default */
+	interval->lambdaK1.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nX,sizeof(real_t) );
+	interval->lambdaK1.isDefined = QPDUNES_TRUE;
+
+	/* get memory for clipping QP solver */
+	interval->qpSolverClipping.qStep.data  = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+	interval->qpSolverClipping.zUnconstrained.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+	interval->qpSolverClipping.dz.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+
+	/* memory of qpOASES and box QP solver and of the objective function parameterization
+	 * is only allocated once a stage selects one of them, see qpDUNES_allocStageQpSolver */
+
+
+	interval->qpSolverSpecification = QPDUNES_STAGE_QP_SOLVER_UNDEFINED;
+
+	return interval;
+}
+/*<<< END OF qpDUNES_allocInterval */
+
+
+/* ----------------------------------------------
+ * add memory of one interval to memorySize;
+ * mirrors qpDUNES_allocInterval
+ *
+#>>>>>>                                           */
+void qpDUNES_getIntervalMemorySize(	uint_t* const memorySize,
+									uint_t nX,
+									uint_t nV,
+									uint_t nD
+									)
+{
+	qpDUNES_reserveMemoryAligned( memorySize, 1, sizeof(interval_t) );
+
+	qpDUNES_reserveMemory( memorySize, nV*nV, sizeof(real_t) );		/* H */
+	qpDUNES_reserveMemory( memorySize, nV*nV, sizeof(real_t) );		/* cholH */
+	qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );		/* g */
+	qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );		/* q */
+	qpDUNES_reserveMemory( memorySize, nX*nV, sizeof(real_t) );		/* C */
+	qpDUNES_reserveMemory( memorySize, nX, sizeof(real_t) );		/* c */
+	qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );		/* zLow */
+	qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );		/* zUpp */
+	qpDUNES_reserveMemory( memorySize, nD*nV, sizeof(real_t) );		/* D */
+	qpDUNES_reserveMemory( memorySize, nD, sizeof(real_t) );		/* dLow */
+	qpDUNES_reserveMemory( memorySize, nD, sizeof(real_t) );		/* dUpp */
+	qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );		/* z */
+	qpDUNES_reserveMemory( memorySize, 2*nV + 2*nD, sizeof(real_t) );	/* y */
+	qpDUNES_reserveMemory( memorySize, 2*nV + 2*nD, sizeof(real_t) );	/* yPrev */
+	qpDUNES_reserveMemory( memorySize, nV, sizeof(int_t) );			/* hessianActSet */
+	qpDUNES_reserveMemory( memorySize, nX, sizeof(real_t) );		/* lambdaK */
+	qpDUNES_reserveMemory( memorySize, nX, sizeof(real_t) );		/* lambdaK1 */
+
+	qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );		/* clipping qStep */
+	qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );		/* clipping zUnconstrained */
+	qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );		/* clipping dz */
+}
+/*<<< END OF qpDUNES_getIntervalMemorySize */
+
+
+/* ----------------------------------------------
+ * memory allocation of all intervals as structure
+ * of arrays: each array of all intervals is one
+ * block with one slot per interval, such that
+ * stage loops stream through memory; with the
+ * interval pointers rotated by
+ * qpDUNES_shiftIntervals, the slots of intervals
+ * 0..nI-1 form a ring buffer
+ *
+#>>>>>>                                           */
+void qpDUNES_allocIntervalsByField(	qpData_t* const qpData,
+									const uint_t* const nD
+									)
+{
+	uint_t kk;
+
+	uint_t nI = qpData->nI;
+	uint_t nX = qpData->nX;
+	uint_t nU = qpData->nU;
+	uint_t nZ = qpData->nZ;
+	uint_t nDttl = qpData->nDttl;
+
+	uint_t nV;
+	uint_t nDk;
+	uint_t offsetD = 0;		/* number of constraints of all previous intervals */
+	interval_t* interval;
+
+	/* slots of nZ variables for all intervals, the last one uses only nX of them */
+	interval_t* intervals = (interval_t*)qpDUNES_callocAligned( &(qpData->arena), nI+1, sizeof(interval_t) );
+	real_t* H = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ*nZ, sizeof(real_t) );
+	real_t* cholH = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ*nZ, sizeof(real_t) );
+	real_t* g = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ, sizeof(real_t) );
+	real_t* q = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ, sizeof(real_t) );
+	real_t* C = (real_t*)qpDUNES_calloc( &(qpData->arena), nI*nX*nZ, sizeof(real_t) );			/* no coupling of last interval */
+	real_t* c = (real_t*)qpDUNES_calloc( &(qpData->arena), nI*nX, sizeof(real_t) );
+	real_t* zLow = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ, sizeof(real_t) );
+	real_t* zUpp = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ, sizeof(real_t) );
+	real_t* D = (real_t*)qpDUNES_calloc( &(qpData->arena), nDttl*nZ, sizeof(real_t) );
+	real_t* dLow = (real_t*)qpDUNES_calloc( &(qpData->arena), nDttl, sizeof(real_t) );
+	real_t* dUpp = (real_t*)qpDUNES_calloc( &(qpData->arena), nDttl, sizeof(real_t) );
+	real_t* z = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ, sizeof(real_t) );
+	real_t* y = (real_t*)qpDUNES_calloc( &(qpData->arena), 2*(nI+1)*nZ + 2*nDttl, sizeof(real_t) );
+	real_t* yPrev = (real_t*)qpDUNES_calloc( &(qpData->arena), 2*(nI+1)*nZ + 2*nDttl, sizeof(real_t) );
+	int_t* hessianActSet = (int_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ, sizeof(int_t) );
+	real_t* lambdaK = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nX, sizeof(real_t) );
+	real_t* lambdaK1 = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nX, sizeof(real_t) );
+	real_t* qStep = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ, sizeof(real_t) );
+	real_t* zUnconstrained = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ, sizeof(real_t) );
+	real_t* dz = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ, sizeof(real_t) );
+	real_t* xVecTmp = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nX, sizeof(real_t) );
+	real_t* uVecTmp = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nU, sizeof(real_t) );
+	real_t* zVecTmp = (real_t*)qpDUNES_calloc( &(qpData->arena), (nI+1)*nZ, sizeof(real_t) );
+
+	for( kk=0; kk<nI+1; ++kk )
+	{
+		interval = &( intervals[kk] );
+		qpData->intervals[kk] = interval;
+
+		nV = ( kk < nI ) ? nZ : nX;
+		nDk = ( nD != 0 ) ? nD[kk] : 0;
+
+		interval->id = kk;		/* give interval its initial stage index */
+		interval->nD = nDk;
+		interval->nV = nV;
+
+		interval->H.data = &( H[kk*nZ*nZ] );
+		interval->H.sparsityType = QPDUNES_MATRIX_UNDEFINED;
+		interval->cholH.data = &( cholH[kk*nZ*nZ] );
+		interval->cholH.sparsityType = QPDUNES_MATRIX_UNDEFINED;
+		interval->cholHStorage = interval->cholH.data;
+
+		interval->g.data = &( g[kk*nZ] );
+		interval->q.data = &( q[kk*nZ] );
+
+		if ( kk < nI ) {
+			interval->C.data = &( C[kk*nX*nZ] );
+			interval->c.data = &( c[kk*nX] );
+		}
+		else {
+			interval->C.data = 0;
+			interval->c.data = 0;
+		}
+		interval->C.sparsityType = QPDUNES_MATRIX_UNDEFINED;
+
+		interval->zLow.data = &( zLow[kk*nZ] );
+		interval->zUpp.data = &( zUpp[kk*nZ] );
+
+		interval->D.data = &( D[offsetD*nZ] );
+		interval->D.sparsityType = QPDUNES_MATRIX_UNDEFINED;
+		interval->dLow.data = &( dLow[offsetD] );
+		interval->dUpp.data = &( dUpp[offsetD] );
+
+		interval->z.data = &( z[kk*nZ] );
+
+		interval->y.data = &( y[2*(kk*nZ + offsetD)] );
+		interval->yPrev.data = &( yPrev[2*(kk*nZ + offsetD)] );
+		interval->hessianActSet.data = &( hessianActSet[kk*nZ] );
+
+		interval->lambdaK.data = &( lambdaK[kk*nX] );
+		interval->lambdaK.isDefined = QPDUNES_TRUE;
+		interval->lambdaK1.data = &( lambdaK1[kk*nX] );
+		interval->lambdaK1.isDefined = QPDUNES_TRUE;
+
+		interval->qpSolverClipping.qStep.data = &( qStep[kk*nZ] );
+		interval->qpSolverClipping.zUnconstrained.data = &( zUnconstrained[kk*nZ] );
+		interval->qpSolverClipping.dz.data = &( dz[kk*nZ] );
+
+		/* stage QP solver memory of qpOASES and box QP stages: see qpDUNES_allocStageQpSolver */
+
+		interval->qpSolverSpecification = QPDUNES_STAGE_QP_SOLVER_UNDEFINED;
+
+		interval->xVecTmp.data = &( xVecTmp[kk*nX] );
+		interval->uVecTmp.data = &( uVecTmp[kk*nU] );
+		interval->zVecTmp.data = &( zVecTmp[kk*nZ] );
+
+		offsetD += nDk;
+	}
+}
+/*<<< END OF qpDUNES_allocIntervalsByField */
+
+
+/* ----------------------------------------------
+ * add memory of all intervals to memorySize;
+ * mirrors qpDUNES_allocIntervalsByField
+ *
+#>>>>>>                                           */
+void qpDUNES_getIntervalsByFieldMemorySize(	const qpData_t* const qpData,
+											uint_t* const memorySize
+											)
+{
+	uint_t nI = qpData->nI;
+	uint_t nX = qpData->nX;
+	uint_t nU = qpData->nU;
+	uint_t nZ = qpData->nZ;
+	uint_t nDttl = qpData->nDttl;
+
+	qpDUNES_reserveMemoryAligned( memorySize, nI+1, sizeof(interval_t) );
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nZ*nZ, sizeof(real_t) );		/* H */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nZ*nZ, sizeof(real_t) );		/* cholH */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nZ, sizeof(real_t) );			/* g */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nZ, sizeof(real_t) );			/* q */
+	qpDUNES_reserveMemory( memorySize, nI*nX*nZ, sizeof(real_t) );			/* C */
+	qpDUNES_reserveMemory( memorySize, nI*nX, sizeof(real_t) );				/* c */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nZ, sizeof(real_t) );			/* zLow */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nZ, sizeof(real_t) );			/* zUpp */
+	qpDUNES_reserveMemory( memorySize, nDttl*nZ, sizeof(real_t) );			/* D */
+	qpDUNES_reserveMemory( memorySize, nDttl, sizeof(real_t) );				/* dLow */
+	qpDUNES_reserveMemory( memorySize, nDttl, sizeof(real_t) );				/* dUpp */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nZ, sizeof(real_t) );			/* z */
+	qpDUNES_reserveMemory( memorySize, 2*(nI+1)*nZ + 2*nDttl, sizeof(real_t) );	/* y */
+	qpDUNES_reserveMemory( memorySize, 2*(nI+1)*nZ + 2*nDttl, sizeof(real_t) );	/* yPrev */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nZ, sizeof(int_t) );			/* hessianActSet */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nX, sizeof(real_t) );			/* lambdaK */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nX, sizeof(real_t) );			/* lambdaK1 */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nZ, sizeof(real_t) );			/* clipping qStep */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nZ, sizeof(real_t) );			/* clipping zUnconstrained */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nZ, sizeof(real_t) );			/* clipping dz */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nX, sizeof(real_t) );			/* xVecTmp */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nU, sizeof(real_t) );			/* uVecTmp */
+	qpDUNES_reserveMemory( memorySize, (nI+1)*nZ, sizeof(real_t) );			/* zVecTmp */
+}
+/*<<< END OF qpDUNES_getIntervalsByFieldMemorySize */
+
+
+
+/* ----------------------------------------------
+ * memory allocation of the stage QP solver an
+ * interval has selected; the clipping solver
+ * workspace is part of every interval, qpOASES
+ * and box QP solver memory is only allocated for
+ * the stages that use them, from the part of the
+ * memory block reserved by
+ * qpDUNES_getStageQpSolverMaxMemorySize. The
+ * qpOASES objects themselves are created by
+ * qpOASES and always live on the heap
+ *
+#>>>>>>                                           */
+return_t qpDUNES_allocStageQpSolver(	qpData_t* const qpData,
+										interval_t* const interval
+										)
+{
+	uint_t nV = interval->nV;
+	uint_t nParametricObjFctn = qpData->options.maxNumQpoasesIterations + 2;
+
+	switch ( interval->qpSolverSpecification ) {
+		case QPDUNES_STAGE_QP_SOLVER_QPOASES:
+			if ( interval->qpSolverQpoases.qpoasesObject == 0 ) {
+				interval->qpSolverQpoases.qpoasesObject = qpOASES_constructor( qpData, nV, interval->nD );
+				interval->qpSolverQpoases.qFullStep.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+			}
+			break;
+
+		case QPDUNES_STAGE_QP_SOLVER_BOXQP:
+			if ( interval->qpSolverBoxQp.cholHFree.data == 0 ) {
+				interval->qpSolverBoxQp.cholHFree.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV*nV,sizeof(real_t) );
+				interval->qpSolverBoxQp.cholHFree.sparsityType = QPDUNES_DENSE;
+				interval->qpSolverBoxQp.ZT.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV*nV,sizeof(real_t) );
+				interval->qpSolverBoxQp.ZT.sparsityType = QPDUNES_DENSE;
+				interval->qpSolverBoxQp.freeIdx.data = (int_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(int_t) );
+				interval->qpSolverBoxQp.actSet.data = (int_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(int_t) );
+				interval->qpSolverBoxQp.zCur.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+				interval->qpSolverBoxQp.qCur.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+				interval->qpSolverBoxQp.qFullStep.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+				interval->qpSolverBoxQp.qTarget.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+				interval->qpSolverBoxQp.dq.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+				interval->qpSolverBoxQp.dz.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+				interval->qpSolverBoxQp.wFree.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nV,sizeof(real_t) );
+			}
+			break;
+
+		default:
+			return QPDUNES_OK;
+	}
+
+	/* objective function parameterization, logged along the homotopies of both solvers */
+	if ( interval->parametricObjFctn_alpha.data == 0 ) {
+		interval->parametricObjFctn_alpha.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nParametricObjFctn, sizeof(real_t) );
+		interval->parametricObjFctn_f.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nParametricObjFctn, sizeof(real_t) );
+		interval->parametricObjFctn_fPrime.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nParametricObjFctn, sizeof(real_t) );
+		interval->parametricObjFctn_fPrimePrime.data = (real_t*)qpDUNES_calloc( &(qpData->arena), nParametricObjFctn, sizeof(real_t) );
+	}
 
-	interval->z.data = (real_t*)calloc( nV,sizeof(real_t) );
+	if ( ( qpData->arena.isExhausted == QPDUNES_TRUE ) && ( qpData->arena.isOwned == QPDUNES_FALSE ) ) {	/* user-supplied memory block too small */
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Stage QP solver data does not fit into the memory block (size %d).", qpData->arena.size );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_allocStageQpSolver */
+
+
+/* ----------------------------------------------
+ * add the largest memory qpDUNES_allocStageQpSolver
+ * may take for an interval to memorySize: the
+ * stage QP solver is only known after the stage
+ * data is set up, so both qpOASES and, if enabled
+ * and possible, box QP solver memory is reserved
+ *
+#>>>>>>                                           */
+void qpDUNES_getStageQpSolverMaxMemorySize(	const qpData_t* const qpData,
+											uint_t* const memorySize,
+											uint_t nV,
+											uint_t nD
+											)
+{
+	uint_t nParametricObjFctn = qpData->options.maxNumQpoasesIterations + 2;
+
+	qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );		/* qpOASES qFullStep */
+
+	if ( ( qpData->options.useBoxQpSolver == QPDUNES_TRUE ) && ( nD == 0 ) ) {
+		qpDUNES_reserveMemory( memorySize, nV*nV, sizeof(real_t) );	/* cholHFree */
+		qpDUNES_reserveMemory( memorySize, nV*nV, sizeof(real_t) );	/* ZT */
+		qpDUNES_reserveMemory( memorySize, nV, sizeof(int_t) );		/* freeIdx */
+		qpDUNES_reserveMemory( memorySize, nV, sizeof(int_t) );		/* actSet */
+		qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );	/* zCur */
+		qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );	/* qCur */
+		qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );	/* qFullStep */
+		qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );	/* qTarget */
+		qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );	/* dq */
+		qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );	/* dz */
+		qpDUNES_reserveMemory( memorySize, nV, sizeof(real_t) );	/* wFree */
+	}
+
+	qpDUNES_reserveMemory( memorySize, nParametricObjFctn, sizeof(real_t) );	/* parametricObjFctn_alpha */
+	qpDUNES_reserveMemory( memorySize, nParametricObjFctn, sizeof(real_t) );	/* parametricObjFctn_f */
+	qpDUNES_reserveMemory( memorySize, nParametricObjFctn, sizeof(real_t) );	/* parametricObjFctn_fPrime */
+	qpDUNES_reserveMemory( memorySize, nParametricObjFctn, sizeof(real_t) );	/* parametricObjFctn_fPrimePrime */
+}
+/*<<< END OF qpDUNES_getStageQpSolverMaxMemorySize */
+
+
+/* ----------------------------------------------
+ * bytes of interval data every stage holds,
+ * independent of its stage QP solver
+ *
+#>>>>>>                                           */
+uint_t qpDUNES_getStageDataMemorySize(	const qpData_t* const qpData,
+										const interval_t* const interval
+										)
+{
+	uint_t nX = qpData->nX;
+	uint_t nV = interval->nV;
+	uint_t nD = interval->nD;
+	uint_t nXC = ( interval->C.data != 0 ) ? nX : 0;	/* no coupling of last interval */
+
+	uint_t memorySize = sizeof(interval_t);
+
+	memorySize += 2*nV*nV * sizeof(real_t);								/* H, cholH */
+	memorySize += ( nXC*nV + nXC ) * sizeof(real_t);					/* C, c */
+	memorySize += ( nD*nV + 2*nD ) * sizeof(real_t);					/* D, dLow, dUpp */
+	memorySize += 2*( 2*nV + 2*nD ) * sizeof(real_t);					/* y, yPrev */
+	memorySize += 5*nV * sizeof(real_t);								/* g, q, zLow, zUpp, z */
+	memorySize += nV * sizeof(int_t);									/* hessianActSet */
+	memorySize += 3*nV * sizeof(real_t);								/* clipping qStep, zUnconstrained, dz */
+	memorySize += ( 3*nX + qpData->nU + qpData->nZ ) * sizeof(real_t);	/* lambdaK, lambdaK1, workspace */
+
+	return memorySize;
+}
+/*<<< END OF qpDUNES_getStageDataMemorySize */
+
+
+/* ----------------------------------------------
+ * bytes allocated for the stage QP solver of an
+ * interval by qpDUNES_allocStageQpSolver
+ *
+#>>>>>>                                           */
+uint_t qpDUNES_getStageQpSolverMemorySize(	const qpData_t* const qpData,
+											const interval_t* const interval
+											)
+{
+	uint_t nV = interval->nV;
+	uint_t memorySize = 0;
+
+	if ( interval->qpSolverQpoases.qpoasesObject != 0 ) {
+		memorySize += qpOASES_getMemorySize( nV, interval->nD );
+		memorySize += nV * sizeof(real_t);								/* qFullStep */
+	}
+	if ( interval->qpSolverBoxQp.cholHFree.data != 0 ) {
+		memorySize += 2*nV*nV * sizeof(real_t);							/* cholHFree, ZT */
+		memorySize += 2*nV * sizeof(int_t);								/* freeIdx, actSet */
+		memorySize += 7*nV * sizeof(real_t);							/* vectors */
+	}
+	if ( interval->parametricObjFctn_alpha.data != 0 ) {
+		memorySize += 4*( qpData->options.maxNumQpoasesIterations + 2 ) * sizeof(real_t);
+	}
+
+	return memorySize;
+}
+/*<<< END OF qpDUNES_getStageQpSolverMemorySize */
+
+
+/* ----------------------------------------------
+ * memory per stage and stage QP solver after
+ * qpDUNES_setupAllLocalQPs; stageReports has to
+ * hold nI+1 entries
+ *
+#>>>>>>                                           */
+return_t qpDUNES_getMemoryReport(	const qpData_t* const qpData,
+									stageMemoryReport_t* const stageReports
+									)
+{
+	int_t kk;
+	interval_t* interval;
+
+	if ( stageReports == 0 ) {
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	for( kk=0; kk<_NI_+1; ++kk ) {
+		interval = qpData->intervals[kk];
+		stageReports[kk].qpSolverSpecification = interval->qpSolverSpecification;
+		stageReports[kk].dataBytes = qpDUNES_getStageDataMemorySize( qpData, interval );
+		stageReports[kk].solverBytes = qpDUNES_getStageQpSolverMemorySize( qpData, interval );
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_getMemoryReport */
+
+
+/* ----------------------------------------------
+ * print memory per stage and totals per stage
+ * QP solver
+ *
+#>>>>>>                                           */
+void qpDUNES_printMemoryReport(	const qpData_t* const qpData
+								)
+{
+	int_t kk;
+	int_t ss;
+	interval_t* interval;
+	uint_t dataBytes;
+	uint_t solverBytes;
+
+	const char* solverNames[4] = { "undefined", "clipping", "qpOASES", "box QP" };
+	int_t nStages[4] = { 0, 0, 0, 0 };
+	uint_t solverBytesTotal[4] = { 0, 0, 0, 0 };
+	uint_t dataBytesTotal = 0;
+	int_t nFactors = 0;
+	int_t nSharingStages = 0;
+
+	qpDUNES_printf( "[qpDUNES] Memory per stage:" );
+	for( kk=0; kk<_NI_+1; ++kk ) {
+		interval = qpData->intervals[kk];
+		ss = (int_t)interval->qpSolverSpecification;
+		dataBytes = qpDUNES_getStageDataMemorySize( qpData, interval );
+		solverBytes = qpDUNES_getStageQpSolverMemorySize( qpData, interval );
+
+		qpDUNES_printf( "          stage %3d: %-9s  data %9d bytes, stage QP solver %9d bytes", kk, solverNames[ss], (int)dataBytes, (int)solverBytes );
+
+		nStages[ss] += 1;
+		solverBytesTotal[ss] += solverBytes;
+		dataBytesTotal += dataBytes;
+	}
+
+	qpDUNES_printf( "[qpDUNES] Memory per stage QP solver:" );
+	for( ss=0; ss<4; ++ss ) {
+		if ( nStages[ss] > 0 ) {
+			qpDUNES_printf( "          %-9s  %4d stages, %9d bytes", solverNames[ss], (int)nStages[ss], (int)solverBytesTotal[ss] );
+		}
+	}
+	qpDUNES_printf( "          stage data %4d stages, %9d bytes", (int)(_NI_+1), (int)dataBytesTotal );
+
+	if ( qpData->factorCache.entries != 0 ) {
+		for( kk=0; kk<_NI_+1; ++kk ) {
+			if ( qpData->factorCache.entries[kk].data != 0 ) {
+				nFactors += 1;
+				nSharingStages += qpData->factorCache.entries[kk].nRefs;
+			}
+		}
+	}
+	if ( nFactors > 0 ) {
+		qpDUNES_printf( "[qpDUNES] Stage Hessian factors: %d distinct for %d stages", (int)nFactors, (int)nSharingStages );
+	}
+	if ( qpData->newtonMemo.nSlots > 0 ) {
+		qpDUNES_printf( "[qpDUNES] Newton Hessian memo: %d stage contributions, %d hits, %d misses", (int)qpData->newtonMemo.nSlots, (int)qpData->newtonMemo.nHits, (int)qpData->newtonMemo.nMisses );
+	}
+}
+/*<<< END OF qpDUNES_printMemoryReport */
 
-	interval->y.data = (real_t*)calloc( 2*nV + 2*nD,sizeof(real_t) );	/* TODO: clean multiplier definition */
-	interval->yPrev.data = (real_t*)calloc( 2*nV + 2*nD,sizeof(real_t) );
 
-	interval->lambdaK.data = (real_t*)calloc( nX,sizeof(real_t) );
-	interval->lambdaK.isDefined = QPDUNES_TRUE;							/* define both lambda parts by default */
-	interval->lambdaK1.data = (real_t*)calloc( nX,sizeof(real_t) );
-	interval->lambdaK1.isDefined = QPDUNES_TRUE;
 
-	/* get memory for clipping QP solver */
-	interval->qpSolverClipping.qStep.data  = (real_t*)calloc( nV,sizeof(real_t) );
-	interval->qpSolverClipping.zUnconstrained.data = (real_t*)calloc( nV,sizeof(real_t) );
-	interval->qpSolverClipping.dz.data = (real_t*)calloc( nV,sizeof(real_t) );
+/* ----------------------------------------------
+ * number of block rows needed to store all levels
+ * of a cyclic reduction Newton Hessian factor
+ *
+ >>>>>>                                           */
+uint_t qpDUNES_getCyclicReductionNumBlocks(	uint_t nI
+											)
+{
+	uint_t nBlocks = nI;
+	uint_t nBlocksTotal = nI;
 
-	/* get memory for qpOASES QP solver */
-	/* TODO: do this only if needed later on in code generated / static memory version */
-	/* TODO: utilize special bound version of qpOASES later on for full Hessians, but box constraints */
-	interval->qpSolverQpoases.qpoasesObject = qpOASES_constructor( qpData, nV, nD );
-	interval->qpSolverQpoases.qFullStep.data  = (real_t*)calloc( nV,sizeof(real_t) );
+	/* every level keeps every other block of the previous one */
+	while ( nBlocks > 1 ) {
+		nBlocks = ( nBlocks + 1 ) / 2;
+		nBlocksTotal += nBlocks;
+	}
 
-	/* get memory for objecte function parameterization */
-	interval->parametricObjFctn_alpha.data = (real_t*)calloc( qpData->options.maxNumQpoasesIterations + 2 , sizeof(real_t) );
-	interval->parametricObjFctn_f.data = (real_t*)calloc( qpData->options.maxNumQpoasesIterations + 2 , sizeof(real_t) );
-	interval->parametricObjFctn_fPrime.data = (real_t*)calloc( qpData->options.maxNumQpoasesIterations + 2 , sizeof(real_t) );
-	interval->parametricObjFctn_fPrimePrime.data = (real_t*)calloc( qpData->options.maxNumQpoasesIterations + 2 , sizeof(real_t) );
-	interval->parametricObjFctn_fSum.data = (real_t*)calloc( qpData->options.maxNumQpoasesIterations + 2 , sizeof(real_t) );
+	return nBlocksTotal;
+}
+/*<<< END OF qpDUNES_getCyclicReductionNumBlocks */
 
 
-	interval->qpSolverSpecification = QPDUNES_STAGE_QP_SOLVER_UNDEFINED;
+/* ----------------------------------------------
+ * strides of the Newton Hessian storage layout
+ *
+ >>>>>>                                           */
+void qpDUNES_setupNewtonHessianLayout(	nhLayout_t* const layout,
+										uint_t nX,
+										nwtnHssnLayout_t layoutType
+										)
+{
+	switch ( layoutType ) {
+		case QPDUNES_NH_LAYOUT_BLOCKED:
+			/* [sub-diagonal block][diagonal block] per block row, each row padded to full cache lines */
+			layout->rowStride = (int_t)QPDUNES_NH_PAD( nX );
+			layout->blockStride = (int_t)nX * layout->rowStride;
+			layout->blockRowStride = 2 * layout->blockStride;
+			break;
 
-	return interval;
+		case QPDUNES_NH_LAYOUT_INTERLEAVED:
+		default:
+			/* rows of sub-diagonal and diagonal block side by side */
+			layout->rowStride = 2 * (int_t)nX;
+			layout->blockStride = (int_t)nX;
+			layout->blockRowStride = 2 * (int_t)nX * (int_t)nX;
+			break;
+	}
 }
+/*<<< END OF qpDUNES_setupNewtonHessianLayout */
 
 
 
@@ -278,99 +1291,187 @@ return_t qpDUNES_cleanup(	qpData_t* const qpData
 {
 	uint_t ii, kk;
 
+	/* stages point to their own Hessian factor storage again */
+	qpDUNES_resetFactorCache( qpData );
+
 	/* free all normal intervals */
 	for( kk=0; kk<_NI_; ++kk )
 	{
 		qpDUNES_freeInterval( qpData, qpData->intervals[kk] );
 		
-		qpDUNES_free( &(qpData->intervals[kk]->xVecTmp.data) );
-		qpDUNES_free( &(qpData->intervals[kk]->uVecTmp.data) );
-		qpDUNES_free( &(qpData->intervals[kk]->zVecTmp.data) );
+		qpDUNES_free( &(qpData->arena), &(qpData->intervals[kk]->xVecTmp.data) );
+		qpDUNES_free( &(qpData->arena), &(qpData->intervals[kk]->uVecTmp.data) );
+		qpDUNES_free( &(qpData->arena), &(qpData->intervals[kk]->zVecTmp.data) );
 
-		free( qpData->intervals[kk] );
+		qpDUNES_freeAlignedMemory( &(qpData->arena), qpData->intervals[kk] );
 	}
 	
 	/* free last interval */
 	qpDUNES_freeInterval( qpData, qpData->intervals[_NI_] );
 	
-	qpDUNES_free( &(qpData->intervals[_NI_]->xVecTmp.data) );
-	qpDUNES_free( &(qpData->intervals[_NI_]->uVecTmp.data) );
-	qpDUNES_free( &(qpData->intervals[_NI_]->zVecTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->intervals[_NI_]->xVecTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->intervals[_NI_]->uVecTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->intervals[_NI_]->zVecTmp.data) );
 	
-	free( qpData->intervals[_NI_] );
+	qpDUNES_freeAlignedMemory( &(qpData->arena), qpData->intervals[_NI_] );
 
 
 	if ( qpData->intervals != 0 )
-		free( qpData->intervals );
+		qpDUNES_freeMemory( &(qpData->arena), qpData->intervals );
 	qpData->intervals = 0;
 	
 	
 	/* free remainder of qpData struct */
-	qpDUNES_free( &(qpData->lambda.data) );
-	qpDUNES_free( &(qpData->deltaLambda.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->lambda.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->deltaLambda.data) );
 	
-	qpDUNES_free( &(qpData->hessian.data) );
-	qpDUNES_free( &(qpData->cholHessian.data) );
-	qpDUNES_free( &(qpData->gradient.data) );
+	qpDUNES_freeAligned( &(qpData->arena), &(qpData->hessian.data) );
+	qpDUNES_freeAligned( &(qpData->arena), &(qpData->cholHessian.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->gradient.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->gradientCache.data) );
+
+	qpDUNES_freeAligned( &(qpData->arena), &(qpData->unconstrainedHessian.data) );
+	qpDUNES_freeAligned( &(qpData->arena), &(qpData->cholUnconstrainedHessian.data) );
+	if ( qpData->cholHessianBlockSparsity != 0 ) {
+		qpDUNES_freeMemory( &(qpData->arena), qpData->cholHessianBlockSparsity );
+		qpData->cholHessianBlockSparsity = 0;
+	}
+	if ( qpData->cholUnconstrainedHessianBlockSparsity != 0 ) {
+		qpDUNES_freeMemory( &(qpData->arena), qpData->cholUnconstrainedHessianBlockSparsity );
+		qpData->cholUnconstrainedHessianBlockSparsity = 0;
+	}
+
+	if ( qpData->factorCache.entries != 0 ) {
+		qpDUNES_freeMemory( &(qpData->arena), qpData->factorCache.entries );
+		qpData->factorCache.entries = 0;
+	}
+	qpDUNES_free( &(qpData->arena), &(qpData->factorCache.keys) );
+	qpDUNES_intFree( &(qpData->arena), &(qpData->factorCache.newtonBlockSource.data) );
+
+	if ( qpData->newtonMemo.slots != 0 ) {
+		qpDUNES_freeMemory( &(qpData->arena), qpData->newtonMemo.slots );
+		qpData->newtonMemo.slots = 0;
+	}
+	if ( qpData->newtonMemo.actSets != 0 ) {
+		qpDUNES_freeMemory( &(qpData->arena), qpData->newtonMemo.actSets );
+		qpData->newtonMemo.actSets = 0;
+	}
+	qpDUNES_free( &(qpData->arena), &(qpData->newtonMemo.blocks) );
+	qpDUNES_intFree( &(qpData->arena), &(qpData->newtonMemo.stageSlot.data) );
+	qpData->newtonMemo.nSlots = 0;
+
+	qpDUNES_freeAligned( &(qpData->arena), &(qpData->cyclicReductionTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->cyclicReductionRhs.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->newtonKernelTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->lineSearchBreakpoints.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->lineSearchGrid.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->lineSearchStageObjVals.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->homotopyBreakpoints.data) );
+	qpDUNES_intFree( &(qpData->arena), &(qpData->homotopyBreakpointIdx.data) );
+	qpDUNES_intFree( &(qpData->arena), &(qpData->homotopyRunStart.data) );
 	
 	
-	qpDUNES_free( &(qpData->xVecTmp.data) );
-	qpDUNES_free( &(qpData->uVecTmp.data) );
-	qpDUNES_free( &(qpData->zVecTmp.data) );
-	qpDUNES_free( &(qpData->xnVecTmp.data) );
-	qpDUNES_free( &(qpData->xnVecTmp2.data) );
-	qpDUNES_free( &(qpData->xxMatTmp.data) );
-	qpDUNES_free( &(qpData->xxMatTmp2.data) );
-	qpDUNES_free( &(qpData->xzMatTmp.data) );
-	qpDUNES_free( &(qpData->uxMatTmp.data) );
-	qpDUNES_free( &(qpData->zxMatTmp.data) );
-	qpDUNES_free( &(qpData->zzMatTmp.data) );
-	qpDUNES_free( &(qpData->zzMatTmp2.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->xVecTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->uVecTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->zVecTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->xnVecTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->xnVecTmp2.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->xxMatTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->xxMatTmp2.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->xzMatTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->uxMatTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->zxMatTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->zzMatTmp.data) );
+	qpDUNES_free( &(qpData->arena), &(qpData->zzMatTmp2.data) );
+
+	if ( qpData->threadWorkspace != 0 ) {
+		for( ii=0; ii<(uint_t)qpData->nThreads; ++ii ) {
+			qpDUNES_free( &(qpData->arena), &(qpData->threadWorkspace[ii].xVecTmp.data) );
+			qpDUNES_free( &(qpData->arena), &(qpData->threadWorkspace[ii].uVecTmp.data) );
+			qpDUNES_free( &(qpData->arena), &(qpData->threadWorkspace[ii].zVecTmp.data) );
+			qpDUNES_free( &(qpData->arena), &(qpData->threadWorkspace[ii].xxMatTmp.data) );
+			qpDUNES_free( &(qpData->arena), &(qpData->threadWorkspace[ii].xxMatTmp2.data) );
+			qpDUNES_free( &(qpData->arena), &(qpData->threadWorkspace[ii].uxMatTmp.data) );
+			qpDUNES_free( &(qpData->arena), &(qpData->threadWorkspace[ii].xzMatTmp.data) );
+			qpDUNES_free( &(qpData->arena), &(qpData->threadWorkspace[ii].zxMatTmp.data) );
+		}
+		qpDUNES_freeMemory( &(qpData->arena), qpData->threadWorkspace );
+		qpData->threadWorkspace = 0;
+	}
 	
 	
 	/* free log */
 	if ( qpData->options.logLevel >= QPDUNES_LOG_ITERATIONS )
 	{
 		for( ii=0; ii<qpData->options.maxIter+1; ++ii ) {
-			free( qpData->log.itLog[ii].numQpoasesIter );
+			qpDUNES_freeMemory( &(qpData->arena), qpData->log.itLog[ii].numQpoasesIter );
 
 			/* free remainder of data */
 			if ( qpData->options.logLevel == QPDUNES_LOG_ALL_DATA )
 			{
-				qpDUNES_free( &(qpData->log.itLog[ii].regDirections.data) );
+				qpDUNES_free( &(qpData->arena), &(qpData->log.itLog[ii].regDirections.data) );
 
-				qpDUNES_free( &(qpData->log.itLog[ii].lambda.data) );
-				qpDUNES_free( &(qpData->log.itLog[ii].deltaLambda.data) );
+				qpDUNES_free( &(qpData->arena), &(qpData->log.itLog[ii].lambda.data) );
+				qpDUNES_free( &(qpData->arena), &(qpData->log.itLog[ii].deltaLambda.data) );
 
-				qpDUNES_free( &(qpData->log.itLog[ii].gradient.data) );
-				qpDUNES_free( &(qpData->log.itLog[ii].hessian.data) );
-				qpDUNES_free( &(qpData->log.itLog[ii].cholHessian.data) );
+				qpDUNES_free( &(qpData->arena), &(qpData->log.itLog[ii].gradient.data) );
+				qpDUNES_free( &(qpData->arena), &(qpData->log.itLog[ii].hessian.data) );
+				qpDUNES_free( &(qpData->arena), &(qpData->log.itLog[ii].cholHessian.data) );
 				#if defined(__ANALYZE_FACTORIZATION__)
-				qpDUNES_free( &(qpData->log.itLog[ii].invHessian.data) );
+				qpDUNES_free( &(qpData->arena), &(qpData->log.itLog[ii].invHessian.data) );
 				#endif
 
-				qpDUNES_free( &(qpData->log.itLog[ii].dz.data) );
-				qpDUNES_free( &(qpData->log.itLog[ii].zUnconstrained.data) );
-				qpDUNES_free( &(qpData->log.itLog[ii].z.data) );
-				qpDUNES_free( &(qpData->log.itLog[ii].y.data) );
+				qpDUNES_free( &(qpData->arena), &(qpData->log.itLog[ii].dz.data) );
+				qpDUNES_free( &(qpData->arena), &(qpData->log.itLog[ii].zUnconstrained.data) );
+				qpDUNES_free( &(qpData->arena), &(qpData->log.itLog[ii].z.data) );
+				qpDUNES_free( &(qpData->arena), &(qpData->log.itLog[ii].y.data) );
 			}
 		}
 	}
 	else {
 		/* free qpoases iterations number log */
-		free( qpData->log.itLog[0].numQpoasesIter );
+		qpDUNES_freeMemory( &(qpData->arena), qpData->log.itLog[0].numQpoasesIter );
 	}
 
 
 	if ( qpData->log.itLog != 0 )
-		free( qpData->log.itLog );
+		qpDUNES_freeMemory( &(qpData->arena), qpData->log.itLog );
 	qpData->log.itLog = 0;
 
+	#if !defined(__STATIC_MEMORY__)
+	/* release memory block holding all of the above */
+	if ( qpData->arena.isOwned == QPDUNES_TRUE ) {
+		qpDUNES_freeAlignedMemory( 0, qpData->arena.buffer );
+	}
+	qpData->arena.buffer = 0;
+	qpData->arena.size = 0;
+	qpData->arena.used = 0;
+	#endif
+
 	return QPDUNES_OK;
 }
 /*<<< END OF qpDUNES_deallocate */
 
 
+/* ----------------------------------------------
+ * memory deallocation of a batch of QPs
+ *
+#>>>>>>                                           */
+return_t qpDUNES_cleanupBatch(	qpData_t* const qpDataBatch,
+								int_t nBatch
+								)
+{
+	int_t bb;
+
+	for( bb=0; bb<nBatch; ++bb ) {
+		qpDUNES_cleanup( &(qpDataBatch[bb]) );
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_cleanupBatch */
+
+
 
 /* ----------------------------------------------
  *
@@ -379,68 +1480,67 @@ void qpDUNES_freeInterval(	qpData_t* const qpData,
 						interval_t* const interval
 						)
 {
-	qpDUNES_free( &(interval->H.data) );
+	qpDUNES_releaseIntervalData( qpData, interval, QPDUNES_FALSE );	/* user memory is not freed here */
 
-	qpDUNES_free( &(interval->g.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->H.data) );
 
-	qpDUNES_free( &(interval->q.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->g.data) );
 
-	qpDUNES_free( &(interval->cholH.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->q.data) );
 
-	qpDUNES_free( &(interval->C.data) );
-	qpDUNES_free( &(interval->c.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->cholH.data) );
 
-	qpDUNES_free( &(interval->zLow.data) );
-	qpDUNES_free( &(interval->zUpp.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->C.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->c.data) );
 
-	qpDUNES_free( &(interval->D.data) );
-	qpDUNES_free( &(interval->dLow.data) );
-	qpDUNES_free( &(interval->dUpp.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->zLow.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->zUpp.data) );
 
-	qpDUNES_free( &(interval->z.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->D.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->dLow.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->dUpp.data) );
 
-	qpDUNES_free( &(interval->y.data) );
-	qpDUNES_free( &(interval->yPrev.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->z.data) );
 
-	qpDUNES_free( &(interval->lambdaK.data) );
-	qpDUNES_free( &(interval->lambdaK1.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->y.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->yPrev.data) );
+	qpDUNES_intFree( &(qpData->arena), &(interval->hessianActSet.data) );
 
+	qpDUNES_free( &(qpData->arena), &(interval->lambdaK.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->lambdaK1.data) );
 
-	qpDUNES_free( &(interval->qpSolverClipping.qStep.data) );
-	qpDUNES_free( &(interval->qpSolverClipping.zUnconstrained.data) );
-	qpDUNES_free( &(interval->qpSolverClipping.dz.data) );
 
-
-	qpOASES_destructor( &(interval->qpSolverQpoases.qpoasesObject) );
-	qpDUNES_free( &(interval->qpSolverQpoases.qFullStep.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverClipping.qStep.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverClipping.zUnconstrained.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverClipping.dz.data) );
 
 
-	qpDUNES_free( &(interval->parametricObjFctn_alpha.data) );
-	qpDUNES_free( &(interval->parametricObjFctn_f.data) );
-	qpDUNES_free( &(interval->parametricObjFctn_fPrime.data) );
-	qpDUNES_free( &(interval->parametricObjFctn_fPrimePrime.data) );
-	qpDUNES_free( &(interval->parametricObjFctn_fSum.data) );
+	qpOASES_destructor( &(interval->qpSolverQpoases.qpoasesObject) );
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverQpoases.qFullStep.data) );
+
+
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverBoxQp.cholHFree.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverBoxQp.ZT.data) );
+	qpDUNES_intFree( &(qpData->arena), &(interval->qpSolverBoxQp.freeIdx.data) );
+	qpDUNES_intFree( &(qpData->arena), &(interval->qpSolverBoxQp.actSet.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverBoxQp.zCur.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverBoxQp.qCur.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverBoxQp.qFullStep.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverBoxQp.qTarget.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverBoxQp.dq.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverBoxQp.dz.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->qpSolverBoxQp.wFree.data) );
+
+
+	qpDUNES_free( &(qpData->arena), &(interval->parametricObjFctn_alpha.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->parametricObjFctn_f.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->parametricObjFctn_fPrime.data) );
+	qpDUNES_free( &(qpData->arena), &(interval->parametricObjFctn_fPrimePrime.data) );
 }
 /*<<< END OF qpDUNES_freeInterval */
 
 
 
-///* ----------------------------------------------
-// *
-//#>>>>>>                                           */
-//void qpDUNES_indicateDataChange(	qpData_t* const qpData,
-//									interval_t* const interval
-//									)
-//{
-//	int_t ii;
-//
-//	/* initialize prevIeqStatus to safe values when data was changed to force Hessian refactorization */
-//	interval->rebuildHessianBlock = QPDUNES_TRUE;
-//}
-///*<<< END OF qpDUNES_indicateDataChange */
-
-
-
 /* ----------------------------------------------
  *
  >>>>>>                                           */
@@ -857,8 +1957,8 @@ return_t qpDUNES_setupRegularInterval(	qpData_t* const qpData,
 		qpDUNES_updateMatrixData( (matrix_t*)&(interval->D), D_, nD, _NZ_ );
 
 	}
-	else {	/* simply bounded QP */
-		qpDUNES_setMatrixNull( (matrix_t*)&(interval->D) );
+	else if ( !( interval->registeredData.fields & QPDUNES_DATA_D ) ) {	/* simply bounded QP */
+		qpDUNES_setMatrixNull( &(qpData->arena), (matrix_t*)&(interval->D) );
 	}
 	
 	/*  - Vectors */
@@ -935,8 +2035,8 @@ return_t qpDUNES_setupFinalInterval(	qpData_t* const qpData,
 		}
 		qpDUNES_updateMatrixData( (matrix_t*)&(interval->D), D_, nD, nV );
 	}
-	else {	/* simply bounded QP */
-		qpDUNES_setMatrixNull( (matrix_t*)&(interval->D) );
+	else if ( !( interval->registeredData.fields & QPDUNES_DATA_D ) ) {	/* simply bounded QP */
+		qpDUNES_setMatrixNull( &(qpData->arena), (matrix_t*)&(interval->D) );
 	}
 	
 	qpDUNES_updateVector( (vector_t*)&(interval->dLow), dLow_, nD );
@@ -975,14 +2075,10 @@ return_t qpDUNES_updateIntervalData(	qpData_t* const qpData,
 										vv_matrix_t* const cholH
 										)
 {
-	int_t ii;
-
 	int_t nD = interval->nD;
 	int_t nV = interval->nV;
 
-	int_t nQpoasesIter;
-
-	return_t statusFlag;
+	int_t changedData = QPDUNES_DATA_NONE;
 
 //	qpDUNES_printMatrixData( H_, _NZ_, _NZ_, "H:" );
 //	qpDUNES_printMatrixData( g_, _NZ_*_NI_, 1, "g:" );
@@ -996,24 +2092,6 @@ return_t qpDUNES_updateIntervalData(	qpData_t* const qpData,
 //	if (dUpp_)  qpDUNES_printMatrixData( dUpp_, nD, nV, "dUpp:" );
 
 
-	boolean_t refactorHessian;
-	boolean_t H_changed;
-	boolean_t g_changed;
-	boolean_t zLow_changed;
-	boolean_t zUpp_changed;
-	boolean_t D_changed;
-	boolean_t dLow_changed;
-	boolean_t dUpp_changed;
-
-	/** consistency checks */
-	if ( ( (D_ != 0) || (dLow_ != 0) || (dUpp_ != 0) ) &&
-		 ( interval->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_QPOASES ) )
-	{
-		qpDUNES_printError( qpData, __FILE__, __LINE__, "Affine constraint data update on stage %d detected,\n          but incompatible stage stage solver %d initially selected.", interval->id, (int)interval->qpSolverSpecification );
-		return QPDUNES_ERR_INVALID_ARGUMENT;
-	}
-
-
 	/** copy data */
 	qpDUNES_updateMatrixData( (matrix_t*)&(interval->H), H_, nV, nV );
 	qpDUNES_updateVector( (vector_t*)&(interval->g), g_, nV );
@@ -1032,9 +2110,63 @@ return_t qpDUNES_updateIntervalData(	qpData_t* const qpData,
 	qpDUNES_updateVector( (vector_t*)&(interval->dUpp), dUpp_, nD );
 
 
+	/** update stage QP */
+	if ( H_ != 0 )		changedData |= QPDUNES_DATA_H;
+	if ( g_ != 0 )		changedData |= QPDUNES_DATA_G;
+	if ( C_ != 0 )		changedData |= QPDUNES_DATA_C;
+	if ( c_ != 0 )		changedData |= QPDUNES_DATA_C_CONST;
+	if ( zLow_ != 0 )	changedData |= QPDUNES_DATA_ZLOW;
+	if ( zUpp_ != 0 )	changedData |= QPDUNES_DATA_ZUPP;
+	if ( D_ != 0 )		changedData |= QPDUNES_DATA_D;
+	if ( dLow_ != 0 )	changedData |= QPDUNES_DATA_DLOW;
+	if ( dUpp_ != 0 )	changedData |= QPDUNES_DATA_DUPP;
+
+	return qpDUNES_updateIntervalQp( qpData, interval, changedData, cholH );
+}
+/*<<< END OF qpDUNES_updateIntervalData */
+
+
+/* ----------------------------------------------
+ * update of a stage QP after its data given in
+ * changedData (bit mask of dataField_t) has
+ * changed in place
+ *
+ >>>>>>                                           */
+return_t qpDUNES_updateIntervalQp(	qpData_t* const qpData,
+									interval_t* interval,
+									int_t changedData,
+									vv_matrix_t* const cholH
+									)
+{
+	int_t ii;
+
+	int_t nV = interval->nV;
+
+	int_t nQpoasesIter;
+
+	return_t statusFlag = QPDUNES_OK;
+
+	boolean_t refactorHessian;
+	boolean_t H_changed;
+	boolean_t g_changed;
+	boolean_t zLow_changed;
+	boolean_t zUpp_changed;
+	boolean_t D_changed;
+	boolean_t dLow_changed;
+	boolean_t dUpp_changed;
+
+	/** consistency checks */
+	if ( ( changedData & ( QPDUNES_DATA_D | QPDUNES_DATA_DLOW | QPDUNES_DATA_DUPP ) ) &&
+		 ( interval->qpSolverSpecification != QPDUNES_STAGE_QP_SOLVER_QPOASES ) )
+	{
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Affine constraint data update on stage %d detected,\n          but incompatible stage stage solver %d initially selected.", interval->id, (int)interval->qpSolverSpecification );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+
 	/* reset current active set to force Hessian refactorization
 	 * (needed if matrix data entering the Newton Hessian has changed) */
-	if ( (H_ !=0) || (C_ != 0) || (D_ != 0) ) {
+	if ( changedData & ( QPDUNES_DATA_H | QPDUNES_DATA_C | QPDUNES_DATA_D ) ) {
 		interval->rebuildHessianBlock = QPDUNES_TRUE;
 	}
 
@@ -1044,8 +2176,9 @@ return_t qpDUNES_updateIntervalData(	qpData_t* const qpData,
 		case QPDUNES_STAGE_QP_SOLVER_CLIPPING:
 			refactorHessian = QPDUNES_FALSE;
 			/* check if Hessian needs to be refactored */
-			if ( H_ != 0 ) {
+			if ( changedData & QPDUNES_DATA_H ) {
 				if (cholH != 0) {	/* factorization provided */
+					qpDUNES_releaseStageFactor( qpData, interval );
 					qpDUNES_copyMatrix( (matrix_t*)&(interval->cholH), (matrix_t*)cholH, nV, nV );
 				}
 				else {				/* no factorization provided */
@@ -1054,7 +2187,7 @@ return_t qpDUNES_updateIntervalData(	qpData_t* const qpData,
 			}
 
 			/* do re-setup of clipping QP solver only if needed */
-			if ( (H_ != 0) || (g_ != 0) || (zLow_ != 0) || (zUpp_ != 0) )
+			if ( changedData & ( QPDUNES_DATA_H | QPDUNES_DATA_G | QPDUNES_DATA_ZLOW | QPDUNES_DATA_ZUPP ) )
 			{
 				statusFlag = qpDUNES_setupClippingSolver( qpData, interval, refactorHessian );
 
@@ -1073,13 +2206,13 @@ return_t qpDUNES_updateIntervalData(	qpData_t* const qpData,
 			break;
 
 		case QPDUNES_STAGE_QP_SOLVER_QPOASES:
-			H_changed 	 = ( H_    != 0 ) ? QPDUNES_TRUE : QPDUNES_FALSE;
-			g_changed 	 = ( g_    != 0 ) ? QPDUNES_TRUE : QPDUNES_FALSE;
-			zLow_changed = ( zLow_ != 0 ) ? QPDUNES_TRUE : QPDUNES_FALSE;
-			zUpp_changed = ( zUpp_ != 0 ) ? QPDUNES_TRUE : QPDUNES_FALSE;
-			D_changed 	 = ( D_    != 0 ) ? QPDUNES_TRUE : QPDUNES_FALSE;
-			dLow_changed = ( dLow_ != 0 ) ? QPDUNES_TRUE : QPDUNES_FALSE;
-			dUpp_changed = ( dUpp_ != 0 ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+			H_changed 	 = ( changedData & QPDUNES_DATA_H ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+			g_changed 	 = ( changedData & QPDUNES_DATA_G ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+			zLow_changed = ( changedData & QPDUNES_DATA_ZLOW ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+			zUpp_changed = ( changedData & QPDUNES_DATA_ZUPP ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+			D_changed 	 = ( changedData & QPDUNES_DATA_D ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+			dLow_changed = ( changedData & QPDUNES_DATA_DLOW ) ? QPDUNES_TRUE : QPDUNES_FALSE;
+			dUpp_changed = ( changedData & QPDUNES_DATA_DUPP ) ? QPDUNES_TRUE : QPDUNES_FALSE;
 
 //			if (interval->id == 0) 	qpDUNES_printMatrixData( interval->z.data, 1, interval->nV, "i[%3d]: z@resolve:", interval->id);
 
@@ -1090,6 +2223,34 @@ return_t qpDUNES_updateIntervalData(	qpData_t* const qpData,
 //			interval->rebuildHessianBlock = QPDUNES_TRUE;
 			break;
 
+		case QPDUNES_STAGE_QP_SOLVER_BOXQP:
+			refactorHessian = QPDUNES_FALSE;
+			if ( changedData & QPDUNES_DATA_H ) {
+				if (cholH != 0) {	/* factorization provided */
+					qpDUNES_releaseStageFactor( qpData, interval );
+					qpDUNES_copyMatrix( (matrix_t*)&(interval->cholH), (matrix_t*)cholH, nV, nV );
+				}
+				else {				/* no factorization provided */
+					refactorHessian = QPDUNES_TRUE;
+				}
+			}
+
+			/* active set can be kept as long as H and bounds are unchanged */
+			if ( changedData & ( QPDUNES_DATA_H | QPDUNES_DATA_G | QPDUNES_DATA_ZLOW | QPDUNES_DATA_ZUPP ) )
+			{
+				statusFlag = qpDUNES_setupBoxQpSolver( qpData, interval, refactorHessian,
+													   ( changedData & ( QPDUNES_DATA_H | QPDUNES_DATA_ZLOW | QPDUNES_DATA_ZUPP ) ) ? QPDUNES_FALSE : QPDUNES_TRUE );
+
+				/* check if Hessian contribution changed */
+				for (ii = 0; ii < nV; ++ii ) {
+					if ( (boolean_t)( interval->qpSolverBoxQp.actSet.data[ii] != 0 ) != (boolean_t)( interval->hessianActSet.data[ii] != 0 ) ) {
+						interval->rebuildHessianBlock = QPDUNES_TRUE;
+						break;
+					}
+				}
+			}
+			break;
+
 		default:
 			qpDUNES_printError( qpData, __FILE__, __LINE__, "Unknown stage QP solver selected." );
 			return QPDUNES_ERR_INVALID_ARGUMENT;
@@ -1108,7 +2269,225 @@ return_t qpDUNES_updateIntervalData(	qpData_t* const qpData,
 			return statusFlag;
 	}
 }
-/*<<< END OF qpDUNES_updateIntervalData */
+/*<<< END OF qpDUNES_updateIntervalQp */
+
+
+/* ----------------------------------------------
+ * let the data fields of an interval point to
+ * user memory; null pointers keep the current
+ * storage. Registered arrays are read in place
+ * in the storage format of the solver (H: nV*nV
+ * row-major if dense, nV diagonal entries if
+ * diagonal, not read if identity; C, D dense;
+ * H of stages with affine constraints or box
+ * QP solver dense).
+ * After changing them, call
+ * qpDUNES_indicateDataChange.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_registerIntervalData(	qpData_t* const qpData,
+										interval_t* interval,
+										real_t* const H_,
+										sparsityType_t sparsityH,
+										real_t* const g_,
+										real_t* const C_,
+										real_t* const c_,
+										real_t* const zLow_,
+										real_t* const zUpp_,
+										real_t* const D_,
+										real_t* const dLow_,
+										real_t* const dUpp_
+										)
+{
+	registeredData_t* registeredData = &(interval->registeredData);
+	int_t changedData = QPDUNES_DATA_NONE;
+
+	/** consistency checks */
+	if ( ( H_ != 0 ) &&
+		 ( sparsityH != QPDUNES_DENSE ) && ( sparsityH != QPDUNES_DIAGONAL ) && ( sparsityH != QPDUNES_IDENTITY ) )
+	{
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Hessian of stage %d registered with unsupported sparsity type %d.", interval->id, (int)sparsityH );
+		return QPDUNES_ERR_UNKNOWN_MATRIX_SPARSITY_TYPE;
+	}
+	if ( ( H_ != 0 ) && ( sparsityH != QPDUNES_DENSE ) && ( interval->nD > 0 ) ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Hessian of stage %d with affine constraints needs to be registered dense (qpOASES works on it in place).", interval->id );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+	if ( ( H_ != 0 ) && ( sparsityH != QPDUNES_DENSE ) && ( interval->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_BOXQP ) ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Hessian of stage %d needs to be registered dense (box QP solver selected).", interval->id );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+	if ( ( ( C_ != 0 ) || ( c_ != 0 ) ) && ( interval->c.data == 0 ) ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Dynamics registered on stage %d, which has no dynamics.", interval->id );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+	if ( ( ( D_ != 0 ) || ( dLow_ != 0 ) || ( dUpp_ != 0 ) ) && ( interval->nD == 0 ) ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Affine constraints registered on stage %d, which has no affine constraints.", interval->id );
+		return QPDUNES_ERR_INVALID_ARGUMENT;
+	}
+
+	/** redirect data fields; solver-owned storage is kept on first registration */
+	if ( H_ != 0 ) {
+		if ( !( registeredData->fields & QPDUNES_DATA_H ) )  registeredData->H = interval->H.data;
+		interval->H.data = H_;
+		interval->H.sparsityType = sparsityH;
+		changedData |= QPDUNES_DATA_H;
+	}
+	if ( g_ != 0 ) {
+		if ( !( registeredData->fields & QPDUNES_DATA_G ) )  registeredData->g = interval->g.data;
+		interval->g.data = g_;
+		changedData |= QPDUNES_DATA_G;
+	}
+	if ( C_ != 0 ) {
+		if ( !( registeredData->fields & QPDUNES_DATA_C ) )  registeredData->C = interval->C.data;
+		interval->C.data = C_;
+		interval->C.sparsityType = QPDUNES_DENSE;
+		changedData |= QPDUNES_DATA_C;
+	}
+	if ( c_ != 0 ) {
+		if ( !( registeredData->fields & QPDUNES_DATA_C_CONST ) )  registeredData->c = interval->c.data;
+		interval->c.data = c_;
+		changedData |= QPDUNES_DATA_C_CONST;
+	}
+	if ( zLow_ != 0 ) {
+		if ( !( registeredData->fields & QPDUNES_DATA_ZLOW ) )  registeredData->zLow = interval->zLow.data;
+		interval->zLow.data = zLow_;
+		changedData |= QPDUNES_DATA_ZLOW;
+	}
+	if ( zUpp_ != 0 ) {
+		if ( !( registeredData->fields & QPDUNES_DATA_ZUPP ) )  registeredData->zUpp = interval->zUpp.data;
+		interval->zUpp.data = zUpp_;
+		changedData |= QPDUNES_DATA_ZUPP;
+	}
+	if ( D_ != 0 ) {
+		if ( !( registeredData->fields & QPDUNES_DATA_D ) )  registeredData->D = interval->D.data;
+		interval->D.data = D_;
+		interval->D.sparsityType = QPDUNES_DENSE;	/* currently only dense matrices are supported in affine constraints */
+		changedData |= QPDUNES_DATA_D;
+	}
+	if ( dLow_ != 0 ) {
+		if ( !( registeredData->fields & QPDUNES_DATA_DLOW ) )  registeredData->dLow = interval->dLow.data;
+		interval->dLow.data = dLow_;
+		changedData |= QPDUNES_DATA_DLOW;
+	}
+	if ( dUpp_ != 0 ) {
+		if ( !( registeredData->fields & QPDUNES_DATA_DUPP ) )  registeredData->dUpp = interval->dUpp.data;
+		interval->dUpp.data = dUpp_;
+		changedData |= QPDUNES_DATA_DUPP;
+	}
+	registeredData->fields |= changedData;
+
+	/* stage QP solvers are chosen and set up in qpDUNES_setupAllLocalQPs; afterwards they need an update */
+	if ( interval->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_UNDEFINED ) {
+		if ( changedData & ( QPDUNES_DATA_H | QPDUNES_DATA_C | QPDUNES_DATA_D ) ) {
+			interval->rebuildHessianBlock = QPDUNES_TRUE;
+		}
+		return QPDUNES_OK;
+	}
+	return qpDUNES_updateIntervalQp( qpData, interval, changedData, 0 );
+}
+/*<<< END OF qpDUNES_registerIntervalData */
+
+
+/* ----------------------------------------------
+ * let registered data fields of an interval
+ * point to solver-owned storage again; the
+ * current user data is copied
+ *
+ >>>>>>                                           */
+return_t qpDUNES_unregisterIntervalData(	qpData_t* const qpData,
+											interval_t* interval
+											)
+{
+	qpDUNES_releaseIntervalData( qpData, interval, QPDUNES_TRUE );
+
+	return QPDUNES_OK;
+}
+/*<<< END OF qpDUNES_unregisterIntervalData */
+
+
+/* ----------------------------------------------
+ * restore solver-owned storage of registered
+ * data fields, optionally keeping the user data
+ *
+ >>>>>>                                           */
+void qpDUNES_releaseIntervalData(	qpData_t* const qpData,
+									interval_t* interval,
+									boolean_t keepData
+									)
+{
+	registeredData_t* registeredData = &(interval->registeredData);
+
+	int_t nD = interval->nD;
+	int_t nV = interval->nV;
+	int_t nH = 0;
+
+	if ( registeredData->fields & QPDUNES_DATA_H ) {
+		if ( interval->H.sparsityType == QPDUNES_DENSE )  nH = nV*nV;
+		if ( interval->H.sparsityType == QPDUNES_DIAGONAL )  nH = nV;
+		if ( keepData )  qpDUNES_copyArray( registeredData->H, interval->H.data, nH );
+		interval->H.data = registeredData->H;
+	}
+	if ( registeredData->fields & QPDUNES_DATA_G ) {
+		if ( keepData )  qpDUNES_copyArray( registeredData->g, interval->g.data, nV );
+		interval->g.data = registeredData->g;
+	}
+	if ( registeredData->fields & QPDUNES_DATA_C ) {
+		if ( keepData )  qpDUNES_copyArray( registeredData->C, interval->C.data, _NX_*_NZ_ );
+		interval->C.data = registeredData->C;
+	}
+	if ( registeredData->fields & QPDUNES_DATA_C_CONST ) {
+		if ( keepData )  qpDUNES_copyArray( registeredData->c, interval->c.data, _NX_ );
+		interval->c.data = registeredData->c;
+	}
+	if ( registeredData->fields & QPDUNES_DATA_ZLOW ) {
+		if ( keepData )  qpDUNES_copyArray( registeredData->zLow, interval->zLow.data, nV );
+		interval->zLow.data = registeredData->zLow;
+	}
+	if ( registeredData->fields & QPDUNES_DATA_ZUPP ) {
+		if ( keepData )  qpDUNES_copyArray( registeredData->zUpp, interval->zUpp.data, nV );
+		interval->zUpp.data = registeredData->zUpp;
+	}
+	if ( registeredData->fields & QPDUNES_DATA_D ) {
+		if ( registeredData->D != 0 ) {
+			if ( keepData )  qpDUNES_copyArray( registeredData->D, interval->D.data, nD*nV );
+		}
+		else {	/* storage was released for simply bounded stage QP */
+			interval->D.sparsityType = QPDUNES_MATRIX_UNDEFINED;
+		}
+		interval->D.data = registeredData->D;
+	}
+	if ( registeredData->fields & QPDUNES_DATA_DLOW ) {
+		if ( keepData )  qpDUNES_copyArray( registeredData->dLow, interval->dLow.data, nD );
+		interval->dLow.data = registeredData->dLow;
+	}
+	if ( registeredData->fields & QPDUNES_DATA_DUPP ) {
+		if ( keepData )  qpDUNES_copyArray( registeredData->dUpp, interval->dUpp.data, nD );
+		interval->dUpp.data = registeredData->dUpp;
+	}
+	registeredData->fields = QPDUNES_DATA_NONE;
+}
+/*<<< END OF qpDUNES_releaseIntervalData */
+
+
+/* ----------------------------------------------
+ * update a stage QP after the user has changed
+ * registered data in place; changedData is a
+ * bit mask of dataField_t. No data is copied.
+ *
+ >>>>>>                                           */
+return_t qpDUNES_indicateDataChange(	qpData_t* const qpData,
+										interval_t* const interval,
+										int_t changedData
+										)
+{
+	if ( changedData == QPDUNES_DATA_NONE ) {
+		return QPDUNES_OK;
+	}
+	return qpDUNES_updateIntervalQp( qpData, interval, changedData, 0 );
+}
+/*<<< END OF qpDUNES_indicateDataChange */
+
 
 
 
@@ -1154,9 +2533,9 @@ return_t qpDUNES_setupAllLocalQPs(	qpData_t* const qpData,
 				}
 
 				if ( (isLTI) && (kk != 0) && (kk != _NI_) )	{
-					/* only first Hessian needs to be factorized in LTI case, others can be copied;
+					/* only first Hessian needs to be factorized in LTI case, others can use its factor;
 					 * last one might still be different, due to terminal cost, even in LTI case */
-					qpDUNES_copyMatrix( &(interval->cholH), &(qpData->intervals[0]->cholH), interval->nV, interval->nV );
+					qpDUNES_shareStageFactor( qpData, interval, qpData->intervals[0] );
 
 					refactorStageHessian = QPDUNES_FALSE;
 				}
@@ -1166,14 +2545,44 @@ return_t qpDUNES_setupAllLocalQPs(	qpData_t* const qpData,
 
 				statusFlag = qpDUNES_setupClippingSolver( qpData, interval, refactorStageHessian );
 			}
+			else if ( ( qpData->options.useBoxQpSolver == QPDUNES_TRUE ) &&
+					  ( interval->H.sparsityType == QPDUNES_DENSE ) &&
+					  ( interval->nD == 0 ) )
+			{
+				/* (b) box QP solver for dense Hessians */
+				interval->qpSolverSpecification = QPDUNES_STAGE_QP_SOLVER_BOXQP;
+				if( qpData->options.printLevel >= 3 ) {
+					qpDUNES_printf("[qpDUNES] Stage %d: Using box QP solver.", kk);
+				}
+
+				if ( (isLTI) && (kk != 0) && (kk != _NI_) &&
+					 ( qpData->intervals[0]->qpSolverSpecification == QPDUNES_STAGE_QP_SOLVER_BOXQP ) )	{
+					qpDUNES_shareStageFactor( qpData, interval, qpData->intervals[0] );
+
+					refactorStageHessian = QPDUNES_FALSE;
+				}
+				else {
+					refactorStageHessian = QPDUNES_TRUE;
+				}
+
+				statusFlag = qpDUNES_allocStageQpSolver( qpData, interval );
+				if ( statusFlag != QPDUNES_OK ) {
+					return statusFlag;
+				}
+				statusFlag = qpDUNES_setupBoxQpSolver( qpData, interval, refactorStageHessian, QPDUNES_FALSE );
+			}
 			else
 			{
-				/* (b) qpOASES */
+				/* (c) qpOASES */
 				interval->qpSolverSpecification = QPDUNES_STAGE_QP_SOLVER_QPOASES;
 				if( qpData->options.printLevel >= 3 ) {
 					qpDUNES_printf("[qpDUNES] Stage %d: Using qpOASES.", kk);
 				}
 
+				statusFlag = qpDUNES_allocStageQpSolver( qpData, interval );
+				if ( statusFlag != QPDUNES_OK ) {
+					return statusFlag;
+				}
 				statusFlag = qpDUNES_setupQpoases( qpData, interval );
 			}
 		}
@@ -1224,7 +2633,7 @@ return_t qpDUNES_setupClippingSolver(	qpData_t* const qpData,
 
 	/* (b) prepare clipping QP solver */
 	if ( refactorHessian == QPDUNES_TRUE ) {	/* only first Hessian needs to be factorized in LTI case, others can be copied; last one might still be different, due to terminal cost, even in LTI case */
-		factorizeH( qpData, &(interval->cholH), &(interval->H), interval->nV );
+		qpDUNES_factorizeStageHessian( qpData, interval );
 	}
 
 	/* (c) solve unconstrained local QP for g and initial lambda guess: */
@@ -1310,6 +2719,45 @@ return_t qpDUNES_setupQpoases(	qpData_t* const qpData,
 /*<<< END OF qpDUNES_setupQpoases */
 
 
+/* ----------------------------------------------
+ *
+ >>>>>>                                           */
+return_t qpDUNES_setupBoxQpSolver(	qpData_t* const qpData,
+									interval_t* const interval,
+									boolean_t refactorHessian,
+									boolean_t warmStart
+									)
+{
+	return_t statusFlag;
+
+	/* (a) factorize Hessian; the active-set updates start from this factor */
+	if ( refactorHessian == QPDUNES_TRUE ) {
+		statusFlag = qpDUNES_factorizeStageHessian( qpData, interval );
+		if ( statusFlag != QPDUNES_OK ) {
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Stage QP Hessian factorization failed. Check if all stage QPs are positive definite." );
+			return statusFlag;
+		}
+	}
+
+	/* (b) prepare first order term: initial lambda guess and g */
+	qpDUNES_copyVector( &(interval->q), &(interval->g), interval->nV );
+	interval->p = 0.;
+	if (interval->id > 0) {		/* lambdaK exists */
+		qpDUNES_updateVector( &(interval->lambdaK), &(qpData->lambda.data[((interval->id)-1)*_NX_]), _NX_ );
+	}
+	if (interval->id < _NI_) {		/* lambdaK1 exists */
+		qpDUNES_updateVector( &(interval->lambdaK1), &(qpData->lambda.data[(interval->id)*_NX_]), _NX_ );
+	}
+	boxQpSolver_updateDualGuess( qpData, interval, &(interval->lambdaK), &(interval->lambdaK1) );
+
+	/* (c) solve first QP */
+	statusFlag = boxQpSolver_setup( qpData, interval, warmStart );
+
+	return statusFlag;
+}
+/*<<< END OF qpDUNES_setupBoxQpSolver */
+
+
 /* ----------------------------------------------
  *
  >>>>>>                                           */
@@ -1599,6 +3047,9 @@ qpOptions_t qpDUNES_setupDefaultOptions( )
 	 	 	 	 	 	 	 	 	 	 	 	 	  */
 
 	options.nwtnHssnFacAlg				= QPDUNES_NH_FAC_BAND_REVERSE;
+	options.nwtnHssnLayout				= QPDUNES_NH_LAYOUT_INTERLEAVED;
+	options.nwtnHssnMaxRankUpdates		= 0;
+	options.nwtnHssnMemoSize			= 0;
 
 
 	/* line search options */
@@ -1611,6 +3062,21 @@ qpOptions_t qpDUNES_setupDefaultOptions( )
 	options.lineSearchMaxStepSize   		= 1.;
 	options.lineSearchNbrGridPoints   		= 5;
 
+	/* memory options */
+	options.stageDataLayout					= QPDUNES_STAGE_LAYOUT_BY_STAGE;
+
+	/* parallelization options */
+	options.nThreads						= 0;
+
+	/* kernel options */
+	options.useSmallKernels					= QPDUNES_TRUE;
+	options.useSimdNewtonKernels			= QPDUNES_TRUE;
+	options.useSimdClippingKernels			= QPDUNES_TRUE;
+
+	/* stage QP solver options */
+	options.useBoxQpSolver					= QPDUNES_TRUE;
+	options.shareStageFactors				= QPDUNES_TRUE;
+
 	/* qpOASES options */
 	options.qpOASES_terminationTolerance	= 1.e-12;	/*< stationarity tolerance for qpOASES, see qpOASES::Options -> terminationTolerance */
 
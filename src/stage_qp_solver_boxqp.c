@@ -0,0 +1,624 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpDUNES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file src/stage_qp_solver_boxqp.c
+ *	\version 1.0beta
+ */
+
+
+#include <qp/stage_qp_solver_boxqp.h>
+
+
+/* ----------------------------------------------
+ * update QP data
+ *
+ * qFullStep = q + C.T*lambdaK1 - [lambdaK.T 0]
+ * pFullStep = p + c*lambdaK1
+#>>>>>>                                           */
+return_t boxQpSolver_updateDualGuess(	qpData_t* const qpData,
+										interval_t* const interval,
+										const z_vector_t* const lambdaK,
+										const z_vector_t* const lambdaK1
+										)
+{
+	int_t ii;
+	qpSolverBoxQp_t* solver = &(interval->qpSolverBoxQp);
+
+	if (lambdaK1->isDefined == QPDUNES_TRUE) {
+		/* qFullStep = q + C.T*lambdaK1 */
+		multiplyCTy( qpData, &(solver->qFullStep), &(interval->C), lambdaK1 );
+		addToVector( &(solver->qFullStep), &(interval->q), interval->nV );
+		/* pFullStep = p + c*lambdaK1 */
+		solver->pFullStep = interval->p + scalarProd( lambdaK1, &(interval->c), _NX_ );
+	}
+	else {
+		qpDUNES_copyVector( &(solver->qFullStep), &(interval->q), interval->nV );
+		solver->pFullStep = interval->p;
+	}
+	if (lambdaK->isDefined == QPDUNES_TRUE) {
+		/* qFullStep -= [lambdaK.T 0]	*/
+		for ( ii=0; ii<(int_t)_NX_; ++ii ) {
+			solver->qFullStep.data[ii] -= lambdaK->data[ii];
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF boxQpSolver_updateDualGuess */
+
+
+/* ----------------------------------------------
+ * first QP solution, or re-solution after a
+ * change in the first order term
+ *
+#>>>>>>                                           */
+return_t boxQpSolver_setup(	qpData_t* const qpData,
+							interval_t* const interval,
+							boolean_t warmStart
+							)
+{
+	int_t ii, jj;
+	int_t nV = interval->nV;
+	return_t statusFlag;
+
+	qpSolverBoxQp_t* solver = &(interval->qpSolverBoxQp);
+	real_t* zLow = interval->zLow.data;
+	real_t* zUpp = interval->zUpp.data;
+	real_t* z = solver->zCur.data;
+
+	if ( warmStart == QPDUNES_FALSE )
+	{
+		for ( ii=0; ii<nV; ++ii ) {
+			if ( zLow[ii] > zUpp[ii] + qpData->options.equalityTolerance ) {
+				qpDUNES_printError( qpData, __FILE__, __LINE__, "Inconsistent bounds on variable %d of stage %d.", ii, interval->id );
+				return QPDUNES_ERR_STAGE_QP_INFEASIBLE;
+			}
+		}
+
+		/* all variables free: factor of Z'HZ is the factor of H */
+		for ( ii=0; ii<nV; ++ii ) {
+			for ( jj=0; jj<=ii; ++jj ) {
+				solver->cholHFree.data[ii*nV+jj] = interval->cholH.data[ii*nV+jj];
+			}
+			for ( jj=0; jj<nV; ++jj ) {
+				solver->ZT.data[ii*nV+jj] = 0.;
+			}
+			solver->ZT.data[ii*nV+ii] = 1.;
+			solver->freeIdx.data[ii] = ii;
+			solver->actSet.data[ii] = 0;
+		}
+		solver->nFree = nV;
+
+		/* fix variables with equal bounds right away, they are never released */
+		for ( ii=nV-1; ii>=0; --ii ) {
+			if ( zUpp[ii] - zLow[ii] <= qpData->options.equalityTolerance ) {
+				statusFlag = boxQpSolver_removeFreeVariable( interval, ii );
+				if ( statusFlag != QPDUNES_OK ) {
+					return statusFlag;
+				}
+				solver->actSet.data[ii] = -1;
+			}
+		}
+
+		/* start homotopy from projection of the origin, which is optimal for qCur = -H*z */
+		for ( ii=0; ii<nV; ++ii ) {
+			z[ii] = qpDUNES_fmin( qpDUNES_fmax( 0., zLow[ii] ), zUpp[ii] );
+		}
+		multiplyMatrixVector( &(solver->qCur), &(interval->H), &(solver->zCur), nV, nV );
+		for ( ii=0; ii<nV; ++ii ) {
+			solver->qCur.data[ii] = -solver->qCur.data[ii];
+		}
+	}
+
+	statusFlag = boxQpSolver_hotstart( qpData, interval, &(solver->qFullStep), 0, QPDUNES_FALSE );
+	if ( statusFlag != QPDUNES_OK ) {
+		return statusFlag;
+	}
+
+	/* get primal and dual solution */
+	qpDUNES_copyVector( &(interval->z), &(solver->zCur), nV );
+	boxQpSolver_getDualSol( qpData, interval, &(solver->qFullStep), &(interval->y) );
+
+	/* update stage data (q, p) */
+	qpDUNES_copyVector( &(interval->q), &(solver->qFullStep), nV );
+	interval->p = solver->pFullStep;
+
+	return QPDUNES_OK;
+}
+/*<<< END OF boxQpSolver_setup */
+
+
+/* ----------------------------------------------
+ * parametric active-set homotopy
+ *
+ * Along q(tau) = qCur + tau*(qTarget - qCur) the
+ * primal solution is piecewise linear; on each
+ * piece the free variables follow
+ *   dz_F = -(Z'HZ)^-1 dq_F,
+ * and a piece ends when a free variable hits a
+ * bound or a multiplier of an active bound
+ * vanishes.
+ *
+ * When logging, q has to be the current linear
+ * term of the interval and qTarget = qFullStep;
+ * on each piece the stage objective has slope
+ * dq'z + dp and curvature dq'dz.
+ *
+#>>>>>>                                           */
+return_t boxQpSolver_hotstart(	qpData_t* const qpData,
+								interval_t* const interval,
+								const z_vector_t* const qTarget,
+								int_t* const nActSetChanges,
+								boolean_t logHomotopy
+								)
+{
+	int_t ii, jj;
+	int_t nV = interval->nV;
+	int_t nChg = 0;
+	int_t blockIdx;
+	return_t statusFlag;
+
+	real_t tau;			/* homotopy parameter */
+	real_t dTau;		/* length of current piece */
+	real_t tBlock;
+	real_t mult, dMult;
+	real_t dqNorm = 0.;
+	real_t dp = 0.;
+	real_t slope, curvature;
+
+	qpSolverBoxQp_t* solver = &(interval->qpSolverBoxQp);
+	real_t* H = interval->H.data;
+	real_t* zLow = interval->zLow.data;
+	real_t* zUpp = interval->zUpp.data;
+	real_t* z = solver->zCur.data;
+	real_t* qCur = solver->qCur.data;
+	real_t* dq = solver->dq.data;
+	real_t* dz = solver->dz.data;
+	real_t* w = solver->wFree.data;
+	int_t* actSet = solver->actSet.data;
+	int_t* freeIdx = solver->freeIdx.data;
+
+	real_t* logAlpha = interval->parametricObjFctn_alpha.data;
+	real_t* logF = interval->parametricObjFctn_f.data;
+	real_t* logFPrime = interval->parametricObjFctn_fPrime.data;
+	real_t* logFPrimePrime = interval->parametricObjFctn_fPrimePrime.data;
+
+	real_t eps = qpData->options.equalityTolerance;
+
+	/* homotopy direction */
+	for ( ii=0; ii<nV; ++ii ) {
+		dq[ii] = qTarget->data[ii] - qCur[ii];
+		dqNorm = qpDUNES_fmax( dqNorm, fabs( dq[ii] ) );
+	}
+
+	if ( logHomotopy == QPDUNES_TRUE ) {
+		dp = solver->pFullStep - interval->p;
+		logAlpha[0] = 0.;
+		logF[0] = 0.5 * multiplyzHz( qpData, &(interval->H), &(solver->zCur), nV ) + scalarProd( &(solver->qCur), &(solver->zCur), nV ) + interval->p;
+	}
+
+	tau = ( dqNorm > 0. ) ? 0. : 1.;
+	while ( 1 )
+	{
+		/* (1) primal direction on current piece; active variables stay at their bounds */
+		for ( ii=0; ii<nV; ++ii ) {
+			dz[ii] = 0.;
+		}
+		if ( tau < 1. ) {
+			for ( ii=0; ii<solver->nFree; ++ii ) {
+				w[ii] = -dq[freeIdx[ii]];
+			}
+			boxQpSolver_backsolveFree( interval, w );
+			for ( ii=0; ii<solver->nFree; ++ii ) {
+				dz[freeIdx[ii]] = w[ii];
+			}
+		}
+
+		/* (2) ratio test: length of the piece */
+		dTau = 1. - tau;
+		blockIdx = -1;
+		for ( ii=0; ii<nV; ++ii ) {
+			if ( dTau <= 0. )	break;
+
+			if ( actSet[ii] == 0 ) {
+				if ( dz[ii] < -eps ) {
+					tBlock = ( zLow[ii] - z[ii] ) / dz[ii];
+				}
+				else if ( dz[ii] > eps ) {
+					tBlock = ( zUpp[ii] - z[ii] ) / dz[ii];
+				}
+				else {
+					continue;
+				}
+			}
+			else {
+				if ( zUpp[ii] - zLow[ii] <= eps )	continue;	/* fixed variable */
+
+				/* multiplier (H*z + q)_ii of active bound and its derivative */
+				mult = qCur[ii] + tau * dq[ii];
+				dMult = dq[ii];
+				for ( jj=0; jj<nV; ++jj ) {
+					mult += H[ii*nV+jj] * z[jj];
+					dMult += H[ii*nV+jj] * dz[jj];
+				}
+				if ( actSet[ii] > 0 ) {		/* upper bound multiplier has opposite sign */
+					mult = -mult;
+					dMult = -dMult;
+				}
+				if ( dMult >= -eps )	continue;
+				tBlock = -mult / dMult;
+			}
+
+			tBlock = qpDUNES_fmax( tBlock, 0. );
+			if ( tBlock < dTau ) {
+				dTau = tBlock;
+				blockIdx = ii;
+			}
+		}
+
+		/* (3) log piece */
+		if ( logHomotopy == QPDUNES_TRUE ) {
+			slope = dp;
+			curvature = 0.;
+			for ( ii=0; ii<nV; ++ii ) {
+				slope += dq[ii] * z[ii];
+				curvature += dq[ii] * dz[ii];
+			}
+			logFPrime[nChg] = slope;
+			logFPrimePrime[nChg] = curvature;
+		}
+
+		/* (4) move along piece */
+		for ( ii=0; ii<nV; ++ii ) {
+			z[ii] += dTau * dz[ii];
+		}
+		tau += dTau;
+
+		if ( blockIdx < 0 )	break;
+
+		/* (5) active set change */
+		if ( nChg >= qpData->options.maxNumQpoasesIterations ) {
+			qpDUNES_printError( qpData, __FILE__, __LINE__, "Maximum number of permitted active set changes reached on stage %d.", interval->id );
+			return QPDUNES_ERR_ITERATION_LIMIT_REACHED;
+		}
+		if ( logHomotopy == QPDUNES_TRUE ) {
+			logAlpha[nChg+1] = tau;
+			logF[nChg+1] = logF[nChg] + logFPrime[nChg] * dTau + 0.5 * logFPrimePrime[nChg] * dTau * dTau;
+		}
+		++nChg;
+
+		if ( actSet[blockIdx] == 0 ) {		/* bound becomes active */
+			for ( ii=0; freeIdx[ii] != blockIdx; ++ii );
+			statusFlag = boxQpSolver_removeFreeVariable( interval, ii );
+			actSet[blockIdx] = ( dz[blockIdx] < 0. ) ? -1 : +1;
+			z[blockIdx] = ( dz[blockIdx] < 0. ) ? zLow[blockIdx] : zUpp[blockIdx];
+		}
+		else {								/* bound is released */
+			statusFlag = boxQpSolver_addFreeVariable( qpData, interval, blockIdx );
+			actSet[blockIdx] = 0;
+		}
+		if ( statusFlag != QPDUNES_OK ) {
+			return statusFlag;
+		}
+	}
+
+	if ( logHomotopy == QPDUNES_TRUE ) {
+		logAlpha[nChg+1] = 1.;
+		interval->parametricObjFctn_nBasePoints = nChg + 2;
+	}
+	if ( nActSetChanges != 0 ) {
+		*nActSetChanges += nChg;
+	}
+
+	/* recompute free variables for the end point to avoid drift over pieces:
+	 * z_F = -(Z'HZ)^-1 ( q_F + H_FA z_A ) */
+	qpDUNES_copyVector( &(solver->qCur), qTarget, nV );
+	if ( dqNorm > 0. ) {
+		for ( ii=0; ii<solver->nFree; ++ii ) {
+			w[ii] = -qCur[freeIdx[ii]];
+			for ( jj=0; jj<nV; ++jj ) {
+				if ( actSet[jj] != 0 ) {
+					w[ii] -= H[freeIdx[ii]*nV+jj] * z[jj];
+				}
+			}
+		}
+		boxQpSolver_backsolveFree( interval, w );
+		for ( ii=0; ii<solver->nFree; ++ii ) {
+			z[freeIdx[ii]] = w[ii];
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF boxQpSolver_hotstart */
+
+
+/* ----------------------------------------------
+ * do a step of length alpha
+ *
+#>>>>>>                                           */
+return_t boxQpSolver_doStep(	qpData_t* const qpData,
+								interval_t* const interval,
+								real_t alpha,
+								z_vector_t* const z,
+								d2_vector_t* const mu,
+								z_vector_t* const qCandidate,
+								real_t* const p
+								)
+{
+	int_t ii;
+	return_t statusFlag;
+
+	qpSolverBoxQp_t* solver = &(interval->qpSolverBoxQp);
+
+	/* q(alpha) = (1-alpha)*q + alpha*qFullStep; qCandidate may be q itself */
+	for ( ii=0; ii<(int_t)interval->nV; ++ii ) {
+		solver->qTarget.data[ii] = (1-alpha) * interval->q.data[ii] + alpha * solver->qFullStep.data[ii];
+	}
+
+	/* drive homotopy to desired step size */
+	statusFlag = boxQpSolver_hotstart( qpData, interval, &(solver->qTarget), 0, QPDUNES_FALSE );
+
+	/* get primal and dual solution */
+	qpDUNES_copyVector( z, &(solver->zCur), interval->nV );
+	boxQpSolver_getDualSol( qpData, interval, &(solver->qTarget), mu );
+
+	/* update q and p */
+	*p = (1-alpha) * interval->p + alpha * solver->pFullStep;
+	qpDUNES_copyVector( qCandidate, &(solver->qTarget), interval->nV );
+
+	return statusFlag;
+}
+/*<<< END OF boxQpSolver_doStep */
+
+
+/* ----------------------------------------------
+ * Get dual solution in qpDUNES style:
+ * (muLow, muUpp)-pairs >= 0 for all bounds
+ *
+#>>>>>>                                           */
+return_t boxQpSolver_getDualSol(	qpData_t* const qpData,
+									interval_t* const interval,
+									const z_vector_t* const q,
+									d2_vector_t* const mu
+									)
+{
+	int_t ii, jj;
+	int_t nV = interval->nV;
+	real_t grad;
+
+	qpSolverBoxQp_t* solver = &(interval->qpSolverBoxQp);
+
+	for ( ii=0; ii<nV; ++ii ) {
+		mu->data[2*ii] = 0.;
+		mu->data[2*ii+1] = 0.;
+		if ( solver->actSet.data[ii] == 0 )	continue;
+
+		/* multiplier of an active bound is the gradient H*z + q */
+		grad = q->data[ii];
+		for ( jj=0; jj<nV; ++jj ) {
+			grad += interval->H.data[ii*nV+jj] * solver->zCur.data[jj];
+		}
+		if ( solver->actSet.data[ii] > 0 ) {
+			mu->data[2*ii+1] = -grad;
+		}
+		else if ( ( grad < 0. ) && ( interval->zUpp.data[ii] - interval->zLow.data[ii] <= qpData->options.equalityTolerance ) ) {
+			mu->data[2*ii+1] = -grad;	/* fixed variable, upper bound binding */
+		}
+		else {
+			mu->data[2*ii] = grad;
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF boxQpSolver_getDualSol */
+
+
+/* ----------------------------------------------
+ * Get projected Hessian factor
+ *
+#>>>>>>                                           */
+return_t boxQpSolver_getCholZTHZ(	qpData_t* const qpData,
+									interval_t* const interval,
+									zz_matrix_t* const cholZTHZ
+									)
+{
+	(void)qpData;		/* same interface as qpOASES_getCholZTHZ */
+
+	cholZTHZ->data = interval->qpSolverBoxQp.cholHFree.data;		/* row stride nV, lower triangular */
+
+	return QPDUNES_OK;
+}
+/*<<< END OF boxQpSolver_getCholZTHZ */
+
+
+/* ----------------------------------------------
+ * Get null-space basis matrix Z
+ *
+#>>>>>>                                           */
+return_t boxQpSolver_getZT(	qpData_t* const qpData,
+							interval_t* const interval,
+							int_t* const nFree,
+							zz_matrix_t* const ZT
+							)
+{
+	(void)qpData;		/* same interface as qpOASES_getZT */
+
+	*nFree = interval->qpSolverBoxQp.nFree;
+	ZT->data = interval->qpSolverBoxQp.ZT.data;
+
+	return QPDUNES_OK;
+}
+/*<<< END OF boxQpSolver_getZT */
+
+
+/* ----------------------------------------------
+ * append variable idx to the free variables
+ *
+ *   [ L  0 ] [ L' l ]   [ H_FF   H_Fi ]
+ *   [ l' d ] [ 0  d ] = [ H_iF   H_ii ]
+ *
+#>>>>>>                                           */
+return_t boxQpSolver_addFreeVariable(	qpData_t* const qpData,
+										interval_t* const interval,
+										int_t idx
+										)
+{
+	int_t ii, jj;
+	int_t nV = interval->nV;
+	real_t sum;
+
+	qpSolverBoxQp_t* solver = &(interval->qpSolverBoxQp);
+	real_t* L = solver->cholHFree.data;
+	int_t nF = solver->nFree;
+
+	/* l = L^-1 H_Fi */
+	for ( ii=0; ii<nF; ++ii ) {
+		sum = interval->H.data[solver->freeIdx.data[ii]*nV+idx];
+		for ( jj=0; jj<ii; ++jj ) {
+			sum -= L[ii*nV+jj] * L[nF*nV+jj];
+		}
+		L[nF*nV+ii] = sum / L[ii*nV+ii];
+	}
+
+	/* d = sqrt( H_ii - l'l ) */
+	sum = interval->H.data[idx*nV+idx];
+	for ( jj=0; jj<nF; ++jj ) {
+		sum -= L[nF*nV+jj] * L[nF*nV+jj];
+	}
+	if ( sum <= qpData->options.QPDUNES_ZERO ) {
+		qpDUNES_printError( qpData, __FILE__, __LINE__, "Hessian of stage %d not positive definite.", interval->id );
+		return QPDUNES_ERR_DIVISION_BY_ZERO;
+	}
+	L[nF*nV+nF] = sqrt( sum );
+
+	/* new row of null space basis */
+	for ( jj=0; jj<nV; ++jj ) {
+		solver->ZT.data[nF*nV+jj] = 0.;
+	}
+	solver->ZT.data[nF*nV+idx] = 1.;
+
+	solver->freeIdx.data[nF] = idx;
+	solver->nFree = nF + 1;
+
+	return QPDUNES_OK;
+}
+/*<<< END OF boxQpSolver_addFreeVariable */
+
+
+/* ----------------------------------------------
+ * remove free variable at position pos
+ *
+ * Deleting row and column pos of L leaves the
+ * trailing block with L33*L33' = H33 - l*l',
+ * l = L(pos+1:nF,pos), which is restored by a
+ * rank-one update of the Cholesky factor.
+ *
+#>>>>>>                                           */
+return_t boxQpSolver_removeFreeVariable(	interval_t* const interval,
+											int_t pos
+											)
+{
+	int_t ii, jj, kk;
+	int_t nV = interval->nV;
+	real_t r, c, s;
+
+	qpSolverBoxQp_t* solver = &(interval->qpSolverBoxQp);
+	real_t* L = solver->cholHFree.data;
+	real_t* x = solver->wFree.data;
+	int_t* freeIdx = solver->freeIdx.data;
+	int_t nF = solver->nFree;
+
+	/* save column pos below the diagonal and shift rows and columns */
+	for ( ii=pos+1; ii<nF; ++ii ) {
+		x[ii-1] = L[ii*nV+pos];
+		for ( jj=0; jj<pos; ++jj ) {
+			L[(ii-1)*nV+jj] = L[ii*nV+jj];
+		}
+		for ( jj=pos+1; jj<=ii; ++jj ) {
+			L[(ii-1)*nV+jj-1] = L[ii*nV+jj];
+		}
+	}
+
+	/* rank-one update of trailing block */
+	for ( kk=pos; kk<nF-1; ++kk ) {
+		r = sqrt( L[kk*nV+kk] * L[kk*nV+kk] + x[kk] * x[kk] );
+		c = r / L[kk*nV+kk];
+		s = x[kk] / L[kk*nV+kk];
+		L[kk*nV+kk] = r;
+		for ( ii=kk+1; ii<nF-1; ++ii ) {
+			L[ii*nV+kk] = ( L[ii*nV+kk] + s * x[ii] ) / c;
+			x[ii] = c * x[ii] - s * L[ii*nV+kk];
+		}
+	}
+
+	/* shift free variables and null space basis */
+	for ( ii=pos; ii<nF-1; ++ii ) {
+		solver->ZT.data[ii*nV+freeIdx[ii]] = 0.;
+		freeIdx[ii] = freeIdx[ii+1];
+		solver->ZT.data[ii*nV+freeIdx[ii]] = 1.;
+	}
+	solver->nFree = nF - 1;
+
+	return QPDUNES_OK;
+}
+/*<<< END OF boxQpSolver_removeFreeVariable */
+
+
+/* ----------------------------------------------
+ * solve L*L'*x = b for free variables in place
+ *
+#>>>>>>                                           */
+void boxQpSolver_backsolveFree(	interval_t* const interval,
+								real_t* const b
+								)
+{
+	int_t ii, jj;
+	int_t nV = interval->nV;
+	int_t nF = interval->qpSolverBoxQp.nFree;
+	real_t* L = interval->qpSolverBoxQp.cholHFree.data;
+
+	/* L*w = b */
+	for ( ii=0; ii<nF; ++ii ) {
+		for ( jj=0; jj<ii; ++jj ) {
+			b[ii] -= L[ii*nV+jj] * b[jj];
+		}
+		b[ii] /= L[ii*nV+ii];
+	}
+	/* L'*x = w */
+	for ( ii=nF-1; ii>=0; --ii ) {
+		for ( jj=ii+1; jj<nF; ++jj ) {
+			b[ii] -= L[jj*nV+ii] * b[jj];
+		}
+		b[ii] /= L[ii*nV+ii];
+	}
+}
+/*<<< END OF boxQpSolver_backsolveFree */
+
+
+/*
+ *	end of file
+ */
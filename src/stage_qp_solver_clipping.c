@@ -158,6 +158,11 @@ return_t clippingQpSolver_getMinStepsize( 	const qpData_t* const qpData,
 	real_t lbRatio, ubRatio;
 	real_t alphaASChange;
 
+	if ( qpData->clippingKernels.minStepsize != 0 ) {
+		qpData->clippingKernels.minStepsize( interval->y.data, interval->qpSolverClipping.dz.data, interval->nV, qpData->options.QPDUNES_INFTY, alphaMin );
+		return QPDUNES_OK;
+	}
+
 	for( ii=0; ii<interval->nV; ++ii ) {
 		lbRatio = interval->y.data[2*ii] / interval->qpSolverClipping.dz.data[ii];
 		ubRatio = - interval->y.data[2*ii+1] / interval->qpSolverClipping.dz.data[ii];
@@ -177,6 +182,129 @@ return_t clippingQpSolver_getMinStepsize( 	const qpData_t* const qpData,
 /*<<< END OF clippingQpSolver_getMinStepsize */
 
 
+/* ----------------------------------------------
+ * piecewise quadratic dual function along dz
+ *
+ * Component ii of z(alpha) = sat( zUnconstrained + alpha*dz ) is unsaturated
+ * between two breakpoints; there it contributes qStep[ii]*dz[ii] (<= 0) to the
+ * curvature of the stage dual function. Adds slope and curvature at alpha = 0+
+ * and appends all curvature changes (alpha, dCurvature) in (0, alphaMax) to
+ * breakpoints, starting at *nBreakpoints
+ *
+#>>>>>>                                           */
+return_t clippingQpSolver_getBreakpoints(	const interval_t* const interval,
+											real_t alphaMax,
+											real_t* const breakpoints,	/**< pairs (alpha, dCurvature) */
+											int_t* const nBreakpoints,
+											real_t* const slope,
+											real_t* const curvature
+											)
+{
+	uint_t ii;
+	real_t zU, dz, lb, ub;
+	real_t alphaEnter, alphaLeave;
+	real_t dCurvature;
+
+	*slope += interval->qpSolverClipping.pStep;
+
+	for( ii=0; ii<interval->nV; ++ii ) {
+		zU = interval->qpSolverClipping.zUnconstrained.data[ii];
+		dz = interval->qpSolverClipping.dz.data[ii];
+		lb = interval->zLow.data[ii];
+		ub = interval->zUpp.data[ii];
+
+		/* slope: d/dalpha of stage dual function is qStep'*z + pStep */
+		*slope += interval->qpSolverClipping.qStep.data[ii] * qpDUNES_fmax( lb, qpDUNES_fmin( ub, zU ) );
+
+		if ( dz == 0. )	continue;	/* no breakpoints, no curvature */
+
+		/* interval in which the component is unsaturated */
+		if ( dz > 0. ) {
+			alphaEnter = (lb - zU) / dz;
+			alphaLeave = (ub - zU) / dz;
+		}
+		else {
+			alphaEnter = (ub - zU) / dz;
+			alphaLeave = (lb - zU) / dz;
+		}
+		if ( alphaLeave <= 0. )	continue;	/* saturated along the entire search direction */
+
+		dCurvature = interval->qpSolverClipping.qStep.data[ii] * dz;
+		if ( alphaEnter <= 0. ) {
+			*curvature += dCurvature;
+		}
+		else if ( alphaEnter < alphaMax ) {
+			breakpoints[2*(*nBreakpoints)] = alphaEnter;
+			breakpoints[2*(*nBreakpoints)+1] = dCurvature;
+			++(*nBreakpoints);
+		}
+		if ( alphaLeave < alphaMax ) {
+			breakpoints[2*(*nBreakpoints)] = alphaLeave;
+			breakpoints[2*(*nBreakpoints)+1] = -dCurvature;
+			++(*nBreakpoints);
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF clippingQpSolver_getBreakpoints */
+
+
+/* ----------------------------------------------
+ * return stage dual function derivative at given
+ * alpha value along dz
+ *
+#>>>>>>                                           */
+real_t clippingQpSolver_getParametricObjFctnGrad(	const interval_t* const interval,
+													real_t alpha
+													)
+{
+	uint_t ii;
+	real_t zAlpha;
+	real_t grad = interval->qpSolverClipping.pStep;
+
+	/* d/dalpha of stage dual function is qStep'*z(alpha) + pStep */
+	for( ii=0; ii<interval->nV; ++ii ) {
+		zAlpha = interval->qpSolverClipping.zUnconstrained.data[ii] + alpha * interval->qpSolverClipping.dz.data[ii];
+		grad += interval->qpSolverClipping.qStep.data[ii] * qpDUNES_fmax( interval->zLow.data[ii], qpDUNES_fmin( interval->zUpp.data[ii], zAlpha ) );
+	}
+
+	return grad;
+}
+/*<<< END OF clippingQpSolver_getParametricObjFctnGrad */
+
+
+/* ----------------------------------------------
+ * return stage dual function second derivative at
+ * given alpha value along dz; at breakpoints, the
+ * one in given direction (+1: increasing alpha)
+ *
+#>>>>>>                                           */
+real_t clippingQpSolver_getParametricObjFctnHess(	const interval_t* const interval,
+													real_t alpha,
+													int_t direction
+													)
+{
+	uint_t ii;
+	real_t zAlpha, dz;
+	real_t hess = 0.;
+
+	/* only unsaturated components move along, each contributes qStep_i*dz_i */
+	for( ii=0; ii<interval->nV; ++ii ) {
+		dz = interval->qpSolverClipping.dz.data[ii];
+		zAlpha = interval->qpSolverClipping.zUnconstrained.data[ii] + alpha * dz;
+		if ( ( ( zAlpha > interval->zLow.data[ii] ) || ( ( zAlpha == interval->zLow.data[ii] ) && ( direction * dz > 0. ) ) ) &&
+			 ( ( zAlpha < interval->zUpp.data[ii] ) || ( ( zAlpha == interval->zUpp.data[ii] ) && ( direction * dz < 0. ) ) ) )
+		{
+			hess += interval->qpSolverClipping.qStep.data[ii] * dz;
+		}
+	}
+
+	return hess;
+}
+/*<<< END OF clippingQpSolver_getParametricObjFctnHess */
+
+
 /* ----------------------------------------------
  * do a step of length alpha
  *
@@ -216,6 +344,36 @@ return_t directQpSolver_doStep( qpData_t* const qpData,
 /*<<< END OF directQpSolver_doStep */
 
 
+/* ----------------------------------------------
+ * do step for a step size alpha whose saturated
+ * primal variables zTry (and multipliers) were
+ * already computed during line search
+ *
+#>>>>>>                                           */
+return_t directQpSolver_doTrialStep( interval_t* const interval,
+									 const z_vector_t* const stepDir,
+									 real_t alpha,
+									 const z_vector_t* const zTry	)
+{
+	uint_t ii;
+
+	/* update unsaturated primal solution, take over saturated one */
+	addVectorScaledVector( &(interval->qpSolverClipping.zUnconstrained), &(interval->qpSolverClipping.zUnconstrained), alpha, stepDir, interval->nV );
+	qpDUNES_copyVector( &(interval->z), zTry, interval->nV );
+
+	/* update q */
+	for ( ii=0; ii<interval->nV; ++ii ) {
+		interval->q.data[ii] += alpha * interval->qpSolverClipping.qStep.data[ii];
+	}
+
+	/* update p */
+	interval->p += alpha * interval->qpSolverClipping.pStep;
+
+	return QPDUNES_OK;
+}
+/*<<< END OF directQpSolver_doTrialStep */
+
+
 /* ----------------------------------------------
  * ...
  * 
@@ -234,6 +392,10 @@ return_t directQpSolver_saturateVector(	qpData_t* const qpData,
 	
 	switch (H->sparsityType)	{
 		case QPDUNES_DIAGONAL:		/* H is saved in first row of memory */
+			if ( qpData->clippingKernels.saturate != 0 ) {
+				qpData->clippingKernels.saturate( vec->data, mu->data, lb->data, ub->data, H->data, nV, qpData->options.activenessTolerance );
+				break;
+			}
 			for( ii=0; ii<nV; ++ii ) {
 				/* for box constraints and diagonal hessians it holds: lambda_i/H_ii = (zUnconstr_i - zBound_i)	*/
 				mu->data[2*ii] = (lb->data[ii] - vec->data[ii])*H->data[ii];	/* feasibility gap to lower bound; negative value means inactive */
@@ -250,6 +412,10 @@ return_t directQpSolver_saturateVector(	qpData_t* const qpData,
 			break;
 
 		case QPDUNES_IDENTITY:		/* H values not needed */
+			if ( qpData->clippingKernels.saturate != 0 ) {
+				qpData->clippingKernels.saturate( vec->data, mu->data, lb->data, ub->data, 0, nV, qpData->options.activenessTolerance );
+				break;
+			}
 			for( ii=0; ii<nV; ++ii ) {
 				/* for box constraints and diagonal hessians it holds: lambda_i/H_ii = (zUnconstr_i - zBound_i)	*/
 				mu->data[2*ii] = (lb->data[ii] - vec->data[ii]);		/* feasibility gap to lower bound; negative value means inactive */
@@ -307,6 +473,11 @@ return_t clippingQpSolver_ratioTest(	qpData_t* const qpData,
 
 	real_t stepRatio;
 
+	if ( qpData->clippingKernels.ratioTest != 0 ) {
+		qpData->clippingKernels.ratioTest( minStepSizeASChange, zStepDir->data, mu->data, lb->data, ub->data, nV, qpData->options.equalityTolerance, qpData->options.QPDUNES_INFTY );
+		return QPDUNES_OK;
+	}
+
 	*minStepSizeASChange = qpData->options.QPDUNES_INFTY;	/* minimum step size that leads to active set change */
 
 	for( ii=0; ii<nV; ++ii ) {
@@ -345,6 +516,71 @@ return_t clippingQpSolver_ratioTest(	qpData_t* const qpData,
 
 
 
+/* ----------------------------------------------
+ * stage objective values for several step sizes
+ *
+ * objVals[jj] = 0.5*z'*H*z + q(alpha_jj)'*z + p(alpha_jj) for
+ * z = sat( zUnconstrained + alpha_jj*dz ), saturated like in
+ * directQpSolver_saturateVector; z, y and q of the interval are not touched
+ *
+#>>>>>>                                           */
+return_t directQpSolver_getParametricObjectiveValues(	qpData_t* const qpData,
+														const interval_t* const interval,
+														const real_t* const alphas,
+														real_t* const objVals,
+														int_t nAlphas
+														)
+{
+	uint_t ii;
+	int_t jj;
+	real_t hii, zU, dz, lb, ub, q, qStep;
+	real_t z;
+
+	for( jj=0; jj<nAlphas; ++jj ) {
+		objVals[jj] = interval->p + alphas[jj] * interval->qpSolverClipping.pStep;
+	}
+
+	for( ii=0; ii<interval->nV; ++ii ) {
+		switch (interval->H.sparsityType)	{
+			case QPDUNES_DIAGONAL:		/* H is saved in first row of memory */
+				hii = interval->H.data[ii];
+				break;
+
+			case QPDUNES_IDENTITY:
+				hii = 1.;
+				break;
+
+			default:
+				qpDUNES_printError( qpData, __FILE__, __LINE__, "Unknown sparsity type of QP hessian" );
+				return QPDUNES_ERR_UNKNOWN_MATRIX_SPARSITY_TYPE;
+		}
+		zU = interval->qpSolverClipping.zUnconstrained.data[ii];
+		dz = interval->qpSolverClipping.dz.data[ii];
+		lb = interval->zLow.data[ii];
+		ub = interval->zUpp.data[ii];
+		q = interval->q.data[ii];
+		qStep = interval->qpSolverClipping.qStep.data[ii];
+
+		/* one component at all step sizes */
+		for( jj=0; jj<nAlphas; ++jj ) {
+			z = zU + alphas[jj] * dz;
+			if ( (lb - z)*hii >= -qpData->options.activenessTolerance ) {
+				z = lb;
+			}
+			else {
+				if ( (z - ub)*hii >= -qpData->options.activenessTolerance ) {
+					z = ub;
+				}
+			}
+			objVals[jj] += ( 0.5 * hii * z + q + alphas[jj] * qStep ) * z;
+		}
+	}
+
+	return QPDUNES_OK;
+}
+/*<<< END OF directQpSolver_getParametricObjectiveValues */
+
+
 /* ----------------------------------------------
  * ...
  *
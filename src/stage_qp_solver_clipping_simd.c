@@ -0,0 +1,227 @@
+/*
+ *	This file is part of qpDUNES.
+ *
+ *	qpDUNES -- A DUal NEwton Strategy for convex quadratic programming.
+ *	Copyright (C) 2012 by Janick Frasch, Hans Joachim Ferreau et al.
+ *	All rights reserved.
+ *
+ *	qpDUNES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpDUNES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qp42; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file src/stage_qp_solver_clipping_simd.c
+ *	\version 1.0beta
+ *
+ *	Instantiation of stage_qp_solver_clipping_simd_template.h for AVX2 and
+ *	AVX-512 and run-time selection by CPU feature detection, as in
+ *	newton_system_simd.c.
+ */
+
+
+#include <qp/stage_qp_solver_clipping_simd.h>
+
+
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) ) && !defined(__USE_SINGLE_PRECISION__)
+	#define QPDUNES_CLIPPING_SIMD_AVAILABLE
+#endif
+
+
+#ifdef QPDUNES_CLIPPING_SIMD_AVAILABLE
+
+#include <immintrin.h>
+
+
+/** AVX2, 4 doubles per register */
+#define SIMD_NAME( NAME )	NAME##_avx2
+#define SIMD_FUNCTION		static __attribute__((target("avx2")))
+#define SIMD_WIDTH			4
+#define SIMD_VEC			__m256d
+#define SIMD_MASK			__m256d
+#define SIMD_LOAD			_mm256_loadu_pd
+#define SIMD_STORE			_mm256_storeu_pd
+#define SIMD_SET1			_mm256_set1_pd
+#define SIMD_ZERO			_mm256_setzero_pd
+#define SIMD_SUB			_mm256_sub_pd
+#define SIMD_MUL			_mm256_mul_pd
+#define SIMD_DIV			_mm256_div_pd
+#define SIMD_MIN			_mm256_min_pd
+#define SIMD_CMP_GE( A, B )	_mm256_cmp_pd( A, B, _CMP_GE_OQ )
+#define SIMD_CMP_LT( A, B )	_mm256_cmp_pd( A, B, _CMP_LT_OQ )
+#define SIMD_MASK_AND		_mm256_and_pd
+#define SIMD_BLEND( M, A, B )	_mm256_blendv_pd( A, B, M )
+#define SIMD_REDUCE_MIN		reduceMin_avx2
+#define SIMD_LOAD_PAIRS		loadPairs_avx2
+#define SIMD_STORE_PAIRS	storePairs_avx2
+
+SIMD_FUNCTION real_t reduceMin_avx2( __m256d v )
+{
+	__m128d s = _mm_min_pd( _mm256_castpd256_pd128( v ), _mm256_extractf128_pd( v, 1 ) );
+	return _mm_cvtsd_f64( _mm_min_sd( s, _mm_unpackhi_pd( s, s ) ) );
+}
+
+/* (l0,u0,l1,u1,l2,u2,l3,u3) -> (l0,l1,l2,l3), (u0,u1,u2,u3) */
+SIMD_FUNCTION void loadPairs_avx2( const real_t* const pairs, __m256d* const low, __m256d* const upp )
+{
+	__m256d a = _mm256_loadu_pd( pairs );
+	__m256d b = _mm256_loadu_pd( pairs + 4 );
+	__m256d t0 = _mm256_permute2f128_pd( a, b, 0x20 );	/* l0,u0,l2,u2 */
+	__m256d t1 = _mm256_permute2f128_pd( a, b, 0x31 );	/* l1,u1,l3,u3 */
+	*low = _mm256_unpacklo_pd( t0, t1 );
+	*upp = _mm256_unpackhi_pd( t0, t1 );
+}
+
+SIMD_FUNCTION void storePairs_avx2( real_t* const pairs, __m256d low, __m256d upp )
+{
+	__m256d t0 = _mm256_unpacklo_pd( low, upp );	/* l0,u0,l2,u2 */
+	__m256d t1 = _mm256_unpackhi_pd( low, upp );	/* l1,u1,l3,u3 */
+	_mm256_storeu_pd( pairs, _mm256_permute2f128_pd( t0, t1, 0x20 ) );
+	_mm256_storeu_pd( pairs + 4, _mm256_permute2f128_pd( t0, t1, 0x31 ) );
+}
+
+#include <qp/stage_qp_solver_clipping_simd_template.h>
+
+#undef SIMD_NAME
+#undef SIMD_FUNCTION
+#undef SIMD_WIDTH
+#undef SIMD_VEC
+#undef SIMD_MASK
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_ZERO
+#undef SIMD_SUB
+#undef SIMD_MUL
+#undef SIMD_DIV
+#undef SIMD_MIN
+#undef SIMD_CMP_GE
+#undef SIMD_CMP_LT
+#undef SIMD_MASK_AND
+#undef SIMD_BLEND
+#undef SIMD_REDUCE_MIN
+#undef SIMD_LOAD_PAIRS
+#undef SIMD_STORE_PAIRS
+
+
+/** AVX-512, 8 doubles per register */
+#define SIMD_NAME( NAME )	NAME##_avx512
+#define SIMD_FUNCTION		static __attribute__((target("avx512f")))
+#define SIMD_WIDTH			8
+#define SIMD_VEC			__m512d
+#define SIMD_MASK			__mmask8
+#define SIMD_LOAD			_mm512_loadu_pd
+#define SIMD_STORE			_mm512_storeu_pd
+#define SIMD_SET1			_mm512_set1_pd
+#define SIMD_ZERO			_mm512_setzero_pd
+#define SIMD_SUB			_mm512_sub_pd
+#define SIMD_MUL			_mm512_mul_pd
+#define SIMD_DIV			_mm512_div_pd
+#define SIMD_MIN			_mm512_min_pd
+#define SIMD_CMP_GE( A, B )	_mm512_cmp_pd_mask( A, B, _CMP_GE_OQ )
+#define SIMD_CMP_LT( A, B )	_mm512_cmp_pd_mask( A, B, _CMP_LT_OQ )
+#define SIMD_MASK_AND( A, B )	( (__mmask8)( (A) & (B) ) )
+#define SIMD_BLEND( M, A, B )	_mm512_mask_blend_pd( M, A, B )
+#define SIMD_REDUCE_MIN		_mm512_reduce_min_pd
+#define SIMD_LOAD_PAIRS		loadPairs_avx512
+#define SIMD_STORE_PAIRS	storePairs_avx512
+
+SIMD_FUNCTION void loadPairs_avx512( const real_t* const pairs, __m512d* const low, __m512d* const upp )
+{
+	__m512d a = _mm512_loadu_pd( pairs );
+	__m512d b = _mm512_loadu_pd( pairs + 8 );
+	*low = _mm512_permutex2var_pd( a, _mm512_setr_epi64( 0, 2, 4, 6, 8, 10, 12, 14 ), b );
+	*upp = _mm512_permutex2var_pd( a, _mm512_setr_epi64( 1, 3, 5, 7, 9, 11, 13, 15 ), b );
+}
+
+SIMD_FUNCTION void storePairs_avx512( real_t* const pairs, __m512d low, __m512d upp )
+{
+	_mm512_storeu_pd( pairs, _mm512_permutex2var_pd( low, _mm512_setr_epi64( 0, 8, 1, 9, 2, 10, 3, 11 ), upp ) );
+	_mm512_storeu_pd( pairs + 8, _mm512_permutex2var_pd( low, _mm512_setr_epi64( 4, 12, 5, 13, 6, 14, 7, 15 ), upp ) );
+}
+
+#include <qp/stage_qp_solver_clipping_simd_template.h>
+
+#undef SIMD_NAME
+#undef SIMD_FUNCTION
+#undef SIMD_WIDTH
+#undef SIMD_VEC
+#undef SIMD_MASK
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_ZERO
+#undef SIMD_SUB
+#undef SIMD_MUL
+#undef SIMD_DIV
+#undef SIMD_MIN
+#undef SIMD_CMP_GE
+#undef SIMD_CMP_LT
+#undef SIMD_MASK_AND
+#undef SIMD_BLEND
+#undef SIMD_REDUCE_MIN
+#undef SIMD_LOAD_PAIRS
+#undef SIMD_STORE_PAIRS
+
+#endif	/* QPDUNES_CLIPPING_SIMD_AVAILABLE */
+
+
+/* ----------------------------------------------
+ * Select vectorized clipping kernels
+ *
+ >>>>>>                                           */
+boolean_t qpDUNES_setupClippingKernels(	qpData_t* const qpData
+										)
+{
+	clippingKernels_t* kernels = &(qpData->clippingKernels);
+
+	kernels->saturate = 0;
+	kernels->minStepsize = 0;
+	kernels->ratioTest = 0;
+
+	if ( ( qpData->options.useSimdClippingKernels != QPDUNES_TRUE ) ||
+		 ( qpData->nZ < QPDUNES_CLIPPING_SIMD_NZ_MIN ) )
+	{
+		return QPDUNES_FALSE;
+	}
+
+	#ifdef QPDUNES_CLIPPING_SIMD_AVAILABLE
+	__builtin_cpu_init();
+
+	/* stages shorter than one AVX-512 register would only run the scalar remainder loops */
+	if ( __builtin_cpu_supports( "avx512f" ) && ( qpData->nZ >= 8 ) ) {
+		kernels->saturate = &saturate_avx512;
+		kernels->minStepsize = &minStepsize_avx512;
+		kernels->ratioTest = &ratioTest_avx512;
+		return QPDUNES_TRUE;
+	}
+	if ( __builtin_cpu_supports( "avx2" ) ) {
+		kernels->saturate = &saturate_avx2;
+		kernels->minStepsize = &minStepsize_avx2;
+		kernels->ratioTest = &ratioTest_avx2;
+		return QPDUNES_TRUE;
+	}
+	#endif	/* QPDUNES_CLIPPING_SIMD_AVAILABLE */
+
+	return QPDUNES_FALSE;
+}
+/*<<< END OF qpDUNES_setupClippingKernels */
+
+
+
+/*
+ *	end of file
+ */
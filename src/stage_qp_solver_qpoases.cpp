@@ -35,6 +35,24 @@
 #include <stdlib.h>
 
 
+/* ----------------------------------------------
+ * common QProblemB interface of a stage qpOASES
+ * object (LoggedQProblemB on stages with simple
+ * bounds only, LoggedSQProblem otherwise)
+ *
+#>>>>>>                                           */
+static qpOASES::QProblemB* qpOASES_getQProblemB( const qpoasesObject_t* const qpoasesObject )
+{
+	if ( qpoasesObject->isBoundsOnly == QPDUNES_TRUE ) {
+		return static_cast<qpOASES::LoggedQProblemB*>( qpoasesObject->qpoases );
+	}
+	else {
+		return static_cast<qpOASES::LoggedSQProblem*>( qpoasesObject->qpoases );
+	}
+}
+/*<<< END OF qpOASES_getQProblemB */
+
+
 extern "C" {
 
 /* ----------------------------------------------
@@ -47,7 +65,15 @@ qpoasesObject_t* qpOASES_constructor( qpData_t* qpData,
 {
 	/* set up new qpOASES object */
 	qpoasesObject_t* qpoasesObject = (qpoasesObject_t*)calloc( 1,sizeof(qpoasesObject_t) );
-	qpoasesObject->qpoases = static_cast<qpoases_t*>( new qpOASES::LoggedSQProblem( nV, nD ) );
+	if ( nD == 0 ) {
+		/* stages with simple bounds only do not need the constraint bookkeeping of SQProblem */
+		qpoasesObject->isBoundsOnly = QPDUNES_TRUE;
+		qpoasesObject->qpoases = static_cast<qpoases_t*>( new qpOASES::LoggedQProblemB( nV ) );
+	}
+	else {
+		qpoasesObject->isBoundsOnly = QPDUNES_FALSE;
+		qpoasesObject->qpoases = static_cast<qpoases_t*>( new qpOASES::LoggedSQProblem( nV, nD ) );
+	}
 
 	/* set some options */
 	qpoasesObject->options = static_cast<qpoasesOptions_t*>( new qpOASES::Options() );
@@ -70,7 +96,7 @@ qpoasesObject_t* qpOASES_constructor( qpData_t* qpData,
 	static_cast<qpOASES::Options*>( qpoasesObject->options )->initialStatusBounds = qpOASES::ST_INACTIVE;
 	static_cast<qpOASES::Options*>( qpoasesObject->options )->enableFarBounds = qpOASES::BT_FALSE;
 	static_cast<qpOASES::Options*>( qpoasesObject->options )->enableRegularisation = qpOASES::BT_FALSE;
-	static_cast<qpOASES::LoggedSQProblem*>( qpoasesObject->qpoases )->setOptions( *( static_cast<qpOASES::Options*>( qpoasesObject->options ) ) );
+	qpOASES_getQProblemB( qpoasesObject )->setOptions( *( static_cast<qpOASES::Options*>( qpoasesObject->options ) ) );
 
 	#ifdef __DEBUG__
 	if (qpData->options.printLevel > 3)	{
@@ -91,7 +117,7 @@ qpoasesObject_t* qpOASES_constructor( qpData_t* qpData,
 void qpOASES_destructor( qpoasesObject_t** qpoasesObject )
 {
 	if (*qpoasesObject) {
-		delete static_cast<qpOASES::LoggedSQProblem*>( (*qpoasesObject)->qpoases );
+		delete qpOASES_getQProblemB( *qpoasesObject );	/* virtual destructor */
 		delete static_cast<qpOASES::Options*>( (*qpoasesObject)->options );
 		free( *qpoasesObject );
 	}
@@ -101,6 +127,43 @@ void qpOASES_destructor( qpoasesObject_t** qpoasesObject )
 /*<<< END OF qpOASES_destructor */
 
 
+/* ----------------------------------------------
+ * memory in bytes of a qpOASES object built by
+ * qpOASES_constructor; counts the class objects
+ * and the arrays allocated by qpOASES for nV
+ * variables and nC constraints (the flipper
+ * copies of the factors are only allocated on
+ * first use and not counted)
+ *
+#>>>>>>                                           */
+uint_t qpOASES_getMemorySize(	int_t nV,
+								int_t nC
+								)
+{
+	int_t nT = ( nV < nC ) ? nV : nC;	/* dimension of the TQ factor T */
+
+	uint_t memorySize = sizeof(qpoasesObject_t) + sizeof(qpOASES::Options);
+
+	if ( nC == 0 ) {
+		memorySize += sizeof(qpOASES::LoggedQProblemB);
+		memorySize += 2*nV*nV * sizeof(qpOASES::real_t);			/* R, QT */
+		memorySize += 6*nV * sizeof(qpOASES::real_t);				/* g, lb, ub, x, y, delta_xFR_TMP */
+	}
+	else {
+		memorySize += sizeof(qpOASES::LoggedSQProblem);
+		memorySize += ( 2*nV*nV + nT*nT ) * sizeof(qpOASES::real_t);	/* R, Q, T */
+		memorySize += ( 9*nV + 9*nC ) * sizeof(qpOASES::real_t);	/* vectors of QProblemB and QProblem, incl. y */
+		memorySize += 2*nC * sizeof(qpOASES::SubjectToStatus);		/* constraint types and status */
+		memorySize += 4*nC * sizeof(int);							/* active and inactive constraint index lists */
+	}
+	memorySize += 2*nV * sizeof(qpOASES::SubjectToStatus);			/* bound types and status */
+	memorySize += 4*nV * sizeof(int);								/* free and fixed bound index lists */
+
+	return memorySize;
+}
+/*<<< END OF qpOASES_getMemorySize */
+
+
 /* ----------------------------------------------
  * first QP solution
  *
@@ -135,13 +198,22 @@ return_t qpOASES_setup( qpData_t* qpData,
 //	if (interval->dUpp.data)  qpDUNES_printMatrixData( interval->dUpp.data, interval->nD, 1, "dUpp:" );
 //	}
 
-	qpOASES_statusFlag = static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->init( 	interval->H.data,
-																					interval->qpSolverQpoases.qFullStep.data,
-																					interval->D.data,
-																					interval->zLow.data, interval->zUpp.data,
-																					interval->dLow.data, interval->dUpp.data,
-																					nWSR
-																					);
+	if ( qpoasesObject->isBoundsOnly == QPDUNES_TRUE ) {
+		qpOASES_statusFlag = static_cast<qpOASES::LoggedQProblemB*>(qpoasesObject->qpoases)->init( 	interval->H.data,
+																						interval->qpSolverQpoases.qFullStep.data,
+																						interval->zLow.data, interval->zUpp.data,
+																						nWSR
+																						);
+	}
+	else {
+		qpOASES_statusFlag = static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->init( 	interval->H.data,
+																						interval->qpSolverQpoases.qFullStep.data,
+																						interval->D.data,
+																						interval->zLow.data, interval->zUpp.data,
+																						interval->dLow.data, interval->dUpp.data,
+																						nWSR
+																						);
+	}
 	switch ( qpOASES_statusFlag )
 	{
 		case qpOASES::SUCCESSFUL_RETURN:
@@ -161,7 +233,7 @@ return_t qpOASES_setup( qpData_t* qpData,
 	}
 
 	/* get primal and dual solution */
-	static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->getPrimalSolution( static_cast<qpOASES::real_t*>(interval->z.data) );
+	qpOASES_getQProblemB( qpoasesObject )->getPrimalSolution( static_cast<qpOASES::real_t*>(interval->z.data) );
 	qpOASES_getDualSol( qpData, interval, qpoasesObject, &(interval->y) );
 
 	//	qpDUNES_printMatrixData( mu->data, 2*interval->nV+2*interval->nD, 1, "qpoases multipliers[%d]", interval->id );
@@ -222,25 +294,37 @@ return_t qpOASES_dataUpdate( qpData_t* const qpData,
 //		qpDUNES_printMatrixData( interval->H.data, interval->nV, interval->nV, "H:" );
 //		if (interval->id == 0) 	qpDUNES_printMatrixData( interval->zLow.data, 1, interval->nV, "i[%3d]: zLowBeforeOases:", interval->id);
 //		if (interval->id == 0) 	qpDUNES_printMatrixData( interval->zUpp.data, 1, interval->nV, "i[%3d]: zUppBeforeOases:", interval->id);
-		qpOASES_statusFlag
-//			= static_cast<qpOASES::SQProblem*>(qpoasesObject)->hotstart(	interval->H.data,
-//																			interval->qpSolverQpoases.qFullStep.data,
-//																			interval->D.data,
-//																			(zLow_changed == QPDUNES_TRUE)? interval->zLow.data : 0,
-//																			(zUpp_changed == QPDUNES_TRUE)? interval->zUpp.data : 0,
-//																			(dLow_changed == QPDUNES_TRUE)? interval->dLow.data : 0,
-//																			(dUpp_changed == QPDUNES_TRUE)? interval->dUpp.data : 0,
-//																			nWSR
-//																			);
-			= static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->hotstart(	interval->H.data,
-																			interval->qpSolverQpoases.qFullStep.data,
-																			interval->D.data,
-																			interval->zLow.data,
-																			interval->zUpp.data,
-																			interval->dLow.data,
-																			interval->dUpp.data,
-																			*nQpoasesIter
-																			);
+		if ( qpoasesObject->isBoundsOnly == QPDUNES_TRUE ) {
+			/* QProblemB restarts from its current working set for the new Hessian */
+			qpOASES_statusFlag
+				= static_cast<qpOASES::LoggedQProblemB*>(qpoasesObject->qpoases)->hotstart(	interval->H.data,
+																				interval->qpSolverQpoases.qFullStep.data,
+																				interval->zLow.data,
+																				interval->zUpp.data,
+																				*nQpoasesIter
+																				);
+		}
+		else {
+			qpOASES_statusFlag
+//				= static_cast<qpOASES::SQProblem*>(qpoasesObject)->hotstart(	interval->H.data,
+//																				interval->qpSolverQpoases.qFullStep.data,
+//																				interval->D.data,
+//																				(zLow_changed == QPDUNES_TRUE)? interval->zLow.data : 0,
+//																				(zUpp_changed == QPDUNES_TRUE)? interval->zUpp.data : 0,
+//																				(dLow_changed == QPDUNES_TRUE)? interval->dLow.data : 0,
+//																				(dUpp_changed == QPDUNES_TRUE)? interval->dUpp.data : 0,
+//																				nWSR
+//																				);
+				= static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->hotstart(	interval->H.data,
+																				interval->qpSolverQpoases.qFullStep.data,
+																				interval->D.data,
+																				interval->zLow.data,
+																				interval->zUpp.data,
+																				interval->dLow.data,
+																				interval->dUpp.data,
+																				*nQpoasesIter
+																				);
+		}
 //		if (interval->id == 0) {
 //			qpDUNES_printMatrixData( interval->H.data, interval->nV, interval->nV, "D = ");
 //			qpDUNES_printMatrixData( interval->qpSolverQpoases.qFullStep.data, 1, interval->nV, "g = ");
@@ -252,7 +336,7 @@ return_t qpOASES_dataUpdate( qpData_t* const qpData,
 //		}
 //		if (interval->id == 0) 	qpDUNES_printMatrixData( interval->zLow.data, 1, interval->nV, "i[%3d]: zLowAfterOases:", interval->id);
 //		if (interval->id == 0) 	qpDUNES_printMatrixData( interval->zUpp.data, 1, interval->nV, "i[%3d]: zUppAfterOases:", interval->id);
-		static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->getPrimalSolution( static_cast<qpOASES::real_t*>(interval->z.data) );
+		qpOASES_getQProblemB( qpoasesObject )->getPrimalSolution( static_cast<qpOASES::real_t*>(interval->z.data) );
 //		if (interval->id == 0) 	qpDUNES_printMatrixData( interval->z.data, 1, interval->nV, "i[%3d]: z@AfterOases:", interval->id);
 	}
 	else {
@@ -263,20 +347,31 @@ return_t qpOASES_dataUpdate( qpData_t* const qpData,
 //																			(dLow_changed == QPDUNES_TRUE)? interval->dLow.data : 0,
 //																			(dUpp_changed == QPDUNES_TRUE)? interval->dUpp.data : 0,
 //																			nWSR );
-		qpOASES_statusFlag
-			= static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->hotstart( 	interval->qpSolverQpoases.qFullStep.data,
-																			interval->zLow.data,
-																			interval->zUpp.data,
-																			interval->dLow.data,
-																			interval->dUpp.data,
-																			*nQpoasesIter
-																			);
+		if ( qpoasesObject->isBoundsOnly == QPDUNES_TRUE ) {
+			qpOASES_statusFlag
+				= static_cast<qpOASES::LoggedQProblemB*>(qpoasesObject->qpoases)->hotstart( 	interval->qpSolverQpoases.qFullStep.data,
+																				interval->zLow.data,
+																				interval->zUpp.data,
+																				*nQpoasesIter
+																				);
+		}
+		else {
+			qpOASES_statusFlag
+				= static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->hotstart( 	interval->qpSolverQpoases.qFullStep.data,
+																				interval->zLow.data,
+																				interval->zUpp.data,
+																				interval->dLow.data,
+																				interval->dUpp.data,
+																				*nQpoasesIter
+																				);
+		}
 	}
 	switch ( qpOASES_statusFlag )
 	{
 		case qpOASES::SUCCESSFUL_RETURN:
 			break;
 
+		case qpOASES::RET_INIT_FAILED_INFEASIBILITY:		/* bounds-only QP reinitialized for new Hessian */
 		case qpOASES::RET_HOTSTART_STOPPED_INFEASIBILITY:
 			qpDUNES_printError( qpData, __FILE__, __LINE__, "qpOASES subproblem on stage %d infeasible.", interval->id );
 			return QPDUNES_ERR_STAGE_QP_INFEASIBLE;
@@ -292,7 +387,7 @@ return_t qpOASES_dataUpdate( qpData_t* const qpData,
 
 
 	/* get primal and dual solution */
-	static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->getPrimalSolution( static_cast<qpOASES::real_t*>(interval->z.data) );
+	qpOASES_getQProblemB( qpoasesObject )->getPrimalSolution( static_cast<qpOASES::real_t*>(interval->z.data) );
 	qpOASES_getDualSol( qpData, interval, qpoasesObject, &(interval->y) );
 
 	//	qpDUNES_printMatrixData( mu->data, 2*interval->nV+2*interval->nD, 1, "qpoases multipliers[%d]", interval->id );
@@ -380,7 +475,18 @@ return_t qpOASES_hotstart( 	qpData_t* qpData,
 //		qpDUNES_printMatrixData( interval->qpSolverQpoases.qFullStep.data, interval->nV, 1, "g (id = %d):", interval->id );
 //	}
 
-	if ( logHomotopy ) 	{
+	if ( ( logHomotopy ) && ( qpoasesObject->isBoundsOnly == QPDUNES_TRUE ) )	{
+		qpOASES_statusFlag
+			= static_cast<qpOASES::LoggedQProblemB*>(qpoasesObject->qpoases)->hotstart_withHomotopyLogging( 	q->data,
+																		interval->zLow.data,
+																		interval->zUpp.data,
+																		interval->parametricObjFctn_alpha.data,
+																		interval->parametricObjFctn_f.data,
+																		interval->parametricObjFctn_fPrime.data,
+																		interval->parametricObjFctn_fPrimePrime.data,
+																		nWSR );
+	}
+	else if ( logHomotopy ) 	{
 		qpOASES_statusFlag
 			= static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->hotstart_withHomotopyLogging( 	q->data,
 																		interval->zLow.data,
@@ -403,13 +509,22 @@ return_t qpOASES_hotstart( 	qpData_t* qpData,
 //			qpDUNES_printMatrixData( interval->dLow.data, 1, interval->nD, "dLow = ");
 //			qpDUNES_printMatrixData( interval->dUpp.data, 1, interval->nD, "dUpp = ");
 //		}
-		qpOASES_statusFlag
-			= static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->hotstart( 	q->data,
-																		interval->zLow.data,
-																		interval->zUpp.data,
-																		interval->dLow.data,
-																		interval->dUpp.data,
-																		nWSR );
+		if ( qpoasesObject->isBoundsOnly == QPDUNES_TRUE ) {
+			qpOASES_statusFlag
+				= static_cast<qpOASES::LoggedQProblemB*>(qpoasesObject->qpoases)->hotstart( 	q->data,
+																			interval->zLow.data,
+																			interval->zUpp.data,
+																			nWSR );
+		}
+		else {
+			qpOASES_statusFlag
+				= static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->hotstart( 	q->data,
+																			interval->zLow.data,
+																			interval->zUpp.data,
+																			interval->dLow.data,
+																			interval->dUpp.data,
+																			nWSR );
+		}
 	}
 	// janick: qpOASES needs to check if data changed each time. keeping constraints does not seem to be supported...
 //		= static_cast<qpOASES::SQProblem*>(qpoasesObject)->hotstart( 	q->data,
@@ -511,7 +626,7 @@ return_t qpOASES_getDualSol( 	qpData_t* qpData,
 
 	/* (1) get qpOASES multipliers
 	 * 	   qpOASES internal: first nV entries for bounds, then nC for constraints (positve: lower, negative: upper) */
-	static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->getDualSolution( static_cast<qpOASES::real_t*>(mu->data) );
+	qpOASES_getQProblemB( qpoasesObject )->getDualSolution( static_cast<qpOASES::real_t*>(mu->data) );
 
 	//qpDUNES_printMatrixData( mu->data, 2*interval->nV+2*interval->nD, 1, "qpoases multipliers[%d]", interval->id );
 
@@ -544,7 +659,12 @@ return_t qpOASES_getCholZTHZ( 	qpData_t* qpData,
 								zz_matrix_t* cholZTHZ 				)
 {
 	qpOASES::real_t* qpOASES_Rptr = 0;
-	static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->getR( &qpOASES_Rptr );
+	if ( qpoasesObject->isBoundsOnly == QPDUNES_TRUE ) {
+		static_cast<qpOASES::LoggedQProblemB*>(qpoasesObject->qpoases)->getR( &qpOASES_Rptr );
+	}
+	else {
+		static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->getR( &qpOASES_Rptr );
+	}
 
 	cholZTHZ->data = qpOASES_Rptr;	// work with qpOASES memory
 
@@ -563,7 +683,12 @@ return_t qpOASES_getZT( qpData_t* qpData,
 						zz_matrix_t* ZT 				)
 {
 	qpOASES::real_t* qpOASES_Qptr = 0;
-	static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->getQT( &qpOASES_Qptr, nFree );
+	if ( qpoasesObject->isBoundsOnly == QPDUNES_TRUE ) {
+		static_cast<qpOASES::LoggedQProblemB*>(qpoasesObject->qpoases)->getQT( &qpOASES_Qptr, nFree );	/* unit rows of the free variables */
+	}
+	else {
+		static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->getQT( &qpOASES_Qptr, nFree );
+	}
 
 	ZT->data = qpOASES_Qptr;	// work with qpOASES memory
 
@@ -633,7 +758,7 @@ return_t qpOASES_doStep( qpData_t* const qpData,
 	/** (1) do not call qpOASES again for full steps */
 	if (alpha > 1. - qpData->options.equalityTolerance)	{
 		/* get primal and dual solution */
-		static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->getPrimalSolution( static_cast<qpOASES::real_t*>(z->data) );
+		qpOASES_getQProblemB( qpoasesObject )->getPrimalSolution( static_cast<qpOASES::real_t*>(z->data) );
 		qpOASES_getDualSol( qpData, interval, qpoasesObject, mu );
 
 		/* update  q := qFullStep  */
@@ -658,7 +783,7 @@ return_t qpOASES_doStep( qpData_t* const qpData,
 	statusFlag = qpOASES_hotstart( qpData, interval->qpSolverQpoases.qpoasesObject, interval, qCandidate, 0, QPDUNES_FALSE );
 
 	/* get primal and dual solution */
-	static_cast<qpOASES::LoggedSQProblem*>(qpoasesObject->qpoases)->getPrimalSolution( static_cast<qpOASES::real_t*>(z->data) );
+	qpOASES_getQProblemB( qpoasesObject )->getPrimalSolution( static_cast<qpOASES::real_t*>(z->data) );
 	qpOASES_getDualSol( qpData, interval, qpoasesObject, mu );
 
 	/* update p := (1-alpha)*pFullStep + alpha*pOld  */